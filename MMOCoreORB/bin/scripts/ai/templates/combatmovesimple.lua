@@ -1,5 +1,5 @@
 combatmovesimple = {
-	{"cmroot", "CombatMove", "none", BEHAVIOR},
+	{"cmroot", "NativeCombatMove", "none", BEHAVIOR},
 }
 
 addAiTemplate("combatmovesimple", combatmovesimple)
\ No newline at end of file
@@ -1,5 +1,5 @@
 gettargetreactive = {
-	{"gtroot", "GetTarget", "none", BEHAVIOR},
+	{"gtroot", "NativeGetTarget", "none", BEHAVIOR},
 }
 
 addAiTemplate("gettargetreactive", gettargetreactive)
\ No newline at end of file
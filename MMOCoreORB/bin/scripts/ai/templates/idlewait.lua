@@ -1,7 +1,7 @@
 idlewait = {
-	{"idroot", "CompositeDefault", "none", SEQUENCEBEHAVIOR},
-	{"move0", "MoveDefault", "idroot", BEHAVIOR},
-	{"move1", "WaitDefault", "idroot", BEHAVIOR},
+	{"idroot", "NativeCompositeDefault", "none", SEQUENCEBEHAVIOR},
+	{"move0", "NativeMoveDefault", "idroot", BEHAVIOR},
+	{"move1", "NativeWaitDefault", "idroot", BEHAVIOR},
 }
 
 addAiTemplate("idlewait", idlewait)
\ No newline at end of file
@@ -1,27 +1,27 @@
 idlewander = {
-	{"idroot", "CompositeDefault", "none", SELECTORBEHAVIOR},
-	{"move", "CompositeDefault", "idroot", SEQUENCEBEHAVIOR},
-	{"patrol", "GeneratePatrolDefault", "idroot", BEHAVIOR},
-	{"move0", "WalkDefault", "move", BEHAVIOR},
-	{"move1", "Wait10Default", "move", BEHAVIOR},
+	{"idroot", "NativeCompositeDefault", "none", SELECTORBEHAVIOR},
+	{"move", "NativeCompositeDefault", "idroot", SEQUENCEBEHAVIOR},
+	{"patrol", "NativeGeneratePatrolDefault", "idroot", BEHAVIOR},
+	{"move0", "NativeWalkDefault", "move", BEHAVIOR},
+	{"move1", "NativeWait10Default", "move", BEHAVIOR},
 }
 
 addAiTemplate("idlewander", idlewander)
 
 idlewanderpack = {
-	{"idroot", "CompositePack", "none", SELECTORBEHAVIOR},
-	{"move", "CompositePack", "idroot", SEQUENCEBEHAVIOR},
-	{"patrol", "GeneratePatrolPack", "idroot", BEHAVIOR},
-	{"move0", "WalkPack", "move", BEHAVIOR},
-	{"move1", "Wait10Pack", "move", BEHAVIOR},
+	{"idroot", "NativeCompositePack", "none", SELECTORBEHAVIOR},
+	{"move", "NativeCompositePack", "idroot", SEQUENCEBEHAVIOR},
+	{"patrol", "NativeGeneratePatrolPack", "idroot", BEHAVIOR},
+	{"move0", "NativeWalkPack", "move", BEHAVIOR},
+	{"move1", "NativeWait10Pack", "move", BEHAVIOR},
 }
 
 addAiTemplate("idlewanderpack", idlewanderpack)
 
 idlewanderstatic = {
-	{"idroot", "CompositeDefault", "none", SELECTORBEHAVIOR},
-	{"move0", "WalkDefault", "idroot", BEHAVIOR},
-	{"move1", "Wait10Default", "idroot", BEHAVIOR},
+	{"idroot", "NativeCompositeDefault", "none", SELECTORBEHAVIOR},
+	{"move0", "NativeWalkDefault", "idroot", BEHAVIOR},
+	{"move1", "NativeWait10Default", "idroot", BEHAVIOR},
 }
 
 addAiTemplate("idlewanderstatic", idlewanderstatic)
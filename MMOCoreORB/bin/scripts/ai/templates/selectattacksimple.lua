@@ -1,7 +1,7 @@
 selectattacksimple = {
-	{"saroot", "CompositeDefault", "none", SEQUENCEBEHAVIOR},
-	{"attack0", "SelectWeapon", "saroot", BEHAVIOR},
-	{"attack1", "SelectAttack", "saroot", BEHAVIOR},
+	{"saroot", "NativeCompositeDefault", "none", SEQUENCEBEHAVIOR},
+	{"attack0", "NativeSelectWeapon", "saroot", BEHAVIOR},
+	{"attack1", "NativeSelectAttack", "saroot", BEHAVIOR},
 }
 
 addAiTemplate("selectattacksimple", selectattacksimple)
@@ -74,6 +74,25 @@ addAiBehavior("MovePack")
 addAiBehavior("WalkPack")
 addAiBehavior("GeneratePatrolPack")
 
+-- Compiled versions of the base behaviors: addNativeAiBehavior(name, node, interruptClass)
+addNativeAiBehavior("NativeGetTarget", "GetTarget", "Interrupt")
+addNativeAiBehavior("NativeSelectAttack", "SelectAttack", "Interrupt")
+addNativeAiBehavior("NativeSelectWeapon", "SelectWeapon", "Interrupt")
+addNativeAiBehavior("NativeCombatMove", "CombatMove", "Interrupt")
+addNativeAiBehavior("NativeLeash", "Leash", "Interrupt")
+
+addNativeAiBehavior("NativeCompositeDefault", "Composite", "DefaultInterrupt")
+addNativeAiBehavior("NativeWaitDefault", "Wait", "DefaultInterrupt")
+addNativeAiBehavior("NativeWait10Default", "Wait10", "DefaultInterrupt")
+addNativeAiBehavior("NativeMoveDefault", "Move", "DefaultInterrupt")
+addNativeAiBehavior("NativeWalkDefault", "Walk", "DefaultInterrupt")
+addNativeAiBehavior("NativeGeneratePatrolDefault", "GeneratePatrol", "DefaultInterrupt")
+
+addNativeAiBehavior("NativeCompositePack", "Composite", "PackInterrupt")
+addNativeAiBehavior("NativeWait10Pack", "Wait10", "PackInterrupt")
+addNativeAiBehavior("NativeWalkPack", "Walk", "PackInterrupt")
+addNativeAiBehavior("NativeGeneratePatrolPack", "GeneratePatrol", "PackInterrupt")
+
 addAiBehavior("CompositeCreaturePet")
 addAiBehavior("WaitCreaturePet")
 addAiBehavior("Wait10CreaturePet")
@@ -40,34 +40,6 @@
 --this exception also makes it possible to release a modified version 
 --which carries forward this exception.
 
--- Global creature table
-ObjectTemplates = { }
-
-function ObjectTemplates:addTemplate(obj, file)
-	if (obj == nil) then
-		print("null template object specified for " .. file)
-	else
-		crc = crcString(file)
-	
-		if self[crc] == nil then
-			self[crc] = obj 
-		end
-	
-		addTemplateCRC(file, obj)
-	end	
-end
-
-function ObjectTemplates:addClientTemplate(obj, file)
-	if (obj == nil) then
-		print("null template object for " .. file)
-	else
-		addClientTemplate(file, obj)
-	end
-end
-
-function getTemplate(file)
-	return ObjectTemplates[file]
-end
-
+includeFile("templates.lua")
 includeFile("allobjects.lua")
 includeFile("serverobjects.lua")
@@ -401,6 +401,26 @@ namespace conf {
 			return getString("Core3.TrePath", "tre");
 		}
 
+		inline int getTreRecordCacheSize() {
+			return getInt("Core3.TreRecordCacheSize", 64);
+		}
+
+		inline int getTemplateLoaderThreads() {
+			return getInt("Core3.TemplateLoaderThreads", 0);
+		}
+
+		inline int getTreLoaderThreads() {
+			return getInt("Core3.TreLoaderThreads", 0);
+		}
+
+		inline bool getLuaBytecodeCache() {
+			return getBool("Core3.LuaBytecodeCache", true);
+		}
+
+		inline const String& getLuaBytecodeCachePath() {
+			return getString("Core3.LuaBytecodeCachePath", "");
+		}
+
 		inline uint16 getLoginPort() {
 			return getInt("Core3.LoginPort", 44453);
 		}
@@ -469,6 +489,30 @@ namespace conf {
 			return getInt("Core3.MaxNavMeshJobs", 6);
 		}
 
+		inline bool getNavMeshCache() {
+			return getBool("Core3.NavMeshCache", true);
+		}
+
+		inline const String& getNavMeshCachePath() {
+			return getString("Core3.NavMeshCachePath", "navmeshes");
+		}
+
+		inline const String& getZoneSpatialIndex(const String& zoneName) {
+			return getString("Core3.SpatialIndex." + zoneName, getString("Core3.SpatialIndex.default", "quadtree"));
+		}
+
+		inline float getSpatialGridCellSize() {
+			return getFloat("Core3.SpatialGridCellSize", 64.f);
+		}
+
+		inline float getInRangeHysteresis() {
+			return getFloat("Core3.InRangeHysteresis", 0.f);
+		}
+
+		inline int getInRangeBatchInterval() {
+			return getInt("Core3.InRangeBatchInterval", 0);
+		}
+
 		inline int getMaxAuctionSearchJobs() {
 			return getInt("Core3.MaxAuctionSearchJobs", 1);
 		}
@@ -517,6 +561,78 @@ namespace conf {
 			return getBool("Core3.PathfinderLogJSON", false);
 		}
 
+		inline int getMaxPathfinderThreads() {
+			return getInt("Core3.MaxPathfinderThreads", 2);
+		}
+
+		inline int getPathRequestBatchSize() {
+			return getInt("Core3.PathRequestBatchSize", 64);
+		}
+
+		inline bool getAiAsyncPathing() {
+			return getBool("Core3.AiAsyncPathing", true);
+		}
+
+		inline int getPathCacheSize() {
+			return getInt("Core3.PathCacheSize", 4096);
+		}
+
+		inline bool getAiTickLod() {
+			return getBool("Core3.AiTickLod", true);
+		}
+
+		inline int getAiSlowTickMultiplier() {
+			return getInt("Core3.AiSlowTickMultiplier", 4);
+		}
+
+		inline int getAiDormantTickMultiplier() {
+			return getInt("Core3.AiDormantTickMultiplier", 8);
+		}
+
+		inline int getAiTickBudget(const String& zoneName) {
+			return getInt("Core3.AiTickBudget." + zoneName, getInt("Core3.AiTickBudget.default", 0));
+		}
+
+		inline int getAiTickMaxDeferral() {
+			return getInt("Core3.AiTickMaxDeferral", 4000);
+		}
+
+		inline bool getAiAwarenessBatch() {
+			return getBool("Core3.AiAwarenessBatch", true);
+		}
+
+		inline int getAiAwarenessInterval() {
+			return getInt("Core3.AiAwarenessInterval", 1000);
+		}
+
+		inline int getAiAwarenessFullPass() {
+			return getInt("Core3.AiAwarenessFullPass", 5);
+		}
+
+		inline int getAiAwarenessThreads() {
+			return getInt("Core3.AiAwarenessThreads", 2);
+		}
+
+		inline int getChatRoomShardSize() {
+			return getInt("Core3.ChatRoomShardSize", 256);
+		}
+
+		inline int getChatDeliveryThreads() {
+			return getInt("Core3.ChatDeliveryThreads", 2);
+		}
+
+		inline int getDBPoolThreads() {
+			return getInt("Core3.DBPoolThreads", 0);
+		}
+
+		inline int getStructureLoadThreads() {
+			return getInt("Core3.StructureLoadThreads", 4);
+		}
+
+		inline bool getLazyFactoryCrates() {
+			return getBool("Core3.LazyFactoryCrates", true);
+		}
+
 		inline int getCleanupMailCount() {
 			return getInt("Core3.CleanupMailCount", 25000);
 		}
@@ -0,0 +1,292 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "NavMeshCache.h"
+#include "conf/ConfigManager.h"
+#include "templates/appearance/MeshData.h"
+
+#include <cstdio>
+#include <cfloat>
+#include <cerrno>
+#include <sys/stat.h>
+
+namespace {
+	struct NavMeshCacheHeader {
+		uint32 magic;
+		uint32 version;
+		uint64 settingsHash;
+		dtNavMeshParams params;
+		int numTiles;
+	};
+
+	struct NavMeshCacheTileHeader {
+		uint32 key;
+		int dataSize;
+		uint64 geometryHash;
+	};
+
+	inline uint64 mix(uint64 hash) {
+		hash ^= hash >> 33;
+		hash *= 0xff51afd7ed558ccdULL;
+		hash ^= hash >> 33;
+		hash *= 0xc4ceb9fe1a85ec53ULL;
+		hash ^= hash >> 33;
+
+		return hash;
+	}
+}
+
+NavMeshCache::NavMeshCache() : Logger("NavMeshCache") {
+	enabled = ConfigManager::instance()->getNavMeshCache();
+	cachePath = ConfigManager::instance()->getNavMeshCachePath();
+
+	if (enabled && mkdir(cachePath.toCharArray(), 0755) != 0 && errno != EEXIST) {
+		error() << "could not create navmesh cache directory " << cachePath << ", navmeshes will always be rebuilt";
+
+		enabled = false;
+	}
+}
+
+NavMeshCache::NavMeshCache(const String& path) : Logger("NavMeshCache") {
+	enabled = true;
+	cachePath = path;
+}
+
+String NavMeshCache::getCacheFile(const String& name) const {
+	return cachePath + "/" + name.replaceAll("/", "_") + ".navcache";
+}
+
+int NavMeshCache::loadTiles(const String& name, uint64 settingsHash, const VectorMap<uint32, uint64>& tileHashes,
+		dtNavMesh* mesh, SortedVector<uint32>& cachedTiles) {
+	String fileName = getCacheFile(name);
+
+	FILE* file = fopen(fileName.toCharArray(), "rb");
+
+	if (file == nullptr)
+		return 0;
+
+	NavMeshCacheHeader header;
+
+	if (fread(&header, sizeof(header), 1, file) != 1 || header.magic != CACHEMAGIC || header.version != CACHEVERSION
+			|| header.settingsHash != settingsHash || memcmp(&header.params, mesh->getParams(), sizeof(dtNavMeshParams)) != 0) {
+		fclose(file);
+
+		info(true) << "navmesh cache of " << name << " is out of date, rebuilding every tile";
+
+		return 0;
+	}
+
+	int loaded = 0;
+
+	for (int i = 0; i < header.numTiles; ++i) {
+		NavMeshCacheTileHeader tileHeader;
+
+		if (fread(&tileHeader, sizeof(tileHeader), 1, file) != 1 || tileHeader.dataSize < 0) {
+			error() << "truncated navmesh cache file " << fileName;
+			break;
+		}
+
+		auto index = tileHashes.find(tileHeader.key);
+
+		// geometry under the tile changed, leave it to the builder
+		if (index == tileHashes.npos || tileHashes.elementAt(index).getValue() != tileHeader.geometryHash) {
+			if (tileHeader.dataSize > 0 && fseek(file, tileHeader.dataSize, SEEK_CUR) != 0)
+				break;
+
+			continue;
+		}
+
+		if (tileHeader.dataSize > 0) {
+			byte* data = (byte*) dtAlloc(tileHeader.dataSize, DT_ALLOC_PERM);
+
+			if (data == nullptr)
+				break;
+
+			if (fread(data, tileHeader.dataSize, 1, file) != 1) {
+				dtFree(data);
+
+				error() << "truncated navmesh cache file " << fileName;
+				break;
+			}
+
+			dtStatus status = mesh->addTile(data, tileHeader.dataSize, DT_TILE_FREE_DATA, 0, 0);
+
+			if (dtStatusFailed(status)) {
+				dtFree(data);
+				continue;
+			}
+		}
+
+		cachedTiles.put(tileHeader.key);
+		++loaded;
+	}
+
+	fclose(file);
+
+	loadedTiles.add(loaded);
+
+	return loaded;
+}
+
+bool NavMeshCache::saveTiles(const String& name, uint64 settingsHash, const VectorMap<uint32, uint64>& tileHashes, const dtNavMesh* mesh) {
+	String fileName = getCacheFile(name);
+
+	// write next to the final file and rename so a crash never leaves a partial cache behind
+	String tempFileName = fileName + ".tmp";
+
+	FILE* file = fopen(tempFileName.toCharArray(), "wb");
+
+	if (file == nullptr) {
+		error() << "could not write " << tempFileName;
+
+		return false;
+	}
+
+	NavMeshCacheHeader header;
+	memset(&header, 0, sizeof(header));
+
+	header.magic = CACHEMAGIC;
+	header.version = CACHEVERSION;
+	header.settingsHash = settingsHash;
+	header.numTiles = tileHashes.size();
+
+	memcpy(&header.params, mesh->getParams(), sizeof(dtNavMeshParams));
+
+	bool res = fwrite(&header, sizeof(header), 1, file) == 1;
+
+	for (int i = 0; i < tileHashes.size() && res; ++i) {
+		uint32 key = tileHashes.elementAt(i).getKey();
+
+		const dtMeshTile* tile = mesh->getTileAt(key & 0xFFFF, key >> 16, 0);
+		bool hasData = tile != nullptr && tile->header != nullptr && tile->dataSize > 0;
+
+		NavMeshCacheTileHeader tileHeader;
+		memset(&tileHeader, 0, sizeof(tileHeader));
+
+		tileHeader.key = key;
+		tileHeader.dataSize = hasData ? tile->dataSize : 0;
+		tileHeader.geometryHash = tileHashes.elementAt(i).getValue();
+
+		res = fwrite(&tileHeader, sizeof(tileHeader), 1, file) == 1;
+
+		if (res && hasData)
+			res = fwrite(tile->data, tile->dataSize, 1, file) == 1;
+	}
+
+	fclose(file);
+
+	if (!res || std::rename(tempFileName.toCharArray(), fileName.toCharArray()) != 0) {
+		error() << "could not write " << fileName;
+
+		std::remove(tempFileName.toCharArray());
+
+		return false;
+	}
+
+	return true;
+}
+
+uint64 NavMeshCache::hashBytes(const void* data, int size, uint64 hash) {
+	const byte* bytes = (const byte*) data;
+
+	for (int i = 0; i < size; ++i) {
+		hash ^= bytes[i];
+		hash *= 0x100000001b3ULL;
+	}
+
+	return hash;
+}
+
+uint64 NavMeshCache::hashSettings(const RecastSettings& settings, const AABB& bounds, float waterTableHeight,
+		const Vector<Reference<RecastPolygon*> >& water) {
+	const float values[] = { settings.m_cellHeight, settings.m_agentHeight, settings.m_agentRadius, settings.m_agentMaxClimb,
+			settings.m_agentMaxSlope, settings.m_regionMinSize, settings.m_regionMergeSize, settings.m_edgeMaxLen,
+			settings.m_edgeMaxError, settings.m_vertsPerPoly, settings.m_detailSampleDist, settings.m_detailSampleMaxError,
+			settings.m_tileSize, settings.m_cellSize, settings.distanceBetweenPoles, (float) settings.m_partitionType,
+			bounds.getXMin(), bounds.getYMin(), bounds.getZMin(), bounds.getXMax(), bounds.getYMax(), bounds.getZMax(),
+			waterTableHeight };
+
+	uint64 hash = hashBytes(values, sizeof(values));
+
+	for (int i = 0; i < water.size(); ++i) {
+		const RecastPolygon* poly = water.get(i);
+
+		const float limits[] = { (float) poly->type, poly->hmin, poly->hmax };
+
+		hash = hashBytes(limits, sizeof(limits), hash);
+		hash = hashBytes(poly->verts, poly->numVerts * 3 * sizeof(float), hash);
+	}
+
+	return hash;
+}
+
+void NavMeshCache::hashTiles(const MeshData* geom, const AABB& bounds, const RecastSettings& settings,
+		VectorMap<uint32, uint64>& tileHashes) {
+	float bmin[3] = { bounds.getXMin(), bounds.getYMin(), bounds.getZMin() };
+	float bmax[3] = { bounds.getXMax(), bounds.getYMax(), bounds.getZMax() };
+
+	int gw = 0, gh = 0;
+	rcCalcGridSize(bmin, bmax, settings.m_cellSize, &gw, &gh);
+
+	const int ts = (int) settings.m_tileSize;
+	const int tw = (gw + ts - 1) / ts;
+	const int th = (gh + ts - 1) / ts;
+	const float tcs = settings.m_tileSize * settings.m_cellSize;
+
+	if (tw <= 0 || th <= 0)
+		return;
+
+	// same padding RecastTileBuilder rasterizes around every tile
+	const float border = ((int) ceilf(settings.m_agentRadius / settings.m_cellSize) + 3) * settings.m_cellSize;
+
+	Vector<uint64> hashes(tw * th, 1);
+
+	for (int i = 0; i < tw * th; ++i)
+		hashes.add(0);
+
+	const Vector<Vector3>* verts = geom->getVerts();
+	const Vector<MeshTriangle>* triangles = geom->getTriangles();
+
+	for (int i = 0; i < triangles->size(); ++i) {
+		const int* indices = triangles->getUnsafe(i).getVerts();
+
+		float coords[9];
+		float minX = FLT_MAX, maxX = -FLT_MAX, minZ = FLT_MAX, maxZ = -FLT_MAX;
+
+		for (int v = 0; v < 3; ++v) {
+			const Vector3& vert = verts->get(indices[v]);
+
+			coords[v * 3 + 0] = vert.getX();
+			coords[v * 3 + 1] = vert.getY();
+			coords[v * 3 + 2] = vert.getZ();
+
+			minX = Math::min(minX, vert.getX());
+			maxX = Math::max(maxX, vert.getX());
+			minZ = Math::min(minZ, vert.getZ());
+			maxZ = Math::max(maxZ, vert.getZ());
+		}
+
+		uint64 triangleHash = mix(hashBytes(coords, sizeof(coords)));
+
+		int x0 = Math::max(0, (int) floorf((minX - border - bmin[0]) / tcs));
+		int x1 = Math::min(tw - 1, (int) floorf((maxX + border - bmin[0]) / tcs));
+		int z0 = Math::max(0, (int) floorf((minZ - border - bmin[2]) / tcs));
+		int z1 = Math::min(th - 1, (int) floorf((maxZ + border - bmin[2]) / tcs));
+
+		for (int z = z0; z <= z1; ++z) {
+			for (int x = x0; x <= x1; ++x) {
+				hashes.elementAt(z * tw + x) += triangleHash;
+			}
+		}
+	}
+
+	tileHashes.removeAll();
+	tileHashes.setNoDuplicateInsertPlan();
+
+	for (int z = 0; z < th; ++z) {
+		for (int x = 0; x < tw; ++x) {
+			tileHashes.put(getTileKey(x, z), hashes.getUnsafe(z * tw + x));
+		}
+	}
+}
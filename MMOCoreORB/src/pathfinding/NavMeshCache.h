@@ -0,0 +1,86 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef NAVMESHCACHE_H_
+#define NAVMESHCACHE_H_
+
+#include "engine/engine.h"
+#include "pathfinding/RecastTileBuilder.h"
+
+class MeshData;
+
+/**
+ * On disk store of built navmesh tiles, one file per navmesh name. Every tile is
+ * keyed by a hash of the input geometry (terrain and structure triangles) that
+ * recast rasterizes into it, so loading a navmesh only rebuilds the tiles whose
+ * geometry changed since the cache was written. The rest of the input (recast
+ * settings, mesh bounds and water) goes into a settings hash, any change to it
+ * invalidates the whole file.
+ */
+class NavMeshCache : public Singleton<NavMeshCache>, public Logger, public Object {
+protected:
+	bool enabled;
+	String cachePath;
+
+	AtomicInteger loadedTiles;
+	AtomicInteger builtTiles;
+
+	const static uint32 CACHEMAGIC = 0x4E564D43; // NVMC
+	const static uint32 CACHEVERSION = 1;
+
+	String getCacheFile(const String& name) const;
+
+public:
+	NavMeshCache();
+	NavMeshCache(const String& path);
+
+	bool isEnabled() const {
+		return enabled;
+	}
+
+	/**
+	 * Adds the cached tiles of name whose geometry hash matches tileHashes to mesh, which
+	 * must already be initialized with the same params the cache was written with. The keys
+	 * of the tiles taken from the cache, empty ones included, are put into cachedTiles.
+	 * @return number of tiles taken from the cache
+	 */
+	int loadTiles(const String& name, uint64 settingsHash, const VectorMap<uint32, uint64>& tileHashes,
+			dtNavMesh* mesh, SortedVector<uint32>& cachedTiles);
+
+	/**
+	 * Writes every tile in tileHashes of mesh, tiles the builder left empty are stored empty.
+	 */
+	bool saveTiles(const String& name, uint64 settingsHash, const VectorMap<uint32, uint64>& tileHashes, const dtNavMesh* mesh);
+
+	void addBuiltTiles(int count) {
+		builtTiles.add(count);
+	}
+
+	int getLoadedTiles() const {
+		return loadedTiles.get();
+	}
+
+	int getBuiltTiles() const {
+		return builtTiles.get();
+	}
+
+	static inline uint32 getTileKey(int x, int y) {
+		return ((uint32) y << 16) | ((uint32) x & 0xFFFF);
+	}
+
+	static uint64 hashBytes(const void* data, int size, uint64 hash = 0xcbf29ce484222325ULL);
+
+	static uint64 hashSettings(const RecastSettings& settings, const AABB& bounds, float waterTableHeight,
+			const Vector<Reference<RecastPolygon*> >& water);
+
+	/**
+	 * Hashes every triangle of geom into the tiles of the navmesh grid over bounds it
+	 * overlaps, tile border included. Triangles are combined order independently since
+	 * the solid objects around a navmesh don't come back in a fixed order.
+	 */
+	static void hashTiles(const MeshData* geom, const AABB& bounds, const RecastSettings& settings,
+			VectorMap<uint32, uint64>& tileHashes);
+};
+
+#endif /* NAVMESHCACHE_H_ */
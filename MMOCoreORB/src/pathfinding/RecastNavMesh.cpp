@@ -7,6 +7,8 @@
 
 #include "RecastNavMesh.h"
 
+AtomicInteger RecastNavMesh::nextGeneration;
+
 bool RecastNavMesh::toBinaryStream(ObjectOutputStream* stream) {
 	saveAll(stream);
 	return true;
@@ -80,7 +82,7 @@ void RecastNavMesh::loadAll(ObjectInputStream* stream) {
 		mesh->addTile(data, tileHeader.dataSize, DT_TILE_FREE_DATA, tileHeader.tileRef, 0);
 	}
 
-	navMesh = mesh;
+	setDetourNavMesh(mesh);
 }
 
 void RecastNavMesh::saveAll(ObjectOutputStream* stream) {
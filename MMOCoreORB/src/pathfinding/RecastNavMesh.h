@@ -21,9 +21,15 @@ class RecastNavMesh : public Object, public Logger {
 	NavMeshSetHeader header;
 	String name;
 
+	// changes every time navMesh is replaced, a freed mesh can come back at the same address
+	uint32 generation;
+
+	static AtomicInteger nextGeneration;
+
 public:
 	RecastNavMesh() : Logger("RecastNavMesh"), header() {
 		navMesh = nullptr;
+		generation = 0;
 	}
 
 	~RecastNavMesh() {
@@ -52,6 +58,11 @@ public:
 
 	void setDetourNavMesh(dtNavMesh* navMesh) {
 		this->navMesh = navMesh;
+		generation = nextGeneration.increment();
+	}
+
+	uint32 getGeneration() const {
+		return generation;
 	}
 
 	void setName(const String& name) {
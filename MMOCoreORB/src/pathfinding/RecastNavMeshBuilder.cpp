@@ -20,6 +20,7 @@
 #include "server/zone/managers/planet/PlanetManager.h"
 #include "templates/appearance/MeshData.h"
 #include "ChunkyTriMesh.h"
+#include "NavMeshCache.h"
 #include "terrain/layer/boundaries/BoundaryRectangle.h"
 #include "terrain/layer/boundaries/BoundaryPolygon.h"
 #include "conf/ConfigManager.h"
@@ -182,6 +183,49 @@ void RecastNavMeshBuilder::rebuildArea(const AABB& buildArea) {
 }
 
 bool RecastNavMeshBuilder::build() {
+	if (!initNavMesh())
+		return false;
+
+	if (m_buildAll)
+		buildAllTiles();
+
+	return true;
+}
+
+bool RecastNavMeshBuilder::buildCached() {
+	if (!initNavMesh())
+		return false;
+
+	NavMeshCache* cache = NavMeshCache::instance();
+
+	VectorMap<uint32, uint64> tileHashes;
+	NavMeshCache::hashTiles(m_geom, bounds, settings, tileHashes);
+
+	uint64 settingsHash = NavMeshCache::hashSettings(settings, bounds, waterTableHeight, water);
+
+	SortedVector<uint32> cachedTiles;
+	cachedTiles.setNoDuplicateInsertPlan();
+
+	int loaded = cache->loadTiles(name, settingsHash, tileHashes, m_navMesh, cachedTiles);
+	int dirty = tileHashes.size() - loaded;
+
+	info(true) << "loaded " << loaded << " of " << tileHashes.size() << " navmesh tiles from the cache, rebuilding " << dirty;
+
+	if (dirty == 0)
+		return true;
+
+	buildAllTiles(&cachedTiles);
+
+	if (!running->get())
+		return false;
+
+	cache->addBuiltTiles(dirty);
+	cache->saveTiles(name, settingsHash, tileHashes, m_navMesh);
+
+	return true;
+}
+
+bool RecastNavMeshBuilder::initNavMesh() {
 	if (m_navMesh) {
 		dtFreeNavMesh(m_navMesh);
 	}
@@ -238,9 +282,6 @@ bool RecastNavMeshBuilder::build() {
 		return false;
 	}
 
-	if (m_buildAll)
-		buildAllTiles();
-
 	return true;
 }
 
@@ -364,7 +405,7 @@ void RecastNavMeshBuilder::buildAllTiles(const AABB& area) {
 }
 
 
-void RecastNavMeshBuilder::buildAllTiles() {
+void RecastNavMeshBuilder::buildAllTiles(const SortedVector<uint32>* skipTiles) {
 	if (!m_geom) return;
 	if (!m_navMesh) return;
 
@@ -425,6 +466,8 @@ void RecastNavMeshBuilder::buildAllTiles() {
 			return;
 
 		for (int x = 0; x < tw; ++x) {
+			if (skipTiles != nullptr && skipTiles->contains(NavMeshCache::getTileKey(x, y)))
+				continue;
 
 			float minx = bmin[0] + x * tcs;
 			float miny = bmin[1];
@@ -63,6 +63,8 @@ protected:
 
 	void cleanup();
 
+	bool initNavMesh();
+
 	Vector <Reference<RecastPolygon*>> water;
 
 	float waterTableHeight;
@@ -91,9 +93,15 @@ public:
 
 	virtual bool build();
 
+	/**
+	 * Builds the navmesh like build(), taking every tile whose input geometry is unchanged
+	 * from the NavMeshCache and writing the cache back when any tile had to be rebuilt.
+	 */
+	bool buildCached();
+
 	virtual void rebuildAreas(const Vector<AABB>& buildAreas, NavArea* navArea);
 
-	void buildAllTiles();
+	void buildAllTiles(const SortedVector<uint32>* skipTiles = nullptr);
 
 	void buildAllTiles(const AABB& areaToRebuild);
 
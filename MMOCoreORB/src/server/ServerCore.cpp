@@ -28,6 +28,7 @@
 #include "server/zone/managers/collision/NavMeshManager.h"
 #include "server/zone/managers/name/NameManager.h"
 #include "server/zone/managers/frs/FrsManager.h"
+#include "server/zone/objects/installation/factory/FactoryCrateFlusher.h"
 
 #include "server/zone/QuadTree.h"
 
@@ -617,7 +618,8 @@ void ServerCore::initialize() {
 			int zoneAllowedConnections =
 					configManager->getZoneAllowedConnections();
 
-			if (arguments.contains("deleteNavMeshes") && zoneServer != nullptr) {
+			// prebuilding goes through every navmesh so the cache ends up with all of their tiles
+			if ((arguments.contains("deleteNavMeshes") || arguments.contains("prebuildNavMeshes")) && zoneServer != nullptr) {
 				zoneServer->setShouldDeleteNavAreas(true);
 			}
 
@@ -694,6 +696,16 @@ void ServerCore::initialize() {
 			zoneServer->getPlayerManager()->getCleanupCharacterCount();
 		}
 
+		if (arguments.contains("prebuildNavMeshes") && zoneServer != nullptr) {
+			zoneServer->setServerStateLocked();
+
+			info(true) << "prebuilding navmeshes, the server will shut down when done";
+
+			NavMeshManager::instance()->waitForJobs();
+
+			handleCmds = false;
+		}
+
 		if (arguments.contains("shutdown")) {
 			handleCmds = false;
 		}
@@ -781,6 +793,11 @@ void ServerCore::shutdown() {
 
 	Thread::sleep(5000);
 
+	// the units factories made since their crates were last written aren't saved
+	int flushedFactories = FactoryCrateFlusher::instance()->flushAll();
+
+	info(true) << flushedFactories << " factory output crates flushed";
+
 	objectManager->createBackup(true);
 
 	while (objectManager->isObjectUpdateInProgress())
@@ -34,6 +34,7 @@
 #include "server/zone/packets/chat/ChatOnRemoveModeratorFromRoom.h"
 #include "server/zone/packets/chat/ChatOnBanFromRoom.h"
 #include "server/zone/packets/chat/ChatOnUnbanFromRoom.h"
+#include "server/zone/packets/chat/ChatSystemMessage.h"
 
 #include "server/zone/objects/group/GroupObject.h"
 #include "server/zone/objects/guild/GuildObject.h"
@@ -52,6 +53,47 @@
 Reference<ChatRoom*> generalRoom;
 Reference<ChatRoom*> pvpRoom;
 
+namespace {
+	// a single worker keeps the broadcasts in order
+	const char* BROADCAST_QUEUE = "ChatBroadcastQueue";
+
+	/**
+	 * Sends the message to the online players of the list, only those of the faction and gods
+	 * when factionCRC is set, and releases it.
+	 */
+	void sendToPlayers(const PlayerList* players, BaseMessage* message, uint32 factionCRC) {
+#ifdef LOCKFREE_BCLIENT_BUFFERS
+		message->acquire();
+#endif
+
+		for (int i = 0; i < players->size(); ++i) {
+			CreatureObject* player = players->getUnsafe(i);
+
+			if (player == nullptr || !player->isOnline())
+				continue;
+
+			if (factionCRC != 0 && player->getFaction() != factionCRC) {
+				PlayerObject* ghost = player->getPlayerObject();
+
+				if (ghost == nullptr || !ghost->hasGodMode())
+					continue;
+			}
+
+#ifdef LOCKFREE_BCLIENT_BUFFERS
+			player->sendMessage(message);
+#else
+			player->sendMessage(message->clone());
+#endif
+		}
+
+#ifdef LOCKFREE_BCLIENT_BUFFERS
+		message->release();
+#else
+		delete message;
+#endif
+	}
+}
+
 ChatManagerImplementation::ChatManagerImplementation(ZoneServer* serv, int initsize) : ManagedServiceImplementation() {
 	server = serv;
 	playerManager = nullptr;
@@ -66,6 +108,8 @@ ChatManagerImplementation::ChatManagerImplementation(ZoneServer* serv, int inits
 	loadSocialTypes();
 	loadSpatialChatTypes();
 	loadMoodTypes();
+
+	Core::getTaskManager()->initializeCustomQueue(BROADCAST_QUEUE, 1, false);
 }
 
 void ChatManagerImplementation::stop() {
@@ -924,7 +968,7 @@ void ChatManagerImplementation::addPlayer(CreatureObject* player) {
 	Locker _locker(_this.getReferenceUnsafeStaticCast());
 
 	String name = player->getFirstName().toLowerCase();
-	playerMap->put(name, player, false);
+	playerMap->put(name, player);
 }
 
 CreatureObject* ChatManagerImplementation::getPlayer(const String& name) {
@@ -948,24 +992,13 @@ CreatureObject* ChatManagerImplementation::removePlayer(const String& name) {
 
 	String lName = name.toLowerCase();
 
-	CreatureObject* player = playerMap->remove(lName, false);
+	CreatureObject* player = playerMap->remove(lName);
 
 	return player;
 }
 
 void ChatManagerImplementation::broadcastGalaxy(const String& message, const String& faction) {
-	Locker locker(_this.getReferenceUnsafeStaticCast());
-
-	playerMap->resetIterator(false);
-
-	uint32 factionCRC = faction.hashCode();
-
-	while (playerMap->hasNext(false)) {
-		ManagedReference<CreatureObject*> playerObject = playerMap->getNextValue(false);
-
-		if (playerObject->getFaction() == factionCRC || playerObject->getPlayerObject()->hasGodMode())
-			playerObject->sendSystemMessage(message);
-	}
+	broadcastMessage(new ChatSystemMessage(UnicodeString(message)), faction.hashCode());
 }
 
 void ChatManagerImplementation::broadcastGalaxy(CreatureObject* player, const String& message) {
@@ -977,48 +1010,26 @@ void ChatManagerImplementation::broadcastGalaxy(CreatureObject* player, const St
 	StringBuffer fullMessage;
 	fullMessage << "[" << firstName << "] " << message;
 
-	const auto stringMessage = fullMessage.toString();
-
-	Locker locker(_this.getReferenceUnsafeStaticCast());
-	//playerMap->lock();
-
-	playerMap->resetIterator(false);
-
-	while (playerMap->hasNext(false)) {
-		ManagedReference<CreatureObject*> playerObject = playerMap->getNextValue(false);
-
-		playerObject->sendSystemMessage(stringMessage);
-	}
+	broadcastMessage(new ChatSystemMessage(UnicodeString(fullMessage.toString())), 0);
 }
 
 void ChatManagerImplementation::broadcastMessage(BaseMessage* message) {
-	Locker _lock(_this.getReferenceUnsafeStaticCast());
-
-	playerMap->resetIterator(false);
-
-#ifdef LOCKFREE_BCLIENT_BUFFERS
-	message->acquire();
-#endif
+	broadcastMessage(message, 0);
+}
 
-	while (playerMap->hasNext(false)) {
-		ManagedReference<CreatureObject*> player = playerMap->getNextValue(false);
+void ChatManagerImplementation::broadcastMessage(BaseMessage* message, uint32 factionCRC) {
+	// the message is built once and the players are walked on the broadcast queue, off the chat manager lock
+	Reference<PlayerMap*> playerMap = this->playerMap;
+	Reference<PlayerList*> players;
 
-		if (player == nullptr || !player->isOnline())
-			continue;
-
-#ifdef LOCKFREE_BCLIENT_BUFFERS
-		player->sendMessage(message);
-#else
-		player->sendMessage(message->clone());
-#endif
-	}
+	if (playerMap != nullptr)
+		players = playerMap->getSnapshot();
+	else
+		players = new PlayerList();
 
-#ifdef LOCKFREE_BCLIENT_BUFFERS
-	message->release();
-#else
-	delete message;
-#endif
-	message = nullptr;
+	Core::getTaskManager()->executeTask([players, message, factionCRC] () {
+		sendToPlayers(players, message, factionCRC);
+	}, "BroadcastMessageLambda", BROADCAST_QUEUE);
 }
 
 void ChatManagerImplementation::broadcastChatMessage(CreatureObject* sourceCreature, const UnicodeString& message,
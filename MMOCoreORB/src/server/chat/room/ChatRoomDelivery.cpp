@@ -0,0 +1,285 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "ChatRoomDelivery.h"
+#include "conf/ConfigManager.h"
+#include "server/zone/objects/creature/CreatureObject.h"
+#include "server/zone/objects/player/PlayerObject.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+	Vector<String> queueNames;
+
+	/**
+	 * One room delivery, shared by its shards. The last one done releases the messages.
+	 */
+	class ChatRoomDeliveryJob : public Object {
+		ChatRoomDelivery* delivery;
+
+		uint32 roomID;
+		String roomName;
+
+		Reference<ChatRoomMembers*> members;
+		Vector<BaseMessage*> messages;
+
+		// set to check the members ignoring the sender, they must have a ghost then
+		bool checkIgnore;
+		String ignoreName;
+
+		uint64 startTime;
+		AtomicInteger recipients;
+
+		bool sharded;
+
+	public:
+		ChatRoomDeliveryJob(ChatRoomDelivery* delivery, uint32 roomID, const String& roomName, ChatRoomMembers* members, const Vector<BaseMessage*>& messages, bool checkIgnore, const String& ignoreName)
+			: delivery(delivery), roomID(roomID), roomName(roomName), members(members), messages(messages), checkIgnore(checkIgnore), ignoreName(ignoreName), sharded(false) {
+			startTime = Time::currentNanoTime();
+
+#ifdef LOCKFREE_BCLIENT_BUFFERS
+			for (int i = 0; i < this->messages.size(); ++i)
+				this->messages.getUnsafe(i)->acquire();
+#endif
+		}
+
+		~ChatRoomDeliveryJob() {
+			for (int i = 0; i < messages.size(); ++i) {
+#ifdef LOCKFREE_BCLIENT_BUFFERS
+				messages.getUnsafe(i)->release();
+#else
+				delete messages.getUnsafe(i);
+#endif
+			}
+
+			delivery->recordDelivery(roomID, roomName, recipients.get(), (Time::currentNanoTime() - startTime) / 1000);
+
+			if (sharded)
+				delivery->finishShardedDelivery(roomID);
+		}
+
+		void send(int shard, int shards) {
+			int sent = 0;
+
+			for (int i = 0; i < members->size(); ++i) {
+				CreatureObject* player = members->getUnsafe(i).get();
+
+				if (player == nullptr || (shards > 1 && player->getObjectID() % shards != (uint64) shard))
+					continue;
+
+				if (checkIgnore) {
+					PlayerObject* ghost = player->getPlayerObject();
+
+					if (ghost == nullptr || (!ignoreName.isEmpty() && ghost->isIgnoring(ignoreName)))
+						continue;
+				}
+
+				for (int j = 0; j < messages.size(); ++j)
+					delivery->sendToMember(player, messages.getUnsafe(j));
+
+				++sent;
+			}
+
+			recipients.add(sent);
+		}
+
+		int getMemberCount() const {
+			return members->size();
+		}
+
+		void setSharded() {
+			sharded = true;
+		}
+	};
+}
+
+ChatRoomDelivery::ChatRoomDelivery() : Logger("ChatRoomDelivery") {
+	ConfigManager* config = ConfigManager::instance();
+
+	shardSize = Math::max(1, config->getChatRoomShardSize());
+	threads = config->getChatDeliveryThreads();
+
+	stats.setNullValue(nullptr);
+	shardedDeliveries.setNullValue(0);
+}
+
+String ChatRoomDelivery::getQueueName(int shard) {
+	return "ChatDeliveryQueue" + String::valueOf(shard);
+}
+
+void ChatRoomDelivery::deliver(uint32 roomID, const String& roomName, ChatRoomMembers* members, BaseMessage* message, bool checkIgnore, const String& ignoreName) {
+	Vector<BaseMessage*> messages;
+	messages.add(message);
+
+	deliver(roomID, roomName, members, messages, checkIgnore, ignoreName);
+}
+
+void ChatRoomDelivery::deliver(uint32 roomID, const String& roomName, ChatRoomMembers* members, const Vector<BaseMessage*>& messages, bool checkIgnore, const String& ignoreName) {
+	Reference<ChatRoomDeliveryJob*> job = new ChatRoomDeliveryJob(this, roomID, roomName, members, messages, checkIgnore, ignoreName);
+
+	if (threads <= 1 || !startShardedDelivery(roomID, job->getMemberCount())) {
+		job->send(0, 1);
+		return;
+	}
+
+	job->setSharded();
+
+	int shards = threads;
+
+	for (int i = 0; i < shards; ++i) {
+		executeShard(i, [job, i, shards] () {
+			job->send(i, shards);
+		});
+	}
+}
+
+bool ChatRoomDelivery::startShardedDelivery(uint32 roomID, int memberCount) {
+	Locker locker(&shardedMutex);
+
+	int running = shardedDeliveries.get(roomID);
+
+	if (memberCount <= shardSize && running == 0)
+		return false;
+
+	shardedDeliveries.put(roomID, running + 1);
+
+	return true;
+}
+
+void ChatRoomDelivery::finishShardedDelivery(uint32 roomID) {
+	Locker locker(&shardedMutex);
+
+	int running = shardedDeliveries.get(roomID) - 1;
+
+	if (running > 0)
+		shardedDeliveries.put(roomID, running);
+	else
+		shardedDeliveries.remove(roomID);
+}
+
+void ChatRoomDelivery::executeShard(int shard, Function<void()>&& function) {
+	static bool queuesInitialized = [this] () {
+		for (int i = 0; i < threads; ++i) {
+			queueNames.add(getQueueName(i));
+
+			Core::getTaskManager()->initializeCustomQueue(queueNames.get(i), 1, false);
+		}
+
+		return true;
+	} ();
+
+	(void) queuesInitialized;
+
+	Core::getTaskManager()->executeTask(std::move(function), "ChatRoomDeliveryLambda", queueNames.get(shard).toCharArray());
+}
+
+void ChatRoomDelivery::sendToMember(CreatureObject* player, BaseMessage* message) {
+#ifdef LOCKFREE_BCLIENT_BUFFERS
+	player->sendMessage(message);
+#else
+	player->sendMessage(message->clone());
+#endif
+}
+
+void ChatRoomDelivery::recordDelivery(uint32 roomID, const String& roomName, int recipients, uint64 latencyMicros) {
+	Reference<ChatRoomDeliveryStats*> roomStats;
+
+	{
+		ReadLocker locker(&statsLock);
+
+		roomStats = stats.get(roomID);
+	}
+
+	if (roomStats == nullptr) {
+		Locker locker(&statsLock);
+
+		roomStats = stats.get(roomID);
+
+		if (roomStats == nullptr) {
+			roomStats = new ChatRoomDeliveryStats(roomName);
+
+			stats.put(roomID, roomStats);
+		}
+	}
+
+	Locker locker(&roomStats->mutex);
+
+	++roomStats->messages;
+	roomStats->recipients += recipients;
+	roomStats->latencyMicros += latencyMicros;
+	roomStats->maxLatencyMicros = Math::max(roomStats->maxLatencyMicros, latencyMicros);
+}
+
+String ChatRoomDelivery::getStatistics(int maxRooms) {
+	struct RoomRates {
+		String name;
+		int messages;
+		uint64 recipients;
+		uint64 averageLatency;
+		uint64 maxLatency;
+	};
+
+	std::vector<RoomRates> rooms;
+
+	float elapsed = Math::max(1.f, lastStatistics.miliDifference() / 1000.f);
+	lastStatistics.updateToCurrentTime();
+
+	{
+		Locker locker(&statsLock);
+
+		Vector<uint32> idleRooms;
+
+		HashTableIterator<uint32, Reference<ChatRoomDeliveryStats*> > iterator = stats.iterator();
+
+		while (iterator.hasNext()) {
+			uint32 roomID;
+			Reference<ChatRoomDeliveryStats*> roomStats;
+
+			iterator.getNextKeyAndValue(roomID, roomStats);
+
+			Locker statsLocker(&roomStats->mutex);
+
+			// destroyed and quiet rooms, a later message brings them back
+			if (roomStats->messages == 0) {
+				idleRooms.add(roomID);
+				continue;
+			}
+
+			RoomRates rates;
+			rates.name = roomStats->roomName;
+			rates.messages = roomStats->messages;
+			rates.recipients = roomStats->recipients;
+			rates.averageLatency = roomStats->latencyMicros / roomStats->messages;
+			rates.maxLatency = roomStats->maxLatencyMicros;
+
+			rooms.push_back(rates);
+
+			roomStats->messages = 0;
+			roomStats->recipients = 0;
+			roomStats->latencyMicros = 0;
+			roomStats->maxLatencyMicros = 0;
+		}
+
+		for (int i = 0; i < idleRooms.size(); ++i)
+			stats.remove(idleRooms.get(i));
+	}
+
+	std::sort(rooms.begin(), rooms.end(), [] (const RoomRates& a, const RoomRates& b) {
+		return a.messages > b.messages;
+	});
+
+	StringBuffer str;
+	str << "Chat rooms: " << rooms.size() << " active";
+
+	for (int i = 0; i < rooms.size() && i < maxRooms; ++i) {
+		const RoomRates& rates = rooms[i];
+
+		str << endl << "  " << rates.name << ": " << (rates.messages / elapsed) << " msg/s, "
+			<< (rates.recipients / rates.messages) << " recipients, fan out " << rates.averageLatency << "us avg "
+			<< rates.maxLatency << "us max";
+	}
+
+	return str.toString();
+}
@@ -0,0 +1,111 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef CHATROOMDELIVERY_H_
+#define CHATROOMDELIVERY_H_
+
+#include "engine/engine.h"
+
+namespace server {
+namespace zone {
+namespace objects {
+namespace creature {
+	class CreatureObject;
+}
+}
+}
+}
+
+using namespace server::zone::objects::creature;
+
+/**
+ * Members of a chat room as of a membership change, shared by the deliveries until the next one.
+ */
+class ChatRoomMembers : public Vector<ManagedReference<CreatureObject*> > {
+public:
+	ChatRoomMembers(int initialSize) : Vector<ManagedReference<CreatureObject*> >(initialSize, 16) {
+	}
+};
+
+class ChatRoomDeliveryStats : public Object {
+public:
+	String roomName;
+
+	// since the previous statistics read
+	int messages;
+	uint64 recipients;
+	uint64 latencyMicros;
+	uint64 maxLatencyMicros;
+
+	Mutex mutex;
+
+	ChatRoomDeliveryStats(const String& roomName) : roomName(roomName), messages(0), recipients(0), latencyMicros(0), maxLatencyMicros(0) {
+	}
+};
+
+/**
+ * Sends room messages to the members of a room without holding the room lock.
+ *
+ * Every message is encoded once by the caller and shared by all the members (cloned per member
+ * without LOCKFREE_BCLIENT_BUFFERS). Rooms over Core3.ChatRoomShardSize members, like planet and
+ * auction chat, are split in shards delivered in parallel on the ChatDeliveryQueue workers. A
+ * member always lands in shard objectID % workers and shard i always goes to worker i, so members
+ * get their messages in order even when the room changes in between; while a room has sharded
+ * deliveries queued its smaller ones are sharded too instead of overtaking them inline.
+ */
+class ChatRoomDelivery : public Singleton<ChatRoomDelivery>, public Logger, public Object {
+protected:
+	int shardSize;
+	int threads;
+
+	HashTable<uint32, Reference<ChatRoomDeliveryStats*> > stats;
+	ReadWriteLock statsLock;
+
+	// sharded deliveries not done yet per room
+	HashTable<uint32, int> shardedDeliveries;
+	Mutex shardedMutex;
+
+	Time lastStatistics;
+
+	bool startShardedDelivery(uint32 roomID, int memberCount);
+
+	/**
+	 * Runs a shard on the worker of its index.
+	 */
+	virtual void executeShard(int shard, Function<void()>&& function);
+
+public:
+	ChatRoomDelivery();
+
+	virtual ~ChatRoomDelivery() {
+	}
+
+	/**
+	 * Takes ownership of the messages and sends them in order to the members. With checkIgnore only
+	 * members with a ghost get them, minus those ignoring ignoreName when it is set.
+	 */
+	void deliver(uint32 roomID, const String& roomName, ChatRoomMembers* members, const Vector<BaseMessage*>& messages, bool checkIgnore = false, const String& ignoreName = "");
+
+	void deliver(uint32 roomID, const String& roomName, ChatRoomMembers* members, BaseMessage* message, bool checkIgnore = false, const String& ignoreName = "");
+
+	void recordDelivery(uint32 roomID, const String& roomName, int recipients, uint64 latencyMicros);
+
+	void finishShardedDelivery(uint32 roomID);
+
+	virtual void sendToMember(CreatureObject* player, BaseMessage* message);
+
+	int getShardSize() const {
+		return shardSize;
+	}
+
+	/**
+	 * Message rates and fan out latency of the busiest rooms since the previous call, rooms with
+	 * nothing to report are forgotten.
+	 */
+	String getStatistics(int maxRooms = 10);
+
+	static String getQueueName(int shard);
+};
+
+#endif /* CHATROOMDELIVERY_H_ */
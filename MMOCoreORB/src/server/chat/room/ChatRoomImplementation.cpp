@@ -55,6 +55,8 @@ void ChatRoomImplementation::addPlayer(CreatureObject* player) {
 	playerList.put(player->getFirstName(), player);
 	lastJoin.updateToCurrentTime();
 
+	invalidateMembers();
+
 	locker.release();
 
 	Locker plocker(player);
@@ -76,6 +78,8 @@ void ChatRoomImplementation::removePlayer(CreatureObject* player, bool disconnec
 	broadcastMessage(msg);
 
 	playerList.drop(player->getFirstName());
+
+	invalidateMembers();
 }
 
 void ChatRoomImplementation::removeAllPlayers() {
@@ -93,64 +97,47 @@ void ChatRoomImplementation::removeAllPlayers() {
 	}
 
 	playerList.removeAll();
+
+	invalidateMembers();
 }
 
-void ChatRoomImplementation::broadcastMessage(BaseMessage* msg) {
-#ifdef LOCKFREE_BCLIENT_BUFFERS
-	msg->acquire();
-#endif
+Reference<ChatRoomMembers*> ChatRoomImplementation::getMembers() {
+	Locker locker(&memberSnapshotMutex);
 
-	ReadLocker locker(_this.getReferenceUnsafeStaticCast());
+	if (memberSnapshot != nullptr)
+		return memberSnapshot;
+
+	locker.release();
+
+	ReadLocker rlocker(_this.getReferenceUnsafeStaticCast());
+
+	Reference<ChatRoomMembers*> members = new ChatRoomMembers(playerList.size());
 
 	for (int i = 0; i < playerList.size(); ++i) {
 		ManagedReference<CreatureObject*>& player = playerList.get(i);
 
-		if (player != nullptr) {
-#ifdef LOCKFREE_BCLIENT_BUFFERS
-			player->sendMessage(msg);
-#else
-			player->sendMessage(msg->clone());
-#endif
-		}
+		if (player != nullptr)
+			members->add(player);
 	}
 
-#ifdef LOCKFREE_BCLIENT_BUFFERS
-	msg->release();
-#else
-	delete msg;
-#endif
-}
+	Locker mlocker(&memberSnapshotMutex);
 
-void ChatRoomImplementation::broadcastMessages(Vector<BaseMessage*>* messages) {
-#ifdef LOCKFREE_BCLIENT_BUFFERS
-	for (int j = 0; j < messages->size(); ++j) {
-		BaseMessage* msg = messages->getUnsafe(j);
-		msg->acquire();
-	}
-#endif
+	// a join or leave in between already dropped the previous snapshot, this one is as current
+	memberSnapshot = members;
 
-	ReadLocker locker(_this.getReferenceUnsafeStaticCast());
+	return members;
+}
 
-	for (int i = 0; i < playerList.size(); ++i) {
-		ManagedReference<CreatureObject*>& player = playerList.get(i);
+void ChatRoomImplementation::broadcastMessage(BaseMessage* msg) {
+	Reference<ChatRoomMembers*> members = getMembers();
 
-		for (int j = 0; j < messages->size(); ++j) {
-			BaseMessage* msg = messages->get(j);
-#ifdef LOCKFREE_BCLIENT_BUFFERS
-			player->sendMessage(msg);
-#else
-			player->sendMessage(msg->clone());
-#endif
-		}
-	}
+	ChatRoomDelivery::instance()->deliver(roomID, name, members, msg);
+}
 
-	for (int j = 0; j < messages->size(); ++j) {
-#ifdef LOCKFREE_BCLIENT_BUFFERS
-		messages->get(j)->release();
-#else
-		delete messages->get(j);
-#endif
-	}
+void ChatRoomImplementation::broadcastMessages(Vector<BaseMessage*>* messages) {
+	Reference<ChatRoomMembers*> members = getMembers();
+
+	ChatRoomDelivery::instance()->deliver(roomID, name, members, *messages);
 
 	messages->removeAll();
 }
@@ -186,35 +173,9 @@ void ChatRoomImplementation::broadcastMessageCheckIgnore(BaseMessage* msg, const
 	if (senderPlayer->hasGodMode())
 		godMode = true;
 
-#ifdef LOCKFREE_BCLIENT_BUFFERS
-	msg->acquire();
-#endif
-
-	ReadLocker locker(_this.getReferenceUnsafeStaticCast());
-
-	for (int i = 0; i < playerList.size(); ++i) {
-		ManagedReference<CreatureObject*>& player = playerList.get(i);
-
-		if (player != nullptr) {
-			PlayerObject* ghost = player->getPlayerObject();
-			if (ghost == nullptr)
-				continue;
-
-			if (!ghost->isIgnoring(lowerName) || godMode) {
-#ifdef LOCKFREE_BCLIENT_BUFFERS
-				player->sendMessage(msg);
-#else
-				player->sendMessage(msg->clone());
-#endif
-			}
-		}
-	}
+	Reference<ChatRoomMembers*> members = getMembers();
 
-#ifdef LOCKFREE_BCLIENT_BUFFERS
-	msg->release();
-#else
-	delete msg;
-#endif
+	ChatRoomDelivery::instance()->deliver(roomID, name, members, msg, true, godMode ? "" : lowerName);
 }
 
 String ChatRoomImplementation::getGalaxyName() {
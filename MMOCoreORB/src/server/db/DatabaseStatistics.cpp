@@ -0,0 +1,123 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "DatabaseStatistics.h"
+
+#include <algorithm>
+#include <vector>
+
+void StatementLatency::add(uint64 micros) {
+	++buckets[getBucket(micros)];
+	++count;
+
+	totalMicros += micros;
+	maxMicros = Math::max(maxMicros, micros);
+}
+
+int StatementLatency::getBucket(uint64 micros) {
+	int bucket = 0;
+	uint64 bound = FIRSTBUCKETMICROS;
+
+	while (bucket < BUCKETS - 1 && micros >= bound) {
+		bound <<= 1;
+		++bucket;
+	}
+
+	return bucket;
+}
+
+uint64 StatementLatency::getPercentile(float fraction) const {
+	if (count == 0)
+		return 0;
+
+	uint64 target = Math::max((uint64) 1, (uint64) (fraction * count + 0.999f));
+	uint64 seen = 0;
+
+	for (int i = 0; i < BUCKETS - 1; ++i) {
+		seen += buckets[i];
+
+		if (seen >= target)
+			return Math::min((uint64) FIRSTBUCKETMICROS << i, maxMicros);
+	}
+
+	return maxMicros;
+}
+
+DatabaseStatistics::DatabaseStatistics() : Logger("DatabaseStatistics") {
+	statements.setNoDuplicateInsertPlan();
+	statements.setNullValue(nullptr);
+}
+
+void DatabaseStatistics::record(const String& statement, uint64 micros) {
+	Locker locker(&mutex);
+
+	Reference<StatementLatency*> latency = statements.get(statement);
+
+	if (latency == nullptr) {
+		// statements are constant SQL, this only fills up if something builds them with values
+		String key = statements.size() < MAXSTATEMENTS ? statement : "(other)";
+
+		latency = statements.get(key);
+
+		if (latency == nullptr) {
+			latency = new StatementLatency(key);
+
+			statements.put(key, latency);
+		}
+	}
+
+	latency->add(micros);
+}
+
+void DatabaseStatistics::recordUnprepared(const char* query, uint64 micros) {
+	while (*query == ' ' || *query == '(' || *query == '\t' || *query == '\n')
+		++query;
+
+	int length = 0;
+
+	while (isalpha(query[length]) && length < 16)
+		++length;
+
+	record(String(query, length).toUpperCase() + " (unprepared)", micros);
+}
+
+Reference<StatementLatency*> DatabaseStatistics::getLatency(const String& statement) {
+	Locker locker(&mutex);
+
+	return statements.get(statement);
+}
+
+void DatabaseStatistics::reset() {
+	Locker locker(&mutex);
+
+	statements.removeAll();
+}
+
+String DatabaseStatistics::getStatistics(int maxStatements) {
+	std::vector<Reference<StatementLatency*> > latencies;
+
+	StringBuffer str;
+
+	Locker locker(&mutex);
+
+	for (int i = 0; i < statements.size(); ++i)
+		latencies.push_back(statements.elementAt(i).getValue());
+
+	std::sort(latencies.begin(), latencies.end(), [] (const Reference<StatementLatency*>& a, const Reference<StatementLatency*>& b) {
+		return a->totalMicros > b->totalMicros;
+	});
+
+	str << "Database statements: " << statements.size();
+
+	for (int i = 0; i < latencies.size() && i < maxStatements; ++i) {
+		const StatementLatency* latency = latencies[i];
+
+		str << endl << "  " << latency->statement.subString(0, Math::min(latency->statement.length(), 80)) << ": "
+			<< latency->count << " runs, " << (latency->totalMicros / latency->count) << "us avg, "
+			<< latency->getPercentile(0.5f) << "us p50, " << latency->getPercentile(0.99f) << "us p99, "
+			<< latency->maxMicros << "us max";
+	}
+
+	return str.toString();
+}
@@ -0,0 +1,68 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef DATABASESTATISTICS_H_
+#define DATABASESTATISTICS_H_
+
+#include "engine/engine.h"
+
+/**
+ * Latency of one statement as a histogram of power of two buckets, from under 250us to 256ms
+ * and over.
+ */
+class StatementLatency : public Object {
+public:
+	const static int BUCKETS = 12;
+	const static int FIRSTBUCKETMICROS = 250;
+
+	String statement;
+
+	uint64 buckets[BUCKETS];
+	uint64 count;
+	uint64 totalMicros;
+	uint64 maxMicros;
+
+	StatementLatency(const String& statement) : statement(statement), count(0), totalMicros(0), maxMicros(0) {
+		for (int i = 0; i < BUCKETS; ++i)
+			buckets[i] = 0;
+	}
+
+	void add(uint64 micros);
+
+	/**
+	 * Upper bound in microseconds of the bucket holding the given fraction of the samples.
+	 */
+	uint64 getPercentile(float fraction) const;
+
+	static int getBucket(uint64 micros);
+};
+
+/**
+ * Per statement latencies of the MySQL queries, shown in /server statistics. Prepared statements
+ * are recorded under their SQL, everything else under its first keyword.
+ */
+class DatabaseStatistics : public Singleton<DatabaseStatistics>, public Logger, public Object {
+	VectorMap<String, Reference<StatementLatency*> > statements;
+	Mutex mutex;
+
+public:
+	const static int MAXSTATEMENTS = 256;
+
+	DatabaseStatistics();
+
+	void record(const String& statement, uint64 micros);
+
+	void recordUnprepared(const char* query, uint64 micros);
+
+	/**
+	 * Latencies of the statements that took the most time overall.
+	 */
+	String getStatistics(int maxStatements = 10);
+
+	Reference<StatementLatency*> getLatency(const String& statement);
+
+	void reset();
+};
+
+#endif /* DATABASESTATISTICS_H_ */
@@ -11,6 +11,10 @@ Distribution of this file for usage outside of Core3 is prohibited.
 #include "engine/core/TaskWorkerThread.h"
 
 #include "MySqlDatabase.h"
+#include "PreparedResultSet.h"
+#include "DatabaseStatistics.h"
+
+#include <vector>
 
 using namespace server::db::mysql;
 
@@ -76,6 +80,8 @@ MySqlDatabase::MySqlDatabase(const String& s) : Mutex("MYSQL DB"), Logger(s) {
 	writeQueryTimeout = queryTimeout * 10;
 
 	memset(&mysql, 0, sizeof(mysql));
+
+	preparedStatements.setNullValue(nullptr);
 }
 
 MySqlDatabase::MySqlDatabase(const String& s, const String& host) : Mutex("MYSQL DB"), Logger(s) {
@@ -86,6 +92,8 @@ MySqlDatabase::MySqlDatabase(const String& s, const String& host) : Mutex("MYSQL
 	queryTimeout = 5;
 	writeQueryTimeout = queryTimeout * 1000;
 
+	preparedStatements.setNullValue(nullptr);
+
 	setLockTracing(false);
 }
 
@@ -130,6 +138,8 @@ void MySqlDatabase::connect(const String& dbname, const String& user, const Stri
 void MySqlDatabase::doExecuteStatement(const String& statement) {
 	Locker locker(this);
 
+	uint64 start = Time::currentNanoTime();
+
 #ifdef COLLECT_TASKSTATISTICS
 	Timer timer(Time::MONOTONIC_TIME);
 	timer.start();
@@ -149,6 +159,8 @@ void MySqlDatabase::doExecuteStatement(const String& statement) {
 	MysqlDatabaseManager::instance()->addModifiedDatabase(this);
 #endif
 
+	DatabaseStatistics::instance()->recordUnprepared(statement.toCharArray(), (Time::currentNanoTime() - start) / 1000);
+
 #ifdef COLLECT_TASKSTATISTICS
 	uint64 elapsed = timer.stop();
 
@@ -185,6 +197,8 @@ void MySqlDatabase::executeQuery(const char* query, Function<void(engine::db::Re
 engine::db::ResultSet* MySqlDatabase::executeQuery(const char* statement) {
 	Locker locker(this);
 
+	uint64 start = Time::currentNanoTime();
+
 #ifdef COLLECT_TASKSTATISTICS
 	Timer timer(Time::MONOTONIC_TIME);
 	timer.start();
@@ -214,6 +228,8 @@ engine::db::ResultSet* MySqlDatabase::executeQuery(const char* statement) {
 	MysqlDatabaseManager::instance()->addModifiedDatabase(this);
 #endif
 
+	DatabaseStatistics::instance()->recordUnprepared(statement, (Time::currentNanoTime() - start) / 1000);
+
 #ifdef COLLECT_TASKSTATISTICS
 	uint64 elapsed = timer.stop();
 
@@ -237,6 +253,198 @@ engine::db::ResultSet* MySqlDatabase::executeQuery(const StringBuffer& statement
 	return executeQuery(statement.toString().toCharArray());
 }
 
+MYSQL_STMT* MySqlDatabase::getPreparedStatement(const String& query) {
+	MYSQL_STMT* stmt = preparedStatements.get(query);
+
+	if (stmt != nullptr)
+		return stmt;
+
+	if (preparedStatements.size() >= MAXPREPAREDSTATEMENTS) {
+		warning() << "more than " << MAXPREPAREDSTATEMENTS << " prepared statements, statements with values in their SQL?";
+
+		clearPreparedStatements();
+	}
+
+	stmt = mysql_stmt_init(&mysql);
+
+	if (stmt == nullptr)
+		error();
+
+	if (mysql_stmt_prepare(stmt, query.toCharArray(), query.length())) {
+		try {
+			error(stmt, query.toCharArray());
+		} catch (const DatabaseException& e) {
+			mysql_stmt_close(stmt);
+
+			throw;
+		}
+	}
+
+	preparedStatements.put(query, stmt);
+
+	return stmt;
+}
+
+void MySqlDatabase::clearPreparedStatements() {
+	HashTableIterator<String, MYSQL_STMT*> iterator = preparedStatements.iterator();
+
+	while (iterator.hasNext())
+		mysql_stmt_close(iterator.getNextValue());
+
+	preparedStatements.removeAll();
+}
+
+engine::db::ResultSet* MySqlDatabase::doExecutePrepared(const String& query, const QueryParameters& parameters) {
+	int count = parameters.size();
+
+	std::vector<MYSQL_BIND> binds(count);
+	std::vector<unsigned long> lengths(count);
+
+	if (count > 0)
+		memset(binds.data(), 0, sizeof(MYSQL_BIND) * count);
+
+	for (int i = 0; i < count; ++i) {
+		const QueryParameters::Parameter& parameter = parameters.get(i);
+		MYSQL_BIND& bind = binds[i];
+
+		switch (parameter.type) {
+		case QueryParameters::SIGNED:
+		case QueryParameters::UNSIGNED:
+			bind.buffer_type = MYSQL_TYPE_LONGLONG;
+			bind.buffer = const_cast<sys::int64*>(&parameter.signedValue);
+			bind.is_unsigned = parameter.type == QueryParameters::UNSIGNED;
+			break;
+		case QueryParameters::DOUBLE:
+			bind.buffer_type = MYSQL_TYPE_DOUBLE;
+			bind.buffer = const_cast<double*>(&parameter.doubleValue);
+			break;
+		case QueryParameters::STRING:
+			lengths[i] = parameter.stringValue.length();
+
+			bind.buffer_type = MYSQL_TYPE_STRING;
+			bind.buffer = const_cast<char*>(parameter.stringValue.toCharArray());
+			bind.buffer_length = lengths[i];
+			bind.length = &lengths[i];
+			break;
+		default:
+			bind.buffer_type = MYSQL_TYPE_NULL;
+			break;
+		}
+	}
+
+	bool reprepared = false;
+
+	while (true) {
+		MYSQL_STMT* stmt = getPreparedStatement(query);
+
+		if (mysql_stmt_param_count(stmt) != (unsigned long) count)
+			throw DatabaseException("prepared statement expects " + String::valueOf((int) mysql_stmt_param_count(stmt)) + " parameters, got " + String::valueOf(count) + ": " + query);
+
+		if (count > 0 && mysql_stmt_bind_param(stmt, binds.data()))
+			error(stmt, query.toCharArray());
+
+		if (!mysql_stmt_execute(stmt)) {
+#ifdef WITH_STM
+			MysqlDatabaseManager::instance()->addModifiedDatabase(this);
+#endif
+
+			return new PreparedResultSet(stmt);
+		}
+
+		unsigned int errorNumber = mysql_stmt_errno(stmt);
+
+		if (errorNumber == 1205/*ER_LOCK_WAIT_TIMEOUT*/) {
+			warning() << "mysql lock wait timeout on statement: " << query;
+			continue;
+		}
+
+		// the server does not know the statement anymore after a reconnect, prepare it again
+		if (errorNumber == 1243/*ER_UNKNOWN_STMT_HANDLER*/ || errorNumber == 2006/*CR_SERVER_GONE_ERROR*/
+				|| errorNumber == 2013/*CR_SERVER_LOST*/ || errorNumber == 2030/*CR_NO_PREPARE_STMT*/) {
+			String message = mysql_stmt_error(stmt);
+
+			clearPreparedStatements();
+
+			// lost during the query it may have run already, only retry those never sent
+			if (!reprepared && errorNumber != 2013) {
+				reprepared = true;
+				continue;
+			}
+
+			StringBuffer msg;
+			msg << "DatabaseException caused by query: " << query << "\n" << errorNumber << ": " << message;
+			Logger::error(msg);
+
+			throw DatabaseException(msg.toString());
+		}
+
+		error(stmt, query.toCharArray());
+	}
+}
+
+engine::db::ResultSet* MySqlDatabase::executePrepared(const String& query, const QueryParameters& parameters) {
+	pendingQueries.increment();
+
+	Locker locker(this);
+
+	uint64 start = Time::currentNanoTime();
+
+	engine::db::ResultSet* result = nullptr;
+
+	try {
+		result = doExecutePrepared(query, parameters);
+	} catch (const Exception& e) {
+		pendingQueries.decrement();
+
+		throw;
+	}
+
+	DatabaseStatistics::instance()->record(query, (Time::currentNanoTime() - start) / 1000);
+
+	pendingQueries.decrement();
+
+	return result;
+}
+
+void MySqlDatabase::executePreparedBatch(const String& query, const Vector<QueryParameters>& rows) {
+	pendingQueries.increment();
+
+	Locker locker(this);
+
+	uint64 start = Time::currentNanoTime();
+
+#ifndef WITH_STM
+	// one commit for the whole batch instead of one per row
+	mysql_autocommit(&mysql, false);
+#endif
+
+	try {
+		for (int i = 0; i < rows.size(); ++i)
+			delete doExecutePrepared(query, rows.get(i));
+
+#ifndef WITH_STM
+		mysql_commit(&mysql);
+#endif
+	} catch (const Exception& e) {
+#ifndef WITH_STM
+		mysql_rollback(&mysql);
+		mysql_autocommit(&mysql, true);
+#endif
+
+		pendingQueries.decrement();
+
+		throw;
+	}
+
+#ifndef WITH_STM
+	mysql_autocommit(&mysql, true);
+#endif
+
+	DatabaseStatistics::instance()->record(query + " (batch)", (Time::currentNanoTime() - start) / 1000);
+
+	pendingQueries.decrement();
+}
+
 void MySqlDatabase::commit() {
 	Locker locker(this);
 
@@ -256,6 +464,8 @@ void MySqlDatabase::autocommit(bool doCommit) {
 }
 
 void MySqlDatabase::close() {
+	clearPreparedStatements();
+
 	mysql_close(&mysql);
 
 	info("disconnected");
@@ -277,6 +487,14 @@ void MySqlDatabase::error(const char* query) {
 	throw DatabaseException(msg.toString());
 }
 
+void MySqlDatabase::error(MYSQL_STMT* stmt, const char* query) {
+	StringBuffer msg;
+	msg << "DatabaseException caused by query: " << query << "\n" << mysql_stmt_errno(stmt) << ": " << mysql_stmt_error(stmt);
+	Logger::error(msg);
+
+	throw DatabaseException(msg.toString());
+}
+
 void MySqlDatabase::finalizeLibrary() {
 	mysql_library_end();
 }
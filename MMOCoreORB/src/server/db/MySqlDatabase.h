@@ -16,6 +16,7 @@ Distribution of this file for usage outside of Core3 is prohibited.
 
 #include "Statement.h"
 #include "ResultSet.h"
+#include "QueryParameters.h"
 
 namespace server {
   namespace db {
@@ -28,10 +29,20 @@ namespace server {
 		uint32 queryTimeout;
 		uint32 writeQueryTimeout;
 
+		// prepared once per connection, they are gone after a reconnect
+		HashTable<String, MYSQL_STMT*> preparedStatements;
+
+		AtomicInteger pendingQueries;
+
 	private:
 		static int createDatabaseThread();
 		static const char* mysqlThreadName;
 
+		MYSQL_STMT* getPreparedStatement(const String& query);
+		void clearPreparedStatements();
+
+		engine::db::ResultSet* doExecutePrepared(const String& query, const QueryParameters& parameters);
+
 	public:
 		MySqlDatabase(const String& s);
 		MySqlDatabase(const String& s, const String& host);
@@ -56,6 +67,24 @@ namespace server {
 		void executeQuery(const char* query, Function<void(engine::db::ResultSet*)>&& callback);
 #endif
 
+		/**
+		 * Runs the query as a prepared statement, with its ? placeholders set to the parameters. The
+		 * statement is prepared on first use and kept for the connection.
+		 */
+		engine::db::ResultSet* executePrepared(const String& query, const QueryParameters& parameters);
+
+		/**
+		 * Runs the prepared statement once per row, in one transaction.
+		 */
+		void executePreparedBatch(const String& query, const Vector<QueryParameters>& rows);
+
+		/**
+		 * Prepared queries waiting for or holding this connection.
+		 */
+		int getPendingQueries() {
+			return pendingQueries.get();
+		}
+
 		void commit();
 
 		void rollback();
@@ -66,12 +95,15 @@ namespace server {
 
 		void error();
 		void error(const char* query);
+		void error(MYSQL_STMT* stmt, const char* query);
 
 		static void finalizeLibrary();
 		static void initializeLibrary();
 		static void onThreadStart();
 		static void onThreadEnd();
 
+		const static int MAXPREPAREDSTATEMENTS = 128;
+
 		int compareTo(const Database* database) const final {
 			if (this < database)
 				return 1;
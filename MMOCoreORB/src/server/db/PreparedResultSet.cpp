@@ -0,0 +1,105 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "engine/engine.h"
+
+#include "PreparedResultSet.h"
+
+#include <type_traits>
+#include <vector>
+
+using namespace server::db::mysql;
+
+namespace {
+	// my_bool in older client libraries, bool since 8.0
+	typedef std::remove_pointer<decltype(MYSQL_BIND::is_null)>::type mysql_bool;
+
+	const unsigned long COLUMN_BUFFER_SIZE = 256;
+}
+
+PreparedResultSet::PreparedResultSet(MYSQL_STMT* stmt) : columns(0), currentRow(-1), rows(0) {
+	rowsAffected = mysql_stmt_affected_rows(stmt);
+	lastInsertID = mysql_stmt_insert_id(stmt);
+
+	MYSQL_RES* metadata = mysql_stmt_result_metadata(stmt);
+
+	// inserts, updates and deletes have no rows
+	if (metadata == nullptr)
+		return;
+
+	columns = mysql_num_fields(metadata);
+
+	mysql_free_result(metadata);
+
+	if (mysql_stmt_store_result(stmt))
+		throw DatabaseException(String(mysql_stmt_error(stmt)));
+
+	std::vector<MYSQL_BIND> binds(columns);
+	std::vector<std::vector<char> > buffers(columns, std::vector<char>(COLUMN_BUFFER_SIZE));
+	std::vector<unsigned long> lengths(columns);
+	std::vector<mysql_bool> nulls(columns);
+
+	memset(binds.data(), 0, sizeof(MYSQL_BIND) * columns);
+
+	// every column is read as text, like the text protocol rows
+	for (int i = 0; i < columns; ++i) {
+		binds[i].buffer_type = MYSQL_TYPE_STRING;
+		binds[i].buffer = buffers[i].data();
+		binds[i].buffer_length = COLUMN_BUFFER_SIZE;
+		binds[i].length = &lengths[i];
+		binds[i].is_null = &nulls[i];
+	}
+
+	if (mysql_stmt_bind_result(stmt, binds.data())) {
+		String error = mysql_stmt_error(stmt);
+
+		mysql_stmt_free_result(stmt);
+
+		throw DatabaseException(error);
+	}
+
+	int status;
+
+	while ((status = mysql_stmt_fetch(stmt)) == 0 || status == MYSQL_DATA_TRUNCATED) {
+		for (int i = 0; i < columns; ++i) {
+			if (nulls[i]) {
+				values.add(nullptr);
+				continue;
+			}
+
+			unsigned long length = lengths[i];
+			char* value = new char[length + 1];
+
+			if (length <= COLUMN_BUFFER_SIZE) {
+				memcpy(value, buffers[i].data(), length);
+			} else {
+				// longer than the column buffer, fetch it again into its own
+				MYSQL_BIND column;
+				memset(&column, 0, sizeof(MYSQL_BIND));
+
+				unsigned long columnLength = 0;
+
+				column.buffer_type = MYSQL_TYPE_STRING;
+				column.buffer = value;
+				column.buffer_length = length + 1;
+				column.length = &columnLength;
+
+				mysql_stmt_fetch_column(stmt, &column, i, 0);
+			}
+
+			value[length] = 0;
+
+			values.add(value);
+		}
+	}
+
+	rows = columns > 0 ? values.size() / columns : 0;
+
+	mysql_stmt_free_result(stmt);
+}
+
+PreparedResultSet::~PreparedResultSet() {
+	for (int i = 0; i < values.size(); ++i)
+		delete [] values.getUnsafe(i);
+}
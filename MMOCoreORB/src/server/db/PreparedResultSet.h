@@ -0,0 +1,88 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef PREPAREDRESULTSET_H_
+#define PREPAREDRESULTSET_H_
+
+#include <mysql.h>
+
+#include "system/lang.h"
+
+#include "engine/db/ResultSet.h"
+
+namespace server {
+  namespace db {
+    namespace mysql {
+
+	/**
+	 * Rows of an executed prepared statement, read the same way as the text protocol ResultSet.
+	 *
+	 * The rows are copied out of the statement when it is built, so the statement can be run again
+	 * by someone else while this is still being read.
+	 */
+	class PreparedResultSet : public engine::db::ResultSet {
+		int columns;
+		Vector<char*> values;
+
+		sys::int64 currentRow;
+		sys::uint64 rows;
+
+		sys::uint64 rowsAffected;
+		sys::uint64 lastInsertID;
+
+	public:
+		PreparedResultSet(MYSQL_STMT* stmt);
+
+		virtual ~PreparedResultSet();
+
+		bool next() {
+			return ++currentRow < (sys::int64) rows;
+		}
+
+		bool getBoolean(int index) {
+			return atoi(getString(index));
+		}
+
+		int getInt(int index) {
+			return atoi(getString(index));
+		}
+
+		sys::uint32 getUnsignedInt(int index) {
+			return (sys::uint32) strtoul(getString(index), nullptr, 0);
+		}
+
+		sys::int64 getLong(int index) {
+			return Long::valueOf(getString(index));
+		}
+
+		sys::uint64 getUnsignedLong(int index) {
+			return Long::unsignedvalueOf(getString(index));
+		}
+
+		float getFloat(int index) {
+			return atof(getString(index));
+		}
+
+		char* getString(int index) {
+			return values.get(currentRow * columns + index);
+		}
+
+		sys::uint64 getRowsAffected() {
+			return rowsAffected;
+		}
+
+		sys::uint64 getLastAffectedRow() {
+			return lastInsertID;
+		}
+
+		inline sys::uint64 size() {
+			return rows;
+		}
+	};
+
+    } // namespace mysql
+  } // namespace db
+} // namespace server
+
+#endif /*PREPAREDRESULTSET_H_*/
@@ -0,0 +1,106 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef QUERYPARAMETERS_H_
+#define QUERYPARAMETERS_H_
+
+#include "system/lang.h"
+
+namespace server {
+  namespace db {
+    namespace mysql {
+
+	/**
+	 * Values for the ? placeholders of a prepared statement, in order. Strings are sent as they
+	 * are, they need no escaping.
+	 */
+	class QueryParameters {
+	public:
+		enum ParameterType { NULLVALUE, SIGNED, UNSIGNED, DOUBLE, STRING };
+
+		class Parameter {
+		public:
+			ParameterType type;
+
+			union {
+				sys::int64 signedValue;
+				sys::uint64 unsignedValue;
+				double doubleValue;
+			};
+
+			String stringValue;
+
+			Parameter() : type(NULLVALUE), unsignedValue(0) {
+			}
+		};
+
+	protected:
+		Vector<Parameter> parameters;
+
+		Parameter& addParameter(ParameterType type) {
+			parameters.add(Parameter());
+
+			Parameter& parameter = parameters.get(parameters.size() - 1);
+			parameter.type = type;
+
+			return parameter;
+		}
+
+	public:
+		QueryParameters() {
+		}
+
+		QueryParameters& add(int value) {
+			addParameter(SIGNED).signedValue = value;
+			return *this;
+		}
+
+		QueryParameters& add(sys::int64 value) {
+			addParameter(SIGNED).signedValue = value;
+			return *this;
+		}
+
+		QueryParameters& add(sys::uint32 value) {
+			addParameter(UNSIGNED).unsignedValue = value;
+			return *this;
+		}
+
+		QueryParameters& add(sys::uint64 value) {
+			addParameter(UNSIGNED).unsignedValue = value;
+			return *this;
+		}
+
+		QueryParameters& add(double value) {
+			addParameter(DOUBLE).doubleValue = value;
+			return *this;
+		}
+
+		QueryParameters& add(const String& value) {
+			addParameter(STRING).stringValue = value;
+			return *this;
+		}
+
+		QueryParameters& add(const char* value) {
+			return add(String(value));
+		}
+
+		QueryParameters& addNull() {
+			addParameter(NULLVALUE);
+			return *this;
+		}
+
+		const Parameter& get(int index) const {
+			return parameters.get(index);
+		}
+
+		int size() const {
+			return parameters.size();
+		}
+	};
+
+    } // namespace mysql
+  } // namespace db
+} // namespace server
+
+#endif /*QUERYPARAMETERS_H_*/
@@ -9,6 +9,80 @@
 
 Vector<Database*>* ServerDatabase::databases = nullptr;
 AtomicInteger ServerDatabase::currentDB;
+const char* ServerDatabase::poolQueueName = "DatabasePoolQueue";
+
+namespace {
+	class DatabaseCompletionTask final : public Task {
+		ResultSet* result;
+		Function<void(ResultSet*)> callback;
+
+	public:
+		DatabaseCompletionTask(ResultSet* res, Function<void(ResultSet*)>&& f) : result(res), callback(std::move(f)) {
+		}
+
+		~DatabaseCompletionTask() {
+			delete result;
+		}
+
+		void run() final {
+			callback(result);
+		}
+	};
+
+	class DatabasePoolTask final : public Task {
+		String query;
+		QueryParameters parameters;
+		Vector<QueryParameters> rows;
+
+	public:
+		DatabasePoolTask(const String& q, const QueryParameters& params) : query(q), parameters(params) {
+		}
+
+		DatabasePoolTask(const String& q, const Vector<QueryParameters>& batch) : query(q), rows(batch) {
+		}
+
+		void run() final {
+			try {
+				if (rows.size() > 0)
+					ServerDatabase::getConnection()->executePreparedBatch(query, rows);
+				else
+					delete ServerDatabase::getConnection()->executePrepared(query, parameters);
+			} catch (const Exception& e) {
+				// logged by the connection
+			}
+		}
+	};
+
+	class DatabaseQueryTask final : public Task {
+		String query;
+		QueryParameters parameters;
+
+		Function<void(ResultSet*)> callback;
+		String completionQueue;
+
+	public:
+		DatabaseQueryTask(const String& q, const QueryParameters& params, Function<void(ResultSet*)>&& f, const char* queue)
+				: query(q), parameters(params), callback(std::move(f)), completionQueue(queue != nullptr ? queue : "") {
+		}
+
+		void run() final {
+			ResultSet* result = nullptr;
+
+			try {
+				result = ServerDatabase::getConnection()->executePrepared(query, parameters);
+			} catch (const Exception& e) {
+				// logged by the connection, the callback gets nullptr
+			}
+
+			Reference<Task*> completion = new DatabaseCompletionTask(result, std::move(callback));
+
+			if (!completionQueue.isEmpty())
+				completion->setCustomTaskQueue(completionQueue);
+
+			completion->execute();
+		}
+	};
+}
 
 ServerDatabase::ServerDatabase(ConfigManager* configManager) {
 	const String& dbHost = configManager->getDBHost();
@@ -30,6 +104,10 @@ ServerDatabase::ServerDatabase(ConfigManager* configManager) {
 		databases->add(db);
 	}
 
+	int poolThreads = configManager->getDBPoolThreads();
+
+	Core::getTaskManager()->initializeCustomQueue(poolQueueName, poolThreads > 0 ? poolThreads : databases->size(), false);
+
 	try {
 		UniqueReference<ResultSet*> result(instance()->executeQuery("SELECT `schema_version` FROM `db_metadata`;"));
 
@@ -60,6 +138,54 @@ ServerDatabase::~ServerDatabase() {
 	databases = nullptr;
 }
 
+server::db::mysql::MySqlDatabase* ServerDatabase::getConnection() {
+	if (databases == nullptr)
+		throw DatabaseException("No Server Database initiated");
+
+	int size = databases->size();
+	int first = currentDB.postIncrement() % size;
+
+	server::db::mysql::MySqlDatabase* best = nullptr;
+
+	for (int i = 0; i < size; ++i) {
+		auto db = static_cast<server::db::mysql::MySqlDatabase*>(databases->getUnsafe((first + i) % size));
+
+		if (best == nullptr || db->getPendingQueries() < best->getPendingQueries())
+			best = db;
+
+		if (best->getPendingQueries() == 0)
+			break;
+	}
+
+	return best;
+}
+
+ResultSet* ServerDatabase::executePrepared(const String& query, const QueryParameters& parameters) {
+	return getConnection()->executePrepared(query, parameters);
+}
+
+void ServerDatabase::executePreparedAsync(const String& query, const QueryParameters& parameters) {
+	Reference<Task*> task = new DatabasePoolTask(query, parameters);
+	task->setCustomTaskQueue(poolQueueName);
+	task->execute();
+}
+
+void ServerDatabase::executePreparedAsync(const String& query, const QueryParameters& parameters,
+		Function<void(ResultSet*)>&& callback, const char* completionQueue) {
+	Reference<Task*> task = new DatabaseQueryTask(query, parameters, std::move(callback), completionQueue);
+	task->setCustomTaskQueue(poolQueueName);
+	task->execute();
+}
+
+void ServerDatabase::executeBatchAsync(const String& query, const Vector<QueryParameters>& rows) {
+	if (rows.size() == 0)
+		return;
+
+	Reference<Task*> task = new DatabasePoolTask(query, rows);
+	task->setCustomTaskQueue(poolQueueName);
+	task->execute();
+}
+
 void ServerDatabase::alterDatabase(int nextSchemaVersion, const String& alterSql) {
 	if (dbSchemaVersion >= nextSchemaVersion)
 		return;
@@ -7,13 +7,26 @@
 
 #include "engine/engine.h"
 
+#include "QueryParameters.h"
+
 namespace conf {
 	class ConfigManager;
 }
 
+namespace server {
+  namespace db {
+    namespace mysql {
+	class MySqlDatabase;
+    }
+  }
+}
+
+using server::db::mysql::QueryParameters;
+
 class ServerDatabase : public Logger {
 	static Vector<Database*>* databases;
 	static AtomicInteger currentDB;
+	static const char* poolQueueName;
 	int dbSchemaVersion;
 
 public:
@@ -29,6 +42,32 @@ public:
 		return databases->get(i);
 	}
 
+	/**
+	 * The connection with the fewest prepared queries running or waiting on it.
+	 */
+	static server::db::mysql::MySqlDatabase* getConnection();
+
+	static ResultSet* executePrepared(const String& query, const QueryParameters& parameters);
+
+	/**
+	 * Runs the prepared statement on a DatabasePoolQueue worker, so the calling thread does not
+	 * wait for the round trip.
+	 */
+	static void executePreparedAsync(const String& query, const QueryParameters& parameters);
+
+	/**
+	 * Same, then calls back with the result on completionQueue, or the default queue when null. The
+	 * result is nullptr when the query failed and is deleted once the callback returns.
+	 */
+	static void executePreparedAsync(const String& query, const QueryParameters& parameters,
+			Function<void(ResultSet*)>&& callback, const char* completionQueue = nullptr);
+
+	/**
+	 * Runs the prepared statement once per row on a DatabasePoolQueue worker, in a single
+	 * transaction on one connection.
+	 */
+	static void executeBatchAsync(const String& query, const Vector<QueryParameters>& rows);
+
 	inline int getSchemaVersion() const {
 		return dbSchemaVersion;
 	}
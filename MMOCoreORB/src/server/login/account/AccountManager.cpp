@@ -112,25 +112,30 @@ void AccountManager::loginApprovedAccount(LoginClient* client, ManagedReference<
 	SessionAPIClient::instance()->notifySessionStart(ip, accountID);
 #endif // WITH_SESSION_API
 
-	StringBuffer sessionQuery;
-	sessionQuery << "REPLACE INTO sessions (account_id, session_id, ip, expires) VALUES (";
-	sessionQuery << accountID << ", '" << sessionID << "', '" << ip << "' , ADDTIME(NOW(), '00:15'));";
+	QueryParameters sessionParameters;
+	sessionParameters.add(accountID).add(sessionID).add(ip);
 
-	StringBuffer logQuery;
-	logQuery << "INSERT INTO account_log (account_id, ip_address, timestamp) VALUES (" << accountID << ", '" << ip << "', NOW());";
+	QueryParameters logParameters;
+	logParameters.add(accountID).add(ip);
 
-	try {
-		ServerDatabase::instance()->executeStatement(sessionQuery);
-		ServerDatabase::instance()->executeStatement(logQuery);
-	} catch (const DatabaseException& e) {
-		client->error() << e.getMessage();
-	}
+	ServerDatabase::executePreparedAsync("INSERT INTO account_log (account_id, ip_address, timestamp) VALUES (?, ?, NOW())", logParameters);
+
+	// the zone server checks the session as soon as the client picks a cluster, so the cluster list waits for it to be stored
+	ServerDatabase::executePreparedAsync("REPLACE INTO sessions (account_id, session_id, ip, expires) VALUES (?, ?, ?, ADDTIME(NOW(), '00:15'))", sessionParameters,
+			[server = loginServer,
+			loginClient = Reference<LoginClient*>(client),
+			loginAccount = Reference<Account*>(account)
+			](ResultSet* result) {
 
-	client->sendMessage(loginServer->getLoginEnumClusterMessage(account));
-	client->sendMessage(loginServer->getLoginClusterStatusMessage(account));
+		if (result == nullptr)
+			loginClient->error() << "could not store the session of account " << loginAccount->getAccountID();
 
-	Message* eci = new EnumerateCharacterID(account);
-	client->sendMessage(eci);
+		loginClient->sendMessage(server->getLoginEnumClusterMessage(loginAccount));
+		loginClient->sendMessage(server->getLoginClusterStatusMessage(loginAccount));
+
+		Message* eci = new EnumerateCharacterID(loginAccount);
+		loginClient->sendMessage(eci);
+	});
 }
 
 Reference<Account*> AccountManager::validateAccountCredentials(LoginClient* client, const String& username, const String& password) {
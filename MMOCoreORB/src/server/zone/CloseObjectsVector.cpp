@@ -6,6 +6,19 @@
 
 #include "server/zone/QuadTreeEntry.h"
 
+CloseObjectsReceivers::CloseObjectsReceivers(uint32 vers, int size) : receivers(size, 10), receiverFlags(size, 10) {
+	version = vers;
+}
+
+CloseObjectsReceivers::~CloseObjectsReceivers() {
+	receivers.removeAll();
+}
+
+void CloseObjectsReceivers::add(QuadTreeEntry* entry) {
+	receivers.emplace(entry);
+	receiverFlags.add(entry->getReceiverFlags());
+}
+
 CloseObjectsVector::CloseObjectsVector() : messageReceivers() {
 	objects.setNoDuplicateInsertPlan();
 
@@ -57,6 +70,62 @@ bool CloseObjectsVector::contains(const Reference<QuadTreeEntry*>& o) const {
 	return ret;
 }
 
+int CloseObjectsVector::getReceiverTypeIndex(uint32 receiverType) {
+	for (int i = 0; i < RECEIVERTYPES; ++i) {
+		if (receiverType == (uint32) (1 << i))
+			return i;
+	}
+
+	return -1;
+}
+
+Reference<CloseObjectsReceivers*> CloseObjectsVector::getReceivers(uint32 receiverType) const {
+	int typeIndex = getReceiverTypeIndex(receiverType);
+
+	if (typeIndex == -1)
+		return nullptr;
+
+	uint32 version = receiverVersions[typeIndex].get();
+
+	{
+		Locker guard(&snapshotMutex);
+
+		const auto& snapshot = receiverSnapshots[typeIndex];
+
+		if (snapshot != nullptr && snapshot->getVersion() == version)
+			return snapshot;
+	}
+
+	ReadLocker locker(&mutex);
+
+	version = receiverVersions[typeIndex].get();
+
+	int i = messageReceivers.find(receiverType);
+	int size = i != -1 ? messageReceivers.elementAt(i).getValue().size() : 0;
+
+	Reference<CloseObjectsReceivers*> snapshot = new CloseObjectsReceivers(version, size);
+
+	if (i != -1) {
+		const auto& receivers = messageReceivers.elementAt(i).getValue();
+
+		for (int j = 0; j < receivers.size(); ++j)
+			snapshot->add(receivers.getUnsafe(j));
+	}
+
+	locker.release();
+
+	Locker guard(&snapshotMutex);
+
+	const auto& current = receiverSnapshots[typeIndex];
+
+	// another thread may have published a newer one meanwhile, and a receiver dropped since we
+	// copied them must not be cached
+	if ((current == nullptr || CloseObjectsReceivers::isNewerVersion(version, current->getVersion())) && version == receiverVersions[typeIndex].get())
+		receiverSnapshots[typeIndex] = snapshot;
+
+	return snapshot;
+}
+
 void CloseObjectsVector::removeAll(int newSize, int newIncrement) {
 	Locker locker(&mutex);
 
@@ -64,12 +133,22 @@ void CloseObjectsVector::removeAll(int newSize, int newIncrement) {
 
 	messageReceivers.removeAll(newSize, newIncrement);
 
+	for (int i = 0; i < RECEIVERTYPES; ++i)
+		receiverVersions[i].increment();
+
 	count = 0;
+
+	Locker guard(&snapshotMutex);
+
+	for (int i = 0; i < RECEIVERTYPES; ++i)
+		receiverSnapshots[i] = nullptr;
 }
 
 void CloseObjectsVector::dropReceiver(QuadTreeEntry* entry) {
-	uint32 receiverTypes = entry->registerToCloseObjectsReceivers();
+	dropReceiver(entry, entry->registerToCloseObjectsReceivers());
+}
 
+void CloseObjectsVector::dropReceiver(QuadTreeEntry* entry, uint32 receiverTypes) {
 	if (receiverTypes && messageReceivers.size()) {
 		for (int i = 0; i < CloseObjectsVector::MAXTYPES / 2; ++i) {
 			uint32 type = 1 << i;
@@ -80,7 +159,14 @@ void CloseObjectsVector::dropReceiver(QuadTreeEntry* entry) {
 				if (idx != -1) {
 					auto& receivers = messageReceivers.elementAt(idx).getValue();
 
-					receivers.drop(entry);
+					if (receivers.drop(entry)) {
+						receiverVersions[i].increment();
+
+						// the cached snapshot would keep the dropped entry alive until the next broadcast
+						Locker guard(&snapshotMutex);
+
+						receiverSnapshots[i] = nullptr;
+					}
 				}
 			}
 		}
@@ -113,6 +199,21 @@ bool CloseObjectsVector::drop(const Reference<QuadTreeEntry*>& o) {
 	return res;
 }
 
+void CloseObjectsVector::dropAll(const Vector<QuadTreeEntry*>& entries, Vector<QuadTreeEntry*>& dropped) {
+	Locker locker(&mutex);
+
+	for (int i = 0; i < entries.size(); ++i) {
+		QuadTreeEntry* entry = entries.getUnsafe(i);
+
+		dropReceiver(entry);
+
+		if (objects.drop(entry))
+			dropped.add(entry);
+	}
+
+	count = objects.size();
+}
+
 void CloseObjectsVector::safeCopyReceiversTo(Vector<QuadTreeEntry*>& vec, uint32 receiverType) const {
 	ReadLocker locker(&mutex);
 
@@ -180,7 +281,8 @@ void CloseObjectsVector::putReceiver(QuadTreeEntry* entry, uint32 receiverTypes)
 				if (idx != -1) {
 					auto& receivers = messageReceivers.elementAt(idx).getValue();
 
-					receivers.put(entry);
+					if (receivers.put(entry) != -1)
+						receiverVersions[i].increment();
 				} else {
 					SortedVector<QuadTreeEntry*> vec;
 					vec.setNoDuplicateInsertPlan();
@@ -188,6 +290,8 @@ void CloseObjectsVector::putReceiver(QuadTreeEntry* entry, uint32 receiverTypes)
 					vec.put(entry);
 
 					messageReceivers.put(std::move(type), std::move(vec));
+
+					receiverVersions[i].increment();
 				}
 			}
 		}
@@ -219,4 +323,35 @@ int CloseObjectsVector::put(Reference<QuadTreeEntry*>&& o) {
 	count = objects.size();
 
 	return res;
-}
\ No newline at end of file
+}
+
+void CloseObjectsVector::putAll(const SortedVector<QuadTreeEntry*>& entries, Vector<QuadTreeEntry*>& added) {
+	_putAll(entries, added);
+}
+
+void CloseObjectsVector::putAll(const SortedVector<ManagedReference<QuadTreeEntry*> >& entries, Vector<ManagedReference<QuadTreeEntry*> >& added) {
+	_putAll(entries, added);
+}
+
+template<class V, class A>
+void CloseObjectsVector::_putAll(const V& entries, A& added) {
+	Vector<uint32> receiverTypes(entries.size(), 1);
+
+	for (int i = 0; i < entries.size(); ++i) {
+		receiverTypes.add(entries.getUnsafe(i)->registerToCloseObjectsReceivers());
+	}
+
+	Locker locker(&mutex);
+
+	for (int i = 0; i < entries.size(); ++i) {
+		QuadTreeEntry* entry = entries.getUnsafe(i);
+
+		if (objects.put(entry) != -1) {
+			putReceiver(entry, receiverTypes.getUnsafe(i));
+
+			added.add(entry);
+		}
+	}
+
+	count = objects.size();
+}
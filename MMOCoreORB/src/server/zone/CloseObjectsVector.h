@@ -17,7 +17,60 @@ namespace server {
  namespace zone {
 class QuadTreeEntry;
 
+/**
+ * Immutable snapshot of the receivers of one type in a CloseObjectsVector.
+ * Receivers are packed in a contiguous array next to their receiver flags, and
+ * the snapshot is shared between broadcasts until the receiver set changes.
+ */
+class CloseObjectsReceivers : public Object {
+	Vector<Reference<server::zone::QuadTreeEntry*> > receivers;
+	Vector<uint32> receiverFlags;
+
+	uint32 version;
+
+public:
+	CloseObjectsReceivers(uint32 version, int size);
+	~CloseObjectsReceivers();
+
+	void add(server::zone::QuadTreeEntry* entry);
+
+	inline server::zone::QuadTreeEntry* get(int index) const {
+		return receivers.getUnsafe(index).get();
+	}
+
+	inline uint32 getReceiverFlags(int index) const {
+		return receiverFlags.getUnsafe(index);
+	}
+
+	inline int size() const {
+		return receivers.size();
+	}
+
+	inline uint32 getVersion() const {
+		return version;
+	}
+
+	/**
+	 * Versions wrap around, compare them by their signed distance
+	 */
+	static inline bool isNewerVersion(uint32 version, uint32 than) {
+		return (int32) (version - than) > 0;
+	}
+};
+
 class CloseObjectsVector : public Object {
+public:
+	enum {
+		PLAYERTYPE = 1 << 0,
+		CREOTYPE = 1 << 1,
+		COLLIDABLETYPE = 1 << 2,
+		STRUCTURETYPE = 1 << 3,
+		MAXTYPES = STRUCTURETYPE
+	};
+
+	const static int RECEIVERTYPES = 4;
+
+private:
 	mutable ReadWriteLock mutex;
 	SortedVector<Reference<server::zone::QuadTreeEntry*> > objects;
 
@@ -25,22 +78,26 @@ class CloseObjectsVector : public Object {
 
 	AtomicInteger count;
 
+	// bumped under the write lock every time the receivers of a type change
+	AtomicInteger receiverVersions[RECEIVERTYPES];
+
+	mutable Mutex snapshotMutex;
+	mutable Reference<CloseObjectsReceivers*> receiverSnapshots[RECEIVERTYPES];
+
 #ifdef CXX11_COMPILER
 	static_assert(sizeof(server::zone::QuadTreeEntry*) == sizeof(Reference<server::zone::QuadTreeEntry*>), "Reference<> size is not the size of a pointer");
 #endif
 
 protected:
 	void dropReceiver(server::zone::QuadTreeEntry* entry);
+	void dropReceiver(server::zone::QuadTreeEntry* entry, uint32 receiverTypes);
 	void putReceiver(server::zone::QuadTreeEntry* entry, uint32 receiverTypes);
-public:
-	enum {
-		PLAYERTYPE = 1 << 0,
-		CREOTYPE = 1 << 1,
-		COLLIDABLETYPE = 1 << 2,
-		STRUCTURETYPE = 1 << 3,
-		MAXTYPES = STRUCTURETYPE
-	};
 
+	template<class V, class A>
+	void _putAll(const V& entries, A& added);
+	static int getReceiverTypeIndex(uint32 receiverType);
+
+public:
 	CloseObjectsVector();
 
 	Reference<server::zone::QuadTreeEntry*> remove(int index);
@@ -51,6 +108,11 @@ public:
 
 	bool drop(const Reference<server::zone::QuadTreeEntry*>& o);
 
+	/**
+	 * Drops all entries under a single write lock, appending the ones that were present to dropped
+	 */
+	void dropAll(const Vector<server::zone::QuadTreeEntry*>& entries, Vector<server::zone::QuadTreeEntry*>& dropped);
+
 	void safeCopyTo(Vector<server::zone::QuadTreeEntry*>& vec) const;
 	void safeCopyTo(Vector<ManagedReference<server::zone::QuadTreeEntry*> >& vec) const;
 
@@ -59,6 +121,13 @@ public:
 	void safeAppendReceiversTo(Vector<server::zone::QuadTreeEntry*>& vec, uint32 receiverType) const;
 	void safeAppendReceiversTo(Vector<ManagedReference<server::zone::QuadTreeEntry*> >& vec, uint32 receiverType) const;
 
+	/**
+	 * Returns the shared receivers snapshot for receiverType, rebuilding it only
+	 * if receivers were added or dropped since it was taken. Callers iterate it
+	 * without holding the close objects lock.
+	 */
+	Reference<CloseObjectsReceivers*> getReceivers(uint32 receiverType) const;
+
 	SortedVector<ManagedReference<server::zone::QuadTreeEntry*> > getSafeCopy() const;
 
 	const Reference<server::zone::QuadTreeEntry*>& get(int idx) const;
@@ -66,6 +135,12 @@ public:
 	int put(const Reference<server::zone::QuadTreeEntry*>& o);
 	int put(Reference<server::zone::QuadTreeEntry*>&& o);
 
+	/**
+	 * Inserts all entries under a single write lock, appending the ones that weren't already present to added
+	 */
+	void putAll(const SortedVector<server::zone::QuadTreeEntry*>& entries, Vector<server::zone::QuadTreeEntry*>& added);
+	void putAll(const SortedVector<ManagedReference<server::zone::QuadTreeEntry*> >& entries, Vector<ManagedReference<server::zone::QuadTreeEntry*> >& added);
+
 	int size() const NO_THREAD_SAFETY_ANALYSIS {
 		return count;
 	}
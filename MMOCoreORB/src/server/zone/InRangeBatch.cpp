@@ -0,0 +1,100 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "InRangeBatch.h"
+#include "server/zone/Zone.h"
+#include "server/zone/objects/scene/SceneObject.h"
+
+namespace {
+	class InRangePassTask : public Task {
+		WeakReference<InRangeBatch*> batch;
+
+	public:
+		InRangePassTask(InRangeBatch* batch) : batch(batch) {
+		}
+
+		void run() {
+			Reference<InRangeBatch*> strongBatch = batch.get();
+
+			if (strongBatch != nullptr)
+				strongBatch->runPass();
+		}
+	};
+}
+
+InRangeRequest::InRangeRequest(QuadTreeEntry* entry, float range) : entry(entry), range(range) {
+}
+
+InRangeBatch::InRangeBatch(Zone* zone, const String& zoneName, int interval) : Logger("InRangeBatch " + zoneName),
+		zone(zone), zoneName(zoneName), interval(Math::max(1, interval)) {
+	pending.setNoDuplicateInsertPlan();
+	pending.setNullValue(nullptr);
+}
+
+void InRangeBatch::add(QuadTreeEntry* entry, float range) {
+	Locker locker(&pendingMutex);
+
+	InRangeRequest* request = pending.get(entry->getObjectID());
+
+	if (request == nullptr)
+		pending.put(entry->getObjectID(), new InRangeRequest(entry, range));
+	else if (range > request->range)
+		request->range = range;
+
+	schedulePass();
+}
+
+void InRangeBatch::schedulePass() {
+	if (passTask == nullptr) {
+		passTask = new InRangePassTask(this);
+		passTask->setCustomTaskQueue(zoneName);
+	}
+
+	if (!passTask->isScheduled())
+		passTask->schedule(interval);
+}
+
+void InRangeBatch::runPass() {
+	Vector<Reference<InRangeRequest*> > requests;
+
+	{
+		Locker locker(&pendingMutex);
+
+		requests.removeAll(pending.size(), 10);
+
+		for (int i = 0; i < pending.size(); ++i)
+			requests.add(pending.elementAt(i).getValue());
+
+		pending.removeAll();
+	}
+
+	for (int i = 0; i < requests.size(); ++i) {
+		InRangeRequest* request = requests.getUnsafe(i);
+
+		try {
+			recalculate(request->entry, request->range);
+		} catch (Exception& e) {
+			error() << "recalculating close objects of 0x" << hex << request->entry->getObjectID() << ": " << e.getMessage();
+		}
+	}
+}
+
+void InRangeBatch::recalculate(QuadTreeEntry* entry, float range) {
+	ManagedReference<Zone*> strongZone = zone.get();
+
+	if (strongZone == nullptr)
+		return;
+
+	// the entry left the zone since it was queued
+	if (static_cast<SceneObject*>(entry)->getZoneUnsafe() != strongZone)
+		return;
+
+	strongZone->recalculateInRange(entry, range, false);
+}
+
+int InRangeBatch::getPendingCount() {
+	Locker locker(&pendingMutex);
+
+	return pending.size();
+}
@@ -0,0 +1,63 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef INRANGEBATCH_H_
+#define INRANGEBATCH_H_
+
+#include "engine/engine.h"
+
+namespace server {
+namespace zone {
+	class Zone;
+	class QuadTreeEntry;
+}
+}
+
+using namespace server::zone;
+
+class InRangeRequest : public Object {
+public:
+	Reference<QuadTreeEntry*> entry;
+	float range;
+
+	InRangeRequest(QuadTreeEntry* entry, float range);
+};
+
+/**
+ * Close objects recalculations of a zone, collected and run once per Core3.InRangeBatchInterval
+ * on the zone queue. An entry moving several times in an interval is recalculated once, with the
+ * largest range it asked for. Position updates to the current close objects are still sent on
+ * every move, only the insertion of new close objects waits for the pass.
+ */
+class InRangeBatch : public Object, public Logger {
+protected:
+	ManagedWeakReference<Zone*> zone;
+	String zoneName;
+	int interval;
+
+	VectorMap<uint64, Reference<InRangeRequest*> > pending;
+	Reference<Task*> passTask;
+	Mutex pendingMutex;
+
+	virtual void schedulePass();
+
+	/**
+	 * Recalculates the close objects of the entry, it is skipped if the entry left the zone
+	 */
+	virtual void recalculate(QuadTreeEntry* entry, float range);
+
+public:
+	InRangeBatch(Zone* zone, const String& zoneName, int interval);
+
+	/**
+	 * Queues the entry for the next pass, or widens the range of its queued request
+	 */
+	void add(QuadTreeEntry* entry, float range);
+
+	void runPass();
+
+	int getPendingCount();
+};
+
+#endif /* INRANGEBATCH_H_ */
@@ -578,22 +578,9 @@ bool QuadTree::_update(const Reference<QuadTreeNode*>& node, QuadTreeEntry *obj)
 	return cur != nullptr;
 }
 
-void QuadTree::safeInRange(QuadTreeEntry* obj, float range) {
-	CloseObjectsVector* closeObjectsVector = obj->getCloseObjects();
-
-#ifdef NO_ENTRY_REF_COUNTING
-	SortedVector<QuadTreeEntry*> closeObjectsCopy;
-#else
-	SortedVector<ManagedReference<QuadTreeEntry*> > closeObjectsCopy;
-#endif
-
+void QuadTree::safeInRange(QuadTreeEntry* obj, float range, bool notifyPositionUpdates) {
 	Locker objLocker(obj);
 
-	if (closeObjectsVector != nullptr) {
-		closeObjectsCopy.removeAll(closeObjectsVector->size(), 50);
-		closeObjectsVector->safeCopyTo(closeObjectsCopy);
-	}
-
 	float rangesq = range * range;
 
 	float x = obj->getPositionX();
@@ -611,35 +598,90 @@ void QuadTree::safeInRange(QuadTreeEntry* obj, float range) {
 
 	locker.release();
 
-	for (int i = 0; i < inRangeObjects.size(); ++i) {
+	// drop candidates from the node walk that are actually out of range
+	for (int i = inRangeObjects.size() - 1; i >= 0; --i) {
 		QuadTreeEntry *o = inRangeObjects.getUnsafe(i);
 
-		if (o != obj) {
-			float deltaX = x - o->getPositionX();
-			float deltaY = y - o->getPositionY();
+		float deltaX = x - o->getPositionX();
+		float deltaY = y - o->getPositionY();
 
-			try {
-				if (deltaX * deltaX + deltaY * deltaY <= rangesq) {
-					CloseObjectsVector* objCloseObjects = obj->getCloseObjects();
+		if (o != obj && deltaX * deltaX + deltaY * deltaY > rangesq)
+			inRangeObjects.remove(i);
+	}
 
-					if (objCloseObjects != nullptr)
-						obj->addInRangeObject(o, false);
+	notifyInRangeObjects(obj, inRangeObjects, notifyPositionUpdates);
+}
 
-					CloseObjectsVector* oCloseObjects = o->getCloseObjects();
+#ifdef NO_ENTRY_REF_COUNTING
+void QuadTree::notifyInRangeObjects(QuadTreeEntry* obj, const SortedVector<QuadTreeEntry*>& inRangeObjects, bool notifyPositionUpdates) {
+	Vector<QuadTreeEntry*> added(inRangeObjects.size(), 10);
+#else
+void QuadTree::notifyInRangeObjects(QuadTreeEntry* obj, const SortedVector<ManagedReference<QuadTreeEntry*> >& inRangeObjects, bool notifyPositionUpdates) {
+	Vector<ManagedReference<QuadTreeEntry*> > added(inRangeObjects.size(), 10);
+#endif
 
-					if (oCloseObjects != nullptr)
-						o->addInRangeObject(obj);
-				}
-			} catch (...) {
-				System::out << "unreported exception caught in safeInRange()\n";
-			}
-		} else {
-			if (obj->getCloseObjects() != nullptr)
-				obj->addInRangeObject(obj, false);
+	CloseObjectsVector* closeObjectsVector = obj->getCloseObjects();
+
+	// insert everything into our own close objects under one lock, then notify
+
+	if (closeObjectsVector != nullptr)
+		closeObjectsVector->putAll(inRangeObjects, added);
+
+	for (int i = 0; i < added.size(); ++i) {
+		try {
+			obj->notifyInsert(added.getUnsafe(i));
+		} catch (...) {
+			System::out << "unreported exception caught in safeInRange()\n";
 		}
 	}
 
+	for (int i = 0; i < inRangeObjects.size(); ++i) {
+		QuadTreeEntry *o = inRangeObjects.getUnsafe(i);
+
+		if (o == obj)
+			continue;
+
+		try {
+			CloseObjectsVector* oCloseObjects = o->getCloseObjects();
+
+			if (oCloseObjects != nullptr)
+				o->addInRangeObject(obj, notifyPositionUpdates);
+		} catch (...) {
+			System::out << "unreported exception caught in safeInRange()\n";
+		}
+	}
+}
+
+void QuadTree::notifyCloseObjects(QuadTreeEntry* obj) {
+	CloseObjectsVector* closeObjectsVector = obj->getCloseObjects();
+
+	if (closeObjectsVector == nullptr)
+		return;
+
+	Locker objLocker(obj);
 
+#ifdef NO_ENTRY_REF_COUNTING
+	Vector<QuadTreeEntry*> closeObjects;
+#else
+	Vector<ManagedReference<QuadTreeEntry*> > closeObjects;
+#endif
+
+	closeObjectsVector->safeCopyTo(closeObjects);
+
+	for (int i = 0; i < closeObjects.size(); ++i) {
+		QuadTreeEntry *o = closeObjects.getUnsafe(i);
+
+		if (o == obj)
+			continue;
+
+		try {
+			// already known to o, this only sends the position update
+			if (o->getCloseObjects() != nullptr)
+				o->addInRangeObject(obj);
+		} catch (...) {
+			System::out << "unreported exception caught in notifyCloseObjects()\n";
+		}
+	}
 }
 
 void QuadTree::copyObjects(const Reference<QuadTreeNode*>& node, float x, float y, float range, SortedVector<ManagedReference<server::zone::QuadTreeEntry*> >& objects) {
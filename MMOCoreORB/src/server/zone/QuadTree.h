@@ -110,7 +110,22 @@ namespace server {
 		/**
 		 * Updates COV, adds new in range objects
 		 */
-		void safeInRange(QuadTreeEntry* obj, float range);
+		void safeInRange(QuadTreeEntry* obj, float range, bool notifyPositionUpdates = true);
+
+		/**
+		 * Adds the in range objects to obj's COV in one batch and obj to theirs. Objects that already
+		 * had obj get a position update only if notifyPositionUpdates is set
+		 */
+#ifdef NO_ENTRY_REF_COUNTING
+		static void notifyInRangeObjects(QuadTreeEntry* obj, const SortedVector<QuadTreeEntry*>& inRangeObjects, bool notifyPositionUpdates = true);
+#else
+		static void notifyInRangeObjects(QuadTreeEntry* obj, const SortedVector<ManagedReference<QuadTreeEntry*> >& inRangeObjects, bool notifyPositionUpdates = true);
+#endif
+
+		/**
+		 * Notifies obj's current close objects that it moved without querying for new ones
+		 */
+		static void notifyCloseObjects(QuadTreeEntry* obj);
 
 		/**
 		 * Searches for entries that contain x, y point
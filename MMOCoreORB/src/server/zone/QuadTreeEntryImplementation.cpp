@@ -21,12 +21,37 @@ QuadTreeEntryImplementation::QuadTreeEntryImplementation(QuadTreeNode* n) {
 	radius = 0.5f;
 
 	receiverFlags = 0;
+
+	lastInRangeX = 0;
+	lastInRangeY = 0;
+	inRangeUpdated = false;
 }
 
 void QuadTreeEntryImplementation::setNode(QuadTreeNode* n) {
 	node = n;
 }
 
+bool QuadTreeEntryImplementation::checkInRangeUpdate(float cellSize, float hysteresis) {
+	float x = getPositionX();
+	float y = getPositionY();
+
+	if (inRangeUpdated) {
+		bool sameCell = floor(x / cellSize) == floor(lastInRangeX / cellSize) && floor(y / cellSize) == floor(lastInRangeY / cellSize);
+
+		float deltaX = x - lastInRangeX;
+		float deltaY = y - lastInRangeY;
+
+		if (sameCell && deltaX * deltaX + deltaY * deltaY < hysteresis * hysteresis)
+			return false;
+	}
+
+	lastInRangeX = x;
+	lastInRangeY = y;
+	inRangeUpdated = true;
+
+	return true;
+}
+
 bool QuadTreeEntryImplementation::containsPoint(float px, float py) const {
 	return (((px - getPositionX()) * (px - getPositionX())) + ((py - getPositionY()) * (py - getPositionY())) <= radius * radius );
 }
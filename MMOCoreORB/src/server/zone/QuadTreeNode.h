@@ -45,6 +45,7 @@ namespace server {
 namespace zone {
 
 class QuadTree;
+class SpatialGrid;
 class QuadTreeEntry;
 class QuadTreeEntryImplementation;
 
@@ -129,6 +130,7 @@ public:
 	String toStringData() const;
 
 	friend class server::zone::QuadTree;
+	friend class server::zone::SpatialGrid;
 	friend class server::zone::QuadTreeEntryImplementation;
 };
 
@@ -0,0 +1,188 @@
+/*
+Copyright (C) 2007 <SWGEmu>. All rights reserved.
+Distribution of this file for usage outside of Core3 is prohibited.
+ */
+
+#include <math.h>
+
+#include "server/zone/QuadTreeEntry.h"
+
+#include "SpatialGrid.h"
+#include "QuadTree.h"
+
+SpatialGrid::SpatialGrid(float minx, float miny, float maxx, float maxy, float size) {
+	minX = minx;
+	minY = miny;
+	maxX = maxx;
+	maxY = maxy;
+
+	cellSize = size > 0 ? size : DEFAULTCELLSIZE;
+
+	cellsX = Math::max(1, (int) ceil((maxX - minX) / cellSize));
+	cellsY = Math::max(1, (int) ceil((maxY - minY) / cellSize));
+
+	// cells are allocated lazily, the vector itself is never resized after this
+	cells.removeAll(cellsX * cellsY, 1);
+
+	for (int i = 0; i < cellsX * cellsY; ++i) {
+		cells.add(nullptr);
+	}
+}
+
+SpatialGrid::~SpatialGrid() {
+	cells.removeAll();
+}
+
+QuadTreeNode* SpatialGrid::getOrCreateCell(int cellIndex) {
+	Reference<QuadTreeNode*>& cell = cells.getUnsafe(cellIndex);
+
+	if (cell == nullptr) {
+		int cellX = cellIndex % cellsX;
+		int cellY = cellIndex / cellsX;
+
+		float cellMinX = minX + cellX * cellSize;
+		float cellMinY = minY + cellY * cellSize;
+
+		cell = new QuadTreeNode(cellMinX, cellMinY, cellMinX + cellSize, cellMinY + cellSize, nullptr);
+	}
+
+	return cell;
+}
+
+void SpatialGrid::insert(QuadTreeEntry* obj) {
+	E3_ASSERT(obj->getParent() == nullptr);
+
+	if (obj->getNode() != nullptr)
+		remove(obj);
+
+	int cellIndex = getCellIndex(obj->getPositionX(), obj->getPositionY());
+
+	Locker locker(getCellLock(cellIndex));
+
+	obj->clearBounding();
+
+	getOrCreateCell(cellIndex)->addObject(obj);
+}
+
+void SpatialGrid::remove(QuadTreeEntry* obj) {
+	Reference<QuadTreeNode*> node = obj->getNode();
+
+	if (node == nullptr) {
+		System::out << hex << "object [" << obj->getObjectID() <<  "] ERROR - removing from spatial grid\n";
+		StackTrace::printStackTrace();
+
+		return;
+	}
+
+	int cellIndex = getCellIndex(node->dividerX, node->dividerY);
+
+	Locker locker(getCellLock(cellIndex));
+
+	node->removeObject(obj);
+}
+
+bool SpatialGrid::update(QuadTreeEntry* obj) {
+	Reference<QuadTreeNode*> node = obj->getNode();
+
+	if (node == nullptr)
+		return false;
+
+	// Still in the same cell, nothing to do
+	if (node->testInside(obj))
+		return true;
+
+	float x = obj->getPositionX();
+	float y = obj->getPositionY();
+
+	int oldIndex = getCellIndex(node->dividerX, node->dividerY);
+
+	if (!isInside(x, y)) {
+		Locker locker(getCellLock(oldIndex));
+
+		node->removeObject(obj);
+
+		return false;
+	}
+
+	int newIndex = getCellIndex(x, y);
+
+	ReadWriteLock* oldLock = getCellLock(oldIndex);
+	ReadWriteLock* newLock = getCellLock(newIndex);
+
+	// Always acquire shard locks in the same order to avoid deadlocks between two movers
+	ReadWriteLock* firstLock = oldLock < newLock ? oldLock : newLock;
+	ReadWriteLock* secondLock = oldLock < newLock ? newLock : oldLock;
+
+	Locker firstLocker(firstLock);
+
+	if (firstLock != secondLock) {
+		Locker secondLocker(secondLock);
+
+		node->removeObject(obj);
+		getOrCreateCell(newIndex)->addObject(obj);
+	} else {
+		node->removeObject(obj);
+		getOrCreateCell(newIndex)->addObject(obj);
+	}
+
+	return true;
+}
+
+void SpatialGrid::safeInRange(QuadTreeEntry* obj, float range, bool notifyPositionUpdates) {
+	Locker objLocker(obj);
+
+	float x = obj->getPositionX();
+	float y = obj->getPositionY();
+
+#ifdef NO_ENTRY_REF_COUNTING
+	SortedVector<QuadTreeEntry*> inRangeObjects(500, 250);
+#else
+	SortedVector<ManagedReference<QuadTreeEntry*> > inRangeObjects(500, 250);
+#endif
+
+	inRange(x, y, range, inRangeObjects);
+
+	QuadTree::notifyInRangeObjects(obj, inRangeObjects, notifyPositionUpdates);
+}
+
+int SpatialGrid::inRange(float x, float y, float range, SortedVector<ManagedReference<QuadTreeEntry*> >& objects) const {
+	return _inRange(x, y, range, objects);
+}
+
+int SpatialGrid::inRange(float x, float y, float range, SortedVector<QuadTreeEntry*>& objects) const {
+	return _inRange(x, y, range, objects);
+}
+
+template<class V>
+int SpatialGrid::_inRange(float x, float y, float range, V& objects) const {
+	int count = 0;
+
+	int cellMinX = getCellX(x - range);
+	int cellMaxX = getCellX(x + range);
+	int cellMinY = getCellY(y - range);
+	int cellMaxY = getCellY(y + range);
+
+	for (int cellY = cellMinY; cellY <= cellMaxY; ++cellY) {
+		for (int cellX = cellMinX; cellX <= cellMaxX; ++cellX) {
+			int cellIndex = cellY * cellsX + cellX;
+
+			ReadLocker locker(getCellLock(cellIndex));
+
+			const Reference<QuadTreeNode*>& cell = cells.getUnsafe(cellIndex);
+
+			if (cell == nullptr || !cell->testInRange(x, y, range))
+				continue;
+
+			for (int i = 0; i < cell->objects.size(); ++i) {
+				QuadTreeEntry* o = cell->objects.getUnsafe(i);
+
+				if (o->isInRange(x, y, range)) {
+					++count;
+					objects.put(o);
+				}
+			}
+		}
+	}
+
+	return count;
+}
@@ -0,0 +1,119 @@
+/*
+Copyright (C) 2007 <SWGEmu>. All rights reserved.
+Distribution of this file for usage outside of Core3 is prohibited.
+*/
+
+#ifndef SPATIALGRID_H_
+#define SPATIALGRID_H_
+
+#include "system/lang.h"
+
+#include "engine/log/Logger.h"
+
+#include "server/zone/QuadTreeEntry.h"
+
+#include "QuadTreeNode.h"
+
+/**
+ * Uniform grid alternative to the zone QuadTree.
+ *
+ * Entries are bucketed by their position into fixed size cells. Every cell is
+ * a leaf QuadTreeNode so QuadTreeEntry::getNode()/isInQuadTree() keep working
+ * unchanged. Instead of one lock for the whole tree, cells are guarded by a
+ * fixed set of sharded locks, so movers and queriers in different parts of a
+ * zone don't contend with each other.
+ */
+
+namespace server {
+  namespace zone {
+
+	class SpatialGrid : public Object {
+	public:
+		const static int LOCKSHARDS = 64;
+
+		const static int DEFAULTCELLSIZE = 64;
+
+	protected:
+		Vector<Reference<QuadTreeNode*> > cells;
+
+		float minX, minY;
+		float maxX, maxY;
+
+		float cellSize;
+
+		int cellsX, cellsY;
+
+		mutable ReadWriteLock locks[LOCKSHARDS];
+
+	public:
+		SpatialGrid(float minx, float miny, float maxx, float maxy, float cellSize = DEFAULTCELLSIZE);
+
+		~SpatialGrid();
+
+		/**
+		 * Insert an object into the grid.
+		 */
+		void insert(QuadTreeEntry* obj);
+
+		/**
+		 * Remove the object from the grid.
+		 */
+		void remove(QuadTreeEntry* obj);
+
+		/**
+		 * Moves the object to the cell matching its current position.
+		 * @return false if the object left the grid boundaries
+		 */
+		bool update(QuadTreeEntry* obj);
+
+		/**
+		 * Updates COV, adds new in range objects
+		 */
+		void safeInRange(QuadTreeEntry* obj, float range, bool notifyPositionUpdates = true);
+
+		int inRange(float x, float y, float range, SortedVector<ManagedReference<QuadTreeEntry*> >& objects) const;
+		int inRange(float x, float y, float range, SortedVector<QuadTreeEntry*>& objects) const;
+
+		inline float getCellSize() const {
+			return cellSize;
+		}
+
+		inline int getCellCount() const {
+			return cells.size();
+		}
+
+	private:
+		inline bool isInside(float x, float y) const {
+			return x >= minX && x < maxX && y >= minY && y < maxY;
+		}
+
+		inline int getCellX(float x) const {
+			return Math::max(0, Math::min((int) ((x - minX) / cellSize), cellsX - 1));
+		}
+
+		inline int getCellY(float y) const {
+			return Math::max(0, Math::min((int) ((y - minY) / cellSize), cellsY - 1));
+		}
+
+		inline int getCellIndex(float x, float y) const {
+			return getCellY(y) * cellsX + getCellX(x);
+		}
+
+		inline ReadWriteLock* getCellLock(int cellIndex) const {
+			return &locks[cellIndex % LOCKSHARDS];
+		}
+
+		/**
+		 * Returns the cell node, creating it if needed. Cell lock must be held.
+		 */
+		QuadTreeNode* getOrCreateCell(int cellIndex);
+
+		template<class V>
+		int _inRange(float x, float y, float range, V& objects) const;
+	};
+  } // namespace zone
+} // namespace server
+
+using namespace server::zone;
+
+#endif /*SPATIALGRID_H_*/
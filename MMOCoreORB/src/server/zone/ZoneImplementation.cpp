@@ -21,6 +21,7 @@
 #include "server/zone/managers/structure/StructureManager.h"
 #include "terrain/ProceduralTerrainAppearance.h"
 #include "server/zone/managers/collision/NavMeshManager.h"
+#include "conf/ConfigManager.h"
 
 ZoneImplementation::ZoneImplementation(ZoneProcessServer* serv, const String& name) {
 	processor = serv;
@@ -32,6 +33,20 @@ ZoneImplementation::ZoneImplementation(ZoneProcessServer* serv, const String& na
 	regionTree = new server::zone::QuadTree(-8192, -8192, 8192, 8192);
 	quadTree = new server::zone::QuadTree(-8192, -8192, 8192, 8192);
 
+	auto configManager = ConfigManager::instance();
+
+	if (configManager->getZoneSpatialIndex(zoneName) == "grid") {
+		objectGrid = new SpatialGrid(-8192, -8192, 8192, 8192, configManager->getSpatialGridCellSize());
+	}
+
+	collisionBroadphase = new CollisionBroadphase();
+
+	if (configManager->getAiAwarenessBatch())
+		aiAwarenessBatch = new AiAwarenessBatch(zoneName);
+
+	inRangeHysteresis = configManager->getInRangeHysteresis();
+	inRangeCellSize = configManager->getSpatialGridCellSize();
+
 	objectMap = new ObjectMap();
 
 	mapLocations = new MapLocationTable();
@@ -45,6 +60,9 @@ ZoneImplementation::ZoneImplementation(ZoneProcessServer* serv, const String& na
 
 	setLoggingName("Zone " + name);
 
+	if (objectGrid != nullptr)
+		info("using spatial grid with " + String::valueOf(objectGrid->getCellSize()) + "m cells", true);
+
 	Core::getTaskManager()->initializeCustomQueue(zoneName, 1, true);
 }
 
@@ -62,6 +80,11 @@ void ZoneImplementation::initializePrivateData() {
 	creatureManager = new CreatureManager(_this.getReferenceUnsafeStaticCast());
 	creatureManager->deploy("CreatureManager " + zoneName);
 	creatureManager->setZoneProcessor(processor);
+
+	int inRangeBatchInterval = ConfigManager::instance()->getInRangeBatchInterval();
+
+	if (inRangeBatchInterval > 0)
+		inRangeBatch = new InRangeBatch(_this.getReferenceUnsafeStaticCast(), zoneName, inRangeBatchInterval);
 }
 
 void ZoneImplementation::finalize() {
@@ -108,6 +131,10 @@ void ZoneImplementation::stopManagers() {
 	mapLocations = nullptr;
 	objectMap = nullptr;
 	quadTree = nullptr;
+	objectGrid = nullptr;
+	collisionBroadphase = nullptr;
+	aiAwarenessBatch = nullptr;
+	inRangeBatch = nullptr;
 	regionTree = nullptr;
 }
 
@@ -167,12 +194,33 @@ float ZoneImplementation::getHeightNoCache(float x, float y) {
 }
 
 void ZoneImplementation::insert(QuadTreeEntry* entry) {
+	entry->clearInRangeUpdate();
+
+	if (collisionBroadphase != nullptr && CollisionBroadphase::isCollidableEntry(entry))
+		collisionBroadphase->add(static_cast<SceneObject*>(entry));
+
+	// the grid does its own per cell locking, no need to serialize on the zone
+	if (objectGrid != nullptr) {
+		objectGrid->insert(entry);
+		return;
+	}
+
 	Locker locker(_this.getReferenceUnsafeStaticCast());
 
 	quadTree->insert(entry);
 }
 
 void ZoneImplementation::remove(QuadTreeEntry* entry) {
+	if (collisionBroadphase != nullptr && CollisionBroadphase::isCollidableEntry(entry))
+		collisionBroadphase->remove(static_cast<SceneObject*>(entry));
+
+	if (objectGrid != nullptr) {
+		if (entry->isInQuadTree())
+			objectGrid->remove(entry);
+
+		return;
+	}
+
 	Locker locker(_this.getReferenceUnsafeStaticCast());
 
 	if (entry->isInQuadTree())
@@ -180,13 +228,43 @@ void ZoneImplementation::remove(QuadTreeEntry* entry) {
 }
 
 void ZoneImplementation::update(QuadTreeEntry* entry) {
+	// a placed collidable can still be moved by staff
+	if (collisionBroadphase != nullptr && CollisionBroadphase::isCollidableEntry(entry) && collisionBroadphase->contains(static_cast<SceneObject*>(entry)))
+		collisionBroadphase->add(static_cast<SceneObject*>(entry));
+
+	if (objectGrid != nullptr) {
+		objectGrid->update(entry);
+		return;
+	}
+
 	Locker locker(_this.getReferenceUnsafeStaticCast());
 
 	quadTree->update(entry);
 }
 
 void ZoneImplementation::inRange(QuadTreeEntry* entry, float range) {
-	quadTree->safeInRange(entry, range);
+	// skip recalculating close objects for idle jitter, out of range objects are still dropped by removeOutOfRangeObjects.
+	// The current close objects still get the position update
+	if (inRangeHysteresis > 0 && !entry->checkInRangeUpdate(inRangeCellSize, inRangeHysteresis)) {
+		QuadTree::notifyCloseObjects(entry);
+		return;
+	}
+
+	// the new close objects wait for the next pass, the ones we have get the position update now
+	if (inRangeBatch != nullptr) {
+		QuadTree::notifyCloseObjects(entry);
+		inRangeBatch->add(entry, range);
+		return;
+	}
+
+	recalculateInRange(entry, range, true);
+}
+
+void ZoneImplementation::recalculateInRange(QuadTreeEntry* entry, float range, bool notifyPositionUpdates) {
+	if (objectGrid != nullptr)
+		objectGrid->safeInRange(entry, range, notifyPositionUpdates);
+	else
+		quadTree->safeInRange(entry, range, notifyPositionUpdates);
 }
 
 int ZoneImplementation::getInRangeSolidObjects(float x, float y, float range, SortedVector<ManagedReference<QuadTreeEntry*> >* objects, bool readLockZone) {
@@ -194,14 +272,18 @@ int ZoneImplementation::getInRangeSolidObjects(float x, float y, float range, So
 
 	bool readlock = readLockZone && !_this.getReferenceUnsafeStaticCast()->isLockedByCurrentThread();
 
-	try {
-		_this.getReferenceUnsafeStaticCast()->rlock(readlock);
+	if (objectGrid != nullptr) {
+		objectGrid->inRange(x, y, range, *objects);
+	} else {
+		try {
+			_this.getReferenceUnsafeStaticCast()->rlock(readlock);
 
-		quadTree->inRange(x, y, range, *objects);
+			quadTree->inRange(x, y, range, *objects);
 
-		_this.getReferenceUnsafeStaticCast()->runlock(readlock);
-	} catch (...) {
-		_this.getReferenceUnsafeStaticCast()->runlock(readlock);
+			_this.getReferenceUnsafeStaticCast()->runlock(readlock);
+		} catch (...) {
+			_this.getReferenceUnsafeStaticCast()->runlock(readlock);
+		}
 	}
 
 	if (objects->size() > 0) {
@@ -244,14 +326,18 @@ int ZoneImplementation::getInRangeObjects(float x, float y, float range, SortedV
 
 	bool readlock = readLockZone && !_this.getReferenceUnsafeStaticCast()->isLockedByCurrentThread();
 
-	try {
-		_this.getReferenceUnsafeStaticCast()->rlock(readlock);
+	if (objectGrid != nullptr) {
+		objectGrid->inRange(x, y, range, *objects);
+	} else {
+		try {
+			_this.getReferenceUnsafeStaticCast()->rlock(readlock);
 
-		quadTree->inRange(x, y, range, *objects);
+			quadTree->inRange(x, y, range, *objects);
 
-		_this.getReferenceUnsafeStaticCast()->runlock(readlock);
-	} catch (...) {
-		_this.getReferenceUnsafeStaticCast()->runlock(readlock);
+			_this.getReferenceUnsafeStaticCast()->runlock(readlock);
+		} catch (...) {
+			_this.getReferenceUnsafeStaticCast()->runlock(readlock);
+		}
 	}
 
 	if (includeBuildingObjects) {
@@ -302,14 +388,18 @@ int ZoneImplementation::getInRangeObjects(float x, float y, float range, InRange
 
 	bool readlock = readLockZone && !_this.getReferenceUnsafeStaticCast()->isLockedByCurrentThread();
 
-	try {
-		_this.getReferenceUnsafeStaticCast()->rlock(readlock);
+	if (objectGrid != nullptr) {
+		objectGrid->inRange(x, y, range, *objects);
+	} else {
+		try {
+			_this.getReferenceUnsafeStaticCast()->rlock(readlock);
 
-		quadTree->inRange(x, y, range, *objects);
+			quadTree->inRange(x, y, range, *objects);
 
-		_this.getReferenceUnsafeStaticCast()->runlock(readlock);
-	} catch (...) {
-		_this.getReferenceUnsafeStaticCast()->runlock(readlock);
+			_this.getReferenceUnsafeStaticCast()->runlock(readlock);
+		} catch (...) {
+			_this.getReferenceUnsafeStaticCast()->runlock(readlock);
+		}
 	}
 
 	if (includeBuildingObjects) {
@@ -31,6 +31,9 @@
 #include "server/zone/managers/city/CityManager.h"
 #include "server/zone/managers/structure/StructureManager.h"
 #include "server/zone/managers/frs/FrsManager.h"
+#include "server/zone/objects/transaction/TransactionLog.h"
+
+#include "templates/manager/DataArchiveStore.h"
 
 #include "server/chat/ChatManager.h"
 
@@ -183,6 +186,8 @@ void ZoneServerImplementation::initialize() {
 
 	startZones();
 
+	DataArchiveStore::instance()->printStatistics("after zone boot");
+
 	startManagers();
 
 	//serverState = LOCKED;
@@ -391,6 +396,8 @@ void ZoneServerImplementation::stopManagers() {
 		processor = nullptr;
 	}
 
+	TransactionLog::stopWriter();
+
 	if (objectManager != nullptr) {
 		objectManager->shutdown();
 		objectManager = nullptr;
@@ -1488,6 +1488,7 @@ AuctionQueryHeadersResponseMessage* AuctionManagerImplementation::fillAuctionQue
 	AuctionQueryHeadersResponseMessage* reply = new AuctionQueryHeadersResponseMessage(searchType, clientCounter, player);
 
 	String pname = player->getFirstName().toLowerCase();
+	String lowerFilter = filterText.toString().toLowerCase();
 	uint32 now = time(0);
 	int displaying = 0;
 	/*System::out << "Screen =" + String::valueOf(screen) << endl;
@@ -1543,44 +1544,7 @@ AuctionQueryHeadersResponseMessage* AuctionManagerImplementation::fillAuctionQue
 							continue;
 					}
 				case ST_ALL: // All Auctions (Bazaar)
-					if (item->getStatus() == AuctionItem::FORSALE) {
-						if (!checkItemCategory(itemCategory, item))
-							continue;
-
-						if (minPrice != 0 || maxPrice != 0) {
-							int itemPrice = item->getPrice();
-
-							if (includeEntranceFee) {
-								ManagedReference<SceneObject*> itemVendor = player->getZoneServer()->getObject(item->getVendorID());
-
-								if (itemVendor != nullptr && itemVendor->isVendor()) {
-									int accessFee = 0;
-									ManagedReference<SceneObject*> parent = itemVendor->getRootParent();
-
-									if(parent != nullptr && parent->isBuildingObject()) {
-										BuildingObject* building = cast<BuildingObject*>(parent.get());
-
-										if(building != nullptr)
-											accessFee = building->getAccessFee();
-									}
-
-									itemPrice += accessFee;
-								}
-							}
-
-							if ((minPrice != 0 && itemPrice < minPrice) || (maxPrice != 0 && itemPrice > maxPrice))
-								continue;
-						}
-
-						if (!filterText.isEmpty()) {
-							String lowerFilter = filterText.toString().toLowerCase();
-							String itemName = item->getItemName().toLowerCase();
-
-							if (itemName.indexOf(lowerFilter) == -1)
-								continue;
-						}
-
-
+					if (checkSearchFilters(player, item, itemCategory, lowerFilter, minPrice, maxPrice, includeEntranceFee)) {
 						if (displaying >= offset) {
 							reply->addItemToList(item);
 						}
@@ -1661,6 +1625,119 @@ AuctionQueryHeadersResponseMessage* AuctionManagerImplementation::fillAuctionQue
 	return reply;
 }
 
+AuctionQueryHeadersResponseMessage* AuctionManagerImplementation::fillIndexedAuctionQueryHeadersResponseMessage(CreatureObject* player, SceneObject* vendor, AuctionSearchIndex* searchIndex, int searchType, uint32 itemCategory, const UnicodeString& filterText, int minPrice, int maxPrice, bool includeEntranceFee, int clientCounter, int offset) {
+	AuctionQueryHeadersResponseMessage* reply = new AuctionQueryHeadersResponseMessage(searchType, clientCounter, player);
+
+	if (!isMarketEnabled()) {
+		player->sendSystemMessage("@ui_auc:err_vendor_terminal_error"); // This market is unavailable.
+		reply->createMessage(offset, true);
+		return reply;
+	}
+
+	String lowerFilter = filterText.toString().toLowerCase();
+	uint32 now = time(0);
+	int displaying = 0;
+
+	// the entrance fee only adds to the price, so it can't narrow down the low end of the range
+	int indexMinPrice = includeEntranceFee ? 0 : minPrice;
+
+	// the fee comes from the vendor, which can be loaded from the database. Those listings are only
+	// collected under the index lock and their price checked once it is released
+	bool checkFees = includeEntranceFee && (minPrice != 0 || maxPrice != 0);
+
+	Vector<ManagedReference<AuctionItem*> > candidates;
+
+	searchIndex->search(itemCategory, indexMinPrice, maxPrice, lowerFilter, [&] (const AuctionSearchEntry& entry) -> bool {
+		ManagedReference<AuctionItem*> item = entry.getItem();
+
+		if (item == nullptr)
+			return true;
+
+		/// Exclude non-searchable vendor Items
+		if (searchType == ST_VENDOR_SELLING && (entry.getTerminal() == nullptr || !entry.getTerminal()->isSearchable()))
+			return true;
+
+		if (item->getStatus() == AuctionItem::DELETED || item->getStatus() == AuctionItem::RETRIEVED)
+			return true;
+
+		if (!item->isAuction() && item->getExpireTime() <= now) {
+			Core::getTaskManager()->executeTask([=] () {
+				expireSale(item);
+			}, "ExpireSaleLambda");
+
+			return true;
+		}
+
+		if (!checkSearchFilters(player, item, itemCategory, lowerFilter, indexMinPrice, maxPrice, false))
+			return true;
+
+		candidates.add(item);
+
+		return checkFees || candidates.size() < offset + 100;
+	});
+
+	for (int i = 0; i < candidates.size() && displaying < offset + 100; ++i) {
+		AuctionItem* item = candidates.getUnsafe(i);
+
+		if (checkFees && !checkSearchFilters(player, item, itemCategory, lowerFilter, minPrice, maxPrice, true))
+			continue;
+
+		if (displaying >= offset)
+			reply->addItemToList(item);
+
+		displaying++;
+	}
+
+	if (displaying == (offset + 100))
+		reply->createMessage(offset, true);
+	else
+		reply->createMessage(offset);
+
+	return reply;
+}
+
+bool AuctionManagerImplementation::checkSearchFilters(CreatureObject* player, AuctionItem* item, uint32 itemCategory, const String& lowerFilter, int minPrice, int maxPrice, bool includeEntranceFee) {
+	if (item->getStatus() != AuctionItem::FORSALE)
+		return false;
+
+	if (!checkItemCategory(itemCategory, item))
+		return false;
+
+	if (minPrice != 0 || maxPrice != 0) {
+		int itemPrice = item->getPrice();
+
+		if (includeEntranceFee) {
+			ManagedReference<SceneObject*> itemVendor = player->getZoneServer()->getObject(item->getVendorID());
+
+			if (itemVendor != nullptr && itemVendor->isVendor()) {
+				int accessFee = 0;
+				ManagedReference<SceneObject*> parent = itemVendor->getRootParent();
+
+				if(parent != nullptr && parent->isBuildingObject()) {
+					BuildingObject* building = cast<BuildingObject*>(parent.get());
+
+					if(building != nullptr)
+						accessFee = building->getAccessFee();
+				}
+
+				itemPrice += accessFee;
+			}
+		}
+
+		if ((minPrice != 0 && itemPrice < minPrice) || (maxPrice != 0 && itemPrice > maxPrice))
+			return false;
+	}
+
+	if (!lowerFilter.isEmpty()) {
+		String itemName = item->getItemName().toLowerCase();
+
+		if (itemName.indexOf(lowerFilter) == -1)
+			return false;
+	}
+
+	return true;
+}
+
 void AuctionManagerImplementation::getData(CreatureObject* player, int locationType, uint64 vendorObjectID, int searchType, unsigned int itemCategory, const UnicodeString& filterText, int minPrice, int maxPrice, bool includeEntranceFee, int clientCounter, int offset) {
 	auto errorMessage = [=] () -> LoggerHelper {
 		auto msg = error();
@@ -1751,6 +1828,22 @@ void AuctionManagerImplementation::getData(CreatureObject* player, int locationT
 }
 
 void AuctionManagerImplementation::getAuctionData(CreatureObject* player, SceneObject* usedVendor, const String& planet, const String& region, SceneObject* vendor, int searchType, uint32 itemCategory, const UnicodeString& filterText, int minPrice, int maxPrice, bool includeEntranceFee, int clientCounter, int offset) {
+	// bazaar searches over a whole region, planet or the galaxy go through the search indexes
+	if (usedVendor->isBazaarTerminal() && vendor == nullptr && (searchType == ST_ALL || searchType == ST_VENDOR_SELLING)) {
+		AuctionSearchIndex* searchIndex = nullptr;
+
+		if (searchType == ST_ALL)
+			searchIndex = auctionMap->getBazaarSearchIndex(planet, region);
+		else
+			searchIndex = auctionMap->getVendorSearchIndex(planet, region);
+
+		if (searchIndex != nullptr) {
+			AuctionQueryHeadersResponseMessage* msg = fillIndexedAuctionQueryHeadersResponseMessage(player, usedVendor, searchIndex, searchType, itemCategory, filterText, minPrice, maxPrice, includeEntranceFee, clientCounter, offset);
+			player->sendMessage(msg);
+			return;
+		}
+	}
+
 	TerminalListVector terminalList;
 
 	if (usedVendor->isBazaarTerminal() && searchType != ST_VENDOR_SELLING) { // This is to prevent bazaar items from showing on Vendor Search
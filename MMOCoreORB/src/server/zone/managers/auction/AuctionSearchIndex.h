@@ -0,0 +1,374 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef AUCTIONSEARCHINDEX_H_
+#define AUCTIONSEARCHINDEX_H_
+
+#include "server/zone/objects/auction/AuctionItem.h"
+
+#include <map>
+#include <string>
+
+class TerminalItemList;
+
+/**
+ * Listing of an item in an AuctionSearchIndex. Fixed price listings sort before
+ * auctions, cheapest first; auctions are kept in object id order since bids keep
+ * changing their price.
+ */
+class AuctionSearchEntry {
+protected:
+	ManagedReference<AuctionItem*> item;
+	TerminalItemList* terminal;
+
+	uint64 objectID;
+	int sortPrice;
+	bool auction;
+
+public:
+	AuctionSearchEntry() : terminal(nullptr), objectID(0), sortPrice(0), auction(false) {
+	}
+
+	AuctionSearchEntry(AuctionItem* auctionItem, TerminalItemList* itemList) : item(auctionItem), terminal(itemList) {
+		objectID = auctionItem->getAuctionedItemObjectID();
+		auction = auctionItem->isAuction();
+		sortPrice = auction ? 0 : auctionItem->getPrice();
+	}
+
+	AuctionSearchEntry(bool isAuction, int price, uint64 id) : terminal(nullptr), objectID(id), sortPrice(price), auction(isAuction) {
+	}
+
+	AuctionSearchEntry(const AuctionSearchEntry& e) : item(e.item), terminal(e.terminal),
+			objectID(e.objectID), sortPrice(e.sortPrice), auction(e.auction) {
+	}
+
+	AuctionSearchEntry& operator=(const AuctionSearchEntry& e) {
+		if (this == &e)
+			return *this;
+
+		item = e.item;
+		terminal = e.terminal;
+		objectID = e.objectID;
+		sortPrice = e.sortPrice;
+		auction = e.auction;
+
+		return *this;
+	}
+
+	int compareTo(const AuctionSearchEntry& e) const {
+		if (auction != e.auction)
+			return auction ? -1 : 1;
+
+		if (sortPrice != e.sortPrice)
+			return sortPrice < e.sortPrice ? 1 : -1;
+
+		if (objectID == e.objectID)
+			return 0;
+
+		return objectID < e.objectID ? 1 : -1;
+	}
+
+	inline AuctionItem* getItem() const {
+		return item.get();
+	}
+
+	inline TerminalItemList* getTerminal() const {
+		return terminal;
+	}
+
+	inline uint64 getObjectID() const {
+		return objectID;
+	}
+
+	inline bool isAuction() const {
+		return auction;
+	}
+};
+
+class AuctionSearchBucket : public SortedVector<AuctionSearchEntry> {
+public:
+	AuctionSearchBucket() {
+		setNoDuplicateInsertPlan();
+	}
+
+	/**
+	 * First position in the bucket not sorting before e.
+	 */
+	int lowerBound(const AuctionSearchEntry& e) const {
+		int l = 0, r = size();
+
+		while (l < r) {
+			int m = (l + r) / 2;
+
+			if (getUnsafe(m).compareTo(e) > 0)
+				l = m + 1;
+			else
+				r = m;
+		}
+
+		return l;
+	}
+};
+
+/**
+ * Secondary index over the items listed in a region, planet or the whole galaxy,
+ * so bazaar and vendor searches scan the item types and price range asked for
+ * instead of every terminal in range. Items are bucketed by item type (factory
+ * crates with a crated type share their own bucket), and every suffix of the
+ * lowercased words of the item names points back to their listings, so the words
+ * containing the filter text are one sorted range of suffixes starting with it.
+ *
+ * The index only narrows the candidates down, every listing it returns still has
+ * to go through the regular search checks.
+ */
+class AuctionSearchIndex : public Object, public ReadWriteLock {
+protected:
+	VectorMap<int, AuctionSearchBucket> itemTypes;
+	std::map<std::string, SortedVector<uint64> > suffixes;
+	HashTable<uint64, AuctionSearchEntry> listings;
+
+	const static int CRATEBUCKET = -1;
+
+public:
+	AuctionSearchIndex() {
+		itemTypes.setNoDuplicateInsertPlan();
+	}
+
+	void add(AuctionItem* item, TerminalItemList* terminal) {
+		if (item == nullptr)
+			return;
+
+		AuctionSearchEntry entry(item, terminal);
+
+		Locker locker(this);
+
+		if (listings.containsKey(entry.getObjectID()))
+			return;
+
+		listings.put(entry.getObjectID(), entry);
+
+		int bucket = getBucket(item);
+
+		if (!itemTypes.contains(bucket))
+			itemTypes.put(bucket, AuctionSearchBucket());
+
+		itemTypes.get(bucket).put(entry);
+
+		Vector<String> words;
+		tokenize(item->getItemName(), words);
+
+		for (int i = 0; i < words.size(); ++i) {
+			const String& word = words.get(i);
+
+			for (int j = 0; j < word.length(); ++j) {
+				auto result = suffixes.emplace(std::string(word.toCharArray() + j), SortedVector<uint64>());
+
+				if (result.second)
+					result.first->second.setNoDuplicateInsertPlan();
+
+				result.first->second.put(entry.getObjectID());
+			}
+		}
+	}
+
+	void remove(AuctionItem* item) {
+		if (item == nullptr)
+			return;
+
+		uint64 objectID = item->getAuctionedItemObjectID();
+
+		Locker locker(this);
+
+		if (!listings.containsKey(objectID))
+			return;
+
+		AuctionSearchEntry entry = listings.remove(objectID);
+
+		int bucket = getBucket(item);
+
+		if (itemTypes.contains(bucket)) {
+			AuctionSearchBucket& entries = itemTypes.get(bucket);
+			entries.drop(entry);
+
+			if (entries.isEmpty())
+				itemTypes.drop(bucket);
+		}
+
+		Vector<String> words;
+		tokenize(item->getItemName(), words);
+
+		for (int i = 0; i < words.size(); ++i) {
+			const String& word = words.get(i);
+
+			for (int j = 0; j < word.length(); ++j) {
+				auto suffix = suffixes.find(std::string(word.toCharArray() + j));
+
+				if (suffix == suffixes.end())
+					continue;
+
+				suffix->second.drop(objectID);
+
+				if (suffix->second.isEmpty())
+					suffixes.erase(suffix);
+			}
+		}
+	}
+
+	int size() {
+		ReadLocker locker(this);
+
+		return listings.size();
+	}
+
+	/**
+	 * Calls visitor(const AuctionSearchEntry&) on the listings that can match category, the
+	 * fixed price range and lowerFilter, fixed price listings cheapest first and auctions
+	 * after them. A zero price is no limit. The visitor returns false to stop the search.
+	 */
+	template<class Visitor>
+	void search(uint32 category, int minPrice, int maxPrice, const String& lowerFilter, Visitor visitor) {
+		ReadLocker locker(this);
+
+		String word = getLongestWord(lowerFilter);
+
+		if (!word.isEmpty()) {
+			searchText(word, visitor);
+			return;
+		}
+
+		AuctionSearchEntry lowest(false, minPrice, 0);
+		AuctionSearchEntry highest(false, maxPrice, (uint64) -1);
+		AuctionSearchEntry firstAuction(true, 0, 0);
+
+		// two sorted slices per bucket: the fixed price range and the auctions
+		Vector<const AuctionSearchBucket*> buckets;
+		Vector<int> cursors;
+		Vector<int> priceEnds;
+		Vector<int> auctionStarts;
+
+		for (int i = 0; i < itemTypes.size(); ++i) {
+			int itemType = itemTypes.elementAt(i).getKey();
+
+			if (itemType != CRATEBUCKET && !matchesCategory(category, itemType))
+				continue;
+
+			const AuctionSearchBucket* entries = &itemTypes.elementAt(i).getValue();
+			int auctionStart = entries->lowerBound(firstAuction);
+
+			buckets.add(entries);
+			cursors.add(entries->lowerBound(lowest));
+			priceEnds.add(maxPrice != 0 ? Math::min(entries->lowerBound(highest), auctionStart) : auctionStart);
+			auctionStarts.add(auctionStart);
+		}
+
+		while (true) {
+			int next = -1;
+
+			for (int i = 0; i < buckets.size(); ++i) {
+				int cursor = cursors.get(i);
+
+				// past the price range, skip ahead to the auctions
+				if (cursor >= priceEnds.get(i) && cursor < auctionStarts.get(i)) {
+					cursor = auctionStarts.get(i);
+					cursors.set(i, cursor);
+				}
+
+				if (cursor >= buckets.get(i)->size())
+					continue;
+
+				if (next == -1 || buckets.get(i)->getUnsafe(cursor).compareTo(buckets.get(next)->getUnsafe(cursors.get(next))) > 0)
+					next = i;
+			}
+
+			if (next == -1)
+				return;
+
+			int cursor = cursors.get(next);
+			cursors.set(next, cursor + 1);
+
+			if (!visitor(buckets.get(next)->getUnsafe(cursor)))
+				return;
+		}
+	}
+
+	static bool matchesCategory(uint32 category, int itemType) {
+		if (category & 255)
+			return (uint32) itemType == category;
+
+		return (itemType & category) || (category == 8192 && itemType < 256) || category == 0;
+	}
+
+	/**
+	 * Splits the lowercased name on anything that isn't a letter or a digit.
+	 */
+	static void tokenize(const String& name, Vector<String>& words) {
+		String lowerName = name.toLowerCase();
+		int length = lowerName.length();
+		int start = -1;
+
+		for (int i = 0; i <= length; ++i) {
+			bool wordChar = i < length && isWordChar(lowerName.charAt(i));
+
+			if (wordChar && start == -1) {
+				start = i;
+			} else if (!wordChar && start != -1) {
+				words.add(lowerName.subString(start, i));
+				start = -1;
+			}
+		}
+	}
+
+private:
+	static inline bool isWordChar(char c) {
+		return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9');
+	}
+
+	static int getBucket(AuctionItem* item) {
+		if (item->isFactoryCrate() && item->getCratedItemType() > 0)
+			return CRATEBUCKET;
+
+		return item->getItemType();
+	}
+
+	/**
+	 * Longest word of the filter. Any name containing the filter has a word containing it.
+	 */
+	static String getLongestWord(const String& lowerFilter) {
+		Vector<String> words;
+		tokenize(lowerFilter, words);
+
+		String longest;
+
+		for (int i = 0; i < words.size(); ++i) {
+			if (words.get(i).length() > longest.length())
+				longest = words.get(i);
+		}
+
+		return longest;
+	}
+
+	template<class Visitor>
+	void searchText(const String& word, Visitor& visitor) {
+		AuctionSearchBucket candidates;
+		std::string prefix(word.toCharArray(), word.length());
+
+		for (auto suffix = suffixes.lower_bound(prefix); suffix != suffixes.end() && suffix->first.compare(0, prefix.length(), prefix) == 0; ++suffix) {
+			const SortedVector<uint64>& ids = suffix->second;
+
+			for (int j = 0; j < ids.size(); ++j) {
+				uint64 objectID = ids.getUnsafe(j);
+
+				if (listings.containsKey(objectID))
+					candidates.put(listings.get(objectID));
+			}
+		}
+
+		for (int i = 0; i < candidates.size(); ++i) {
+			if (!visitor(candidates.getUnsafe(i)))
+				return;
+		}
+	}
+};
+
+#endif /* AUCTIONSEARCHINDEX_H_ */
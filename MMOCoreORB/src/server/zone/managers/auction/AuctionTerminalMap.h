@@ -72,6 +72,13 @@ public:
 
 			targetRegion->put(vendor->getObjectID(), itemList);
 			put(vendor->getObjectID(), itemList);
+
+			Vector<Reference<AuctionSearchIndex*> > indexes;
+			indexes.add(targetRegion->getSearchIndex());
+			indexes.add(planetList->getSearchIndex());
+			indexes.add(galaxyListing.getSearchIndex());
+
+			itemList->setSearchIndexes(indexes);
 		}
 		return true;
 	}
@@ -86,6 +93,13 @@ public:
 		//Locker locker(this);
 		//Locker glocker(&galaxyListing);
 
+		Reference<TerminalItemList*> itemList = get(vendor->getObjectID());
+
+		if(itemList != nullptr) {
+			Locker locker(itemList);
+			itemList->clearSearchIndexes();
+		}
+
 		Reference<TerminalRegionList*> existingRegion = getVendorRegion(vendor);
 		if(existingRegion == nullptr)
 			return drop(vendor->getObjectID());
@@ -211,6 +225,31 @@ public:
 		return terminals;
 	}
 
+	/**
+	 * Search index of the items listed in region, in planet when region is empty
+	 * or in the whole galaxy when planet is empty.
+	 */
+	AuctionSearchIndex* getSearchIndex(const String& planet, const String& region) {
+
+		if(planet.isEmpty())
+			return galaxyListing.getSearchIndex();
+
+		Reference<TerminalPlanetList*> planetList = galaxyListing.get(planet);
+
+		if(planetList == nullptr)
+			return nullptr;
+
+		if(region.isEmpty())
+			return planetList->getSearchIndex();
+
+		Reference<TerminalRegionList*> regionList = planetList->get(region);
+
+		if(regionList == nullptr)
+			return nullptr;
+
+		return regionList->getSearchIndex();
+	}
+
 private:
 	bool addPlanetListing(const String& planet) {
 
@@ -154,6 +154,19 @@ TerminalListVector AuctionsMapImplementation::getBazaarTerminalData(const String
 
 	return bazaarItemsForSale.getTerminalData(planet, region, vendor);
 }
+
+AuctionSearchIndex* AuctionsMapImplementation::getVendorSearchIndex(const String& planet, const String& region) {
+	Locker locker(_this.getReferenceUnsafeStaticCast());
+
+	return vendorItemsForSale.getSearchIndex(planet, region);
+}
+
+AuctionSearchIndex* AuctionsMapImplementation::getBazaarSearchIndex(const String& planet, const String& region) {
+	Locker locker(_this.getReferenceUnsafeStaticCast());
+
+	return bazaarItemsForSale.getSearchIndex(planet, region);
+}
+
 int AuctionsMapImplementation::getPlayerItemCount(CreatureObject* player) {
 	ManagedReference<PlayerObject*> ghost = player->getPlayerObject();
 
@@ -8,15 +8,24 @@
 #ifndef TERMINALLISTVECTOR_H_
 #define TERMINALLISTVECTOR_H_
 
+#include "AuctionSearchIndex.h"
+
 class TerminalItemList : public SortedVector<ManagedReference<AuctionItem*> >, public ReadWriteLock {
 protected:
 	bool searchable;
 
+	/// region, planet and galaxy indexes the items of this terminal are listed in
+	Vector<Reference<AuctionSearchIndex*> > searchIndexes;
+
 public:
 	TerminalItemList() {
 		searchable = false;
 	}
 
+	~TerminalItemList() {
+		clearSearchIndexes();
+	}
+
 	TerminalItemList(const TerminalItemList& list) : SortedVector<ManagedReference<AuctionItem*> >(list), ReadWriteLock() {
 		searchable = list.searchable;
 	}
@@ -41,27 +50,90 @@ public:
 	int put(const ManagedReference<AuctionItem*>& o) {
 		Locker locker(this);
 
-		return SortedVector<ManagedReference<AuctionItem*> >::put(o);
+		int result = SortedVector<ManagedReference<AuctionItem*> >::put(o);
+
+		if (result != -1) {
+			for (int i = 0; i < searchIndexes.size(); ++i)
+				searchIndexes.get(i)->add(o, this);
+		}
+
+		return result;
 	}
 
 	bool drop(const ManagedReference<AuctionItem*>& o) {
 		Locker locker(this);
 
+		for (int i = 0; i < searchIndexes.size(); ++i)
+			searchIndexes.get(i)->remove(o);
+
 		return SortedVector<ManagedReference<AuctionItem*> >::drop(o);
 	}
 
+	/**
+	 * Moves the items of this terminal from the indexes they are listed in to indexes.
+	 */
+	void setSearchIndexes(const Vector<Reference<AuctionSearchIndex*> >& indexes) {
+		Locker locker(this);
+
+		clearSearchIndexes();
+
+		searchIndexes = indexes;
+
+		for (int i = 0; i < searchIndexes.size(); ++i) {
+			for (int j = 0; j < size(); ++j)
+				searchIndexes.get(i)->add(get(j), this);
+		}
+	}
+
+	/// Pre Locked
+	void clearSearchIndexes() {
+		for (int i = 0; i < searchIndexes.size(); ++i) {
+			for (int j = 0; j < size(); ++j)
+				searchIndexes.get(i)->remove(get(j));
+		}
+
+		searchIndexes.removeAll();
+	}
+
 };
 
 class TerminalRegionList : public VectorMap<uint64, Reference<TerminalItemList*> >, public ReadWriteLock {
+	Reference<AuctionSearchIndex*> searchIndex;
 
+public:
+	TerminalRegionList() {
+		searchIndex = new AuctionSearchIndex();
+	}
+
+	inline AuctionSearchIndex* getSearchIndex() {
+		return searchIndex;
+	}
 };
 
 class TerminalPlanetList : public VectorMap<String, Reference<TerminalRegionList*> >, public ReadWriteLock {
+	Reference<AuctionSearchIndex*> searchIndex;
+
+public:
+	TerminalPlanetList() {
+		searchIndex = new AuctionSearchIndex();
+	}
 
+	inline AuctionSearchIndex* getSearchIndex() {
+		return searchIndex;
+	}
 };
 
 class TerminalGalaxyList : public VectorMap<String, Reference<TerminalPlanetList*> >, public ReadWriteLock {
+	Reference<AuctionSearchIndex*> searchIndex;
 
+public:
+	TerminalGalaxyList() {
+		searchIndex = new AuctionSearchIndex();
+	}
+
+	inline AuctionSearchIndex* getSearchIndex() {
+		return searchIndex;
+	}
 };
 
 class TerminalListVector : public SortedVector<Reference<TerminalItemList*> > {
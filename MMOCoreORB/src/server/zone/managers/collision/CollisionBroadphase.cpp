@@ -0,0 +1,407 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "CollisionBroadphase.h"
+#include "CollisionManager.h"
+#include "server/zone/objects/scene/SceneObject.h"
+#include "templates/collision/BaseBoundingVolume.h"
+
+#include <cfloat>
+
+// objects whose collision appearance has no bounding volume, large enough for any static building
+#define FALLBACK_RADIUS 64.f
+
+CollisionBroadphase::CollisionBroadphase() : Logger("CollisionBroadphase"), root(-1), freeList(-1) {
+	leaves.setNullValue(-1);
+}
+
+int CollisionBroadphase::allocateNode() {
+	int index;
+
+	if (freeList != -1) {
+		index = freeList;
+		freeList = nodes[index].parent;
+	} else {
+		index = nodes.size();
+		nodes.emplace_back();
+	}
+
+	Node& node = nodes[index];
+	node.parent = -1;
+	node.left = -1;
+	node.right = -1;
+	node.height = 0;
+	node.object = nullptr;
+
+	return index;
+}
+
+void CollisionBroadphase::freeNode(int index) {
+	nodes[index].parent = freeList;
+	nodes[index].height = -1;
+	nodes[index].object = nullptr;
+
+	freeList = index;
+}
+
+bool CollisionBroadphase::isCollidableEntry(server::zone::QuadTreeEntry* entry) {
+	return entry->registerToCloseObjectsReceivers() & CloseObjectsVector::COLLIDABLETYPE;
+}
+
+bool CollisionBroadphase::isStaticCollidable(SceneObject* object) {
+	if (object == nullptr || object->getParentID() != 0)
+		return false;
+
+	if (!(object->getReceiverFlags() & CloseObjectsVector::COLLIDABLETYPE))
+		return false;
+
+	return CollisionManager::getCollisionAppearance(object, 255) != nullptr;
+}
+
+bool CollisionBroadphase::getBounds(SceneObject* object, float& minX, float& minY, float& maxX, float& maxY) {
+	const AppearanceTemplate* app = CollisionManager::getCollisionAppearance(object, 255);
+
+	if (app == nullptr)
+		return false;
+
+	const BaseBoundingVolume* volume = app->getBoundingVolume();
+
+	if (volume == nullptr)
+		return false;
+
+	const AABB& box = volume->getBoundingBox();
+
+	// model space has y up, the farthest corner on the x/z plane bounds every heading
+	float extentX = Math::max(fabs(box.getXMin()), fabs(box.getXMax()));
+	float extentZ = Math::max(fabs(box.getZMin()), fabs(box.getZMax()));
+	float radius = Math::sqrt(extentX * extentX + extentZ * extentZ);
+
+	minX = object->getPositionX() - radius;
+	minY = object->getPositionY() - radius;
+	maxX = object->getPositionX() + radius;
+	maxY = object->getPositionY() + radius;
+
+	return true;
+}
+
+void CollisionBroadphase::add(SceneObject* object) {
+	if (!isStaticCollidable(object))
+		return;
+
+	float minX, minY, maxX, maxY;
+
+	if (!getBounds(object, minX, minY, maxX, maxY)) {
+		minX = object->getPositionX() - FALLBACK_RADIUS;
+		minY = object->getPositionY() - FALLBACK_RADIUS;
+		maxX = object->getPositionX() + FALLBACK_RADIUS;
+		maxY = object->getPositionY() + FALLBACK_RADIUS;
+	}
+
+	add(object, minX, minY, maxX, maxY);
+}
+
+void CollisionBroadphase::add(SceneObject* object, float minX, float minY, float maxX, float maxY) {
+	uint64 objectID = object->getObjectID();
+
+	Locker locker(&treeLock);
+
+	int leaf = leaves.get(objectID);
+
+	if (leaf != -1) {
+		Node& node = nodes[leaf];
+
+		if (node.minX == minX && node.minY == minY && node.maxX == maxX && node.maxY == maxY)
+			return;
+
+		removeLeaf(leaf);
+	} else {
+		leaf = allocateNode();
+		leaves.put(objectID, leaf);
+	}
+
+	Node& node = nodes[leaf];
+	node.minX = minX;
+	node.minY = minY;
+	node.maxX = maxX;
+	node.maxY = maxY;
+	node.object = object;
+
+	insertLeaf(leaf);
+}
+
+void CollisionBroadphase::remove(SceneObject* object) {
+	if (object == nullptr)
+		return;
+
+	Locker locker(&treeLock);
+
+	int leaf = leaves.get(object->getObjectID());
+
+	if (leaf == -1)
+		return;
+
+	leaves.remove(object->getObjectID());
+
+	removeLeaf(leaf);
+	freeNode(leaf);
+}
+
+bool CollisionBroadphase::contains(SceneObject* object) const {
+	ReadLocker locker(&treeLock);
+
+	return leaves.containsKey(object->getObjectID());
+}
+
+int CollisionBroadphase::size() const {
+	ReadLocker locker(&treeLock);
+
+	return leaves.size();
+}
+
+int CollisionBroadphase::getHeight() const {
+	ReadLocker locker(&treeLock);
+
+	return root == -1 ? 0 : nodes[root].height;
+}
+
+void CollisionBroadphase::insertLeaf(int leaf) {
+	if (root == -1) {
+		root = leaf;
+		nodes[root].parent = -1;
+		return;
+	}
+
+	const Node leafNode = nodes[leaf];
+
+	// walk down to the sibling that grows the tree perimeter the least
+	int index = root;
+
+	while (!nodes[index].isLeaf()) {
+		const Node& node = nodes[index];
+
+		Node combined;
+		merge(combined, node, leafNode);
+
+		float cost = 2.f * combined.perimeter();
+		float inheritanceCost = 2.f * (combined.perimeter() - node.perimeter());
+
+		float childCost[2];
+		int children[2] = { node.left, node.right };
+
+		for (int i = 0; i < 2; ++i) {
+			const Node& child = nodes[children[i]];
+
+			Node grown;
+			merge(grown, child, leafNode);
+
+			childCost[i] = inheritanceCost + (child.isLeaf() ? grown.perimeter() : grown.perimeter() - child.perimeter());
+		}
+
+		if (cost < childCost[0] && cost < childCost[1])
+			break;
+
+		index = childCost[0] < childCost[1] ? children[0] : children[1];
+	}
+
+	int sibling = index;
+	int oldParent = nodes[sibling].parent;
+	int newParent = allocateNode();
+
+	Node& parentNode = nodes[newParent];
+	parentNode.parent = oldParent;
+	merge(parentNode, nodes[sibling], leafNode);
+	parentNode.height = nodes[sibling].height + 1;
+	parentNode.left = sibling;
+	parentNode.right = leaf;
+
+	if (oldParent != -1) {
+		if (nodes[oldParent].left == sibling)
+			nodes[oldParent].left = newParent;
+		else
+			nodes[oldParent].right = newParent;
+	} else {
+		root = newParent;
+	}
+
+	nodes[sibling].parent = newParent;
+	nodes[leaf].parent = newParent;
+
+	for (index = nodes[leaf].parent; index != -1; index = nodes[index].parent) {
+		index = balance(index);
+
+		refit(index);
+	}
+}
+
+void CollisionBroadphase::removeLeaf(int leaf) {
+	if (leaf == root) {
+		root = -1;
+		return;
+	}
+
+	int parent = nodes[leaf].parent;
+	int grandParent = nodes[parent].parent;
+	int sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+
+	if (grandParent != -1) {
+		if (nodes[grandParent].left == parent)
+			nodes[grandParent].left = sibling;
+		else
+			nodes[grandParent].right = sibling;
+
+		nodes[sibling].parent = grandParent;
+
+		freeNode(parent);
+
+		for (int index = grandParent; index != -1; index = nodes[index].parent) {
+			index = balance(index);
+
+			refit(index);
+		}
+	} else {
+		root = sibling;
+		nodes[sibling].parent = -1;
+
+		freeNode(parent);
+	}
+
+	nodes[leaf].parent = -1;
+}
+
+int CollisionBroadphase::balance(int a) {
+	Node& nodeA = nodes[a];
+
+	if (nodeA.isLeaf() || nodeA.height < 2)
+		return a;
+
+	int b = nodeA.left;
+	int c = nodeA.right;
+
+	int balanceFactor = nodes[c].height - nodes[b].height;
+
+	// promote the taller child, its taller grand child stays under it
+	if (balanceFactor > 1 || balanceFactor < -1) {
+		int up = balanceFactor > 1 ? c : b;
+		int down = balanceFactor > 1 ? b : c;
+
+		Node& nodeUp = nodes[up];
+
+		int f = nodeUp.left;
+		int g = nodeUp.right;
+
+		nodeUp.left = a;
+		nodeUp.parent = nodeA.parent;
+		nodeA.parent = up;
+
+		if (nodeUp.parent != -1) {
+			if (nodes[nodeUp.parent].left == a)
+				nodes[nodeUp.parent].left = up;
+			else
+				nodes[nodeUp.parent].right = up;
+		} else {
+			root = up;
+		}
+
+		int keep = nodes[f].height > nodes[g].height ? f : g;
+		int give = keep == f ? g : f;
+
+		nodeUp.right = keep;
+
+		if (up == c) {
+			nodeA.right = give;
+			nodeA.left = down;
+		} else {
+			nodeA.left = give;
+			nodeA.right = down;
+		}
+
+		nodes[give].parent = a;
+
+		refit(a);
+		refit(up);
+
+		return up;
+	}
+
+	return a;
+}
+
+int CollisionBroadphase::raycast(float x0, float y0, float x1, float y1, Vector<ManagedReference<SceneObject*> >& objects) const {
+	ReadLocker locker(&treeLock);
+
+	if (root == -1)
+		return 0;
+
+	float dirX = x1 - x0;
+	float dirY = y1 - y0;
+
+	float invX = dirX != 0.f ? 1.f / dirX : FLT_MAX;
+	float invY = dirY != 0.f ? 1.f / dirY : FLT_MAX;
+
+	int found = 0;
+
+	// the tree is balanced so this is rarely outgrown, deeper nodes spill into overflow
+	const static int STACKSIZE = 64;
+
+	int stack[STACKSIZE];
+	int count = 0;
+
+	std::vector<int> overflow;
+
+	stack[count++] = root;
+
+	while (count > 0 || !overflow.empty()) {
+		int index;
+
+		if (!overflow.empty()) {
+			index = overflow.back();
+			overflow.pop_back();
+		} else {
+			index = stack[--count];
+		}
+
+		const Node& node = nodes[index];
+
+		// slab test of the segment against the node box
+		float tMin = 0.f, tMax = 1.f;
+
+		if (dirX == 0.f) {
+			if (x0 < node.minX || x0 > node.maxX)
+				continue;
+		} else {
+			float t0 = (node.minX - x0) * invX;
+			float t1 = (node.maxX - x0) * invX;
+
+			tMin = Math::max(tMin, Math::min(t0, t1));
+			tMax = Math::min(tMax, Math::max(t0, t1));
+		}
+
+		if (dirY == 0.f) {
+			if (y0 < node.minY || y0 > node.maxY)
+				continue;
+		} else {
+			float t0 = (node.minY - y0) * invY;
+			float t1 = (node.maxY - y0) * invY;
+
+			tMin = Math::max(tMin, Math::min(t0, t1));
+			tMax = Math::min(tMax, Math::max(t0, t1));
+		}
+
+		if (tMin > tMax)
+			continue;
+
+		if (node.isLeaf()) {
+			objects.add(node.object);
+			++found;
+		} else if (count + 2 <= STACKSIZE) {
+			stack[count++] = node.left;
+			stack[count++] = node.right;
+		} else {
+			overflow.push_back(node.left);
+			overflow.push_back(node.right);
+		}
+	}
+
+	return found;
+}
@@ -0,0 +1,128 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef COLLISIONBROADPHASE_H_
+#define COLLISIONBROADPHASE_H_
+
+#include "engine/engine.h"
+
+#include <vector>
+
+namespace server {
+namespace zone {
+	class QuadTreeEntry;
+
+namespace objects {
+namespace scene {
+	class SceneObject;
+}
+}
+}
+}
+
+using namespace server::zone::objects::scene;
+
+/**
+ * Dynamic AABB tree over the static collidables of a zone (buildings, walls and other
+ * COLLIDABLETYPE objects placed in the world), so a line of sight ray only goes through
+ * the mesh intersection of the objects whose bounds it actually crosses.
+ *
+ * Bounds are on the ground plane and conservative: the circle around the object position
+ * enclosing its collision appearance bounding box at any heading. Leaves are inserted
+ * next to the sibling that grows the least and the tree is kept balanced with rotations.
+ */
+class CollisionBroadphase : public Object, public Logger {
+protected:
+	struct Node {
+		float minX, minY, maxX, maxY;
+
+		int parent;
+		int left;
+		int right;
+		int height;
+
+		SceneObject* object;
+
+		inline bool isLeaf() const {
+			return left == -1;
+		}
+
+		inline float perimeter() const {
+			return 2.f * ((maxX - minX) + (maxY - minY));
+		}
+	};
+
+	std::vector<Node> nodes;
+	int root;
+	int freeList;
+
+	HashTable<uint64, int> leaves;
+
+	mutable ReadWriteLock treeLock;
+
+	int allocateNode();
+	void freeNode(int index);
+
+	void insertLeaf(int leaf);
+	void removeLeaf(int leaf);
+
+	int balance(int index);
+
+	inline void merge(Node& node, const Node& a, const Node& b) {
+		node.minX = Math::min(a.minX, b.minX);
+		node.minY = Math::min(a.minY, b.minY);
+		node.maxX = Math::max(a.maxX, b.maxX);
+		node.maxY = Math::max(a.maxY, b.maxY);
+	}
+
+	inline void refit(int index) {
+		Node& node = nodes[index];
+
+		merge(node, nodes[node.left], nodes[node.right]);
+		node.height = 1 + Math::max(nodes[node.left].height, nodes[node.right].height);
+	}
+
+public:
+	CollisionBroadphase();
+
+	/**
+	 * Adds object if it is a static collidable with a collision appearance, or moves it
+	 * to its current position when it is already in the tree.
+	 */
+	void add(SceneObject* object);
+
+	/**
+	 * Adds object with explicit ground plane bounds.
+	 */
+	void add(SceneObject* object, float minX, float minY, float maxX, float maxY);
+
+	void remove(SceneObject* object);
+
+	bool contains(SceneObject* object) const;
+
+	int size() const;
+
+	int getHeight() const;
+
+	/**
+	 * Collects the objects whose bounds the segment from x0, y0 to x1, y1 crosses.
+	 * @return number of objects added
+	 */
+	int raycast(float x0, float y0, float x1, float y1, Vector<ManagedReference<SceneObject*> >& objects) const;
+
+	static bool isStaticCollidable(SceneObject* object);
+
+	/**
+	 * Lock free check on the transient receiver flags, objects without COLLIDABLETYPE
+	 * (every mobile) are never in the tree and skip the tree lock.
+	 */
+	static bool isCollidableEntry(server::zone::QuadTreeEntry* entry);
+
+	/**
+	 * Ground plane bounds of object, false when its collision appearance has no bounding volume.
+	 */
+	static bool getBounds(SceneObject* object, float& minX, float& minY, float& maxX, float& maxY);
+};
+
+#endif /* COLLISIONBROADPHASE_H_ */
@@ -6,6 +6,7 @@
  */
 
 #include "CollisionManager.h"
+#include "CollisionBroadphase.h"
 #include "server/zone/Zone.h"
 #include "server/zone/objects/building/BuildingObject.h"
 #include "server/zone/objects/cell/CellObject.h"
@@ -456,9 +457,27 @@ bool CollisionManager::checkLineOfSight(SceneObject* object1, SceneObject* objec
 	UniqueReference<SortedVector<QuadTreeEntry*>* > closeObjectsNonReference;/* new SortedVector<QuadTreeEntry* >();*/
 	UniqueReference<SortedVector<ManagedReference<QuadTreeEntry*> >*> closeObjects;/*new SortedVector<ManagedReference<QuadTreeEntry*> >();*/
 
+	Vector<ManagedReference<SceneObject*> > candidates;
+
 	int maxInRangeObjectCount = 0;
 
-	if (object1->getCloseObjects() == nullptr) {
+	if (object1->isCreatureObject())
+		heightOrigin = getRayOriginPoint(object1->asCreatureObject());
+
+	if (object2->isCreatureObject())
+		heightEnd = getRayOriginPoint(object2->asCreatureObject());
+
+	rayOrigin.set(rayOrigin.getX(), rayOrigin.getY(), rayOrigin.getZ() + heightOrigin);
+
+	Vector3 rayEnd = object2->getWorldPosition();
+	rayEnd.set(rayEnd.getX(), rayEnd.getY(), rayEnd.getZ() + heightEnd);
+
+	CollisionBroadphase* broadphase = zone->getCollisionBroadphase();
+
+	if (broadphase != nullptr) {
+		// only the collidables whose bounds the ray crosses
+		broadphase->raycast(rayOrigin.getX(), rayOrigin.getY(), rayEnd.getX(), rayEnd.getY(), candidates);
+	} else if (object1->getCloseObjects() == nullptr) {
 #ifdef COV_DEBUG
 		object1->info("Null closeobjects vector in CollisionManager::checkLineOfSight for " + object1->getDisplayedName(), true);
 #endif
@@ -472,28 +491,21 @@ bool CollisionManager::checkLineOfSight(SceneObject* object1, SceneObject* objec
 		vec->safeCopyReceiversTo(*closeObjectsNonReference.get(), CloseObjectsVector::COLLIDABLETYPE);
 	}
 
-	if (object1->isCreatureObject())
-		heightOrigin = getRayOriginPoint(object1->asCreatureObject());
-
-	if (object2->isCreatureObject())
-		heightEnd = getRayOriginPoint(object2->asCreatureObject());
-
-	rayOrigin.set(rayOrigin.getX(), rayOrigin.getY(), rayOrigin.getZ() + heightOrigin);
-
-	Vector3 rayEnd = object2->getWorldPosition();
-	rayEnd.set(rayEnd.getX(), rayEnd.getY(), rayEnd.getZ() + heightEnd);
-
 	float dist = rayEnd.distanceTo(rayOrigin);
 	float intersectionDistance;
 	Triangle* triangle = nullptr;
 
 	try {
-		for (int i = 0; i < (closeObjects != nullptr ? closeObjects->size() : closeObjectsNonReference->size()); ++i) {
+		int candidateCount = broadphase != nullptr ? candidates.size() : (closeObjects != nullptr ? closeObjects->size() : closeObjectsNonReference->size());
+
+		for (int i = 0; i < candidateCount; ++i) {
 			const AppearanceTemplate* app = nullptr;
 
 			SceneObject* scno;
 
-			if (closeObjects != nullptr) {
+			if (broadphase != nullptr) {
+				scno = candidates.getUnsafe(i).get();
+			} else if (closeObjects != nullptr) {
 				scno = static_cast<SceneObject*>(closeObjects->get(i).get());
 			} else {
 				scno = static_cast<SceneObject*>(closeObjectsNonReference->get(i));
@@ -581,53 +593,26 @@ const TriangleNode* CollisionManager::getTriangle(const Vector3& point, const Fl
 }
 
 Vector3 CollisionManager::convertToModelSpace(const Vector3& point, SceneObject* model) {
-	Reference<Matrix4*> modelMatrix = getTransformMatrix(model);
+	Matrix4 modelMatrix = getTransformMatrix(model);
 
-	Vector3 transformedPoint = point * *modelMatrix;
+	Vector3 transformedPoint = point * modelMatrix;
 
 	return transformedPoint;
 }
 
-Reference<Matrix4*> CollisionManager::getTransformMatrix(SceneObject* model) {
-	//this can be optimized by storing the matrix on the model and update it when needed
-	//Reference
+Matrix4 CollisionManager::getTransformMatrix(SceneObject* model) {
+	Matrix4 modelMatrix;
 
-	Reference<Matrix4*> modelMatrix = model->getTransformForCollisionMatrix();
-
-	if (modelMatrix == nullptr) {
-		//modelMatrix = new Matrix4();
-
-		Matrix4 translationMatrix;
-		translationMatrix.setTranslation(-model->getPositionX(), -model->getPositionZ(), -model->getPositionY());
-
-		float rad = -model->getDirection()->getRadians();
-		float cosRad = cos(rad);
-		float sinRad = sin(rad);
-
-		Matrix3 rot;
-		rot[0][0] = cosRad;
-		rot[0][2] = -sinRad;
-		rot[1][1] = 1;
-		rot[2][0] = sinRad;
-		rot[2][2] = cosRad;
-
-		Matrix4 rotateMatrix;
-		rotateMatrix.setRotationMatrix(rot);
-
-		//Matrix4 modelMatrix;
-		modelMatrix = new Matrix4(translationMatrix * rotateMatrix);
-
-		model->setTransformForCollisionMatrixIfNull(modelMatrix);
-	}
+	model->getCollisionTransform()->get(model->getPositionX(), model->getPositionY(), model->getPositionZ(), *model->getDirection(), modelMatrix);
 
 	return modelMatrix;
 }
 
 Ray CollisionManager::convertToModelSpace(const Vector3& rayOrigin, const Vector3& rayEnd, SceneObject* model) {
-	Reference<Matrix4*> modelMatrix = getTransformMatrix(model);
+	Matrix4 modelMatrix = getTransformMatrix(model);
 
-	Vector3 transformedOrigin = rayOrigin * *modelMatrix;
-	Vector3 transformedEnd = rayEnd * *modelMatrix;
+	Vector3 transformedOrigin = rayOrigin * modelMatrix;
+	Vector3 transformedEnd = rayEnd * modelMatrix;
 
 	Vector3 norm = transformedEnd - transformedOrigin;
 	norm.normalize();
@@ -51,7 +51,7 @@ public:
 	static Ray convertToModelSpace(const Vector3& rayOrigin, const Vector3& rayEnd, SceneObject* model);
 	static Vector3 convertToModelSpace(const Vector3& point, SceneObject* model);
 	static const TriangleNode* getTriangle(const Vector3& point, const FloorMesh* floor);
-	static Reference<Matrix4*> getTransformMatrix(SceneObject* model);
+	static Matrix4 getTransformMatrix(SceneObject* model);
 	/**
 	 * @returns nearest available path node int the floor path graph with the lowest distance from triangle to final target
 	 */
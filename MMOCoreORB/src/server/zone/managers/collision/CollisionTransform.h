@@ -0,0 +1,116 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef COLLISIONTRANSFORM_H_
+#define COLLISIONTRANSFORM_H_
+
+#include "engine/engine.h"
+
+#include <atomic>
+
+/**
+ * World to model space matrix of a collidable object, stamped with the position and
+ * direction it was built for. A move or rotation doesn't have to invalidate it, the
+ * next read sees the stamp is stale and rebuilds it.
+ *
+ * Readers copy the matrix out under a sequence counter instead of a lock; a writer
+ * makes the counter odd while it updates the matrix and readers retry around it.
+ */
+class CollisionTransform {
+	std::atomic<uint32> sequence;
+
+	Matrix4 worldToModel;
+
+	float positionX, positionY, positionZ;
+	float directionW, directionX, directionY, directionZ;
+	bool valid;
+
+	AtomicInteger rebuildCount;
+
+	inline bool matches(float x, float y, float z, const Quaternion& dir) const {
+		return valid && positionX == x && positionY == y && positionZ == z && directionW == dir.getW()
+				&& directionX == dir.getX() && directionY == dir.getY() && directionZ == dir.getZ();
+	}
+
+public:
+	CollisionTransform() : sequence(0), positionX(0), positionY(0), positionZ(0),
+			directionW(1), directionX(0), directionY(0), directionZ(0), valid(false) {
+	}
+
+	// a copy starts out empty, it gets built on its first read
+	CollisionTransform(const CollisionTransform&) : CollisionTransform() {
+	}
+
+	CollisionTransform& operator=(const CollisionTransform&) {
+		return *this;
+	}
+
+	/**
+	 * Copies the world to model matrix for the object at x, y, z (z up) facing dir into matrix.
+	 */
+	void get(float x, float y, float z, const Quaternion& dir, Matrix4& matrix) {
+		uint32 seq = sequence.load(std::memory_order_acquire);
+
+		if (!(seq & 1) && matches(x, y, z, dir)) {
+			matrix = worldToModel;
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			if (sequence.load(std::memory_order_relaxed) == seq)
+				return;
+		}
+
+		matrix = buildWorldToModel(x, y, z, dir.getRadians());
+
+		rebuildCount.increment();
+
+		// publish it unless another thread is already writing, the next reader will catch up
+		if ((seq & 1) || !sequence.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire))
+			return;
+
+		worldToModel = matrix;
+
+		positionX = x;
+		positionY = y;
+		positionZ = z;
+		directionW = dir.getW();
+		directionX = dir.getX();
+		directionY = dir.getY();
+		directionZ = dir.getZ();
+		valid = true;
+
+		sequence.store(seq + 2, std::memory_order_release);
+	}
+
+	int getRebuildCount() const {
+		return rebuildCount.get();
+	}
+
+	/**
+	 * Translates to the object position and rotates by the inverse of its heading. Collision
+	 * space has y up, so world z and y swap places.
+	 */
+	static Matrix4 buildWorldToModel(float x, float y, float z, float radians) {
+		Matrix4 translationMatrix;
+		translationMatrix.setTranslation(-x, -z, -y);
+
+		float rad = -radians;
+		float cosRad = cos(rad);
+		float sinRad = sin(rad);
+
+		Matrix3 rot;
+		rot[0][0] = cosRad;
+		rot[0][2] = -sinRad;
+		rot[1][1] = 1;
+		rot[2][0] = sinRad;
+		rot[2][2] = cosRad;
+
+		Matrix4 rotateMatrix;
+		rotateMatrix.setRotationMatrix(rot);
+
+		return translationMatrix * rotateMatrix;
+	}
+};
+
+#endif /* COLLISIONTRANSFORM_H_ */
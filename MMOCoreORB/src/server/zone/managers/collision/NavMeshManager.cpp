@@ -1,6 +1,8 @@
 #include "NavMeshManager.h"
 #include "pathfinding/RecastNavMesh.h"
 #include "pathfinding/RecastNavMeshBuilder.h"
+#include "pathfinding/NavMeshCache.h"
+#include "server/zone/managers/collision/PathFinderManager.h"
 #include "server/zone/managers/planet/PlanetManager.h"
 #include "terrain/manager/TerrainManager.h"
 #include "terrain/ProceduralTerrainAppearance.h"
@@ -199,7 +201,10 @@ void NavMeshManager::startJob(Reference<NavMeshJob*> job) {
 #ifdef NAVMESH_DEBUG
         info("Rebuilding Base Mesh", true);
 #endif
-        builder->build();
+        if (NavMeshCache::instance()->isEnabled())
+            builder->buildCached();
+        else
+            builder->build();
     } else if (dirtyZones.size() > 0) {
 #ifdef NAVMESH_DEBUG
         info("Rebuilding area", true);
@@ -242,6 +247,8 @@ void NavMeshManager::startJob(Reference<NavMeshJob*> job) {
     	navmesh->setupDetourNavMeshHeader();
     	area->_setUpdated(true);
 
+    	PathFinderManager::instance()->getPathCache()->notifyNavMeshUpdated(zone->getObjectID(), area->getObjectID(), navmesh->getGeneration(), initialBuild);
+
 	info(true) <<
 		"Done building and setting navmesh for area: " << name << " on planet: "
 		<< zone->getZoneName() << " at: " << area->getPosition().toString();
@@ -302,6 +309,26 @@ void NavMeshManager::cancelAllJobs() {
 	jobs.removeAll();
 }
 
+bool NavMeshManager::hasPendingJobs() {
+	Locker locker(&jobQueueMutex);
+
+	return jobs.size() > 0 || runningJobs.size() > 0;
+}
+
+void NavMeshManager::waitForJobs() {
+	if (zoneServer == nullptr)
+		return;
+
+	// jobs are queued while the zones load, only an empty queue after that means we are done
+	while (!stopped && (zoneServer->isServerLoading() || hasPendingJobs()))
+		Thread::sleep(1000);
+
+	NavMeshCache* cache = NavMeshCache::instance();
+
+	info(true) << "navmesh jobs done, " << cache->getLoadedTiles() << " tiles loaded from the cache and "
+		<< cache->getBuiltTiles() << " tiles built";
+}
+
 void NavMeshManager::stop() {
 	stopped = true;
 	cancelAllJobs();
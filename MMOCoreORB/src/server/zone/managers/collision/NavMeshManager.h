@@ -41,6 +41,13 @@ public:
 		return stopped;
 	}
 
+	bool hasPendingJobs();
+
+	/**
+	 * Blocks until the zones are loaded and every queued navmesh job finished.
+	 */
+	void waitForJobs();
+
 	void dumpMeshesToFiles();
 
 	static bool AABBEncompasessAABB(const AABB& lhs, const AABB& rhs);
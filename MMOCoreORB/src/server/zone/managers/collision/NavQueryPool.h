@@ -0,0 +1,84 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef NAVQUERYPOOL_H_
+#define NAVQUERYPOOL_H_
+
+#include "engine/engine.h"
+#include "pathfinding/RecastNavMesh.h"
+#include "pathfinding/recast/DetourNavMeshQuery.h"
+
+/**
+ * Per thread set of dtNavMeshQuery objects, each one initialized against one navmesh and
+ * reused for as long as that mesh isn't replaced. Callers must hold the read lock of the
+ * NavArea owning the mesh while they use the query.
+ */
+class NavQueryPool {
+	struct Entry {
+		dtNavMeshQuery* query;
+		const dtNavMesh* mesh;
+		uint32 generation;
+		uint64 lastUse;
+	};
+
+	Entry entries[8];
+	int maxNodes;
+	uint64 useCounter;
+
+public:
+	NavQueryPool(int nodes) : maxNodes(nodes), useCounter(0) {
+		for (auto& entry : entries) {
+			entry.query = nullptr;
+			entry.mesh = nullptr;
+			entry.generation = 0;
+			entry.lastUse = 0;
+		}
+	}
+
+	~NavQueryPool() {
+		for (auto& entry : entries)
+			dtFreeNavMeshQuery(entry.query);
+	}
+
+	/**
+	 * Returns a query ready to use on mesh, nullptr when the mesh isn't loaded.
+	 */
+	dtNavMeshQuery* getQuery(RecastNavMesh* navMesh) {
+		const dtNavMesh* mesh = navMesh->getNavMesh();
+
+		if (mesh == nullptr)
+			return nullptr;
+
+		uint32 generation = navMesh->getGeneration();
+		Entry* oldest = &entries[0];
+
+		for (auto& entry : entries) {
+			if (entry.query != nullptr && entry.mesh == mesh && entry.generation == generation) {
+				entry.lastUse = ++useCounter;
+				return entry.query;
+			}
+
+			if (entry.lastUse < oldest->lastUse)
+				oldest = &entry;
+		}
+
+		if (oldest->query == nullptr)
+			oldest->query = dtAllocNavMeshQuery();
+
+		if (dtStatusFailed(oldest->query->init(mesh, maxNodes))) {
+			oldest->mesh = nullptr;
+			oldest->lastUse = 0;
+
+			return nullptr;
+		}
+
+		oldest->mesh = mesh;
+		oldest->generation = generation;
+		oldest->lastUse = ++useCounter;
+
+		return oldest->query;
+	}
+};
+
+#endif /* NAVQUERYPOOL_H_ */
@@ -0,0 +1,150 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "PathCache.h"
+#include "PathRequestQueue.h"
+
+PathCache::PathCache(int capacity) : recentTable(0), capacity(capacity) {
+}
+
+uint64 PathCache::getKey(const WorldCoordinates& start, const WorldCoordinates& goal, uint64 zoneID) {
+	return PathRequestQueue::getRequestKey(start, goal) ^ zoneID;
+}
+
+bool PathCache::isCurrent(const PathCacheEntry* entry, const WorldCoordinates& start, const WorldCoordinates& goal, uint64 zoneID) const {
+	if (start.getCell() != nullptr && goal.getCell() != nullptr)
+		return true;
+
+	if (entry->getZoneGeneration() != zoneGenerations.get(zoneID))
+		return false;
+
+	const VectorMap<uint64, uint32>& stamps = entry->getNavMeshGenerations();
+
+	for (int i = 0; i < stamps.size(); ++i) {
+		uint64 areaID = stamps.elementAt(i).getKey();
+
+		if (navMeshGenerations.containsKey(areaID) && navMeshGenerations.get(areaID) != stamps.elementAt(i).getValue())
+			return false;
+	}
+
+	return true;
+}
+
+Vector<WorldCoordinates>* PathCache::get(const WorldCoordinates& start, const WorldCoordinates& goal, uint64 zoneID) {
+	if (capacity <= 0)
+		return nullptr;
+
+	uint64 key = getKey(start, goal, zoneID);
+	Reference<PathCacheEntry*> entry;
+
+	{
+		Locker locker(&cacheMutex);
+
+		entry = tables[recentTable].get(key);
+
+		if (entry == nullptr) {
+			int oldTable = 1 - recentTable;
+
+			entry = tables[oldTable].get(key);
+
+			if (entry != nullptr) {
+				tables[oldTable].remove(key);
+
+				insert(key, entry);
+			}
+		}
+
+		if (entry != nullptr && !isCurrent(entry, start, goal, zoneID)) {
+			tables[recentTable].remove(key);
+
+			entry = nullptr;
+
+			invalidated.increment();
+		}
+	}
+
+	if (entry == nullptr) {
+		misses.increment();
+
+		return nullptr;
+	}
+
+	hits.increment();
+
+	Vector<WorldCoordinates>* path = new Vector<WorldCoordinates>(entry->getPath());
+
+	if (path->size() > 0 && path->get(0).getCell() == start.getCell())
+		path->set(0, start);
+
+	return path;
+}
+
+void PathCache::put(const WorldCoordinates& start, const WorldCoordinates& goal, uint64 zoneID, const Vector<WorldCoordinates>* path,
+		const VectorMap<uint64, uint32>& navMeshes, int updateCount) {
+	if (capacity <= 0 || path == nullptr || path->size() == 0)
+		return;
+
+	Locker locker(&cacheMutex);
+
+	// a mesh changed while the path was searched, its generation may already be the new one
+	if (navMeshUpdates.get() != updateCount)
+		return;
+
+	Reference<PathCacheEntry*> entry = new PathCacheEntry(*path, navMeshes, zoneGenerations.get(zoneID));
+
+	insert(getKey(start, goal, zoneID), entry);
+}
+
+void PathCache::notifyNavMeshUpdated(uint64 zoneID, uint64 areaID, uint32 generation, bool newArea) {
+	Locker locker(&cacheMutex);
+
+	navMeshGenerations.put(areaID, generation);
+
+	// world paths found before the area existed may cross it
+	if (newArea)
+		zoneGenerations.put(zoneID, zoneGenerations.get(zoneID) + 1);
+
+	navMeshUpdates.increment();
+}
+
+void PathCache::notifyNavMeshRemoved(uint64 areaID) {
+	Locker locker(&cacheMutex);
+
+	navMeshGenerations.put(areaID, 0);
+
+	navMeshUpdates.increment();
+}
+
+void PathCache::insert(uint64 key, PathCacheEntry* entry) {
+	HashTable<uint64, Reference<PathCacheEntry*> >& recent = tables[recentTable];
+
+	if (recent.size() >= capacity / 2 && !recent.containsKey(key)) {
+		recentTable = 1 - recentTable;
+
+		tables[recentTable].removeAll();
+	}
+
+	tables[recentTable].put(key, entry);
+}
+
+void PathCache::clear() {
+	Locker locker(&cacheMutex);
+
+	tables[0].removeAll();
+	tables[1].removeAll();
+}
+
+int PathCache::size() const {
+	Locker locker(&cacheMutex);
+
+	return tables[0].size() + tables[1].size();
+}
+
+String PathCache::getStatistics() const {
+	StringBuffer str;
+	str << size() << " paths cached, " << hits.get() << " hits, " << misses.get() << " misses, "
+		<< invalidated.get() << " invalidated by navmesh rebuilds";
+
+	return str.toString();
+}
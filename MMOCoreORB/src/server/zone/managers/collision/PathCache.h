@@ -0,0 +1,115 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef PATHCACHE_H_
+#define PATHCACHE_H_
+
+#include "engine/engine.h"
+#include "server/zone/objects/scene/WorldCoordinates.h"
+
+class PathCacheEntry : public Object {
+protected:
+	Vector<WorldCoordinates> path;
+
+	// nav area object id -> generation of its mesh when the path was found
+	VectorMap<uint64, uint32> navMeshGenerations;
+	uint32 zoneGeneration;
+
+public:
+	PathCacheEntry(const Vector<WorldCoordinates>& path, const VectorMap<uint64, uint32>& navMeshGenerations, uint32 zoneGeneration)
+		: path(path), navMeshGenerations(navMeshGenerations), zoneGeneration(zoneGeneration) {
+	}
+
+	const Vector<WorldCoordinates>& getPath() const {
+		return path;
+	}
+
+	const VectorMap<uint64, uint32>& getNavMeshGenerations() const {
+		return navMeshGenerations;
+	}
+
+	uint32 getZoneGeneration() const {
+		return zoneGeneration;
+	}
+};
+
+/**
+ * Bounded cache of found paths keyed by zone, start and goal cells and their positions on the
+ * path merge grid, so patrols, leashing and returns home stop solving the same path over and over.
+ *
+ * Paths touching the world are stamped with the generation of every nav area mesh along them and
+ * dropped once one of those meshes is rebuilt or removed, or once a new nav area appears in their
+ * zone. Rebuilds elsewhere leave them alone; paths between cells only depend on floor meshes,
+ * which never change.
+ * Entries live in two generations of tables: lookups promote from the old one, and when the recent
+ * one fills half the capacity the old one is dropped, so rarely used paths age out in O(1).
+ */
+class PathCache : public Object {
+	HashTable<uint64, Reference<PathCacheEntry*> > tables[2];
+	int recentTable;
+	int capacity;
+
+	mutable Mutex cacheMutex;
+
+	AtomicInteger hits;
+	AtomicInteger misses;
+	AtomicInteger invalidated;
+
+	// only meshes rebuilt or removed since they were loaded are tracked, 0 for a removed one
+	HashTable<uint64, uint32> navMeshGenerations;
+	HashTable<uint64, uint32> zoneGenerations;
+	AtomicInteger navMeshUpdates;
+
+	static uint64 getKey(const WorldCoordinates& start, const WorldCoordinates& goal, uint64 zoneID);
+
+	bool isCurrent(const PathCacheEntry* entry, const WorldCoordinates& start, const WorldCoordinates& goal, uint64 zoneID) const;
+
+	void insert(uint64 key, PathCacheEntry* entry);
+
+public:
+	PathCache(int capacity);
+
+	/**
+	 * Returns a copy of the cached path starting at the exact start position, nullptr on a miss.
+	 */
+	Vector<WorldCoordinates>* get(const WorldCoordinates& start, const WorldCoordinates& goal, uint64 zoneID);
+
+	/**
+	 * Caches a path found on the nav areas in navMeshes (object id -> mesh generation). updateCount
+	 * is getNavMeshUpdateCount() from before the search, the path isn't kept if a mesh changed since.
+	 */
+	void put(const WorldCoordinates& start, const WorldCoordinates& goal, uint64 zoneID, const Vector<WorldCoordinates>* path,
+			const VectorMap<uint64, uint32>& navMeshes, int updateCount);
+
+	/**
+	 * Called with the nav area locked once its mesh was replaced, newArea when it is the area's first mesh.
+	 */
+	void notifyNavMeshUpdated(uint64 zoneID, uint64 areaID, uint32 generation, bool newArea);
+
+	void notifyNavMeshRemoved(uint64 areaID);
+
+	int getNavMeshUpdateCount() const {
+		return navMeshUpdates.get();
+	}
+
+	void clear();
+
+	bool isEnabled() const {
+		return capacity > 0;
+	}
+
+	int size() const;
+
+	int getHits() const {
+		return hits.get();
+	}
+
+	int getMisses() const {
+		return misses.get();
+	}
+
+	String getStatistics() const;
+};
+
+#endif /* PATHCACHE_H_ */
@@ -15,17 +15,18 @@
 #include "server/zone/Zone.h"
 
 #include "CollisionManager.h"
+#include "NavQueryPool.h"
 #include "engine/util/u3d/Funnel.h"
 #include "engine/util/u3d/Segment.h"
 #include "pathfinding/recast/DetourCommon.h"
 
 const static constexpr int MAX_QUERY_NODES = 2048 * 2;
 
-void destroyNavMeshQuery(void* value) {
-	dtFreeNavMeshQuery(reinterpret_cast<dtNavMeshQuery*>(value));
+void destroyNavQueryPool(void* value) {
+	delete reinterpret_cast<NavQueryPool*>(value);
 }
 
-PathFinderManager::PathFinderManager() : Logger("PathFinderManager"), m_navQuery(destroyNavMeshQuery) {
+PathFinderManager::PathFinderManager() : Logger("PathFinderManager"), pathCache(ConfigManager::instance()->getPathCacheSize()), m_navQueries(destroyNavQueryPool) {
 	setFileLogger("log/pathfinder.log");
 	setLogJSON(ConfigManager::instance()->getPathfinderLogJSON());
 	setRotateLogSizeMB(ConfigManager::instance()->getRotateLogSizeMB());
@@ -60,20 +61,73 @@ Vector<WorldCoordinates>* PathFinderManager::findPath(const WorldCoordinates& po
 	if (std::isnan(pointB.getX()) || std::isnan(pointB.getY()) || std::isnan(pointB.getZ()))
 		return nullptr;
 
+	uint64 zoneID = zone != nullptr ? zone->getObjectID() : 0;
+
+	Vector<WorldCoordinates>* path = pathCache.get(pointA, pointB, zoneID);
+
+	if (path != nullptr)
+		return path;
+
+	int navMeshUpdates = pathCache.getNavMeshUpdateCount();
+
 	CellObject* cellA = pointA.getCell();
 	CellObject* cellB = pointB.getCell();
 
 	if (cellA == nullptr && cellB == nullptr) { // world -> world
-		return findPathFromWorldToWorld(pointA, pointB, zone);
+		path = findPathFromWorldToWorld(pointA, pointB, zone);
 	} else if (cellA != nullptr && cellB == nullptr) { // cell -> world
-		return findPathFromCellToWorld(pointA, pointB, zone);
+		path = findPathFromCellToWorld(pointA, pointB, zone);
 	} else if (cellA == nullptr && cellB != nullptr) { // world -> cell
-		return findPathFromWorldToCell(pointA, pointB, zone);
+		path = findPathFromWorldToCell(pointA, pointB, zone);
 	} else /* if (cellA != nullptr && cellB != nullptr) */ { // cell -> cell, the only left option
-		return findPathFromCellToCell(pointA, pointB);
+		path = findPathFromCellToCell(pointA, pointB);
+	}
+
+	if (path != nullptr && pathCache.isEnabled()) {
+		VectorMap<uint64, uint32> navMeshes;
+		getPathNavMeshes(path, zone, navMeshes);
+
+		pathCache.put(pointA, pointB, zoneID, path, navMeshes, navMeshUpdates);
+	}
+
+	return path;
+}
+
+void PathFinderManager::getPathNavMeshes(const Vector<WorldCoordinates>* path, Zone* zone, VectorMap<uint64, uint32>& navMeshes) {
+	if (zone == nullptr)
+		return;
+
+	SortedVector<ManagedReference<NavArea*> > areas;
+
+	for (int i = 0; i < path->size(); ++i) {
+		const WorldCoordinates& point = path->get(i);
+
+		if (point.getCell() == nullptr)
+			zone->getInRangeNavMeshes(point.getX(), point.getY(), &areas, true);
+	}
+
+	navMeshes.setAllowOverwriteInsertPlan();
+
+	for (const ManagedReference<NavArea*>& area : areas) {
+		ReadLocker rLocker(area);
+
+		RecastNavMesh* navMesh = area->getNavMesh();
+
+		// still being built, there is nothing to invalidate the path against yet
+		if (navMesh == nullptr)
+			continue;
+
+		navMeshes.put(area->getObjectID(), navMesh->getGeneration());
 	}
 }
 
+void PathFinderManager::findPathAsync(SceneObject* object, const WorldCoordinates& pointB, PathRequestCallback&& callback) {
+	Zone* zone = object->getZone();
+	String queue = zone != nullptr ? zone->getZoneName() : "";
+
+	PathRequestQueue::instance()->submit(WorldCoordinates(object), pointB, zone, queue, std::move(callback));
+}
+
 void PathFinderManager::filterPastPoints(Vector<WorldCoordinates>* path, SceneObject* object) {
 	Vector3 thisWorldPosition = object->getWorldPosition();
 	Vector3 thiswP = thisWorldPosition;
@@ -157,15 +211,15 @@ void PathFinderManager::getNavMeshCollisions(SortedVector<NavCollision*> *collis
 	}
 }
 
-dtNavMeshQuery* PathFinderManager::getNavQuery() {
-	dtNavMeshQuery* query = m_navQuery.get();
+dtNavMeshQuery* PathFinderManager::getNavQuery(RecastNavMesh* navMesh) {
+	NavQueryPool* pool = m_navQueries.get();
 
-	if (query == nullptr) {
-		query = dtAllocNavMeshQuery();
-		m_navQuery.set(query);
+	if (pool == nullptr) {
+		pool = new NavQueryPool(MAX_QUERY_NODES);
+		m_navQueries.set(pool);
 	}
 
-	return query;
+	return pool->getQuery(navMesh);
 }
 
 bool PathFinderManager::getRecastPath(const Vector3& start, const Vector3& end, NavArea* area, Vector<WorldCoordinates>* path, float& len, bool allowPartial) {
@@ -185,8 +239,6 @@ bool PathFinderManager::getRecastPath(const Vector3& start, const Vector3& end,
 
 	areaPos.setZ(area->getAreaTerrainHeight());
 
-	dtNavMeshQuery* query = getNavQuery();
-
 	ReadLocker rLocker(area);
 
 	RecastNavMesh* navMesh = area->getNavMesh();
@@ -197,7 +249,10 @@ bool PathFinderManager::getRecastPath(const Vector3& start, const Vector3& end,
 	// We need to flip the Y/Z axis and negate Z to put it in recasts model space
 	const Sphere sphere(Vector3(areaPos.getX(), areaPos.getZ(), -areaPos.getY()), area->getRadius());
 
-	query->init(navMesh->getNavMesh(), MAX_QUERY_NODES);
+	dtNavMeshQuery* query = getNavQuery(navMesh);
+
+	if (query == nullptr)
+		return false;
 
 	if (pointInSphere(targetPosition, sphere) || pointInSphere(startPosition, sphere)) {
 		Vector3 polyStart;
@@ -1057,8 +1112,6 @@ bool PathFinderManager::getSpawnPointInArea(const Sphere& area, Zone *zone, Vect
 	Vector3 flipped(center.getX(), center.getZ(), -center.getY());
 	const float extents[3] = {3, 5, 3};
 
-	dtNavMeshQuery* query = getNavQuery();
-
 	if (zone == nullptr)
 		return false;
 
@@ -1085,12 +1138,10 @@ bool PathFinderManager::getSpawnPointInArea(const Sphere& area, Zone *zone, Vect
 
 		ReadLocker rLocker(navArea);
 
-		dtNavMesh *dtNavMesh = mesh->getNavMesh();
-		if (dtNavMesh == nullptr)
+		dtNavMeshQuery* query = getNavQuery(mesh);
+		if (query == nullptr)
 			continue;
 
-		query->init(dtNavMesh, MAX_QUERY_NODES);
-
 		if (!((status = query->findNearestPoly(flipped.toFloatArray(), extents, &m_spawnFilter, &startPoly, polyStart.toFloatArray())) & DT_SUCCESS))
 			continue;
 
@@ -9,6 +9,8 @@
 #define PATHFINDERMANAGER_H_
 
 #include "server/zone/objects/scene/WorldCoordinates.h"
+#include "server/zone/managers/collision/PathRequestQueue.h"
+#include "server/zone/managers/collision/PathCache.h"
 #include "server/zone/objects/pathfinding/NavArea.h"
 #include "pathfinding/recast/DetourNavMeshQuery.h"
 
@@ -26,6 +28,7 @@ using namespace server::zone::objects::cell;
 
 class FloorMesh;
 class dtQueryFilter;
+class NavQueryPool;
 
 class NavCollision : public Object {
 protected:
@@ -55,8 +58,18 @@ public:
 
 	Vector<WorldCoordinates>* findPath(const WorldCoordinates& pointA, const WorldCoordinates& pointB, Zone* zone);
 
+	/**
+	 * Finds a path from object to pointB on the path worker queue, callback runs on the task queue
+	 * of the object's zone with the path or nullptr when there is none.
+	 */
+	void findPathAsync(SceneObject* object, const WorldCoordinates& pointB, PathRequestCallback&& callback);
+
 	void filterPastPoints(Vector<WorldCoordinates>* path, SceneObject* object);
 
+	PathCache* getPathCache() {
+		return &pathCache;
+	}
+
 	static Vector3 transformToModelSpace(const Vector3& point, SceneObject* building);
 	static const FloorMesh* getFloorMesh(CellObject* cell);
 
@@ -83,11 +96,15 @@ protected:
 	// The caller of this function is responsible for deleting the NavCollision objects.
 	// Collisions should be sorted from closest to farthest.
 	void getNavMeshCollisions(SortedVector<NavCollision*> *collisions, const SortedVector<ManagedReference<NavArea*>> *area, const Vector3& start, const Vector3& end);
-	dtNavMeshQuery* getNavQuery();
+	dtNavMeshQuery* getNavQuery(RecastNavMesh* navMesh);
+
+	// the nav areas with a mesh around the world points of path and their mesh generations
+	void getPathNavMeshes(const Vector<WorldCoordinates>* path, Zone* zone, VectorMap<uint64, uint32>& navMeshes);
 private:
+	PathCache pathCache;
 	dtQueryFilter m_filter;
 	dtQueryFilter m_spawnFilter;
-	ThreadLocal<dtNavMeshQuery*> m_navQuery;
+	ThreadLocal<NavQueryPool*> m_navQueries;
 };
 
 #endif /* PATHFINDERMANAGER_H_ */
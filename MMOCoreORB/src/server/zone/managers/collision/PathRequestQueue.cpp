@@ -0,0 +1,211 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "PathRequestQueue.h"
+#include "PathFinderManager.h"
+#include "server/zone/Zone.h"
+#include "conf/ConfigManager.h"
+
+#include <algorithm>
+
+namespace {
+	const char* PATH_QUEUE = "PathFinderQueue";
+
+	inline uint64 mixKey(uint64 hash, uint64 value) {
+		hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+
+		return hash;
+	}
+
+	inline uint64 hashCoordinates(uint64 hash, const WorldCoordinates& coords) {
+		const Vector3& point = coords.getPoint();
+		CellObject* cell = coords.getCell();
+
+		hash = mixKey(hash, (uint64) (int64) floorf(point.getX() / PathRequestQueue::PATH_MERGE_GRID));
+		hash = mixKey(hash, (uint64) (int64) floorf(point.getY() / PathRequestQueue::PATH_MERGE_GRID));
+		hash = mixKey(hash, (uint64) (int64) floorf(point.getZ() / PathRequestQueue::PATH_MERGE_GRID));
+
+		return mixKey(hash, cell != nullptr ? cell->getObjectID() : 0);
+	}
+}
+
+PathRequestQueue::PathRequestQueue() : Logger("PathRequestQueue") {
+	drainScheduled = false;
+	queueInitialized = false;
+	batchSize = Math::max(1, ConfigManager::instance()->getPathRequestBatchSize());
+
+	pending.setNoDuplicateInsertPlan();
+	running.setNoDuplicateInsertPlan();
+}
+
+uint64 PathRequestQueue::getRequestKey(const WorldCoordinates& start, const WorldCoordinates& goal) {
+	return hashCoordinates(hashCoordinates(0, start), goal);
+}
+
+void PathRequestQueue::submit(const WorldCoordinates& start, const WorldCoordinates& goal, Zone* zone, const String& callbackQueue, PathRequestCallback&& callback) {
+	Reference<PathRequestListener*> listener = new PathRequestListener(start, callbackQueue, std::move(callback));
+
+	if (zone == nullptr) {
+		deliver(listener, nullptr);
+		return;
+	}
+
+	enqueue(getRequestKey(start, goal) ^ zone->getObjectID(), start, goal, zone, listener);
+}
+
+void PathRequestQueue::enqueue(uint64 key, const WorldCoordinates& start, const WorldCoordinates& goal, Zone* zone, PathRequestListener* listener) {
+	requestCount.increment();
+
+	Locker locker(&queueMutex);
+
+	Reference<PathRequest*> request = pending.get(key);
+
+	if (request == nullptr)
+		request = running.get(key);
+
+	if (request != nullptr) {
+		request->addListener(listener);
+		mergedCount.increment();
+		return;
+	}
+
+	request = new PathRequest(key, start, goal, zone);
+	request->addListener(listener);
+
+	pending.put(key, request);
+
+	if (!drainScheduled)
+		scheduleDrain();
+}
+
+void PathRequestQueue::scheduleDrain() {
+	drainScheduled = true;
+
+	if (!queueInitialized) {
+		Core::getTaskManager()->initializeCustomQueue(PATH_QUEUE, Math::max(1, ConfigManager::instance()->getMaxPathfinderThreads()), false);
+
+		queueInitialized = true;
+	}
+
+	Core::getTaskManager()->executeTask([this] () {
+		drain();
+	}, "PathRequestDrain", PATH_QUEUE);
+}
+
+void PathRequestQueue::drain() {
+	Vector<Reference<PathRequest*> > batch;
+
+	{
+		Locker locker(&queueMutex);
+
+		int count = Math::min(batchSize, pending.size());
+
+		for (int i = 0; i < count; ++i) {
+			const Reference<PathRequest*>& request = pending.elementAt(i).getValue();
+
+			running.put(request->getKey(), request);
+			batch.add(request);
+		}
+
+		for (int i = count - 1; i >= 0; --i)
+			pending.remove(i);
+
+		// let another worker start on the rest while this one runs its batch
+		if (pending.size() > 0)
+			scheduleDrain();
+		else
+			drainScheduled = false;
+	}
+
+	// run the batch grouped by the nav area the searches start in
+	std::vector<PathRequest*> ordered;
+	ordered.reserve(batch.size());
+
+	for (int i = 0; i < batch.size(); ++i) {
+		PathRequest* request = batch.getUnsafe(i);
+		ManagedReference<Zone*> zone = request->getZone();
+
+		if (zone != nullptr && request->getStart().getCell() == nullptr) {
+			SortedVector<ManagedReference<NavArea*> > navAreas;
+			Vector3 position = request->getStart().getWorldPosition();
+
+			zone->getInRangeNavMeshes(position.getX(), position.getY(), &navAreas, true);
+
+			if (navAreas.size() > 0)
+				request->setNavAreaID(navAreas.getUnsafe(0)->getObjectID());
+		}
+
+		ordered.push_back(request);
+	}
+
+	std::stable_sort(ordered.begin(), ordered.end(), [] (const PathRequest* a, const PathRequest* b) {
+		return a->getNavAreaID() < b->getNavAreaID();
+	});
+
+	for (PathRequest* request : ordered)
+		process(request);
+}
+
+Reference<Vector<WorldCoordinates>*> PathRequestQueue::findPath(PathRequest* request) {
+	ManagedReference<Zone*> zone = request->getZone();
+
+	if (zone == nullptr)
+		return nullptr;
+
+	try {
+		return PathFinderManager::instance()->findPath(request->getStart(), request->getGoal(), zone);
+	} catch (const Exception& e) {
+		error() << "exception in path request: " << e.getMessage();
+	}
+
+	return nullptr;
+}
+
+void PathRequestQueue::process(PathRequest* request) {
+	Reference<Vector<WorldCoordinates>*> path = findPath(request);
+
+	searchCount.increment();
+
+	// no more listeners can join once it is out of running
+	{
+		Locker locker(&queueMutex);
+
+		running.drop(request->getKey());
+	}
+
+	const Vector<Reference<PathRequestListener*> >& listeners = request->getListeners();
+
+	for (int i = 0; i < listeners.size(); ++i)
+		deliver(listeners.getUnsafe(i), path);
+}
+
+void PathRequestQueue::deliver(PathRequestListener* listener, Vector<WorldCoordinates>* path) {
+	Reference<Vector<WorldCoordinates>*> result;
+
+	// every listener owns its copy, starting from where it actually stood
+	if (path != nullptr) {
+		result = new Vector<WorldCoordinates>(*path);
+
+		if (result->size() > 0 && result->get(0).getCell() == listener->getStart().getCell())
+			result->set(0, listener->getStart());
+	}
+
+	runCallback(listener, result);
+}
+
+void PathRequestQueue::runCallback(PathRequestListener* listener, const Reference<Vector<WorldCoordinates>*>& result) {
+	Reference<PathRequestListener*> strongListener = listener;
+
+	const String& queue = listener->getCallbackQueue();
+
+	if (queue.isEmpty()) {
+		Core::getTaskManager()->executeTask([strongListener, result] () {
+			strongListener->run(result);
+		}, "PathRequestCallback");
+	} else {
+		Core::getTaskManager()->executeTask([strongListener, result] () {
+			strongListener->run(result);
+		}, "PathRequestCallback", queue.toCharArray());
+	}
+}
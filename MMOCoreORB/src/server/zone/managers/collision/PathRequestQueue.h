@@ -0,0 +1,167 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef PATHREQUESTQUEUE_H_
+#define PATHREQUESTQUEUE_H_
+
+#include "engine/engine.h"
+#include "server/zone/objects/scene/WorldCoordinates.h"
+
+namespace server {
+ namespace zone {
+  class Zone;
+ }
+}
+
+using namespace server::zone;
+
+typedef Function<void(const Reference<Vector<WorldCoordinates>*>& path)> PathRequestCallback;
+
+class PathRequestListener : public Object {
+protected:
+	WorldCoordinates start;
+	String callbackQueue;
+	PathRequestCallback callback;
+
+public:
+	PathRequestListener(const WorldCoordinates& start, const String& queue, PathRequestCallback&& callback) :
+		start(start), callbackQueue(queue), callback(std::move(callback)) {
+	}
+
+	const WorldCoordinates& getStart() const {
+		return start;
+	}
+
+	const String& getCallbackQueue() const {
+		return callbackQueue;
+	}
+
+	void run(const Reference<Vector<WorldCoordinates>*>& path) {
+		callback(path);
+	}
+};
+
+class PathRequest : public Object {
+protected:
+	uint64 key;
+	uint64 navAreaID;
+
+	WorldCoordinates start;
+	WorldCoordinates goal;
+	ManagedWeakReference<Zone*> zone;
+
+	Vector<Reference<PathRequestListener*> > listeners;
+
+public:
+	PathRequest(uint64 key, const WorldCoordinates& start, const WorldCoordinates& goal, Zone* zone) :
+		key(key), navAreaID(0), start(start), goal(goal), zone(zone) {
+	}
+
+	uint64 getKey() const {
+		return key;
+	}
+
+	uint64 getNavAreaID() const {
+		return navAreaID;
+	}
+
+	void setNavAreaID(uint64 id) {
+		navAreaID = id;
+	}
+
+	const WorldCoordinates& getStart() const {
+		return start;
+	}
+
+	const WorldCoordinates& getGoal() const {
+		return goal;
+	}
+
+	ManagedReference<Zone*> getZone() const {
+		return zone.get();
+	}
+
+	void addListener(PathRequestListener* listener) {
+		listeners.add(listener);
+	}
+
+	const Vector<Reference<PathRequestListener*> >& getListeners() const {
+		return listeners;
+	}
+};
+
+/**
+ * Runs path requests off the caller's thread on a small worker queue and hands every result
+ * back to the task queue the request came from.
+ *
+ * Requests whose start and goal fall on the same PATH_MERGE_GRID cells, like a herd chasing one
+ * player, share a single search: a request arriving while an equal one is queued or running
+ * just waits for its result. Workers drain up to a batch of requests at a time and run them
+ * grouped by the nav area they start in, so consecutive searches reuse the same initialized
+ * dtNavMeshQuery.
+ */
+class PathRequestQueue : public Singleton<PathRequestQueue>, public Logger, public Object {
+	Mutex queueMutex;
+
+	VectorMap<uint64, Reference<PathRequest*> > pending;
+	VectorMap<uint64, Reference<PathRequest*> > running;
+
+	bool drainScheduled;
+	bool queueInitialized;
+	int batchSize;
+
+	AtomicInteger requestCount;
+	AtomicInteger mergedCount;
+	AtomicInteger searchCount;
+
+	void process(PathRequest* request);
+	void deliver(PathRequestListener* listener, Vector<WorldCoordinates>* path);
+
+protected:
+	/**
+	 * Adds listener to the request queued or running under key, or queues a new one.
+	 */
+	void enqueue(uint64 key, const WorldCoordinates& start, const WorldCoordinates& goal, Zone* zone, PathRequestListener* listener);
+
+	/**
+	 * Runs up to a batch of the pending requests.
+	 */
+	void drain();
+
+	/// Pre: queueMutex locked
+	virtual void scheduleDrain();
+
+	virtual Reference<Vector<WorldCoordinates>*> findPath(PathRequest* request);
+
+	virtual void runCallback(PathRequestListener* listener, const Reference<Vector<WorldCoordinates>*>& path);
+
+public:
+	static const constexpr float PATH_MERGE_GRID = 1.f;
+
+	PathRequestQueue();
+	virtual ~PathRequestQueue() {
+	}
+
+	/**
+	 * Queues a path search from start to goal, callback runs on callbackQueue (the default
+	 * task queue when empty) with the path or nullptr when there is none.
+	 */
+	void submit(const WorldCoordinates& start, const WorldCoordinates& goal, Zone* zone, const String& callbackQueue, PathRequestCallback&& callback);
+
+	static uint64 getRequestKey(const WorldCoordinates& start, const WorldCoordinates& goal);
+
+	int getRequestCount() const {
+		return requestCount.get();
+	}
+
+	int getMergedCount() const {
+		return mergedCount.get();
+	}
+
+	int getSearchCount() const {
+		return searchCount.get();
+	}
+};
+
+#endif /* PATHREQUESTQUEUE_H_ */
@@ -0,0 +1,70 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef ATTACKERCOMBATVALUES_H_
+#define ATTACKERCOMBATVALUES_H_
+
+#include "server/zone/objects/creature/CreatureObject.h"
+
+/**
+ * The attacker side of the hit chance and damage math for one attack. CombatManager resolves it
+ * once per doCombatAction and every defender an area or cone attack reaches shares it, only the
+ * defender side (defense, posture, toughness, armor) is still read per defender under its lock.
+ * The attacker posture modifier isn't kept, states applied to one defender can change it.
+ */
+class AttackerCombatValues {
+public:
+	// getHitChance: the command bonus plus the command accuracy skill mod, the skill mod alone
+	// for force attacks, the weapon accuracy mods, the private bonuses and private_aim
+	int accuracyBonus;
+	int commandAccuracy;
+	int attackerAccuracy;
+	int bonusAccuracy;
+	int creatureHitBonus;
+	int aimAccuracy;
+
+	// posture attackerAccuracy was resolved in, it includes the *_while_standing mods
+	int accuracyPosture;
+
+	// calculateDamage: the special attack damage with its frs and npc modifiers, or the weapon
+	// damage after the certification check
+	bool specialAttack;
+	float minDamage;
+	float maxDamage;
+
+	// the weapon and private damage skill mods: added, then multiplied and divided
+	float damageBonus;
+	int damageMultiplier;
+	int damageDivisor;
+
+	// players in combat spam range of the attacker when the attack started
+	Vector<ManagedReference<CreatureObject*> > spamReceivers;
+	bool spamReceiversCollected;
+
+	// combat actions broadcast, the attacker effect follows once for all of them. The attacker
+	// posture is only committed again when a defender's states changed it
+	int broadcasts;
+	int attackerPosture;
+	bool postureUpdated;
+
+	AttackerCombatValues() : accuracyBonus(0), commandAccuracy(0), attackerAccuracy(0), bonusAccuracy(0),
+			creatureHitBonus(0), aimAccuracy(0), accuracyPosture(0), specialAttack(false), minDamage(0), maxDamage(0),
+			damageBonus(0), damageMultiplier(0), damageDivisor(0), spamReceiversCollected(false), broadcasts(0),
+			attackerPosture(0), postureUpdated(false) {
+	}
+
+	float applyDamageModifiers(float damage) const {
+		damage += damageBonus;
+
+		if (damageMultiplier != 0)
+			damage *= damageMultiplier;
+
+		if (damageDivisor != 0)
+			damage /= damageDivisor;
+
+		return damage;
+	}
+};
+
+#endif /* ATTACKERCOMBATVALUES_H_ */
@@ -7,6 +7,7 @@
 
 #include "CombatManager.h"
 #include "CreatureAttackData.h"
+#include "AttackerCombatValues.h"
 #include "server/zone/objects/scene/variables/DeltaVector.h"
 #include "server/zone/objects/creature/CreatureObject.h"
 #include "server/zone/objects/player/PlayerObject.h"
@@ -201,9 +202,17 @@ int CombatManager::doCombatAction(CreatureObject* attacker, WeaponObject* weapon
 
 	debug("past special attack cost");
 
+	// the attacker side of the math and the spam receivers are the same for every defender
+	AttackerCombatValues attackerValues;
+	getAttackerCombatValues(attacker, weapon, data, attackerValues);
+	attackerValues.spamReceiversCollected = collectCombatSpamReceivers(attacker, attackerValues.spamReceivers);
+
+	CreatureAttackData attackData(data);
+	attackData.setAttackerValues(&attackerValues);
+
 	int damage = 0;
 	bool shouldGcwTef = false, shouldBhTef = false, shouldJediTef = false;
-	damage = doTargetCombatAction(attacker, weapon, defenderObject, data, &shouldGcwTef, &shouldBhTef, &shouldJediTef);
+	damage = doTargetCombatAction(attacker, weapon, defenderObject, attackData, &shouldGcwTef, &shouldBhTef, &shouldJediTef);
 
 	if (data.getCommand()->isAreaAction() || data.getCommand()->isConeAction()) {
 		Reference<SortedVector<ManagedReference<TangibleObject*> >* > areaDefenders = getAreaTargets(attacker, weapon, defenderObject, data);
@@ -220,7 +229,7 @@ int CombatManager::doCombatAction(CreatureObject* attacker, WeaponObject* weapon
 					continue;
 				}
 
-				damage += doTargetCombatAction(attacker, weapon, areaDefenders->get(i), data, &shouldGcwTef,
+				damage += doTargetCombatAction(attacker, weapon, areaDefenders->get(i), attackData, &shouldGcwTef,
 											   &shouldBhTef, &shouldJediTef);
 				areaDefenders->remove(i);
 
@@ -232,6 +241,10 @@ int CombatManager::doCombatAction(CreatureObject* attacker, WeaponObject* weapon
 		}
 	}
 
+	// once for the whole attack rather than once per defender
+	if (attackerValues.broadcasts > 0)
+		broadcastAttackerEffects(attacker, attackData);
+
 	if (damage > 0) {
 		attacker->updateLastSuccessfulCombatAction();
 
@@ -366,7 +379,10 @@ int CombatManager::doTargetCombatAction(CreatureObject* attacker, WeaponObject*
 	damageMultiplier = 1.0f;
 
 	if (!data.isStateOnlyAttack()) {
-		hitVal = getHitChance(attacker, defender, weapon, data, damage, data.getAccuracyBonus() + attacker->getSkillMod(data.getCommand()->getAccuracySkillMod()));
+		const AttackerCombatValues* values = data.getAttackerValues();
+		int accuracyBonus = values != nullptr ? values->accuracyBonus : data.getAccuracyBonus() + attacker->getSkillMod(data.getCommand()->getAccuracySkillMod());
+
+		hitVal = getHitChance(attacker, defender, weapon, data, damage, accuracyBonus);
 
 		//Send Attack Combat Spam. For state-only attacks, this is sent in applyStates().
 		data.getCommand()->sendAttackCombatSpam(attacker, defender, hitVal, damage, data);
@@ -895,8 +911,6 @@ float CombatManager::hitChanceEquation(float attackerAccuracy, float attackerRol
 }
 
 int CombatManager::calculateDamageRange(TangibleObject* attacker, CreatureObject* defender, WeaponObject* weapon) const {
-	int attackType = weapon->getAttackType();
-	int damageMitigation = 0;
 	float minDamage = weapon->getMinDamage(), maxDamage = weapon->getMaxDamage();
 
 	// restrict damage if a player is not certified (don't worry about mobs)
@@ -907,6 +921,13 @@ int CombatManager::calculateDamageRange(TangibleObject* attacker, CreatureObject
 
 	debug() << "attacker base damage is " << minDamage << "-" << maxDamage;
 
+	return calculateDamageRange(defender, weapon, minDamage, maxDamage);
+}
+
+int CombatManager::calculateDamageRange(CreatureObject* defender, WeaponObject* weapon, float minDamage, float maxDamage) const {
+	int attackType = weapon->getAttackType();
+	int damageMitigation = 0;
+
 	PlayerObject* defenderGhost = defender->getPlayerObject();
 
 	// this is for damage mitigation
@@ -941,36 +962,68 @@ int CombatManager::calculateDamageRange(TangibleObject* attacker, CreatureObject
 	return range < 0 ? 0 : (int)range;
 }
 
-float CombatManager::applyDamageModifiers(CreatureObject* attacker, WeaponObject* weapon, float damage, const CreatureAttackData& data) const {
+void CombatManager::getAttackerCombatValues(CreatureObject* attacker, WeaponObject* weapon, const CreatureAttackData& data, AttackerCombatValues& values) const {
+	values.attackerPosture = attacker->getPosture();
+	values.commandAccuracy = attacker->getSkillMod(data.getCommand()->getAccuracySkillMod());
+	values.accuracyBonus = data.getAccuracyBonus() + values.commandAccuracy;
+	values.attackerAccuracy = getAttackerAccuracyModifier(attacker, nullptr, weapon);
+	values.accuracyPosture = values.attackerPosture;
+	values.bonusAccuracy = getAttackerAccuracyBonus(attacker, weapon);
+	values.creatureHitBonus = attacker->getSkillMod("creature_hit_bonus");
+
+	// accounts for steadyaim, general aim, and specific weapon aim
+	if (weapon->getAttackType() == SharedWeaponObjectTemplate::RANGEDATTACK)
+		values.aimAccuracy = attacker->getSkillMod("private_aim");
+
+	values.specialAttack = data.getMinDamage() > 0 && data.getMaxDamage() > 0;
+
+	if (values.specialAttack) { // this is a special attack (force, etc)
+		float minDmg = data.getMinDamage();
+		float maxDmg = data.getMaxDamage();
+
+		if (data.isForceAttack() && attacker->isPlayerCreature())
+			getFrsModifiedForceAttackDamage(attacker, minDmg, maxDmg, data);
+
+		float mod = attacker->isAiAgent() ? cast<AiAgent*>(attacker)->getSpecialDamageMult() : 1.f;
+		values.minDamage = minDmg * mod;
+		values.maxDamage = maxDmg * mod;
+	} else {
+		values.minDamage = weapon->getMinDamage();
+		values.maxDamage = weapon->getMaxDamage();
+
+		// restrict damage if a player is not certified (don't worry about mobs)
+		if (attacker->isPlayerCreature() && !weapon->isCertifiedFor(attacker)) {
+			values.minDamage = 5.f;
+			values.maxDamage = 10.f;
+		}
+	}
+
+	float damageBonus = 0;
+
 	if (!data.isForceAttack()) {
 		const auto weaponDamageMods = weapon->getDamageModifiers();
 
 		for (int i = 0; i < weaponDamageMods->size(); ++i) {
-			damage += attacker->getSkillMod(weaponDamageMods->get(i));
+			damageBonus += attacker->getSkillMod(weaponDamageMods->get(i));
 		}
 
 		if (weapon->getAttackType() == SharedWeaponObjectTemplate::MELEEATTACK)
-			damage += attacker->getSkillMod("private_melee_damage_bonus");
+			damageBonus += attacker->getSkillMod("private_melee_damage_bonus");
 		if (weapon->getAttackType() == SharedWeaponObjectTemplate::RANGEDATTACK)
-			damage += attacker->getSkillMod("private_ranged_damage_bonus");
+			damageBonus += attacker->getSkillMod("private_ranged_damage_bonus");
 	}
 
-	damage += attacker->getSkillMod("private_damage_bonus");
-
-	int damageMultiplier = attacker->getSkillMod("private_damage_multiplier");
+	damageBonus += attacker->getSkillMod("private_damage_bonus");
 
-	if (damageMultiplier != 0)
-		damage *= damageMultiplier;
+	values.damageBonus = damageBonus;
+	values.damageMultiplier = attacker->getSkillMod("private_damage_multiplier");
 
 	int damageDivisor = attacker->getSkillMod("private_damage_divisor");
 
 	if (data.isForceAttack() && (attacker->hasSkill("frs_post9_dark_powers_04") || attacker->hasSkill("frs_post9_light_powers_04")))
 		damageDivisor = 0;
 
-	if (damageDivisor != 0)
-		damage /= damageDivisor;
-
-	return damage;
+	values.damageDivisor = damageDivisor;
 }
 
 int CombatManager::getSpeedModifier(CreatureObject* attacker, WeaponObject* weapon) const {
@@ -1286,35 +1339,21 @@ float CombatManager::getArmorPiercing(TangibleObject* defender, int armorPiercin
 }
 
 float CombatManager::calculateDamage(CreatureObject* attacker, WeaponObject* weapon, TangibleObject* defender, const CreatureAttackData& data) const {
-	float damage = 0;
-	int diff = 0;
-
-	if (data.getMinDamage() > 0 && data.getMaxDamage() > 0) { // this is a special attack (force, etc)
-		float minDmg = data.getMinDamage();
-		float maxDmg = data.getMaxDamage();
-
-		if (data.isForceAttack() && attacker->isPlayerCreature())
-			getFrsModifiedForceAttackDamage(attacker, minDmg, maxDmg, data);
-
-		float mod = attacker->isAiAgent() ? cast<AiAgent*>(attacker)->getSpecialDamageMult() : 1.f;
-		damage = minDmg * mod;
-		diff = (maxDmg * mod) - damage;
-	} else {
-		float minDamage = weapon->getMinDamage(), maxDamage = weapon->getMaxDamage();
-
-		if (attacker->isPlayerCreature() && !weapon->isCertifiedFor(attacker)) {
-			minDamage = 5.f;
-			maxDamage = 10.f;
-		}
+	const AttackerCombatValues* values = data.getAttackerValues();
+	AttackerCombatValues attackerValues;
 
-		damage = minDamage;
-		diff = maxDamage - minDamage;
+	if (values == nullptr) {
+		getAttackerCombatValues(attacker, weapon, data, attackerValues);
+		values = &attackerValues;
 	}
 
+	float damage = values->minDamage;
+	int diff = values->maxDamage - values->minDamage;
+
 	if (diff > 0)
 		damage += System::random(diff);
 
-	damage = applyDamageModifiers(attacker, weapon, damage, data);
+	damage = values->applyDamageModifiers(damage);
 
 	if (attacker->isPlayerCreature())
 		damage *= 1.5;
@@ -1467,33 +1506,26 @@ void CombatManager::getFrsModifiedForceAttackDamage(CreatureObject* attacker, fl
 }
 
 float CombatManager::calculateDamage(CreatureObject* attacker, WeaponObject* weapon, CreatureObject* defender, const CreatureAttackData& data) const {
-	float damage = 0;
-	int diff = 0;
+	const AttackerCombatValues* values = data.getAttackerValues();
+	AttackerCombatValues attackerValues;
 
-	if (data.getMinDamage() > 0 && data.getMaxDamage() > 0) { // this is a special attack (force, etc)
-		float minDmg = data.getMinDamage();
-		float maxDmg = data.getMaxDamage();
-
-		if (data.isForceAttack() && attacker->isPlayerCreature())
-			getFrsModifiedForceAttackDamage(attacker, minDmg, maxDmg, data);
-
-		float mod = attacker->isAiAgent() ? cast<AiAgent*>(attacker)->getSpecialDamageMult() : 1.f;
-		damage = minDmg * mod;
-		diff = (maxDmg * mod) - damage;
-	} else {
-		diff = calculateDamageRange(attacker, defender, weapon);
-		float minDamage = weapon->getMinDamage();
+	if (values == nullptr) {
+		getAttackerCombatValues(attacker, weapon, data, attackerValues);
+		values = &attackerValues;
+	}
 
-		if (attacker->isPlayerCreature() && !weapon->isCertifiedFor(attacker))
-			minDamage = 5;
+	float damage = values->minDamage;
+	int diff = 0;
 
-		damage = minDamage;
-	}
+	if (values->specialAttack) // this is a special attack (force, etc)
+		diff = values->maxDamage - values->minDamage;
+	else
+		diff = calculateDamageRange(defender, weapon, values->minDamage, values->maxDamage);
 
 	if (diff > 0)
 		damage += System::random(diff);
 
-	damage = applyDamageModifiers(attacker, weapon, damage, data);
+	damage = values->applyDamageModifiers(damage);
 
 	damage += defender->getSkillMod("private_damage_susceptibility");
 
@@ -1565,12 +1597,13 @@ int CombatManager::getHitChance(TangibleObject* attacker, CreatureObject* target
 	int hitChance = 0;
 	int attackType = weapon->getAttackType();
 	CreatureObject* creoAttacker = nullptr;
+	const AttackerCombatValues* values = data.getAttackerValues();
 
 	if (attacker->isCreatureObject()) {
 		creoAttacker = attacker->asCreatureObject();
 
 		if (creoAttacker != nullptr && data.isForceAttack()) {
-			int attackerAccuracy = creoAttacker->getSkillMod(data.getCommand()->getAccuracySkillMod());
+			int attackerAccuracy = values != nullptr ? values->commandAccuracy : creoAttacker->getSkillMod(data.getCommand()->getAccuracySkillMod());
 			int targetDefense = targetCreature->getSkillMod("force_defense");
 
 			float attackerRoll = (float)System::random(249) + 1.f;
@@ -1593,24 +1626,35 @@ int CombatManager::getHitChance(TangibleObject* attacker, CreatureObject* target
 	weaponAccuracy = getWeaponRangeModifier(attacker->getWorldPosition().distanceTo(targetCreature->getWorldPosition()) - targetCreature->getTemplateRadius() - attacker->getTemplateRadius(), weapon);
 	// accounts for steadyaim, general aim, and specific weapon aim, these buffs will clear after a completed combat action
 
-	if (creoAttacker != nullptr && weapon->getAttackType() == SharedWeaponObjectTemplate::RANGEDATTACK)
+	if (values != nullptr)
+		weaponAccuracy += values->aimAccuracy;
+	else if (creoAttacker != nullptr && weapon->getAttackType() == SharedWeaponObjectTemplate::RANGEDATTACK)
 		weaponAccuracy += creoAttacker->getSkillMod("private_aim");
 
 	debug() << "Attacker weapon accuracy is " << weaponAccuracy;
 
-	int attackerAccuracy = getAttackerAccuracyModifier(attacker, targetCreature, weapon);
+	int attackerAccuracy = 0;
+
+	// a defender's states may have changed the attacker posture since it was resolved
+	if (values != nullptr && (creoAttacker == nullptr || creoAttacker->getPosture() == values->accuracyPosture))
+		attackerAccuracy = values->attackerAccuracy;
+	else
+		attackerAccuracy = getAttackerAccuracyModifier(attacker, targetCreature, weapon);
+
 	debug() << "Base attacker accuracy is " << attackerAccuracy;
 
 	// need to also add in general attack accuracy (mostly gotten from posture and states)
 
 	int bonusAccuracy = 0;
 
-	if (creoAttacker != nullptr)
+	if (values != nullptr)
+		bonusAccuracy = values->bonusAccuracy;
+	else if (creoAttacker != nullptr)
 		bonusAccuracy = getAttackerAccuracyBonus(creoAttacker, weapon);
 
 	// this is the scout/ranger creature hit bonus that only works against creatures (not NPCS)
 	if (targetCreature->isCreature() && creoAttacker != nullptr)
-		bonusAccuracy += creoAttacker->getSkillMod("creature_hit_bonus");
+		bonusAccuracy += values != nullptr ? values->creatureHitBonus : creoAttacker->getSkillMod("creature_hit_bonus");
 
 	debug() << "Attacker total bonus is " << bonusAccuracy;
 
@@ -2242,14 +2286,10 @@ void CombatManager::sendMitigationCombatSpam(CreatureObject* defender, TangibleO
 	defender->sendMessage(spam);
 }
 
-void CombatManager::broadcastCombatSpam(TangibleObject* attacker, TangibleObject* defender, TangibleObject* item,
-		int damage, const String& file, const String& stringName, byte color) const {
-	if (attacker == nullptr)
-		return;
-
+bool CombatManager::collectCombatSpamReceivers(TangibleObject* attacker, Vector<ManagedReference<CreatureObject*> >& receivers) const {
 	Zone* zone = attacker->getZone();
 	if (zone == nullptr)
-		return;
+		return false;
 
 	CloseObjectsVector* vec = (CloseObjectsVector*) attacker->getCloseObjects();
 	SortedVector<QuadTreeEntry*> closeObjects;
@@ -2259,7 +2299,7 @@ void CombatManager::broadcastCombatSpam(TangibleObject* attacker, TangibleObject
 		vec->safeCopyReceiversTo(closeObjects, CloseObjectsVector::PLAYERTYPE);
 	} else {
 #ifdef COV_DEBUG
-		info("Null closeobjects vector in CombatManager::broadcastCombatSpam", true);
+		info("Null closeobjects vector in CombatManager::collectCombatSpamReceivers", true);
 #endif
 		zone->getInRangeObjects(attacker->getWorldPositionX(), attacker->getWorldPositionY(), COMBAT_SPAM_RANGE, &closeObjects, true);
 	}
@@ -2267,11 +2307,31 @@ void CombatManager::broadcastCombatSpam(TangibleObject* attacker, TangibleObject
 	for (int i = 0; i < closeObjects.size(); ++i) {
 		SceneObject* object = static_cast<SceneObject*>( closeObjects.get(i));
 
-		if (object->isPlayerCreature() && attacker->isInRange(object, COMBAT_SPAM_RANGE)) {
-			CreatureObject* receiver = static_cast<CreatureObject*>( object);
-			CombatSpam* spam = new CombatSpam(attacker, defender, receiver, item, damage, file, stringName, color);
-			receiver->sendMessage(spam);
-		}
+		if (object->isPlayerCreature() && attacker->isInRange(object, COMBAT_SPAM_RANGE))
+			receivers.add(static_cast<CreatureObject*>( object));
+	}
+
+	return true;
+}
+
+void CombatManager::broadcastCombatSpam(TangibleObject* attacker, TangibleObject* defender, TangibleObject* item,
+		int damage, const String& file, const String& stringName, byte color, const AttackerCombatValues* values) const {
+	if (attacker == nullptr)
+		return;
+
+	Vector<ManagedReference<CreatureObject*> > closeReceivers;
+	const Vector<ManagedReference<CreatureObject*> >* receivers = &closeReceivers;
+
+	// an area attack collects the receivers once for all of its defenders
+	if (values != nullptr && values->spamReceiversCollected)
+		receivers = &values->spamReceivers;
+	else if (!collectCombatSpamReceivers(attacker, closeReceivers))
+		return;
+
+	for (int i = 0; i < receivers->size(); ++i) {
+		CreatureObject* receiver = receivers->get(i);
+		CombatSpam* spam = new CombatSpam(attacker, defender, receiver, item, damage, file, stringName, color);
+		receiver->sendMessage(spam);
 	}
 }
 
@@ -2317,7 +2377,28 @@ void CombatManager::broadcastCombatAction(CreatureObject * attacker, TangibleObj
 		}
 	}
 
-	if(data.changesAttackerPosture())
+	AttackerCombatValues* values = data.getAttackerValues();
+
+	if (values == nullptr) {
+		broadcastAttackerEffects(attacker, data);
+		return;
+	}
+
+	// the next defender rolls with the new posture, everything else waits for the end of the attack
+	if (data.changesAttackerPosture() && attacker->getPosture() != values->attackerPosture) {
+		attacker->updatePostures(false);
+
+		values->attackerPosture = attacker->getPosture();
+		values->postureUpdated = true;
+	}
+
+	values->broadcasts++;
+}
+
+void CombatManager::broadcastAttackerEffects(CreatureObject* attacker, const CreatureAttackData& data) const {
+	const AttackerCombatValues* values = data.getAttackerValues();
+
+	if(data.changesAttackerPosture() && (values == nullptr || !values->postureUpdated))
 		attacker->updatePostures(false);
 
 	const String& effect = data.getCommand()->getEffectString();
@@ -14,6 +14,7 @@
 #include "server/zone/objects/tangible/wearables/ArmorObject.h"
 
 class CreatureAttackData;
+class AttackerCombatValues;
 class CombatQueueCommand;
 
 class CombatManager : public Singleton<CombatManager>, public Logger, public Object {
@@ -152,10 +153,22 @@ public:
 	float calculateWeaponAttackSpeed(CreatureObject* attacker, WeaponObject* weapon, float skillSpeedRatio) const;
 
 	void sendMitigationCombatSpam(CreatureObject* defender, TangibleObject* item, uint32 damage, int type) const;
-	void broadcastCombatSpam(TangibleObject* attacker, TangibleObject* defender, TangibleObject* item, int damage, const String& file, const String& stringName, byte color) const;
+	void broadcastCombatSpam(TangibleObject* attacker, TangibleObject* defender, TangibleObject* item, int damage, const String& file, const String& stringName, byte color, const AttackerCombatValues* values = nullptr) const;
+
+	/**
+	 * Players in combat spam range of the attacker
+	 * @return false when the attacker is not in a zone
+	 */
+	bool collectCombatSpamReceivers(TangibleObject* attacker, Vector<ManagedReference<CreatureObject*> >& receivers) const;
 
 	void broadcastCombatAction(CreatureObject* attacker, TangibleObject* defenderObject, WeaponObject* weapon, const CreatureAttackData& data, int damage, uint8 hit, uint8 hitLocation) const;
 
+	/**
+	 * Resolves the attacker skill mods and damage of an attack once so that every defender of an area attack can share them
+	 * @pre { attacker locked }
+	 */
+	void getAttackerCombatValues(CreatureObject* attacker, WeaponObject* weapon, const CreatureAttackData& data, AttackerCombatValues& values) const;
+
 	float hitChanceEquation(float attackerAccuracy, float attackerRoll, float targetDefense, float defenderRoll) const;
 	float doDroidDetonation(CreatureObject* droid, CreatureObject* defender, float damage) const;
 
@@ -190,7 +203,7 @@ protected:
 	int getDefenderSecondaryDefenseModifier(CreatureObject* defender) const;
 	float getDefenderToughnessModifier(CreatureObject* defender, int attackType, int damType, float damage) const;
 	int calculateDamageRange(TangibleObject* attacker, CreatureObject* defender, WeaponObject* weapon) const;
-	float applyDamageModifiers(CreatureObject* attacker, WeaponObject* weapon, float damage, const CreatureAttackData& data) const;
+	int calculateDamageRange(CreatureObject* defender, WeaponObject* weapon, float minDamage, float maxDamage) const;
 	int getSpeedModifier(CreatureObject* attacker, WeaponObject* weapon) const;
 	float calculateDamage(CreatureObject* attacker, WeaponObject* weapon, CreatureObject* defender, const CreatureAttackData& data) const;
 	float calculateDamage(TangibleObject* attacker, WeaponObject* weapon, CreatureObject* defender, const CreatureAttackData& data) const;
@@ -208,6 +221,7 @@ protected:
 	int applyDamage(CreatureObject* attacker, WeaponObject* weapon, TangibleObject* defender, int poolsToDamage, const CreatureAttackData& data) const;
 	int applyDamage(TangibleObject* attacker, WeaponObject* weapon, CreatureObject* defender, int damage, float damageMultiplier, int poolsToDamage, uint8& hitLocation, const CreatureAttackData& data) const;
 	void applyStates(CreatureObject* creature, CreatureObject* targetCreature, const CreatureAttackData& data) const;
+	void broadcastAttackerEffects(CreatureObject* attacker, const CreatureAttackData& data) const;
 
 	int doTargetCombatAction(TangibleObject* attacker, WeaponObject* weapon, CreatureObject* defenderObject, const CreatureAttackData& data) const;
 	int doTargetCombatAction(TangibleObject* attacker, WeaponObject* weapon, TangibleObject* tano, const CreatureAttackData& data) const;
@@ -11,6 +11,7 @@
 CreatureAttackData::CreatureAttackData(const UnicodeString& dataString, const CombatQueueCommand* base, uint64 target) {
 	targetID = target;
 	baseCommand = base;
+	attackerValues = nullptr;
 	fillFromBase();
 
 	StringTokenizer data(dataString.toString());
@@ -74,6 +75,8 @@ CreatureAttackData::CreatureAttackData(const CreatureAttackData& data) {
 	combatSpam = data.combatSpam;
 
 	stateAccuracyBonus = data.stateAccuracyBonus;
+
+	attackerValues = data.attackerValues;
 }
 
 void CreatureAttackData::fillFromBase() {
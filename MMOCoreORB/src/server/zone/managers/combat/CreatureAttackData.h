@@ -12,6 +12,7 @@
 #include "server/zone/objects/creature/commands/effect/DotEffect.h"
 
 class CombatQueueCommand;
+class AttackerCombatValues;
 
 class CreatureAttackData {
 protected:
@@ -58,6 +59,9 @@ protected:
 
 	int stateAccuracyBonus;
 
+	// resolved once per attack by CombatManager::doCombatAction, nullptr outside of it
+	AttackerCombatValues* attackerValues;
+
 public:
 	CreatureAttackData(const UnicodeString & dataString, const CombatQueueCommand *base, uint64 target);
 	CreatureAttackData(const CreatureAttackData& data);
@@ -237,6 +241,14 @@ public:
 		this->stateAccuracyBonus = stateAccuracyBonus;
 	}
 
+	AttackerCombatValues* getAttackerValues() const {
+		return attackerValues;
+	}
+
+	void setAttackerValues(AttackerCombatValues* values) {
+		attackerValues = values;
+	}
+
 	bool changesDefenderPosture() const;
 	bool changesAttackerPosture() const;
 };
@@ -0,0 +1,286 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "AiAwarenessBatch.h"
+#include "conf/ConfigManager.h"
+#include "server/zone/objects/creature/ai/AiAgent.h"
+
+#include <algorithm>
+#include <vector>
+
+AtomicInteger AiAwarenessBatch::checkedAgents;
+AtomicInteger AiAwarenessBatch::checkedTargets;
+AtomicInteger AiAwarenessBatch::skippedTargets;
+
+namespace {
+	const char* AWARENESS_QUEUE = "AiAwarenessQueue";
+
+	// below this many agents a pass is not worth splitting
+	const int MIN_CHUNK_SIZE = 32;
+
+	class AiAwarenessPassTask : public Task {
+		WeakReference<AiAwarenessBatch*> batch;
+
+	public:
+		AiAwarenessPassTask(AiAwarenessBatch* batch) : batch(batch) {
+		}
+
+		void run() {
+			Reference<AiAwarenessBatch*> strongBatch = batch.get();
+
+			if (strongBatch != nullptr)
+				strongBatch->runPass();
+		}
+	};
+}
+
+AiAwarenessRequest::AiAwarenessRequest(AiAgent* agent, uint64 dueTime) : agent(agent), dueTime(dueTime) {
+}
+
+AiAwarenessBatch::AiAwarenessBatch(const String& zoneName) : Logger("AiAwarenessBatch " + zoneName), zoneName(zoneName) {
+	ConfigManager* config = ConfigManager::instance();
+
+	interval = Math::max(100, config->getAiAwarenessInterval());
+	fullPassInterval = config->getAiAwarenessFullPass();
+	threads = config->getAiAwarenessThreads();
+
+	pending.setNoDuplicateInsertPlan();
+	pending.setNullValue(nullptr);
+
+	lastCounters.setNullValue(0xFFFFFFFF);
+	passCounters.setNullValue(0);
+
+	// the first pass of an agent is always a full one
+	pass = 1;
+}
+
+void AiAwarenessBatch::add(AiAgent* agent, uint64 delay) {
+	uint64 dueTime = getTime() + delay;
+
+	Locker locker(&pendingMutex);
+
+	AiAwarenessRequest* request = pending.get(agent->getObjectID());
+
+	if (request == nullptr)
+		pending.put(agent->getObjectID(), new AiAwarenessRequest(agent, dueTime));
+	else if (dueTime < request->dueTime)
+		request->dueTime = dueTime;
+
+	schedulePass();
+}
+
+void AiAwarenessBatch::schedulePass() {
+	if (passTask == nullptr) {
+		passTask = new AiAwarenessPassTask(this);
+
+		if (threads > 0) {
+			static bool queueInitialized = [this] () {
+				Core::getTaskManager()->initializeCustomQueue(AWARENESS_QUEUE, threads, false);
+				return true;
+			} ();
+
+			(void) queueInitialized;
+
+			passTask->setCustomTaskQueue(AWARENESS_QUEUE);
+		} else {
+			passTask->setCustomTaskQueue(zoneName);
+		}
+	}
+
+	if (!passTask->isScheduled())
+		passTask->schedule(interval);
+}
+
+void AiAwarenessBatch::runPass() {
+	Vector<ManagedReference<AiAgent*> > agents;
+
+	{
+		Locker locker(&pendingMutex);
+
+		// the chunks of the previous pass are still checking, everything waits for the next pass
+		if (runningChunks.get() > 0) {
+			if (pending.size() > 0)
+				schedulePass();
+
+			return;
+		}
+
+		// agents due closer to this pass than to the next one are checked now
+		takeDueRequests(getTime() + interval / 2, agents);
+
+		if (pending.size() > 0)
+			schedulePass();
+	}
+
+	if (agents.size() == 0)
+		return;
+
+	startPass();
+
+	// neighbours share close objects, checking them back to back keeps those warm
+	std::vector<std::pair<uint32, int> > order;
+	order.reserve(agents.size());
+
+	for (int i = 0; i < agents.size(); ++i) {
+		AiAgent* agent = agents.getUnsafe(i);
+
+		order.emplace_back(getCellKey(agent->getWorldPositionX(), agent->getWorldPositionY()), i);
+	}
+
+	std::sort(order.begin(), order.end());
+
+	Vector<ManagedReference<AiAgent*> > sorted(agents.size(), 1);
+
+	for (const auto& entry : order)
+		sorted.add(agents.getUnsafe(entry.second));
+
+	checkedAgents.add(sorted.size());
+
+	int chunks = threads > 0 ? Math::min(threads, sorted.size() / MIN_CHUNK_SIZE) : 0;
+
+	if (chunks <= 1) {
+		checkAgents(sorted, 0, sorted.size());
+
+		return;
+	}
+
+	// split on cell boundaries so no cell is checked from two workers
+	Vector<uint32> cellKeys(sorted.size(), 1);
+
+	for (const auto& entry : order)
+		cellKeys.add(entry.first);
+
+	Vector<int> ends;
+	splitChunks(cellKeys, chunks, ends);
+
+	Reference<Vector<ManagedReference<AiAgent*> >*> shared = new Vector<ManagedReference<AiAgent*> >(sorted);
+	int start = 0;
+
+	for (int i = 0; i < ends.size(); ++i) {
+		int end = ends.get(i);
+
+		runningChunks.increment();
+
+		Reference<AiAwarenessBatch*> batch = this;
+
+		Core::getTaskManager()->executeTask([batch, shared, start, end] () {
+			checkAgents(*shared, start, end);
+
+			batch->runningChunks.decrement();
+		}, "AiAwarenessChunkLambda", AWARENESS_QUEUE);
+
+		start = end;
+	}
+}
+
+int AiAwarenessBatch::takeDueRequests(uint64 passTime, Vector<ManagedReference<AiAgent*> >& agents) {
+	int taken = 0;
+
+	for (int i = 0; i < pending.size(); ++i) {
+		AiAwarenessRequest* request = pending.elementAt(i).getValue();
+
+		if (request->dueTime > passTime)
+			continue;
+
+		ManagedReference<AiAgent*> agent = request->agent.get();
+
+		if (agent != nullptr)
+			agents.add(agent);
+
+		pending.remove(i--);
+		++taken;
+	}
+
+	return taken;
+}
+
+void AiAwarenessBatch::startPass() {
+	Locker locker(&moversMutex);
+
+	lastCounters.removeAll();
+
+	HashTableIterator<uint64, uint64> iterator = passCounters.iterator();
+
+	while (iterator.hasNext()) {
+		uint64 key;
+		uint64 value;
+
+		iterator.getNextKeyAndValue(key, value);
+
+		lastCounters.put(key, (uint32) value);
+	}
+
+	passCounters.removeAll();
+
+	++pass;
+}
+
+void AiAwarenessBatch::splitChunks(const Vector<uint32>& cellKeys, int chunks, Vector<int>& ends) {
+	int size = cellKeys.size();
+	int start = 0;
+
+	for (int c = 1; c <= chunks && start < size; ++c) {
+		int end = c == chunks ? size : (size * c) / chunks;
+
+		while (end < size && end > start && cellKeys.get(end) == cellKeys.get(end - 1))
+			++end;
+
+		if (end <= start)
+			continue;
+
+		ends.add(end);
+
+		start = end;
+	}
+}
+
+void AiAwarenessBatch::checkAgents(const Vector<ManagedReference<AiAgent*> >& agents, int start, int end) {
+	for (int i = start; i < end; ++i) {
+		AiAgent* agent = agents.getUnsafe(i);
+
+		Locker locker(agent);
+
+		agent->doAwarenessCheck();
+	}
+}
+
+bool AiAwarenessBatch::hasMoved(SceneObject* object) {
+	uint64 objectID = object->getObjectID();
+
+	Locker locker(&moversMutex);
+
+	uint64 entry = passCounters.get(objectID);
+
+	if (entry != 0)
+		return (entry >> 32) & 1;
+
+	uint32 counter = object->getMovementCounter();
+	bool moved = lastCounters.get(objectID) != counter;
+
+	// bit 33 keeps entries of unmoved creatures with counter 0 apart from missing ones
+	passCounters.put(objectID, (uint64) counter | ((uint64) moved << 32) | (1ull << 33));
+
+	return moved;
+}
+
+int AiAwarenessBatch::getPendingCount() {
+	Locker locker(&pendingMutex);
+
+	return pending.size();
+}
+
+uint32 AiAwarenessBatch::getCellKey(float x, float y) {
+	uint32 cellX = (uint32) Math::min(Math::max(0, (int) ((x + 8192.f) / CELLSIZE)), 0xFFFF);
+	uint32 cellY = (uint32) Math::min(Math::max(0, (int) ((y + 8192.f) / CELLSIZE)), 0xFFFF);
+
+	return (cellY << 16) | cellX;
+}
+
+String AiAwarenessBatch::getStatistics() {
+	StringBuffer str;
+	str << "AI awareness: " << checkedAgents.get() << " agents checked in batches, " << checkedTargets.get()
+		<< " targets checked, " << skippedTargets.get() << " skipped as not moved";
+
+	return str.toString();
+}
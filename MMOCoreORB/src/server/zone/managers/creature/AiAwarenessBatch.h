@@ -0,0 +1,139 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef AIAWARENESSBATCH_H_
+#define AIAWARENESSBATCH_H_
+
+#include "engine/engine.h"
+
+namespace server {
+namespace zone {
+namespace objects {
+namespace scene {
+	class SceneObject;
+}
+
+namespace creature {
+namespace ai {
+	class AiAgent;
+}
+}
+}
+}
+}
+
+using namespace server::zone::objects::scene;
+using namespace server::zone::objects::creature::ai;
+
+class AiAwarenessRequest : public Object {
+public:
+	ManagedWeakReference<AiAgent*> agent;
+	uint64 dueTime;
+
+	AiAwarenessRequest(AiAgent* agent, uint64 dueTime);
+};
+
+/**
+ * Awareness checks of all the agents of a zone, run together once per pass instead of an
+ * AiAwarenessEvent per agent.
+ *
+ * Agents asking for an awareness check are queued until the pass closest to the delay they asked
+ * for, which sorts them by map cell so neighbours are checked back to back and splits the cells
+ * over the Core3.AiAwarenessThreads workers of the AiAwarenessQueue. With no threads the passes
+ * run on the zone queue. The pass also tracks which creatures moved since the previous one, so an
+ * agent that did not move itself only runs the aggro, flee and follow logic against the creatures
+ * around it that did. Changes that are not movement (faction, pvp status, invisibility) are only
+ * seen on the full passes, every Core3.AiAwarenessFullPass passes, so they can take up to that
+ * many intervals to make an idle agent react.
+ */
+class AiAwarenessBatch : public Object, public Logger {
+protected:
+	String zoneName;
+
+	int interval;
+	int fullPassInterval;
+	int threads;
+
+	VectorMap<uint64, Reference<AiAwarenessRequest*> > pending;
+	Reference<Task*> passTask;
+	Mutex pendingMutex;
+
+	// movement counters seen in the previous pass, and in this one with the moved flag on bit 32
+	HashTable<uint64, uint32> lastCounters;
+	HashTable<uint64, uint64> passCounters;
+	Mutex moversMutex;
+
+	uint32 pass;
+	AtomicInteger runningChunks;
+
+	static AtomicInteger checkedAgents;
+	static AtomicInteger checkedTargets;
+	static AtomicInteger skippedTargets;
+
+	static void checkAgents(const Vector<ManagedReference<AiAgent*> >& agents, int start, int end);
+
+	virtual void schedulePass();
+
+	virtual uint64 getTime() {
+		return System::getMiliTime();
+	}
+
+	/**
+	 * Removes the requests due at or before passTime from the queue and adds their agents, with
+	 * pendingMutex locked.
+	 * @return number of requests removed, including the ones of agents already gone
+	 */
+	int takeDueRequests(uint64 passTime, Vector<ManagedReference<AiAgent*> >& agents);
+
+	/**
+	 * Makes the movement counters seen in the current pass the ones hasMoved compares against.
+	 */
+	void startPass();
+
+public:
+	const static int CELLSIZE = 64;
+
+	AiAwarenessBatch(const String& zoneName);
+
+	/**
+	 * Queues the agent for the pass closest to delay from now, or moves it to an earlier one if
+	 * it already is queued.
+	 */
+	void add(AiAgent* agent, uint64 delay);
+
+	void runPass();
+
+	/**
+	 * Whether the creature moved since the previous pass. Creatures nobody looked at in the
+	 * previous pass count as moved.
+	 */
+	bool hasMoved(SceneObject* object);
+
+	bool isFullPass() const {
+		return fullPassInterval <= 1 || pass % fullPassInterval == 0;
+	}
+
+	uint32 getPass() const {
+		return pass;
+	}
+
+	int getPendingCount();
+
+	static void countTargets(int checked, int skipped) {
+		checkedTargets.add(checked);
+		skippedTargets.add(skipped);
+	}
+
+	static String getStatistics();
+
+	static uint32 getCellKey(float x, float y);
+
+	/**
+	 * Splits the sorted cell keys of a pass in about chunks even parts without splitting a cell.
+	 * @param ends receives the index after the last agent of each part
+	 */
+	static void splitChunks(const Vector<uint32>& cellKeys, int chunks, Vector<int>& ends);
+};
+
+#endif /* AIAWARENESSBATCH_H_ */
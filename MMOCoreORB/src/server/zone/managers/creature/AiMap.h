@@ -18,8 +18,10 @@
 #include "server/zone/objects/creature/ai/bt/ParallelSequenceBehavior.h"
 #include "server/zone/objects/creature/ai/bt/ParallelSelectorBehavior.h"
 #include "server/zone/objects/creature/ai/bt/LuaBehavior.h"
+#include "server/zone/objects/creature/ai/bt/NativeBehavior.h"
 #include "templates/params/creature/CreatureFlag.h"
 #include "server/zone/managers/creature/PetManager.h"
+#include "server/zone/managers/director/LuaBytecodeCache.h"
 
 class AiMap : public Singleton<AiMap>, public Logger, public Object {
 public:
@@ -89,7 +91,7 @@ public:
 		if (DEBUG_MODE)
 			info("Initializing...", true);
 
-		lua->runFile("scripts/ai/ais.lua");
+		LuaBytecodeCache::runFile("scripts/ai/ais.lua", lua->getLuaState());
 	}
 
 	void loadTemplates(Lua* lua) {
@@ -101,7 +103,7 @@ public:
 		if (DEBUG_MODE)
 			info("Loading templates...", true);
 
-		lua->runFile("scripts/ai/templates/templates.lua");
+		LuaBytecodeCache::runFile("scripts/ai/templates/templates.lua", lua->getLuaState());
 
 		Locker locker(&guard);
 
@@ -173,6 +175,7 @@ private:
 	void registerFunctions(Lua* lua) {
 		lua->registerFunction("addAiTemplate", addAiTemplate);
 		lua->registerFunction("addAiBehavior", addAiBehavior);
+		lua->registerFunction("addNativeAiBehavior", addNativeAiBehavior);
 		lua->registerFunction("includeAiFile", includeFile);
 	}
 
@@ -269,7 +272,7 @@ private:
 		if (DEBUG_MODE)
 			AiMap::instance()->info("Including file: " + filename, true);
 
-		Lua::runFile("scripts/ai/" + filename, L);
+		LuaBytecodeCache::runFile("scripts/ai/" + filename, L);
 
 		return 0;
 	}
@@ -310,6 +313,30 @@ private:
 		return 0;
 	}
 
+	/**
+	 * addNativeAiBehavior(name, node, interruptClass) registers the C++ node
+	 * as behavior name, forwarding interrupts to the lua interruptClass.
+	 */
+	static int addNativeAiBehavior(lua_State* L) {
+		String interruptClass = lua_tostring(L, -1);
+		String node = lua_tostring(L, -2);
+		String name = lua_tostring(L, -3);
+
+		Reference<LuaBehavior*> b = NativeBehavior::createNativeBehavior(node, name, interruptClass);
+
+		if (b == nullptr) {
+			AiMap::instance()->error("Native AI behavior not found: " + node);
+			return 0;
+		}
+
+		AiMap::instance()->putBehavior(name, b);
+
+		if (DEBUG_MODE)
+			AiMap::instance()->info("Loaded native AI behavior " + name + " (" + node + ", " + interruptClass + ")", true);
+
+		return 0;
+	}
+
 public:
 	static Behavior* createNewInstance(AiAgent* _agent, const String& _name, uint16 _type) {
 		Behavior* newBehavior;
@@ -0,0 +1,137 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "AiTickScheduler.h"
+#include "conf/ConfigManager.h"
+
+AiTickScheduler::AiTickScheduler() : Logger("AiTickScheduler") {
+	ConfigManager* config = ConfigManager::instance();
+
+	enabled = config->getAiTickLod();
+
+	multipliers[FULL] = 1;
+	multipliers[SLOW] = Math::max(1, config->getAiSlowTickMultiplier());
+	multipliers[DORMANT] = Math::max(1, config->getAiDormantTickMultiplier());
+
+	maxDeferral = Math::max(0, config->getAiTickMaxDeferral());
+
+	zoneBudgets.setNullValue(nullptr);
+
+	windowStart.set(System::getMiliTime());
+}
+
+AiTickBudget* AiTickScheduler::getZoneBudget(const String& zoneName) {
+	ReadLocker readLocker(&zoneBudgetsLock);
+
+	AiTickBudget* budget = zoneBudgets.get(zoneName);
+
+	if (budget != nullptr)
+		return budget;
+
+	readLocker.release();
+
+	Locker locker(&zoneBudgetsLock);
+
+	budget = zoneBudgets.get(zoneName);
+
+	if (budget == nullptr) {
+		budget = new AiTickBudget(ConfigManager::instance()->getAiTickBudget(zoneName));
+
+		zoneBudgets.put(zoneName, budget);
+	}
+
+	return budget;
+}
+
+void AiTickScheduler::advanceWindow(uint64 now) {
+	uint64 start = windowStart.get();
+
+	if (now - start < 1000 || !windowStart.compareAndSet(start, now))
+		return;
+
+	// an idle gap of several seconds leaves nothing for the seconds in between
+	bool lastSecond = now - start < 2000;
+
+	for (int i = 0; i < LODCOUNT; ++i) {
+		int ticks;
+
+		do {
+			ticks = windowTicks[i].get();
+		} while (!windowTicks[i].compareAndSet(ticks, 0));
+
+		lastTicks[i].set(lastSecond ? ticks : 0);
+	}
+}
+
+uint64 AiTickScheduler::scheduleTick(const String& zoneName, int lod, uint64 delay) {
+	return scheduleTick(zoneName, lod, delay, System::getMiliTime());
+}
+
+uint64 AiTickScheduler::scheduleTick(const String& zoneName, int lod, uint64 delay, uint64 now) {
+	if (lod < 0 || lod >= LODCOUNT)
+		lod = FULL;
+
+	advanceWindow(now);
+
+	windowTicks[lod].increment();
+
+	if (!enabled || lod == FULL)
+		return delay;
+
+	AiTickBudget* budget = getZoneBudget(zoneName);
+
+	if (budget->budget <= 0)
+		return delay;
+
+	Locker locker(&budget->mutex);
+
+	if (now - budget->windowStart >= 1000) {
+		budget->windowStart = now;
+		budget->scheduledTicks = 0;
+	}
+
+	int overflow = budget->scheduledTicks++ / budget->budget;
+
+	locker.release();
+
+	if (overflow == 0)
+		return delay;
+
+	deferredTicks.increment();
+
+	// a zone far over its budget keeps the agents ticking every few seconds instead of stalling them
+	return delay + Math::min((uint64) overflow * 1000, (uint64) maxDeferral);
+}
+
+int AiTickScheduler::getTicksPerSecond(int lod) {
+	if (System::getMiliTime() - windowStart.get() >= 2000)
+		return 0;
+
+	return lastTicks[lod].get();
+}
+
+String AiTickScheduler::getStatistics() {
+	StringBuffer str;
+	str << "AI ticks per second:";
+
+	for (int i = 0; i < LODCOUNT; ++i)
+		str << " " << getLodName(i) << " " << getTicksPerSecond(i) << (i < LODCOUNT - 1 ? "," : "");
+
+	str << " (" << deferredTicks.get() << " deferred by zone budgets)";
+
+	return str.toString();
+}
+
+const char* AiTickScheduler::getLodName(int lod) {
+	switch (lod) {
+	case FULL:
+		return "full";
+	case SLOW:
+		return "slow";
+	case DORMANT:
+		return "dormant";
+	default:
+		return "invalid";
+	}
+}
@@ -0,0 +1,96 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef AITICKSCHEDULER_H_
+#define AITICKSCHEDULER_H_
+
+#include "engine/engine.h"
+
+class AiTickBudget : public Object {
+public:
+	int budget;
+
+	uint64 windowStart;
+	int scheduledTicks;
+
+	// only the move events of this zone take it
+	Mutex mutex;
+
+	AiTickBudget(int budget) : budget(budget), windowStart(0), scheduledTicks(0) {
+	}
+};
+
+/**
+ * Level of detail for the AI recovery and movement ticks.
+ *
+ * Agents with players in range (or in combat) tick at full rate. Agents nobody can see but still
+ * busy following or retreating tick SLOW times less often and move proportionally further per
+ * tick, and idle agents only left with recovery tick DORMANT times less often. On top of that every
+ * zone can cap the ticks per second of the throttled agents, the overflow is spread over the next
+ * seconds up to the maximum deferral.
+ */
+class AiTickScheduler : public Singleton<AiTickScheduler>, public Logger, public Object {
+public:
+	enum {
+		FULL,
+		SLOW,
+		DORMANT,
+		LODCOUNT
+	};
+
+protected:
+	bool enabled;
+	int multipliers[LODCOUNT];
+	int maxDeferral;
+
+	HashTable<String, Reference<AiTickBudget*> > zoneBudgets;
+	ReadWriteLock zoneBudgetsLock;
+
+	// ticks per level scheduled in the current and in the last complete second
+	AtomicLong windowStart;
+	AtomicInteger windowTicks[LODCOUNT];
+	AtomicInteger lastTicks[LODCOUNT];
+
+	AtomicInteger deferredTicks;
+
+	void advanceWindow(uint64 now);
+
+	AiTickBudget* getZoneBudget(const String& zoneName);
+
+public:
+	AiTickScheduler();
+
+	/**
+	 * How many times longer than at full rate an agent waits between ticks at this level.
+	 */
+	int getMultiplier(int lod) const {
+		if (!enabled || lod < 0 || lod >= LODCOUNT)
+			return 1;
+
+		return multipliers[lod];
+	}
+
+	/**
+	 * Accounts a tick of an agent at this level and returns the delay to schedule it with, deferred
+	 * when the throttled ticks of the zone are over its budget for the second.
+	 */
+	uint64 scheduleTick(const String& zoneName, int lod, uint64 delay);
+
+	/**
+	 * Same, accounting the tick in the second of now (msec)
+	 */
+	uint64 scheduleTick(const String& zoneName, int lod, uint64 delay, uint64 now);
+
+	int getTicksPerSecond(int lod);
+
+	int getDeferredTicks() const {
+		return deferredTicks.get();
+	}
+
+	String getStatistics();
+
+	static const char* getLodName(int lod);
+};
+
+#endif /* AITICKSCHEDULER_H_ */
@@ -6,6 +6,7 @@
  */
 
 #include "DirectorManager.h"
+#include "LuaBytecodeCache.h"
 #include "server/zone/objects/cell/CellObject.h"
 #include "server/zone/objects/creature/LuaCreatureObject.h"
 #include "server/zone/objects/scene/LuaSceneObject.h"
@@ -631,7 +632,7 @@ int DirectorManager::loadScreenPlays(Lua* luaEngine) {
 	Timer loadTimer;
 	loadTimer.start();
 
-	bool res = luaEngine->runFile("scripts/screenplays/screenplays.lua");
+	bool res = LuaBytecodeCache::runFile("scripts/screenplays/screenplays.lua", luaEngine->getLuaState());
 
 	if (!DEBUG_MODE) {
 		auto elapsed = loadTimer.stopMs();
@@ -642,6 +643,8 @@ int DirectorManager::loadScreenPlays(Lua* luaEngine) {
 			<< " screenplays in "
 			<< elapsed
 			<< " ms.";
+
+		debug() << "bytecode cache: " << LuaBytecodeCache::instance()->getStatistics();
 	}
 
 	if (!res)
@@ -954,7 +957,7 @@ int DirectorManager::includeFile(lua_State* L) {
 
 	int oldError = ERROR_CODE;
 
-	bool ret = Lua::runFile("scripts/screenplays/" + filename, L);
+	bool ret = LuaBytecodeCache::runFile("scripts/screenplays/" + filename, L);
 
 	if (!ret) {
 		ERROR_CODE = GENERAL_ERROR;
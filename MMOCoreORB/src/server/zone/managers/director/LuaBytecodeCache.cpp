@@ -0,0 +1,286 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "LuaBytecodeCache.h"
+#include "conf/ConfigManager.h"
+
+#include <string>
+#include <cstdio>
+#include <cerrno>
+#include <sys/stat.h>
+
+namespace {
+	struct DiskCacheHeader {
+		uint32 magic;
+		uint32 luaVersion;
+		uint64 sourceSize;
+		uint64 sourceHash;
+		uint32 dataSize;
+	};
+
+	bool readSource(const String& path, std::string& source) {
+		FILE* file = fopen(path.toCharArray(), "rb");
+
+		if (file == nullptr)
+			return false;
+
+		char buffer[8192];
+		size_t read = 0;
+
+		while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+			source.append(buffer, read);
+
+		bool res = ferror(file) == 0;
+
+		fclose(file);
+
+		return res;
+	}
+}
+
+LuaBytecodeCache::LuaBytecodeCache() : Logger("LuaBytecodeCache") {
+	chunks.setNullValue(nullptr);
+
+	enabled = ConfigManager::instance()->getLuaBytecodeCache();
+	diskCachePath = ConfigManager::instance()->getLuaBytecodeCachePath();
+
+	if (enabled && !diskCachePath.isEmpty()) {
+		if (mkdir(diskCachePath.toCharArray(), 0755) != 0 && errno != EEXIST) {
+			error() << "could not create disk cache directory " << diskCachePath << ", keeping bytecode in memory only";
+
+			diskCachePath = "";
+		}
+	}
+}
+
+bool LuaBytecodeCache::runFile(const String& path, lua_State* L) {
+	LuaBytecodeCache* cache = instance();
+
+	if (!cache->isEnabled())
+		return Lua::runFile(path, L);
+
+	int status = cache->loadFile(path, L);
+
+	if (status == LUA_OK)
+		status = lua_pcall(L, 0, 0, 0);
+
+	if (status != LUA_OK) {
+		cache->error() << "running file " << path << ": " << lua_tostring(L, -1);
+
+		lua_pop(L, 1);
+
+		return false;
+	}
+
+	return true;
+}
+
+int LuaBytecodeCache::loadFile(const String& path, lua_State* L) {
+	std::string source;
+
+	// let lua report the missing file
+	if (!readSource(path, source))
+		return luaL_loadfilex(L, path.toCharArray(), nullptr);
+
+	uint64 sourceSize = source.size();
+	uint64 sourceHash = hashSource(source.data(), sourceSize);
+
+	String chunkName = "@" + path;
+
+	Reference<LuaBytecodeChunk*> chunk = getChunk(path, sourceSize, sourceHash);
+
+	if (chunk != nullptr) {
+		int status = luaL_loadbufferx(L, (const char*) chunk->getData(), chunk->size(), chunkName.toCharArray(), "b");
+
+		if (status == LUA_OK) {
+			hits.increment();
+
+			return status;
+		}
+
+		// stale or foreign bytecode, compile from source again
+		lua_pop(L, 1);
+	}
+
+	int status = LUA_OK;
+
+	compile(path, L, source.data(), sourceSize, sourceHash, status);
+
+	return status;
+}
+
+uint64 LuaBytecodeCache::hashSource(const char* source, uint64 size) {
+	// 64 bit FNV-1a
+	uint64 hash = 0xcbf29ce484222325ULL;
+
+	for (uint64 i = 0; i < size; ++i) {
+		hash ^= (byte) source[i];
+		hash *= 0x100000001b3ULL;
+	}
+
+	return hash;
+}
+
+Reference<LuaBytecodeChunk*> LuaBytecodeCache::getChunk(const String& path, uint64 sourceSize, uint64 sourceHash) {
+	Reference<LuaBytecodeChunk*> chunk;
+
+	{
+		ReadLocker locker(&chunksLock);
+
+		chunk = chunks.get(path);
+	}
+
+	if (chunk != nullptr && chunk->matches(sourceSize, sourceHash))
+		return chunk;
+
+	if (diskCachePath.isEmpty())
+		return nullptr;
+
+	chunk = readDiskCache(path, sourceSize, sourceHash);
+
+	if (chunk == nullptr)
+		return nullptr;
+
+	diskLoads.increment();
+
+	Locker locker(&chunksLock);
+
+	chunks.put(path, chunk);
+
+	return chunk;
+}
+
+Reference<LuaBytecodeChunk*> LuaBytecodeCache::compile(const String& path, lua_State* L, const char* source, uint64 sourceSize, uint64 sourceHash, int& status) {
+	String chunkName = "@" + path;
+
+	// compile the bytes that were hashed, the file may change again meanwhile
+	status = luaL_loadbufferx(L, source, sourceSize, chunkName.toCharArray(), "t");
+
+	if (status != LUA_OK)
+		return nullptr;
+
+	// keep the debug info so tracebacks still point at source lines
+	std::string buffer;
+
+	if (lua_dump(L, dumpWriter, &buffer, 0) != 0 || buffer.empty()) {
+		error() << "could not dump bytecode of " << path;
+
+		return nullptr;
+	}
+
+	byte* data = new byte[buffer.size()];
+	memcpy(data, buffer.data(), buffer.size());
+
+	Reference<LuaBytecodeChunk*> chunk = new LuaBytecodeChunk(data, buffer.size(), sourceSize, sourceHash);
+
+	compiles.increment();
+
+	{
+		Locker locker(&chunksLock);
+
+		chunks.put(path, chunk);
+	}
+
+	if (!diskCachePath.isEmpty())
+		writeDiskCache(path, chunk);
+
+	return chunk;
+}
+
+String LuaBytecodeCache::getDiskCacheFile(const String& path) const {
+	return diskCachePath + "/" + path.replaceAll("/", "_") + "c";
+}
+
+LuaBytecodeChunk* LuaBytecodeCache::readDiskCache(const String& path, uint64 sourceSize, uint64 sourceHash) {
+	String fileName = getDiskCacheFile(path);
+
+	FILE* file = fopen(fileName.toCharArray(), "rb");
+
+	if (file == nullptr)
+		return nullptr;
+
+	DiskCacheHeader header;
+
+	if (fread(&header, sizeof(header), 1, file) != 1 || header.magic != DISKCACHEMAGIC || header.luaVersion != LUA_VERSION_NUM
+			|| header.sourceSize != sourceSize || header.sourceHash != sourceHash || header.dataSize == 0) {
+		fclose(file);
+
+		return nullptr;
+	}
+
+	byte* data = new byte[header.dataSize];
+
+	if (fread(data, header.dataSize, 1, file) != 1) {
+		delete [] data;
+		fclose(file);
+
+		return nullptr;
+	}
+
+	fclose(file);
+
+	return new LuaBytecodeChunk(data, header.dataSize, sourceSize, sourceHash);
+}
+
+void LuaBytecodeCache::writeDiskCache(const String& path, const LuaBytecodeChunk* chunk) {
+	String fileName = getDiskCacheFile(path);
+
+	// write next to the final file and rename so concurrent readers never see a partial chunk
+	String tempFileName = fileName + ".tmp" + String::valueOf(tempFiles.increment());
+
+	FILE* file = fopen(tempFileName.toCharArray(), "wb");
+
+	if (file == nullptr) {
+		debug() << "could not write " << tempFileName;
+
+		return;
+	}
+
+	DiskCacheHeader header;
+	memset(&header, 0, sizeof(header));
+
+	header.magic = DISKCACHEMAGIC;
+	header.luaVersion = LUA_VERSION_NUM;
+	header.sourceSize = chunk->getSourceSize();
+	header.sourceHash = chunk->getSourceHash();
+	header.dataSize = chunk->size();
+
+	bool res = fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(chunk->getData(), chunk->size(), 1, file) == 1;
+
+	fclose(file);
+
+	if (!res || std::rename(tempFileName.toCharArray(), fileName.toCharArray()) != 0) {
+		debug() << "could not write " << fileName;
+
+		std::remove(tempFileName.toCharArray());
+	}
+}
+
+void LuaBytecodeCache::clear() {
+	Locker locker(&chunksLock);
+
+	chunks.removeAll();
+}
+
+String LuaBytecodeCache::getStatistics() const {
+	int cached = 0;
+
+	{
+		ReadLocker locker(&chunksLock);
+
+		cached = chunks.size();
+	}
+
+	StringBuffer str;
+	str << cached << " chunks cached, " << hits.get() << " precompiled loads, " << compiles.get() << " compiled, "
+		<< diskLoads.get() << " loaded from disk";
+
+	return str.toString();
+}
+
+int LuaBytecodeCache::dumpWriter(lua_State* L, const void* p, size_t size, void* buffer) {
+	static_cast<std::string*>(buffer)->append(static_cast<const char*>(p), size);
+
+	return 0;
+}
@@ -0,0 +1,118 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef LUABYTECODECACHE_H_
+#define LUABYTECODECACHE_H_
+
+#include "engine/engine.h"
+
+/**
+ * Precompiled chunk of a lua source file.
+ */
+class LuaBytecodeChunk : public Object {
+	byte* data;
+	uint32 dataSize;
+
+	// size and content hash of the source the chunk was compiled from
+	uint64 sourceSize;
+	uint64 sourceHash;
+
+public:
+	LuaBytecodeChunk(byte* bytecode, uint32 size, uint64 srcSize, uint64 srcHash) : Object(),
+			data(bytecode), dataSize(size), sourceSize(srcSize), sourceHash(srcHash) {
+	}
+
+	~LuaBytecodeChunk() {
+		delete [] data;
+	}
+
+	inline bool matches(uint64 srcSize, uint64 srcHash) const {
+		return sourceSize == srcSize && sourceHash == srcHash;
+	}
+
+	inline const byte* getData() const {
+		return data;
+	}
+
+	inline uint32 size() const {
+		return dataSize;
+	}
+
+	inline uint64 getSourceSize() const {
+		return sourceSize;
+	}
+
+	inline uint64 getSourceHash() const {
+		return sourceHash;
+	}
+};
+
+/**
+ * Keeps the dumped bytecode of every lua file run through it, keyed by path
+ * and checked against the size and a hash of the current source, so thread local
+ * lua states (DirectorManager, AiMap, JediManager) load precompiled chunks
+ * instead of parsing the same sources on every worker thread and on every
+ * screenplay reload. Chunks can also be persisted to a disk directory so a
+ * restart skips compilation of unchanged files. The source is still read on
+ * every load, modification times are too coarse to catch quick edits.
+ */
+class LuaBytecodeCache : public Singleton<LuaBytecodeCache>, public Logger {
+	HashTable<String, Reference<LuaBytecodeChunk*> > chunks;
+	mutable ReadWriteLock chunksLock;
+
+	bool enabled;
+	String diskCachePath;
+
+	AtomicInteger hits;
+	AtomicInteger compiles;
+	AtomicInteger diskLoads;
+	AtomicInteger tempFiles;
+
+	const static uint32 DISKCACHEMAGIC = 0x324C3343; // C3L2
+
+public:
+	LuaBytecodeCache();
+
+	/**
+	 * Loads and runs the lua file at path on L, like Lua::runFile.
+	 */
+	static bool runFile(const String& path, lua_State* L);
+
+	/**
+	 * Pushes the compiled chunk of the file at path on the stack of L.
+	 * Returns the lua load status, leaving the error message on the stack on failure.
+	 */
+	int loadFile(const String& path, lua_State* L);
+
+	void clear();
+
+	String getStatistics() const;
+
+	inline bool isEnabled() const {
+		return enabled;
+	}
+
+	inline int getHits() const {
+		return hits.get();
+	}
+
+	inline int getCompiles() const {
+		return compiles.get();
+	}
+
+	static uint64 hashSource(const char* source, uint64 size);
+
+private:
+	Reference<LuaBytecodeChunk*> getChunk(const String& path, uint64 sourceSize, uint64 sourceHash);
+
+	Reference<LuaBytecodeChunk*> compile(const String& path, lua_State* L, const char* source, uint64 sourceSize, uint64 sourceHash, int& status);
+
+	String getDiskCacheFile(const String& path) const;
+	LuaBytecodeChunk* readDiskCache(const String& path, uint64 sourceSize, uint64 sourceHash);
+	void writeDiskCache(const String& path, const LuaBytecodeChunk* chunk);
+
+	static int dumpWriter(lua_State* L, const void* p, size_t size, void* buffer);
+};
+
+#endif /* LUABYTECODECACHE_H_ */
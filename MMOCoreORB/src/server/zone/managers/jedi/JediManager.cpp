@@ -4,6 +4,7 @@
 
 #include "JediManager.h"
 #include "server/zone/managers/director/DirectorManager.h"
+#include "server/zone/managers/director/LuaBytecodeCache.h"
 
 JediManager::JediManager() : Logger("JediManager") {
 	jediProgressionType = NOJEDIPROGRESSION;
@@ -45,19 +46,19 @@ void JediManager::setupLuaValues(Lua* luaEngine) {
 void JediManager::loadConfiguration(Lua* luaEngine) {
 	setupLuaValues(luaEngine);
 
-	luaEngine->runFile("scripts/managers/jedi/jedi_manager.lua");
+	LuaBytecodeCache::runFile("scripts/managers/jedi/jedi_manager.lua", luaEngine->getLuaState());
 
 	jediProgressionType = luaEngine->getGlobalInt(String("jediProgressionType"));
 
 	switch (jediProgressionType) {
 	case HOLOGRINDJEDIPROGRESSION:
-		luaEngine->runFile("scripts/managers/jedi/hologrind_jedi_manager.lua");
+		LuaBytecodeCache::runFile("scripts/managers/jedi/hologrind_jedi_manager.lua", luaEngine->getLuaState());
 		break;
 	case VILLAGEJEDIPROGRESSION:
-		luaEngine->runFile("scripts/managers/jedi/village_jedi_manager.lua");
+		LuaBytecodeCache::runFile("scripts/managers/jedi/village_jedi_manager.lua", luaEngine->getLuaState());
 		break;
 	case CUSTOMJEDIPROGRESSION:
-		luaEngine->runFile(luaEngine->getGlobalString("customJediProgressionFile"));
+		LuaBytecodeCache::runFile(luaEngine->getGlobalString("customJediProgressionFile"), luaEngine->getLuaState());
 		break;
 	default:
 		break;
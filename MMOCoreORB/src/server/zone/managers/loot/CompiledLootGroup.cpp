@@ -0,0 +1,98 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "CompiledLootGroup.h"
+#include "templates/LootItemTemplate.h"
+
+void CompiledLootGroup::addOutcome(const String& itemName, const String& groupName, const LootItemTemplate* itemTemplate, double chance) {
+	if (chance <= 0)
+		return;
+
+	String key = groupName + ":" + itemName;
+	int index = outcomeIndex.get(key);
+
+	if (index > 0) {
+		outcomes.get(index - 1).chance += chance;
+		return;
+	}
+
+	Outcome outcome;
+	outcome.itemTemplate = itemTemplate;
+	outcome.itemName = itemName;
+	outcome.groupName = groupName;
+	outcome.chance = chance;
+
+	outcomes.add(outcome);
+	outcomeIndex.put(key, outcomes.size());
+}
+
+void CompiledLootGroup::build() {
+	int count = outcomes.size();
+
+	thresholds.removeAll(count, 1);
+	aliases.removeAll(count, 1);
+	outcomeIndex.removeAll();
+
+	if (count == 0) {
+		Outcome nothing;
+		nothing.groupName = name;
+		nothing.chance = 1;
+
+		outcomes.add(nothing);
+		count = 1;
+	}
+
+	double total = 0;
+
+	for (int i = 0; i < count; ++i)
+		total += outcomes.get(i).chance;
+
+	// Vose: split the slots into those under and over the average, pair each small one with a large one
+	Vector<double> scaled;
+	Vector<int> small, large;
+
+	for (int i = 0; i < count; ++i) {
+		double value = outcomes.get(i).chance * count / total;
+
+		scaled.add(value);
+		thresholds.add(THRESHOLDSCALE);
+		aliases.add(i);
+
+		if (value < 1.0)
+			small.add(i);
+		else
+			large.add(i);
+	}
+
+	while (small.size() > 0 && large.size() > 0) {
+		int less = small.remove(small.size() - 1);
+		int more = large.get(large.size() - 1);
+
+		thresholds.set(less, (uint32) (scaled.get(less) * THRESHOLDSCALE + 0.5));
+		aliases.set(less, more);
+
+		double remaining = scaled.get(more) + scaled.get(less) - 1.0;
+		scaled.set(more, remaining);
+
+		if (remaining < 1.0) {
+			large.remove(large.size() - 1);
+			small.add(more);
+		}
+	}
+
+	// whatever is left is 1 up to rounding, those slots keep their own outcome
+}
+
+const CompiledLootGroup::Outcome& CompiledLootGroup::select() const {
+	int slot = System::random(thresholds.size() - 1);
+
+	return select(slot, System::random(THRESHOLDSCALE - 1));
+}
+
+const CompiledLootGroup::Outcome& CompiledLootGroup::select(int slot, uint32 roll) const {
+	if (roll < thresholds.get(slot))
+		return outcomes.get(slot);
+
+	return outcomes.get(aliases.get(slot));
+}
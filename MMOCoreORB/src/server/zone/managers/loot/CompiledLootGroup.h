@@ -0,0 +1,85 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef COMPILEDLOOTGROUP_H_
+#define COMPILEDLOOTGROUP_H_
+
+#include "engine/engine.h"
+
+class LootItemTemplate;
+
+/**
+ * A loot group with its nested groups flattened into the loot items they can end up at, with
+ * the chance of each. Items are picked in constant time with the alias method: every slot holds
+ * one outcome plus an alias, a random slot is taken and a second roll against its threshold
+ * decides between the two.
+ *
+ * Rolls the scripts leave uncovered (weights adding up to less than 10000000) and items that
+ * don't exist are kept as outcomes without a template, createLoot warns and drops them as it
+ * always did.
+ */
+class CompiledLootGroup : public Object {
+public:
+	const static int THRESHOLDSCALE = 1 << 24;
+
+	struct Outcome {
+		Reference<const LootItemTemplate*> itemTemplate;
+
+		// item as written in the scripts and the group that holds it
+		String itemName;
+		String groupName;
+
+		double chance;
+
+		Outcome() : chance(0) {
+		}
+	};
+
+protected:
+	String name;
+
+	Vector<Outcome> outcomes;
+
+	Vector<uint32> thresholds;
+	Vector<int> aliases;
+
+	// outcome position + 1 by group and item, only while adding
+	HashTable<String, int> outcomeIndex;
+
+public:
+	CompiledLootGroup(const String& name) : name(name) {
+		outcomeIndex.setNullValue(0);
+	}
+
+	/**
+	 * Adds chance to the outcome for itemName in groupName, merging repeated paths to the same item.
+	 */
+	void addOutcome(const String& itemName, const String& groupName, const LootItemTemplate* itemTemplate, double chance);
+
+	/**
+	 * Builds the alias table, the chances are normalized to their sum.
+	 */
+	void build();
+
+	const Outcome& select() const;
+
+	/**
+	 * Outcome for a slot and a roll in [0, THRESHOLDSCALE).
+	 */
+	const Outcome& select(int slot, uint32 roll) const;
+
+	const Outcome& getOutcome(int i) const {
+		return outcomes.get(i);
+	}
+
+	int size() const {
+		return outcomes.size();
+	}
+
+	const String& getName() const {
+		return name;
+	}
+};
+
+#endif /* COMPILEDLOOTGROUP_H_ */
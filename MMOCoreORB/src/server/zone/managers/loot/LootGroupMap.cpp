@@ -18,6 +18,11 @@ LootGroupMap::LootGroupMap() : Logger("LootGroupMap") {
 
 	itemTemplates.setNullValue(nullptr);
 	groupTemplates.setNullValue(nullptr);
+	compiledGroups.setNullValue(nullptr);
+	collidingGroups.setNullValue(nullptr);
+
+	compiledOutcomes = 0;
+	compileTimeMs = 0;
 }
 
 LootGroupMap::~LootGroupMap() {
@@ -41,9 +46,90 @@ int LootGroupMap::initialize() {
 	if (!res || !res2)
 		ERROR_CODE = GENERAL_ERROR;
 
+	compileLootGroups();
+
 	return ERROR_CODE;
 }
 
+void LootGroupMap::compileLootGroups() {
+	Timer timer;
+	timer.start();
+
+	compiledGroups.removeAll();
+	collidingGroups.removeAll();
+	compiledOutcomes = 0;
+
+	HashTableIterator<String, Reference<LootGroupTemplate*> > iterator = groupTemplates.iterator();
+
+	String name;
+	Reference<LootGroupTemplate*> group;
+
+	while (iterator.hasNext()) {
+		iterator.getNextKeyAndValue(name, group);
+
+		Reference<CompiledLootGroup*> compiled = new CompiledLootGroup(name);
+
+		flattenLootGroup(compiled, group, 1.0, 0);
+		compiled->build();
+
+		compiledOutcomes += compiled->size();
+
+		uint32 crc = name.hashCode();
+
+		if (compiledGroups.containsKey(crc)) {
+			warning("Loot group " + name + " has the same crc as " + compiledGroups.get(crc)->getName());
+
+			collidingGroups.put(name, compiled);
+		} else {
+			compiledGroups.put(crc, compiled);
+		}
+	}
+
+	compileTimeMs = timer.stopMs();
+}
+
+void LootGroupMap::flattenLootGroup(CompiledLootGroup* compiled, const LootGroupTemplate* group, double chance, int depth) {
+	// same rolls as LootGroupTemplate::getLootGroupEntryForRoll, an entry gets the part of 0 - 10000000 its weight covers
+	const static int64 ROLLMAX = 10000000;
+
+	int64 total = 0;
+	int64 covered = -1;
+
+	for (int i = 0; i < group->size(); ++i) {
+		int weight = group->getLootGroupWeightAt(i);
+
+		total += weight;
+
+		if (weight <= 0)
+			continue;
+
+		int64 high = Math::min(total, ROLLMAX);
+
+		if (high <= covered)
+			continue;
+
+		double entryChance = chance * (high - covered) / (ROLLMAX + 1);
+		covered = high;
+
+		String selection = group->getLootGroupEntryAt(i);
+		const LootGroupTemplate* nested = groupTemplates.get(selection);
+
+		if (nested == nullptr) {
+			compiled->addOutcome(selection, group->getTemplateName(), itemTemplates.get(selection), entryChance);
+		} else if (depth < MAXGROUPDEPTH) {
+			flattenLootGroup(compiled, nested, entryChance, depth + 1);
+		} else {
+			warning("Loot group " + compiled->getName() + " nests deeper than " + String::valueOf(MAXGROUPDEPTH) + " groups at " + selection);
+
+			compiled->addOutcome(selection, group->getTemplateName(), nullptr, entryChance);
+		}
+	}
+
+	// weights adding up to less than 10000000 leave the rest of the rolls without loot
+	if (covered < ROLLMAX)
+		compiled->addOutcome("", group->getTemplateName(), nullptr, chance * (ROLLMAX - covered) / (ROLLMAX + 1));
+}
+
 void LootGroupMap::registerFunctions() {
 	lua->registerFunction("addLootGroupTemplate", addLootGroupTemplate);
 	lua->registerFunction("addLootItemTemplate", addLootItemTemplate);
@@ -11,6 +11,7 @@
 class LootItemTemplate;
 
 #include "templates/LootGroupTemplate.h"
+#include "server/zone/managers/loot/CompiledLootGroup.h"
 
 #include "engine/log/Logger.h"
 #include "engine/util/Singleton.h"
@@ -30,12 +31,42 @@ public:
 	HashTable<String, Reference<LootItemTemplate*> > itemTemplates;
 	HashTable<String, Reference<LootGroupTemplate*> > groupTemplates;
 
+	// flattened groups by name crc, groups whose crc is taken stay keyed by name
+	HashTable<uint32, Reference<CompiledLootGroup*> > compiledGroups;
+	HashTable<String, Reference<CompiledLootGroup*> > collidingGroups;
+
+	int compiledOutcomes;
+	uint64 compileTimeMs;
+
 public:
 	LootGroupMap();
 	virtual ~LootGroupMap();
 
 	int initialize();
 
+	/**
+	 * Flattens every loot group into a CompiledLootGroup, called by initialize() once the
+	 * scripts are loaded.
+	 */
+	void compileLootGroups();
+
+	const CompiledLootGroup* getCompiledLootGroup(const String& name) const {
+		const CompiledLootGroup* group = compiledGroups.get(name.hashCode());
+
+		if (group != nullptr && group->getName() == name)
+			return group;
+
+		return collidingGroups.get(name);
+	}
+
+	inline int countCompiledOutcomes() const {
+		return compiledOutcomes;
+	}
+
+	inline uint64 getCompileTimeMs() const {
+		return compileTimeMs;
+	}
+
 	inline void putLootItemTemplate(const String& name, LootItemTemplate* item) {
 		itemTemplates.put(name, item);
 	}
@@ -67,6 +98,11 @@ public:
 private:
 	static String currentFilename;
 
+	// deepest nesting of loot groups followed while compiling
+	const static int MAXGROUPDEPTH = 16;
+
+	void flattenLootGroup(CompiledLootGroup* compiled, const LootGroupTemplate* group, double chance, int depth);
+
 	void registerFunctions();
 	void registerGlobals();
 
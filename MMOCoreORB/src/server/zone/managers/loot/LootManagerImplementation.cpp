@@ -45,6 +45,7 @@ void LootManagerImplementation::initialize() {
 	info("Loaded " + String::valueOf(lootableHeavyWeaponMods.size()) + " lootable heavy weapon stat mods.");
 	info("Loaded " + String::valueOf(lootGroupMap->countLootItemTemplates()) + " loot items.");
 	info("Loaded " + String::valueOf(lootGroupMap->countLootGroupTemplates()) + " loot groups.");
+	info("Compiled loot groups into " + String::valueOf(lootGroupMap->countCompiledOutcomes()) + " outcomes in " + String::valueOf(lootGroupMap->getCompileTimeMs()) + " ms.");
 
 	info("Initialized.", true);
 }
@@ -793,27 +794,20 @@ bool LootManagerImplementation::createLootFromCollection(TransactionLog& trx, Sc
 }
 
 bool LootManagerImplementation::createLoot(TransactionLog& trx, SceneObject* container, const String& lootGroup, int level, bool maxCondition) {
-	Reference<const LootGroupTemplate*> group = lootGroupMap->getLootGroupTemplate(lootGroup);
+	const CompiledLootGroup* group = lootGroupMap->getCompiledLootGroup(lootGroup);
 
 	if (group == nullptr) {
 		warning("Loot group template requested does not exist: " + lootGroup);
 		return false;
 	}
 
-	//Now we do the third roll for the item out of the group.
-	int roll = System::random(10000000);
-
-	String selection = group->getLootGroupEntryForRoll(roll);
-
-	//Check to see if the group entry is another group
-	if (lootGroupMap->lootGroupExists(selection))
-		return createLoot(trx, container, selection, level, maxCondition);
+	//Now we roll for the item out of the group, nested groups are already flattened into it.
+	const CompiledLootGroup::Outcome& selection = group->select();
 
-	//Entry wasn't another group, it should be a loot item
-	Reference<const LootItemTemplate*> itemTemplate = lootGroupMap->getLootItemTemplate(selection);
+	Reference<const LootItemTemplate*> itemTemplate = selection.itemTemplate;
 
 	if (itemTemplate == nullptr) {
-		warning("Loot item template requested does not exist: " + group->getLootGroupEntryForRoll(roll) + " for templateName: " + group->getTemplateName());
+		warning("Loot item template requested does not exist: " + selection.itemName + " for templateName: " + selection.groupName);
 		return false;
 	}
 
@@ -823,7 +817,7 @@ bool LootManagerImplementation::createLoot(TransactionLog& trx, SceneObject* con
 		return false;
 
 	trx.setSubject(obj);
-	trx.addState("lootGroup", lootGroup);
+	trx.addState("lootGroup", selection.groupName);
 	trx.addState("lootLevel", level);
 	trx.addState("lootMaxCondition", maxCondition);
 
@@ -9,6 +9,8 @@ void PlayerMap::put(const String& name, CreatureObject* player, bool doLock) {
 
 	try {
 		players.put(name.toLowerCase(), player);
+
+		snapshot = nullptr;
 	}
 	catch (Exception & e) {
 		System::out << e.getMessage();
@@ -57,6 +59,8 @@ CreatureObject* PlayerMap::remove(const String& name, bool doLock) {
 
 		player = players.remove(name.toLowerCase());
 
+		snapshot = nullptr;
+
 	}
 	catch (Exception & e) {
 		System::out << e.getMessage();
@@ -117,4 +121,23 @@ int PlayerMap::size(bool doLock) {
 	unlock(doLock);
 
 	return res;
+}
+
+Reference<PlayerList*> PlayerMap::getSnapshot(bool doLock) {
+	lock(doLock);
+
+	if (snapshot == nullptr) {
+		snapshot = new PlayerList(players.size(), 64);
+
+		HashTableIterator<String, Reference<CreatureObject*> > iterator(&players);
+
+		while (iterator.hasNext())
+			snapshot->add(iterator.getNextValue());
+	}
+
+	Reference<PlayerList*> result = snapshot;
+
+	unlock(doLock);
+
+	return result;
 }
\ No newline at end of file
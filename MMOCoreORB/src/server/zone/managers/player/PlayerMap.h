@@ -19,10 +19,15 @@ namespace player {
 
 using namespace server::zone::objects::creature;
 
+typedef Vector<Reference<CreatureObject*> > PlayerList;
+
 class PlayerMap : public Mutex, public Object {
 	HashTable<String, Reference<CreatureObject*> > players;
 	HashTableIterator<String, Reference<CreatureObject*> > iter;
 
+	// rebuilt on the first getSnapshot after a put or remove
+	Reference<PlayerList*> snapshot;
+
 public:
 	PlayerMap(int initsize);
 
@@ -41,6 +46,12 @@ public:
 
 	int size(bool doLock = true);
 
+	/**
+	 * Returns the players as of now, shared by all callers until the map changes, so they can be
+	 * walked without holding this or the chat manager lock. Do not modify it.
+	 */
+	Reference<PlayerList*> getSnapshot(bool doLock = true);
+
 };
 
 
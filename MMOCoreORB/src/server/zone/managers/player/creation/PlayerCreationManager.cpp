@@ -548,20 +548,12 @@ bool PlayerCreationManager::createCharacter(ClientCreateCharacterCallback* callb
 	String lastName = playerCreature->getLastName();
 	int raceID = playerTemplate->getRace();
 
-	try {
-		StringBuffer query;
-		query
-				<< "INSERT INTO `characters_dirty` (`character_oid`, `account_id`, `galaxy_id`, `firstname`, `surname`, `race`, `gender`, `template`)"
-				<< " VALUES (" << playerCreature->getObjectID() << ","
-				<< client->getAccountID() << "," << zoneServer.get()->getGalaxyID()
-				<< "," << "'" << firstName.escapeString() << "','"
-				<< lastName.escapeString() << "'," << raceID << "," << 0 << ",'"
-				<< raceFile.escapeString() << "')";
-
-		ServerDatabase::instance()->executeStatement(query);
-	} catch (const DatabaseException& e) {
-		error(e.getMessage());
-	}
+	QueryParameters parameters;
+	parameters.add(playerCreature->getObjectID()).add(client->getAccountID()).add(zoneServer.get()->getGalaxyID())
+		.add(firstName).add(lastName).add(raceID).add(0).add(raceFile);
+
+	ServerDatabase::executePreparedAsync("INSERT INTO `characters_dirty` (`character_oid`, `account_id`, `galaxy_id`, `firstname`, `surname`, `race`, `gender`, `template`)"
+		" VALUES (?, ?, ?, ?, ?, ?, ?, ?)", parameters);
 
 	playerManager->addPlayer(playerCreature);
 
@@ -964,10 +964,13 @@ void ResourceSpawner::sendSurvey(CreatureObject* player, const String& resname)
 	float maxDensity = -1;
 	float maxX = 0, maxY = 0;
 
+	Vector<float> densities;
+	resourceMap->getDensityGrid(resname, zoneName, posX, posY, spacer, points, densities);
+
 	for (int i = 0; i < points; i++) {
 		for (int j = 0; j < points; j++) {
 
-			float density = resourceMap->getDensityAt(resname, zoneName, posX, posY);
+			float density = densities.get(i * points + j);
 
 			if (density > maxDensity) {
 				maxDensity = density;
@@ -104,6 +104,11 @@ public:
 	*/
 	float getDensityAt(const String& resourcename, String zoneName, float x, float y) const;
 
+	/**
+	 * Get's the density values of resource on a grid of points x points, see ResourceSpawn::getDensityGrid
+	 */
+	void getDensityGrid(const String& resourcename, const String& zoneName, float originX, float originY, float spacing, int points, Vector<float>& densities) const;
+
 	/**
 	 * Get's the density value of resource at given point
 	 * \param zoneid ID of zone being requesting
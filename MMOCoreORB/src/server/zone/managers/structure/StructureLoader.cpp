@@ -0,0 +1,167 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "StructureLoader.h"
+#include "conf/ConfigManager.h"
+#include "server/zone/ZoneServer.h"
+#include "server/zone/Zone.h"
+#include "server/zone/objects/building/BuildingObject.h"
+#include "server/zone/managers/gcw/GCWManager.h"
+
+namespace {
+	const char* STRUCTURE_LOAD_QUEUE = "StructureLoadQueue";
+}
+
+StructureLoader::StructureLoader(ZoneServer* server, const String& zoneName) : Logger("StructureLoader " + zoneName), server(server), zoneName(zoneName) {
+	threads = ConfigManager::instance()->getStructureLoadThreads();
+	maxPendingChunks = threads * 4;
+
+	sequence = 0;
+	pendingChunks = 0;
+	gcwMicros = 0;
+
+	gcwBases.setNoDuplicateInsertPlan();
+}
+
+void StructureLoader::add(uint64 objectID) {
+	chunk.add(objectID);
+	++sequence;
+
+	if (chunk.size() >= CHUNKSIZE)
+		dispatchChunk();
+}
+
+void StructureLoader::dispatchChunk() {
+	if (chunk.size() == 0)
+		return;
+
+	int firstSequence = sequence - chunk.size();
+	bool queue = false;
+
+	if (threads > 0) {
+		Locker locker(&pendingMutex);
+
+		queue = pendingChunks < maxPendingChunks;
+
+		if (queue)
+			++pendingChunks;
+	}
+
+	if (queue) {
+		executeChunk(chunk, firstSequence);
+	} else {
+		uint64 start = Time::currentNanoTime();
+
+		loadChunk(chunk, firstSequence);
+
+		inlineMicros.add((Time::currentNanoTime() - start) / 1000);
+	}
+
+	chunk.removeAll();
+}
+
+void StructureLoader::executeChunk(const Vector<uint64>& objectIDs, int firstSequence) {
+	static bool queueInitialized = [this] () {
+		Core::getTaskManager()->initializeCustomQueue(STRUCTURE_LOAD_QUEUE, threads, false);
+		return true;
+	} ();
+
+	(void) queueInitialized;
+
+	Reference<StructureLoader*> loader = this;
+
+	Core::getTaskManager()->executeTask([loader, objectIDs, firstSequence] () {
+		loader->loadChunk(objectIDs, firstSequence);
+
+		ObjectDatabaseManager::instance()->commitLocalTransaction();
+
+		loader->chunkDone();
+	}, "StructureLoadLambda", STRUCTURE_LOAD_QUEUE);
+}
+
+void StructureLoader::chunkDone() {
+	Locker locker(&pendingMutex);
+
+	if (--pendingChunks == 0)
+		chunksDone.broadcast(&pendingMutex);
+}
+
+Reference<SceneObject*> StructureLoader::loadStructure(uint64 objectID) {
+	return server->getObject(objectID).get();
+}
+
+bool StructureLoader::isGCWBase(SceneObject* object) {
+	return object->isGCWBase();
+}
+
+void StructureLoader::registerGCWBase(BuildingObject* building) {
+	Zone* zone = building->getZone();
+
+	if (zone == nullptr)
+		return;
+
+	GCWManager* gcwMan = zone->getGCWManager();
+
+	if (gcwMan != nullptr)
+		gcwMan->registerGCWBase(building, false);
+}
+
+void StructureLoader::loadChunk(const Vector<uint64>& objectIDs, int firstSequence) {
+	uint64 start = Time::currentNanoTime();
+
+	for (int i = 0; i < objectIDs.size(); ++i) {
+		uint64 objectID = objectIDs.get(i);
+
+		try {
+			Reference<SceneObject*> object = loadStructure(objectID);
+
+			if (object == nullptr) {
+				error("Failed to deserialize structure with objectID: " + String::valueOf(objectID));
+
+				continue;
+			}
+
+			int count = loaded.increment();
+
+			if (isGCWBase(object)) {
+				Locker locker(&gcwBasesMutex);
+
+				gcwBases.put(firstSequence + i, cast<BuildingObject*>(object.get()));
+			}
+
+			if (ConfigManager::instance()->isProgressMonitorActivated())
+				printf("\r\tLoading player structures [%d] / [?]\t", count);
+		} catch (Exception& e) {
+			error("Database exception in StructureLoader::loadChunk(): " + e.getMessage());
+		}
+	}
+
+	deserializeMicros.add((Time::currentNanoTime() - start) / 1000);
+}
+
+void StructureLoader::finish() {
+	dispatchChunk();
+
+	pendingMutex.lock();
+
+	while (pendingChunks > 0)
+		chunksDone.wait(&pendingMutex);
+
+	pendingMutex.unlock();
+
+	uint64 start = Time::currentNanoTime();
+
+	Locker locker(&gcwBasesMutex);
+
+	for (int i = 0; i < gcwBases.size(); ++i) {
+		BuildingObject* building = gcwBases.elementAt(i).getValue();
+
+		if (building != nullptr)
+			registerGCWBase(building);
+	}
+
+	gcwBases.removeAll();
+
+	gcwMicros = (Time::currentNanoTime() - start) / 1000;
+}
@@ -0,0 +1,125 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef STRUCTURELOADER_H_
+#define STRUCTURELOADER_H_
+
+#include "engine/engine.h"
+
+namespace server {
+namespace zone {
+	class ZoneServer;
+namespace objects {
+namespace scene {
+	class SceneObject;
+}
+
+namespace building {
+	class BuildingObject;
+}
+}
+}
+}
+
+using namespace server::zone;
+using namespace server::zone::objects::scene;
+using namespace server::zone::objects::building;
+
+/**
+ * Loads the player structures of one zone as a pipeline: the zone loader walks the sub index and
+ * hands the object ids in chunks to the StructureLoadQueue workers, which deserialize them.
+ *
+ * At most Core3.StructureLoadThreads * 4 chunks are waiting at any time, past that the loader
+ * deserializes the next chunk itself. GCW bases are registered by the loader once everything is
+ * in, in index order, as the sequential loader did.
+ */
+class StructureLoader : public Object, public Logger {
+protected:
+	ZoneServer* server;
+	String zoneName;
+
+	int threads;
+	int maxPendingChunks;
+
+	Vector<uint64> chunk;
+	int sequence;
+
+	// chunks queued to the workers, finish() waits on chunksDone for the last one
+	int pendingChunks;
+	Mutex pendingMutex;
+	Condition chunksDone;
+
+	AtomicInteger loaded;
+
+	// by index sequence
+	VectorMap<int, ManagedReference<BuildingObject*> > gcwBases;
+	Mutex gcwBasesMutex;
+
+	AtomicLong deserializeMicros;
+	AtomicLong inlineMicros;
+	uint64 gcwMicros;
+
+	void dispatchChunk();
+
+	/**
+	 * Loads the chunk on a StructureLoadQueue worker, which calls chunkDone() after it.
+	 */
+	virtual void executeChunk(const Vector<uint64>& objectIDs, int firstSequence);
+
+	void chunkDone();
+
+	virtual Reference<SceneObject*> loadStructure(uint64 objectID);
+
+	virtual bool isGCWBase(SceneObject* object);
+
+	virtual void registerGCWBase(BuildingObject* building);
+
+public:
+	const static int CHUNKSIZE = 32;
+
+	StructureLoader(ZoneServer* server, const String& zoneName);
+
+	virtual ~StructureLoader() {
+	}
+
+	/**
+	 * Queues the next object id of the index.
+	 */
+	void add(uint64 objectID);
+
+	/**
+	 * Waits for the queued structures to be loaded, then registers the GCW bases.
+	 */
+	void finish();
+
+	void loadChunk(const Vector<uint64>& objectIDs, int firstSequence);
+
+	int getLoadedCount() {
+		return loaded.get();
+	}
+
+	/**
+	 * Time spent deserializing, summed over the workers.
+	 */
+	uint64 getDeserializeTimeMs() {
+		return deserializeMicros.get() / 1000;
+	}
+
+	/**
+	 * Time the loader spent deserializing chunks itself because the workers were behind.
+	 */
+	uint64 getInlineTimeMs() {
+		return inlineMicros.get() / 1000;
+	}
+
+	uint64 getGCWTimeMs() const {
+		return gcwMicros / 1000;
+	}
+
+	int getThreads() const {
+		return threads;
+	}
+};
+
+#endif /* STRUCTURELOADER_H_ */
@@ -6,6 +6,7 @@
  */
 
 #include "StructureManager.h"
+#include "StructureLoader.h"
 #include "engine/db/IndexDatabase.h"
 #include "server/zone/objects/scene/SceneObject.h"
 #include "conf/ConfigManager.h"
@@ -144,42 +145,9 @@ void StructureManager::loadPlayerStructures(const String& zoneName) {
 
 	IndexDatabaseIterator iterator(playerStructuresDatabaseIndex, config);
 
-	int i = 0;
-
 	uint64 objectID;
 
-	auto loadFunction = [this] (int& i, uint64 objectID, uint64 planet) {
-		//debug("loading 0x" + String::hexvalueOf(objectID) + " for planet 0x" + String::hexvalueOf(planet), true);
-
-		try {
-			auto object = server->getObject(objectID);
-
-			if (object == nullptr) {
-				error("Failed to deserialize structure with objectID: " + String::valueOf(objectID));
-
-				return;
-			}
-
-			++i;
-
-			if (object->isGCWBase()) {
-				Zone* zone = object->getZone();
-
-				if (zone != nullptr) {
-					GCWManager* gcwMan = zone->getGCWManager();
-
-					if (gcwMan != nullptr) {
-						gcwMan->registerGCWBase(cast<BuildingObject*>(object.get()), false);
-					}
-				}
-			}
-
-			if (ConfigManager::instance()->isProgressMonitorActivated())
-				printf("\r\tLoading player structures [%d] / [?]\t", i);
-		} catch (Exception& e) {
-			error("Database exception in StructureManager::loadPlayerStructures(): " + e.getMessage());
-		}
-	};
+	Reference<StructureLoader*> loader = new StructureLoader(server, zoneName);
 
 	Timer loadTimer;
 	loadTimer.start();
@@ -192,14 +160,14 @@ void StructureManager::loadPlayerStructures(const String& zoneName) {
 	if (iterator.setKeyAndGetValue(zoneHash, objectID, nullptr)) {
 		initialQueryPerf.stop();
 
-		loadFunction(i, objectID, zoneHash);
+		loader->add(objectID);
 
 		iteratorPerf.start();
 
 		while (iterator.getNextKeyAndValue(zoneHash, objectID, nullptr)) {
 			iteratorPerf.stop();
 
-			loadFunction(i, objectID, zoneHash);
+			loader->add(objectID);
 
 			iteratorPerf.start();
 		}
@@ -207,13 +175,25 @@ void StructureManager::loadPlayerStructures(const String& zoneName) {
 		iteratorPerf.stop();
 	}
 
+	Timer finishPerf;
+	finishPerf.start();
+
+	loader->finish();
+
+	finishPerf.stop();
+
 	auto elapsedMs = loadTimer.stopMs();
+	int i = loader->getLoadedCount();
 
 	info(i > 0) << i << " player structures loaded for "
 			<< zoneName << " in "
-			<< elapsedMs << "ms "
-			<< "where the initial query took " << initialQueryPerf.getTotalTimeMs() << "ms "
-			<< "and iterator took " << iteratorPerf.getTotalTimeMs() << "ms.";
+			<< elapsedMs << "ms (" << (i * 1000 / Math::max((uint64) 1, (uint64) elapsedMs)) << "/s) "
+			<< "where the initial query took " << initialQueryPerf.getTotalTimeMs() << "ms, "
+			<< "the iterator took " << iteratorPerf.getTotalTimeMs() << "ms, "
+			<< "deserializing took " << loader->getDeserializeTimeMs() << "ms over " << loader->getThreads() << " workers "
+			<< "(" << loader->getInlineTimeMs() << "ms of it on the loader), "
+			<< "waiting for the workers took " << (finishPerf.getTotalTimeMs() - loader->getGCWTimeMs()) << "ms "
+			<< "and GCW base registration took " << loader->getGCWTimeMs() << "ms.";
 }
 
 int StructureManager::getStructureFootprint(SharedStructureObjectTemplate* objectTemplate, int angle, float& l0, float& w0, float& l1, float& w1) {
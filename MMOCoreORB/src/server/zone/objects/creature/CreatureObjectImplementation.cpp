@@ -805,6 +805,7 @@ bool CreatureObjectImplementation::setState(uint64 state, bool notifyClient) {
 
 				if (thisZone != nullptr) {
 					SortedVector<QuadTreeEntry*> closeSceneObjects;
+					Reference<CloseObjectsReceivers*> receivers;
 					int maxInRangeObjects = 0;
 
 					if (closeobjects == nullptr) {
@@ -814,8 +815,8 @@ bool CreatureObjectImplementation::setState(uint64 state, bool notifyClient) {
 						thisZone->getInRangeObjects(getWorldPositionX(), getWorldPositionY(), ZoneServer::CLOSEOBJECTRANGE, &closeSceneObjects, true);
 						maxInRangeObjects = closeSceneObjects.size();
 					} else {
-						closeobjects->safeCopyReceiversTo(closeSceneObjects, CloseObjectsVector::PLAYERTYPE);
-						maxInRangeObjects = closeSceneObjects.size();
+						receivers = closeobjects->getReceivers(CloseObjectsVector::PLAYERTYPE);
+						maxInRangeObjects = receivers != nullptr ? receivers->size() : 0;
 					}
 
 					SitOnObject* soo = new SitOnObject(asCreatureObject(), getPositionX(), getPositionZ(), getPositionY());
@@ -830,7 +831,7 @@ bool CreatureObjectImplementation::setState(uint64 state, bool notifyClient) {
 #endif
 
 					for (int i = 0; i < maxInRangeObjects; ++i) {
-						SceneObject* object = static_cast<SceneObject*> (closeSceneObjects.get(i));
+						SceneObject* object = static_cast<SceneObject*> (receivers != nullptr ? receivers->get(i) : closeSceneObjects.get(i));
 
 						if (object->getParent().get() == getParent().get()) {
 #ifdef LOCKFREE_BCLIENT_BUFFERS
@@ -3691,6 +3692,8 @@ void CreatureObjectImplementation::removeOutOfRangeObjects() {
 	int countChecked = 0;
 	int countCov = closeObjects.size();
 
+	Vector<QuadTreeEntry*> outOfRangeObjects;
+
 	for (int i = 0; i < closeObjects.size(); ++i) {
 		SceneObject* o = static_cast<SceneObject*>(closeObjects.getUnsafe(i));
 
@@ -3721,14 +3724,27 @@ void CreatureObjectImplementation::removeOutOfRangeObjects() {
 		if (deltaX * deltaX + deltaY * deltaY > outOfRangeSqr) {
 			countCov--;
 
-			if (getCloseObjects() != nullptr)
-				creature->removeInRangeObject(o);
-
-			if (o->getCloseObjects() != nullptr)
-				o->removeInRangeObject(creature);
+			outOfRangeObjects.add(o);
 		}
 	}
 
+	// drop everything from our own close objects under one lock, then notify
+	if (getCloseObjects() != nullptr && outOfRangeObjects.size() > 0) {
+		Vector<QuadTreeEntry*> dropped(outOfRangeObjects.size(), 10);
+
+		closeObjectsVector->dropAll(outOfRangeObjects, dropped);
+
+		for (int i = 0; i < dropped.size(); ++i)
+			creature->notifyDissapear(dropped.getUnsafe(i));
+	}
+
+	for (int i = 0; i < outOfRangeObjects.size(); ++i) {
+		QuadTreeEntry* o = outOfRangeObjects.getUnsafe(i);
+
+		if (o->getCloseObjects() != nullptr)
+			o->removeInRangeObject(creature);
+	}
+
 	if (creature->isPlayerCreature()) {
 		auto ghost = creature->getPlayerObject();
 
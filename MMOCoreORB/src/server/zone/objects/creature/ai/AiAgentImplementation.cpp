@@ -38,6 +38,7 @@
 #include "server/zone/ZoneServer.h"
 #include "server/zone/managers/collision/CollisionManager.h"
 #include "server/zone/managers/collision/PathFinderManager.h"
+#include "conf/ConfigManager.h"
 #include "server/zone/managers/combat/CombatManager.h"
 #include "server/zone/managers/components/ComponentManager.h"
 #include "server/zone/managers/conversation/ConversationManager.h"
@@ -85,6 +86,8 @@
 #include "server/zone/objects/creature/ai/variables/CurrentFoundPath.h"
 #include "server/zone/managers/creature/SpawnObserver.h"
 #include "server/zone/managers/creature/DynamicSpawnObserver.h"
+#include "server/zone/managers/creature/AiTickScheduler.h"
+#include "server/zone/managers/creature/AiAwarenessBatch.h"
 #include "server/zone/packets/ui/CreateClientPathMessage.h"
 #include "server/zone/objects/staticobject/StaticObject.h"
 #include "server/zone/objects/building/BuildingObject.h"
@@ -791,6 +794,21 @@ void AiAgentImplementation::doAwarenessCheck() {
 		AiAgent* thisObject = asAiAgent();
 		newPlayerCount = 0;
 
+		// in a batch pass, unless we moved, only the creatures that moved since our last pass are checked again
+		Zone* zone = getZoneUnsafe();
+		AiAwarenessBatch* batch = zone != nullptr ? zone->getAiAwarenessBatch() : nullptr;
+		bool checkAll = true;
+
+		if (batch != nullptr) {
+			checkAll = batch->isFullPass() || awarenessPass + 1 != batch->getPass() || awarenessMovementCounter != movementCounter;
+
+			awarenessPass = batch->getPass();
+			awarenessMovementCounter = movementCounter;
+		}
+
+		ManagedReference<SceneObject*> follow = getFollowObject().get();
+		int checked = 0, skipped = 0;
+
 		for (int i = 0; i < closeObjects.size(); ++i) {
 			SceneObject* scene = static_cast<SceneObject*>(closeObjects.getUnsafe(i));
 
@@ -807,10 +825,20 @@ void AiAgentImplementation::doAwarenessCheck() {
 			if (target->isPlayerCreature() && !target->isInvisible())
 				++newPlayerCount;
 
+			if (!checkAll && target != follow.get() && !batch->hasMoved(target)) {
+				++skipped;
+				continue;
+			}
+
+			++checked;
+
 			if (current->doAwarenessCheck(target)) {
 				interrupt(target, ObserverEventType::OBJECTINRANGEMOVED);
 			}
 		}
+
+		if (batch != nullptr)
+			AiAwarenessBatch::countTargets(checked, skipped);
 	}
 
 	if (newPlayerCount != -1) {
@@ -1354,6 +1382,8 @@ void AiAgentImplementation::notifyInsert(QuadTreeEntry* entry) {
 		if (newValue == 1) {
 			uint64 delay = 500 + System::random(1000);
 			activateAwarenessEvent(delay);
+
+			promoteTickLod();
 		}
 	}
 }
@@ -1601,6 +1631,14 @@ void AiAgentImplementation::activateAwarenessEvent(uint64 delay) {
 	if (vec == nullptr)
 		return;
 
+	Zone* zone = getZoneUnsafe();
+	AiAwarenessBatch* batch = zone != nullptr ? zone->getAiAwarenessBatch() : nullptr;
+
+	if (batch != nullptr) {
+		batch->add(asAiAgent(), delay);
+		return;
+	}
+
 	Locker locker(&awarenessEventMutex);
 
 	if (awarenessEvent == nullptr) {
@@ -1625,14 +1663,46 @@ void AiAgentImplementation::activateAwarenessEvent(uint64 delay) {
 }
 
 void AiAgentImplementation::activateRecovery() {
-	if (thinkEvent == nullptr) {
+	if (thinkEvent == nullptr)
 		thinkEvent = new AiThinkEvent(asAiAgent());
 
-		thinkEvent->schedule(2000);
+	if (!thinkEvent->isScheduled()) {
+		Zone* zone = getZoneUnsafe();
+		AiTickScheduler* scheduler = AiTickScheduler::instance();
+
+		tickLod = getTickLod();
+
+		uint64 delay = 2000 * scheduler->getMultiplier(tickLod);
+
+		thinkEvent->schedule(scheduler->scheduleTick(zone != nullptr ? zone->getZoneName() : "", tickLod, delay));
 	}
+}
+
+int AiAgentImplementation::getTickLod() {
+	if (numberOfPlayersInRange.get() > 0 || isInCombat())
+		return AiTickScheduler::FULL;
 
-	if (!thinkEvent->isScheduled())
-		thinkEvent->schedule(2000);
+	if (getFollowObject().get() != nullptr || isRetreating() || isFleeing())
+		return AiTickScheduler::SLOW;
+
+	return AiTickScheduler::DORMANT;
+}
+
+void AiAgentImplementation::promoteTickLod() {
+	if (tickLod == AiTickScheduler::FULL)
+		return;
+
+	tickLod = AiTickScheduler::FULL;
+
+	// the movement event picks the full rate up on its next step
+	Reference<AiThinkEvent*> event = thinkEvent;
+
+	if (event != nullptr && event->isScheduled())
+		event->reschedule(2000);
+}
+
+int AiAgentImplementation::getMovementTickInterval() {
+	return UPDATEMOVEMENTINTERVAL * AiTickScheduler::instance()->getMultiplier(getTickLod());
 }
 
 void AiAgentImplementation::activatePostureRecovery() {
@@ -1709,6 +1779,18 @@ void AiAgentImplementation::checkNewAngle() {
 	}
 }
 
+void AiAgentImplementation::notifyPathFound(CurrentFoundPath* path) {
+	Locker locker(&targetMutex);
+
+	pathRequestPending = false;
+
+	// the agent stopped or moved on to a target inside while the search ran
+	if (path == nullptr || path->size() < 2 || currentFoundPath == nullptr || targetCellObject != nullptr)
+		return;
+
+	currentFoundPath = path;
+}
+
 // It is important to know that the return of this function determines whether
 // or not an AI should try to continue finding positions next tick. If true,
 // the AI has not reached the first patrolPoint in their queue and if false,
@@ -1732,7 +1814,11 @@ bool AiAgentImplementation::findNextPosition(float maxDistance, bool walk) {
 	if (hasState(CreatureState::FROZEN))
 		newSpeed = 0.01f;
 
-	float updateTicks = float(UPDATEMOVEMENTINTERVAL) / 1000.f;
+	int tickInterval = getMovementTickInterval();
+
+	// a tick the zone budget deferred came late, the step makes up for it so the agent keeps its speed
+	float updateTicks = float(tickInterval + movementDeferral) / 1000.f;
+	movementDeferral = 0;
 
 	float maxSpeed = newSpeed*updateTicks; // now maxSpeed is the distance able to travel in time updateTicks
 
@@ -1784,7 +1870,25 @@ bool AiAgentImplementation::findNextPosition(float maxDistance, bool walk) {
 			// Don't recalculate path if mob hasn't entered the target cell yet (we already checked to make sure the target is still in the same cell)
 			if (currentCell == targetCoordinateCell && currentFoundPath->get(currentFoundPath->size() - 1).getWorldPosition().distanceTo(targetPosition.getCoordinates().getWorldPosition()) > 3) {
 				// Our target has moved, so we will need a new path with a new position.
-				path = currentFoundPath = static_cast<CurrentFoundPath*>(pathFinder->findPath(asAiAgent(), targetPosition.getCoordinates(), getZoneUnsafe()));
+				if (currentCell == nullptr && ConfigManager::instance()->getAiAsyncPathing()) {
+					// outside we keep walking the old path until the worker queue has the new one
+					if (!pathRequestPending) {
+						pathRequestPending = true;
+
+						ManagedReference<AiAgent*> agent = asAiAgent();
+
+						pathFinder->findPathAsync(asAiAgent(), targetPosition.getCoordinates(), [agent] (const Reference<Vector<WorldCoordinates>*>& path) {
+							agent->notifyPathFound(static_cast<CurrentFoundPath*>(path.get()));
+						});
+					}
+
+					WorldCoordinates curr(asAiAgent());
+					path = currentFoundPath;
+
+					path->set(0, curr);
+				} else {
+					path = currentFoundPath = static_cast<CurrentFoundPath*>(pathFinder->findPath(asAiAgent(), targetPosition.getCoordinates(), getZoneUnsafe()));
+				}
 			} else {
 				// Our target is close to where it was before, so our path begins where we are standing
 				WorldCoordinates curr(asAiAgent());
@@ -1978,8 +2082,7 @@ bool AiAgentImplementation::findNextPosition(float maxDistance, bool walk) {
 				direction.setHeadingDirection(directionangle);
 
 			float dist = fabs(thisWorldPos.distanceTo(nextWorldPos));
-			auto interval = UPDATEMOVEMENTINTERVAL;
-			nextMovementInterval = Math::min((int)((Math::min(dist, maxDist)/newSpeed)*1000 + 0.5), interval);
+			nextMovementInterval = Math::min((int)((Math::min(dist, maxDist)/newSpeed)*1000 + 0.5), tickInterval);
 			currentSpeed = newSpeed;
 
 			// Tell the clients where to expect us next tick -- requires that we have found a destination
@@ -2410,15 +2513,22 @@ void AiAgentImplementation::activateMovementEvent() {
 		return;
 	}
 
-	if (moveEvent == nullptr) {
+	if (moveEvent == nullptr)
 		moveEvent = new AiMoveEvent(asAiAgent());
 
-		moveEvent->schedule(Math::max(minScheduleTime, (uint64) (waitTime > 0 ? waitTime : nextMovementInterval)));
-	}
-
 	try {
-		if (!moveEvent->isScheduled())
-			moveEvent->schedule(Math::max(minScheduleTime, (uint64) (waitTime > 0 ? waitTime : nextMovementInterval)));
+		if (!moveEvent->isScheduled()) {
+			// nextMovementInterval already covers the step of the current level of detail
+			tickLod = getTickLod();
+
+			uint64 delay = Math::max(minScheduleTime, (uint64) (waitTime > 0 ? waitTime : nextMovementInterval));
+
+			uint64 scheduled = AiTickScheduler::instance()->scheduleTick(getZoneUnsafe()->getZoneName(), tickLod, delay);
+
+			movementDeferral = (int) (scheduled - delay);
+
+			moveEvent->schedule(scheduled);
+		}
 	} catch (IllegalArgumentException& e) {
 
 	}
@@ -2967,6 +3077,10 @@ void AiAgentImplementation::setupBehaviorTree(AiTemplate* getTarget, AiTemplate*
 	else if (creatureBitmask & CreatureFlag::PACK)
 		name = "CompositePack";
 
+	// prefer the compiled composite when the ai scripts register one
+	if (AiMap::instance()->getBehavior("Native" + name) != nullptr)
+		name = "Native" + name;
+
 	CompositeBehavior* rootSelector = cast<CompositeBehavior*>(AiMap::instance()->createNewInstance(asAiAgent(), name, AiMap::SELECTORBEHAVIOR));
 	CompositeBehavior* attackSequence = cast<CompositeBehavior*>(AiMap::instance()->createNewInstance(asAiAgent(), name, AiMap::SEQUENCEBEHAVIOR));
 	rootSelector->setID(STRING_HASHCODE("root"));
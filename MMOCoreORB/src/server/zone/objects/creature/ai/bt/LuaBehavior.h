@@ -51,46 +51,46 @@ public:
 	 * @pre { agent is locked }
 	 * @post { agent is locked }
 	 */
-	bool checkConditions(AiAgent* agent);
+	virtual bool checkConditions(AiAgent* agent);
 
 	/**
 	 * Script call to interface
 	 * @pre { agent is locked }
 	 * @post { agent is locked }
 	 */
-	void start(AiAgent* agent);
+	virtual void start(AiAgent* agent);
 
 	/**
 	 * Script call to interface
 	 * @pre { agent is locked }
 	 * @post { agent is locked }
 	 */
-	float end(AiAgent* agent);
+	virtual float end(AiAgent* agent);
 
 	/**
 	 * Script call to interface
 	 * @pre { agent is locked }
 	 * @post { agent is locked }
 	 */
-	int doAction(AiAgent* agent);
+	virtual int doAction(AiAgent* agent);
 
 	/**
 	 * Script call to interface
 	 * @pre { agent is locked }
 	 * @post { agent is locked }
 	 */
-	int interrupt(AiAgent* agent, SceneObject* source, int64 msg);
+	virtual int interrupt(AiAgent* agent, SceneObject* source, int64 msg);
 
 	/**
 	 * Script call to interface
 	 * @pre { agent is locked }
 	 * @post { agent is locked }
 	 */
-	bool doAwarenessCheck(AiAgent* agent, SceneObject* target);
+	virtual bool doAwarenessCheck(AiAgent* agent, SceneObject* target);
 
 	virtual uint16 getType();
 
-	String print() {
+	virtual String print() {
 		return this->className;
 	}
 
@@ -0,0 +1,292 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "NativeBehavior.h"
+#include "server/zone/managers/creature/AiMap.h"
+#include "server/zone/objects/creature/ai/AiAgent.h"
+#include "templates/params/ObserverEventType.h"
+#include "templates/params/creature/CreatureState.h"
+#include "templates/params/creature/CreaturePosture.h"
+
+NativeBehavior* NativeBehavior::createNativeBehavior(const String& node, const String& name, const String& interruptClass) {
+	if (node == "Composite")
+		return new NativeCompositeBehavior(name, interruptClass);
+	else if (node == "Move")
+		return new NativeMoveBehavior(name, interruptClass, false);
+	else if (node == "Walk")
+		return new NativeMoveBehavior(name, interruptClass, true);
+	else if (node == "CombatMove")
+		return new NativeCombatMoveBehavior(name, interruptClass);
+	else if (node == "Wait")
+		return new NativeWaitBehavior(name, interruptClass, false);
+	else if (node == "Wait10")
+		return new NativeWaitBehavior(name, interruptClass, true);
+	else if (node == "GeneratePatrol")
+		return new NativeGeneratePatrolBehavior(name, interruptClass);
+	else if (node == "GetTarget")
+		return new NativeGetTargetBehavior(name, interruptClass);
+	else if (node == "SelectWeapon")
+		return new NativeSelectWeaponBehavior(name, interruptClass);
+	else if (node == "SelectAttack")
+		return new NativeSelectAttackBehavior(name, interruptClass);
+	else if (node == "Leash")
+		return new NativeLeashBehavior(name, interruptClass);
+
+	return nullptr;
+}
+
+bool NativeBehavior::shouldRetreat(AiAgent* agent, float range) {
+	if (agent->isRetreating())
+		return false;
+
+	PatrolPoint* homeLocation = agent->getHomeLocation();
+	ManagedReference<SceneObject*> target = agent->getFollowObject().get();
+
+	if (target != nullptr)
+		return !homeLocation->isInRange(target, range);
+
+	return !homeLocation->isInRange(agent, range);
+}
+
+bool NativeBehavior::checkConditions(AiAgent* agent) {
+	return agent != nullptr;
+}
+
+void NativeBehavior::start(AiAgent* agent) {
+}
+
+float NativeBehavior::end(AiAgent* agent) {
+	return 0;
+}
+
+int NativeBehavior::doAction(AiAgent* agent) {
+	return AiMap::SUCCESS;
+}
+
+int NativeCompositeBehavior::doAction(AiAgent* agent) {
+	if (agent == nullptr)
+		return AiMap::INVALID;
+
+	return agent->getBehaviorStatus();
+}
+
+bool NativeMoveBehavior::checkConditions(AiAgent* agent) {
+	if (agent == nullptr)
+		return false;
+
+	if (agent->getPosture() != CreaturePosture::UPRIGHT || agent->setDestination() <= 0)
+		return false;
+
+	if (shouldRetreat(agent, 256)) {
+		agent->leash();
+		return false;
+	}
+
+	return true;
+}
+
+int NativeMoveBehavior::doAction(AiAgent* agent) {
+	if (agent == nullptr)
+		return AiMap::FAILURE;
+
+	if (agent->getCurrentSpeed() > 0)
+		agent->completeMove();
+
+	if (agent->findNextPosition(agent->getMaxDistance(), walk))
+		return AiMap::RUNNING;
+
+	return AiMap::SUCCESS;
+}
+
+int NativeCombatMoveBehavior::doAction(AiAgent* agent) {
+	if (agent == nullptr)
+		return AiMap::FAILURE;
+
+	if (agent->getCurrentSpeed() > 0)
+		agent->completeMove();
+
+	agent->findNextPosition(agent->getMaxDistance(), false);
+
+	ManagedReference<SceneObject*> target = agent->getFollowObject().get();
+
+	if (target != nullptr && target->isCreatureObject() && target->asCreatureObject()->getTargetID() == agent->getObjectID())
+		agent->broadcastInterrupt(ObserverEventType::STARTCOMBAT);
+
+	return AiMap::SUCCESS;
+}
+
+void NativeWaitBehavior::start(AiAgent* agent) {
+	if (agent == nullptr)
+		return;
+
+	if (randomWait)
+		agent->setWait((System::random(9) + 6) * 1000);
+	else
+		agent->setWait(-1000);
+}
+
+float NativeWaitBehavior::end(AiAgent* agent) {
+	if (agent != nullptr)
+		agent->setWait(0);
+
+	return 0;
+}
+
+int NativeWaitBehavior::doAction(AiAgent* agent) {
+	if (agent != nullptr && agent->isWaiting())
+		return AiMap::RUNNING;
+
+	return AiMap::SUCCESS;
+}
+
+bool NativeGeneratePatrolBehavior::checkConditions(AiAgent* agent) {
+	return agent != nullptr && agent->getPatrolPointSize() == 0;
+}
+
+int NativeGeneratePatrolBehavior::doAction(AiAgent* agent) {
+	if (agent != nullptr && agent->generatePatrol(5, 10))
+		return AiMap::SUCCESS;
+
+	return AiMap::FAILURE;
+}
+
+bool NativeGetTargetBehavior::checkConditions(AiAgent* agent) {
+	if (agent == nullptr)
+		return false;
+
+	if (agent->isDead()) {
+		agent->clearCombatState(true);
+		agent->setOblivious();
+		agent->info("check conditions target for skipped dead target", true);
+
+		return false;
+	}
+
+	return true;
+}
+
+int NativeGetTargetBehavior::checkTarget(AiAgent* agent, SceneObject* target, int randomLevel) {
+	if (target == nullptr)
+		return AiMap::RUNNING;
+
+	ManagedReference<SceneObject*> followObject = agent->getFollowObject().get();
+
+	if (target != followObject.get()) {
+		if (agent->validateTarget(target)) {
+			agent->setFollowObject(target);
+			agent->setDefender(target);
+
+			return AiMap::SUCCESS;
+		}
+	} else if (agent->validateTarget()) {
+		bool followAtPeace = followObject->isCreatureObject() && followObject->asCreatureObject()->hasState(CreatureState::PEACE);
+		bool aggressive = target->isCreatureObject() && agent->isAggressiveTo(target->asCreatureObject());
+
+		if (followAtPeace && randomLevel == 1 && !aggressive) {
+			agent->clearCombatState(true);
+			agent->setOblivious();
+
+			return AiMap::FAILURE;
+		}
+
+		agent->setDefender(target);
+
+		return AiMap::SUCCESS;
+	}
+
+	return AiMap::RUNNING;
+}
+
+int NativeGetTargetBehavior::doAction(AiAgent* agent) {
+	if (agent == nullptr)
+		return AiMap::FAILURE;
+
+	int level = agent->getLevel();
+	int randomLevel = level > 0 ? System::random(level - 1) + 1 : 1;
+
+	ManagedReference<SceneObject*> target = agent->getTargetFromMap();
+
+	int res = checkTarget(agent, target, randomLevel);
+
+	if (res != AiMap::RUNNING)
+		return res;
+
+	target = agent->getTargetFromDefenders();
+
+	res = checkTarget(agent, target, randomLevel);
+
+	if (res != AiMap::RUNNING)
+		return res;
+
+	if (agent->isInCombat()) {
+		agent->clearCombatState(true);
+		agent->setOblivious();
+	}
+
+	return AiMap::FAILURE;
+}
+
+bool NativeSelectWeaponBehavior::checkConditions(AiAgent* agent) {
+	if (agent == nullptr)
+		return false;
+
+	if (agent->isDead()) {
+		agent->removeDefenders();
+		agent->setFollowObject(nullptr);
+
+		return false;
+	}
+
+	return true;
+}
+
+int NativeSelectWeaponBehavior::doAction(AiAgent* agent) {
+	if (agent == nullptr)
+		return AiMap::FAILURE;
+
+	agent->selectWeapon();
+
+	return AiMap::SUCCESS;
+}
+
+int NativeSelectAttackBehavior::doAction(AiAgent* agent) {
+	if (agent == nullptr)
+		return AiMap::FAILURE;
+
+	if (agent->getCommandQueueSize() > 3)
+		return AiMap::SUCCESS;
+
+	if (agent->isCreature()) {
+		if (System::random(4) != 0) {
+			agent->selectDefaultAttack();
+		} else {
+			agent->selectSpecialAttack();
+
+			if (!agent->validateStateAttack())
+				agent->selectDefaultAttack();
+		}
+	} else {
+		agent->selectSpecialAttack();
+
+		if (!agent->validateStateAttack() || System::random(2) == 0)
+			agent->selectDefaultAttack();
+	}
+
+	agent->enqueueAttack();
+
+	return AiMap::SUCCESS;
+}
+
+bool NativeLeashBehavior::checkConditions(AiAgent* agent) {
+	return agent != nullptr && shouldRetreat(agent, 256);
+}
+
+int NativeLeashBehavior::doAction(AiAgent* agent) {
+	if (agent == nullptr)
+		return AiMap::FAILURE;
+
+	agent->leash();
+
+	return AiMap::SUCCESS;
+}
@@ -0,0 +1,194 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef NATIVEBEHAVIOR_H_
+#define NATIVEBEHAVIOR_H_
+
+#include "engine/engine.h"
+#include "server/zone/objects/creature/ai/bt/LuaBehavior.h"
+
+namespace server {
+namespace zone {
+namespace objects {
+namespace creature {
+namespace ai {
+class AiAgent;
+namespace bt {
+
+/**
+ * Behavior interface implemented in C++ instead of a lua class, so ticking it
+ * doesn't need a LuaFunction call per node. Interrupts and awareness checks are
+ * still forwarded to the lua interrupt class the node is registered with.
+ */
+class NativeBehavior : public LuaBehavior {
+protected:
+	String nodeName;
+
+public:
+	NativeBehavior(const String& name, const String& interruptClass) : LuaBehavior(interruptClass), nodeName(name) {
+	}
+
+	NativeBehavior(const NativeBehavior& b) : LuaBehavior(b), nodeName(b.nodeName) {
+	}
+
+	virtual bool checkConditions(AiAgent* agent);
+
+	virtual void start(AiAgent* agent);
+
+	virtual float end(AiAgent* agent);
+
+	virtual int doAction(AiAgent* agent);
+
+	String print() {
+		return nodeName;
+	}
+
+	/**
+	 * Creates the native node called node, registered as name and interrupted through interruptClass.
+	 * Returns nullptr if there is no native node called node.
+	 */
+	static NativeBehavior* createNativeBehavior(const String& node, const String& name, const String& interruptClass);
+
+protected:
+	/**
+	 * Same check as LuaAiAgent::shouldRetreat
+	 */
+	static bool shouldRetreat(AiAgent* agent, float range);
+};
+
+/**
+ * Composite: reports the status of the running child.
+ */
+class NativeCompositeBehavior : public NativeBehavior {
+public:
+	NativeCompositeBehavior(const String& name, const String& interruptClass) : NativeBehavior(name, interruptClass) {
+	}
+
+	int doAction(AiAgent* agent);
+};
+
+/**
+ * Move, Walk: follows the current destination, leashing when too far from home.
+ */
+class NativeMoveBehavior : public NativeBehavior {
+protected:
+	bool walk;
+
+public:
+	NativeMoveBehavior(const String& name, const String& interruptClass, bool walking) : NativeBehavior(name, interruptClass), walk(walking) {
+	}
+
+	bool checkConditions(AiAgent* agent);
+
+	int doAction(AiAgent* agent);
+};
+
+/**
+ * CombatMove: moves towards the follow object and pulls in the agents around when it's targeted back.
+ */
+class NativeCombatMoveBehavior : public NativeMoveBehavior {
+public:
+	NativeCombatMoveBehavior(const String& name, const String& interruptClass) : NativeMoveBehavior(name, interruptClass, false) {
+	}
+
+	int doAction(AiAgent* agent);
+};
+
+/**
+ * Wait, Wait10: waits forever or a random 6 to 15 seconds.
+ */
+class NativeWaitBehavior : public NativeBehavior {
+protected:
+	bool randomWait;
+
+public:
+	NativeWaitBehavior(const String& name, const String& interruptClass, bool random) : NativeBehavior(name, interruptClass), randomWait(random) {
+	}
+
+	void start(AiAgent* agent);
+
+	float end(AiAgent* agent);
+
+	int doAction(AiAgent* agent);
+};
+
+/**
+ * GeneratePatrol: generates wander points when the agent has none left.
+ */
+class NativeGeneratePatrolBehavior : public NativeBehavior {
+public:
+	NativeGeneratePatrolBehavior(const String& name, const String& interruptClass) : NativeBehavior(name, interruptClass) {
+	}
+
+	bool checkConditions(AiAgent* agent);
+
+	int doAction(AiAgent* agent);
+};
+
+/**
+ * GetTarget: picks the target from the threat map or the defenders.
+ */
+class NativeGetTargetBehavior : public NativeBehavior {
+public:
+	NativeGetTargetBehavior(const String& name, const String& interruptClass) : NativeBehavior(name, interruptClass) {
+	}
+
+	bool checkConditions(AiAgent* agent);
+
+	int doAction(AiAgent* agent);
+
+private:
+	/**
+	 * Returns SUCCESS or FAILURE when target decided the outcome, RUNNING to keep looking.
+	 */
+	int checkTarget(AiAgent* agent, SceneObject* target, int randomLevel);
+};
+
+/**
+ * SelectWeapon
+ */
+class NativeSelectWeaponBehavior : public NativeBehavior {
+public:
+	NativeSelectWeaponBehavior(const String& name, const String& interruptClass) : NativeBehavior(name, interruptClass) {
+	}
+
+	bool checkConditions(AiAgent* agent);
+
+	int doAction(AiAgent* agent);
+};
+
+/**
+ * SelectAttack: picks a default or special attack and queues it.
+ */
+class NativeSelectAttackBehavior : public NativeSelectWeaponBehavior {
+public:
+	NativeSelectAttackBehavior(const String& name, const String& interruptClass) : NativeSelectWeaponBehavior(name, interruptClass) {
+	}
+
+	int doAction(AiAgent* agent);
+};
+
+/**
+ * Leash: sends the agent home once it's dragged too far away.
+ */
+class NativeLeashBehavior : public NativeBehavior {
+public:
+	NativeLeashBehavior(const String& name, const String& interruptClass) : NativeBehavior(name, interruptClass) {
+	}
+
+	bool checkConditions(AiAgent* agent);
+
+	int doAction(AiAgent* agent);
+};
+
+}
+}
+}
+}
+}
+}
+
+using namespace server::zone::objects::creature::ai::bt;
+
+#endif /* NATIVEBEHAVIOR_H_ */
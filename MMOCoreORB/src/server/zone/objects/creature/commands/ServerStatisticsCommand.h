@@ -10,6 +10,12 @@
 
 #include "engine/engine.h"
 #include "server/zone/managers/statistics/StatisticsManager.h"
+#include "server/zone/managers/collision/PathFinderManager.h"
+#include "server/zone/managers/creature/AiTickScheduler.h"
+#include "server/zone/managers/creature/AiAwarenessBatch.h"
+#include "server/chat/room/ChatRoomDelivery.h"
+#include "server/db/DatabaseStatistics.h"
+#include "server/zone/objects/transaction/TransactionLog.h"
 
 class ServerStatisticsCommand {
 public:
@@ -31,6 +37,12 @@ public:
 			}
 		} else {
 			creature->sendSystemMessage(StatisticsManager::instance()->getStatistics());
+			creature->sendSystemMessage("Path cache: " + PathFinderManager::instance()->getPathCache()->getStatistics());
+			creature->sendSystemMessage(AiTickScheduler::instance()->getStatistics());
+			creature->sendSystemMessage(AiAwarenessBatch::getStatistics());
+			creature->sendSystemMessage(ChatRoomDelivery::instance()->getStatistics());
+			creature->sendSystemMessage(DatabaseStatistics::instance()->getStatistics());
+			creature->sendSystemMessage(TransactionLog::getWriterStatistics());
 		}
 
 		return 0;
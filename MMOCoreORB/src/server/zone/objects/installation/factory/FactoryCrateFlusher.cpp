@@ -0,0 +1,59 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "FactoryCrateFlusher.h"
+#include "server/zone/objects/installation/factory/FactoryObject.h"
+
+FactoryCrateFlusher::FactoryCrateFlusher() : Logger("FactoryCrateFlusher") {
+	factories.setNoDuplicateInsertPlan();
+}
+
+void FactoryCrateFlusher::add(FactoryObject* factory) {
+	Locker locker(&mutex);
+
+	factories.put(factory->getObjectID(), factory);
+}
+
+void FactoryCrateFlusher::remove(uint64 factoryID) {
+	Locker locker(&mutex);
+
+	factories.drop(factoryID);
+}
+
+int FactoryCrateFlusher::flushAll() {
+	Vector<ManagedReference<FactoryObject*> > pending;
+
+	{
+		Locker locker(&mutex);
+
+		for (int i = 0; i < factories.size(); ++i) {
+			ManagedReference<FactoryObject*> factory = factories.elementAt(i).getValue().get();
+
+			if (factory != nullptr)
+				pending.add(factory);
+		}
+
+		factories.removeAll();
+	}
+
+	for (int i = 0; i < pending.size(); ++i) {
+		FactoryObject* factory = pending.getUnsafe(i);
+
+		Locker locker(factory);
+
+		flush(factory);
+	}
+
+	return pending.size();
+}
+
+void FactoryCrateFlusher::flush(FactoryObject* factory) {
+	factory->flushOutputCrate();
+}
+
+int FactoryCrateFlusher::size() {
+	Locker locker(&mutex);
+
+	return factories.size();
+}
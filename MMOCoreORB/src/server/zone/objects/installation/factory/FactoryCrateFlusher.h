@@ -0,0 +1,94 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef FACTORYCRATEFLUSHER_H_
+#define FACTORYCRATEFLUSHER_H_
+
+#include "engine/engine.h"
+
+namespace server {
+namespace zone {
+namespace objects {
+namespace installation {
+namespace factory {
+	class FactoryObject;
+}
+}
+}
+}
+}
+
+using namespace server::zone::objects::installation::factory;
+
+/**
+ * Units a factory made into its output crate since the crate use count was last written.
+ */
+class FactoryCrateUnits {
+	int pending;
+
+public:
+	FactoryCrateUnits() : pending(0) {
+	}
+
+	/**
+	 * Counts a new unit into a crate holding useCount of maxCapacity
+	 * @param writeNow the count has to be written anyway (lazy crates off or the hopper is open)
+	 * @return true when the use count has to be written now
+	 */
+	bool add(int useCount, int maxCapacity, bool writeNow) {
+		++pending;
+
+		return writeNow || isFull(useCount, maxCapacity);
+	}
+
+	bool isFull(int useCount, int maxCapacity) const {
+		return useCount + pending >= maxCapacity;
+	}
+
+	/**
+	 * Returns the pending units and clears them
+	 */
+	int take() {
+		int units = pending;
+		pending = 0;
+
+		return units;
+	}
+
+	int get() const {
+		return pending;
+	}
+};
+
+/**
+ * Factories holding units that aren't written into their output crate yet. The count is
+ * transient, so the server writes them all before its final save.
+ */
+class FactoryCrateFlusher : public Singleton<FactoryCrateFlusher>, public Logger, public Object {
+protected:
+	VectorMap<uint64, ManagedWeakReference<FactoryObject*> > factories;
+	Mutex mutex;
+
+	/**
+	 * @pre { factory locked }
+	 */
+	virtual void flush(FactoryObject* factory);
+
+public:
+	FactoryCrateFlusher();
+
+	void add(FactoryObject* factory);
+
+	void remove(uint64 factoryID);
+
+	/**
+	 * Writes the pending units of every factory into its crate
+	 * @return number of factories flushed
+	 */
+	int flushAll();
+
+	int size();
+};
+
+#endif /* FACTORYCRATEFLUSHER_H_ */
@@ -13,6 +13,7 @@
 #include "server/chat/ChatManager.h"
 #include "server/zone/packets/factory/FactoryCrateObjectDeltaMessage3.h"
 #include "server/zone/managers/object/ObjectManager.h"
+#include "conf/ConfigManager.h"
 
 #include "server/zone/objects/player/PlayerObject.h"
 #include "server/zone/objects/player/sui/listbox/SuiListBox.h"
@@ -264,8 +265,20 @@ void FactoryObjectImplementation::openHopper(Observable* observable, ManagedObje
 	if(creo == nullptr || outputHopper == nullptr || !creo->isPlayerCreature())
 		return;
 
-	if(observable == outputHopper)
-		operatorList.add(creo);
+	if(observable != outputHopper)
+		return;
+
+	operatorList.add(creo);
+
+	if (pendingCrateUnits.get() > 0) {
+		ManagedReference<FactoryObject*> factory = _this.getReferenceUnsafeStaticCast();
+
+		Core::getTaskManager()->executeTask([factory] () {
+			Locker locker(factory);
+
+			factory->flushOutputCrate();
+		}, "FlushFactoryCrateLambda");
+	}
 }
 
 void FactoryObjectImplementation::closeHopper(Observable* observable, ManagedObject* arg1) {
@@ -478,6 +491,9 @@ void FactoryObjectImplementation::stopFactory(const String& message, const Strin
 	if(pending != nullptr && pending->isScheduled())
 		pending->cancel();
 
+	flushOutputCrate();
+	outputCrate = nullptr;
+
 	//Send out email informing them why their factory stopped
 	ManagedReference<ChatManager*> chatManager = server->getChatManager();
 
@@ -587,24 +603,8 @@ void FactoryObjectImplementation::createNewObject() {
 	if (crateSize > 1) {
 		String crateType = schematic->getFactoryCrateType();
 
-		ManagedReference<FactoryCrate*> crate = locateCrateInOutputHopper(prototype);
-
-		if (crate == nullptr)
-			crate = createNewFactoryCrate(prototype, crateSize, crateType);
-		else {
-			Locker clocker(crate, _this.getReferenceUnsafeStaticCast());
-			crate->setUseCount(crate->getUseCount() + 1, false);
-
-			FactoryCrateObjectDeltaMessage3* dfcty3 = new FactoryCrateObjectDeltaMessage3(crate);
-			dfcty3->setQuantity(crate->getUseCount());
-			dfcty3->close();
-
-			broadcastToOperators(dfcty3);
-		}
-
-		if (crate == nullptr) {
+		if (!addToOutputCrate(prototype, crateSize, crateType))
 			return;
-		}
 	} else {
 		ManagedReference<TangibleObject*> newItem = createNewUncratedItem(prototype);
 
@@ -632,6 +632,79 @@ void FactoryObjectImplementation::createNewObject() {
 		stopFactory("manf_error", "", "", -1);
 }
 
+bool FactoryObjectImplementation::addToOutputCrate(TangibleObject* prototype, int crateSize, String& crateType) {
+	ManagedReference<FactoryCrate*> crate = outputCrate;
+
+	if (crate != nullptr) {
+		ManagedReference<SceneObject*> outputHopper = getSlottedObject("output_hopper");
+
+		bool full = false;
+
+		{
+			Locker clocker(crate, _this.getReferenceUnsafeStaticCast());
+
+			full = pendingCrateUnits.isFull(crate->getUseCount(), crate->getMaxCapacity());
+		}
+
+		if (crate->getParent().get() != outputHopper || full) {
+			flushOutputCrate();
+
+			crate = nullptr;
+		}
+	}
+
+	if (crate == nullptr) {
+		crate = locateCrateInOutputHopper(prototype);
+
+		if (crate == nullptr) {
+			// a new crate starts out holding this unit
+			outputCrate = createNewFactoryCrate(prototype, crateSize, crateType);
+
+			return outputCrate != nullptr;
+		}
+
+		outputCrate = crate;
+	}
+
+	// keep the count live for anyone looking into the hopper
+	bool writeNow = !ConfigManager::instance()->getLazyFactoryCrates() || operatorList.size() > 0;
+
+	{
+		Locker clocker(crate, _this.getReferenceUnsafeStaticCast());
+
+		writeNow = pendingCrateUnits.add(crate->getUseCount(), crate->getMaxCapacity(), writeNow);
+	}
+
+	if (writeNow)
+		flushOutputCrate();
+	else if (pendingCrateUnits.get() == 1)
+		FactoryCrateFlusher::instance()->add(_this.getReferenceUnsafeStaticCast());
+
+	return true;
+}
+
+void FactoryObjectImplementation::flushOutputCrate() {
+	ManagedReference<FactoryCrate*> crate = outputCrate;
+
+	int units = pendingCrateUnits.take();
+
+	if (units > 0)
+		FactoryCrateFlusher::instance()->remove(getObjectID());
+
+	if (crate == nullptr || units <= 0)
+		return;
+
+	Locker clocker(crate, _this.getReferenceUnsafeStaticCast());
+
+	crate->setUseCount(crate->getUseCount() + units, false);
+
+	FactoryCrateObjectDeltaMessage3* dfcty3 = new FactoryCrateObjectDeltaMessage3(crate);
+	dfcty3->setQuantity(crate->getUseCount());
+	dfcty3->close();
+
+	broadcastToOperators(dfcty3);
+}
+
 FactoryCrate* FactoryObjectImplementation::locateCrateInOutputHopper(TangibleObject* prototype) {
 
 	ManagedReference<SceneObject*> outputHopper = getSlottedObject("output_hopper");
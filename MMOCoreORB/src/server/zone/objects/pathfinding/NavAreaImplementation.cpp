@@ -1,6 +1,7 @@
 #include <cstdint>
 #include "server/zone/objects/pathfinding/NavArea.h"
 #include "server/zone/managers/collision/NavMeshManager.h"
+#include "server/zone/managers/collision/PathFinderManager.h"
 #include "server/zone/managers/planet/PlanetManager.h"
 #include "server/zone/Zone.h"
 #include "server/zone/ZoneProcessServer.h"
@@ -13,6 +14,8 @@ void NavAreaImplementation::destroyObjectFromWorld(bool sendSelfDestroy) {
 
 	NavMeshManager::instance()->cancelJobs(asNavArea());
 
+	PathFinderManager::instance()->getPathCache()->notifyNavMeshRemoved(getObjectID());
+
 	if (zone != nullptr) {
 		PlanetManager* planetManager = zone->getPlanetManager();
 
@@ -9,6 +9,8 @@
 
 #include "server/zone/objects/player/sui/listbox/SuiListBox.h"
 
+#include <vector>
+
 void ResourceSpawnImplementation::fillAttributeList(AttributeListMessage* alm,
 		CreatureObject* object) {
 
@@ -202,6 +204,36 @@ float ResourceSpawnImplementation::getDensityAt(const String& zoneName, float x,
 	return map.getDensityAt(x, y);
 }
 
+void ResourceSpawnImplementation::getDensityGrid(const String& zoneName, float originX, float originY, float spacing, int points, Vector<float>& densities) const {
+	densities.removeAll(points * points, 1);
+
+	int count = points * points;
+
+	if (!inShift() || !spawnMaps.contains(zoneName)) {
+		for (int i = 0; i < count; ++i)
+			densities.add(0);
+
+		return;
+	}
+
+	// one copy of the map for the whole grid
+	const SpawnDensityMap map = spawnMaps.get(zoneName);
+
+	std::vector<float> x(count), y(count), values(count);
+
+	for (int i = 0; i < points; ++i) {
+		for (int j = 0; j < points; ++j) {
+			x[i * points + j] = originX + j * spacing;
+			y[i * points + j] = originY - i * spacing;
+		}
+	}
+
+	map.getDensitiesAt(x.data(), y.data(), values.data(), count);
+
+	for (int i = 0; i < count; ++i)
+		densities.add(values[i]);
+}
+
 String ResourceSpawnImplementation::getSpawnMapZone(int i) const {
 	if (spawnMaps.size() > i)
 		return spawnMaps.getKey(i);
@@ -114,6 +114,32 @@ public:
 		return value * density;
 	}
 
+	/**
+	 * Densities at count points, as getDensityAt for each of them
+	 */
+	void getDensitiesAt(const float* x, const float* y, float* densities, int count) const {
+		const static int BLOCKSIZE = 64;
+
+		float noiseX[BLOCKSIZE];
+		float noiseY[BLOCKSIZE];
+
+		for (int start = 0; start < count; start += BLOCKSIZE) {
+			int size = Math::min(BLOCKSIZE, count - start);
+
+			for (int i = 0; i < size; ++i) {
+				noiseX[i] = (x[start + i] - minX) * modifier;
+				noiseY[i] = (maxY - y[start + i]) * modifier;
+			}
+
+			float* values = &densities[start];
+
+			SimplexNoise::noise(noiseX, noiseY, seed * modifier, values, size);
+
+			for (int i = 0; i < size; ++i)
+				values[i] = values[i] < 0 ? 0 : values[i] * density;
+		}
+	}
+
 	void print() const {
 		System::out << "Seed: " << seed << " Modifier: "
 				<< modifier << " Density: " << density << endl;
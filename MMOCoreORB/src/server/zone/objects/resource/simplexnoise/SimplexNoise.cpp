@@ -40,6 +40,10 @@
 
 #include	"SimplexNoise.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #define FASTFLOOR(x) ( ((x)>0) ? ((int)x) : (((int)x)-1) )
 
 //---------------------------------------------------------------------
@@ -474,3 +478,149 @@ float SimplexNoise::noise(float x, float y, float z, float w) {
     return 27.0f * (n0 + n1 + n2 + n3 + n4); // TODO: The scale factor is preliminary!
   }
 //---------------------------------------------------------------------
+
+#ifdef __SSE2__
+static inline __m128 select( __m128 mask, __m128 a, __m128 b ) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// grad( int hash, float x, float y , float z ) for four hashes
+static inline __m128 grad4( __m128i hash, __m128 x, __m128 y, __m128 z ) {
+    __m128i h = _mm_and_si128(hash, _mm_set1_epi32(15));
+
+    __m128 hLt8 = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(8)));
+    __m128 hLt4 = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(4)));
+    __m128 h12or14 = _mm_castsi128_ps(_mm_or_si128(_mm_cmpeq_epi32(h, _mm_set1_epi32(12)),
+                                                   _mm_cmpeq_epi32(h, _mm_set1_epi32(14))));
+
+    __m128 u = select(hLt8, x, y);
+    __m128 v = select(hLt4, y, select(h12or14, x, z));
+
+    // bit 0 flips the sign of u, bit 1 the sign of v
+    __m128 signU = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(1)), 31));
+    __m128 signV = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(2)), 30));
+
+    return _mm_add_ps(_mm_xor_ps(u, signU), _mm_xor_ps(v, signV));
+}
+
+// t^4 * grad for t = 0.6 - x*x - y*y - z*z, nothing past the corner's radius
+static inline __m128 corner4( __m128i hash, __m128 x, __m128 y, __m128 z ) {
+    __m128 t = _mm_sub_ps(_mm_set1_ps(0.6f),
+                          _mm_add_ps(_mm_mul_ps(x, x), _mm_add_ps(_mm_mul_ps(y, y), _mm_mul_ps(z, z))));
+    t = _mm_max_ps(t, _mm_setzero_ps());
+    t = _mm_mul_ps(t, t);
+
+    return _mm_mul_ps(_mm_mul_ps(t, t), grad4(hash, x, y, z));
+}
+
+// a * b in double precision, rounded back to float, like the float * double of the scalar code
+static inline __m128 mulDouble( __m128 a, double b ) {
+    __m128d vb = _mm_set1_pd(b);
+    __m128d lo = _mm_mul_pd(_mm_cvtps_pd(a), vb);
+    __m128d hi = _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(a, a)), vb);
+
+    return _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi));
+}
+
+static inline __m128i fastfloor4( __m128 x ) {
+    // truncation, minus one where x <= 0 like FASTFLOOR
+    return _mm_add_epi32(_mm_cvttps_epi32(x), _mm_castps_si128(_mm_cmple_ps(x, _mm_setzero_ps())));
+}
+#endif
+
+// 3D simplex noise, batch of points on one z plane
+void SimplexNoise::noise( const float* x, const float* y, float z, float* out, int count ) {
+    int n = 0;
+
+#ifdef __SSE2__
+    const __m128 vz = _mm_set1_ps(z);
+    const __m128 g3 = _mm_set1_ps((float) G3);
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    alignas(16) int ci[4], cj[4], ck[4];
+    alignas(16) int hash0[4], hash1[4], hash2[4], hash3[4];
+
+    for (; n + 4 <= count; n += 4) {
+        __m128 vx = _mm_loadu_ps(&x[n]);
+        __m128 vy = _mm_loadu_ps(&y[n]);
+
+        // Skew the input space to determine which simplex cell we're in
+        __m128 s = mulDouble(_mm_add_ps(_mm_add_ps(vx, vy), vz), F3);
+        __m128i i = fastfloor4(_mm_add_ps(vx, s));
+        __m128i j = fastfloor4(_mm_add_ps(vy, s));
+        __m128i k = fastfloor4(_mm_add_ps(vz, s));
+
+        __m128 t = mulDouble(_mm_cvtepi32_ps(_mm_add_epi32(_mm_add_epi32(i, j), k)), G3);
+        __m128 x0 = _mm_sub_ps(vx, _mm_sub_ps(_mm_cvtepi32_ps(i), t));
+        __m128 y0 = _mm_sub_ps(vy, _mm_sub_ps(_mm_cvtepi32_ps(j), t));
+        __m128 z0 = _mm_sub_ps(vz, _mm_sub_ps(_mm_cvtepi32_ps(k), t));
+
+        // The corner order of the simplex, without the branches
+        __m128 xGeY = _mm_cmpge_ps(x0, y0);
+        __m128 xGeZ = _mm_cmpge_ps(x0, z0);
+        __m128 yGtX = _mm_cmpgt_ps(y0, x0);
+        __m128 yGeZ = _mm_cmpge_ps(y0, z0);
+        __m128 zGtX = _mm_cmpgt_ps(z0, x0);
+        __m128 zGtY = _mm_cmpgt_ps(z0, y0);
+
+        __m128 mi1 = _mm_and_ps(xGeY, xGeZ);
+        __m128 mj1 = _mm_and_ps(yGtX, yGeZ);
+        __m128 mk1 = _mm_and_ps(zGtX, zGtY);
+        __m128 mi2 = _mm_or_ps(xGeY, xGeZ);
+        __m128 mj2 = _mm_or_ps(yGtX, yGeZ);
+        __m128 mk2 = _mm_or_ps(zGtX, zGtY);
+
+        __m128 i1 = _mm_and_ps(mi1, one);
+        __m128 j1 = _mm_and_ps(mj1, one);
+        __m128 k1 = _mm_and_ps(mk1, one);
+        __m128 i2 = _mm_and_ps(mi2, one);
+        __m128 j2 = _mm_and_ps(mj2, one);
+        __m128 k2 = _mm_and_ps(mk2, one);
+
+        __m128 x1 = _mm_add_ps(_mm_sub_ps(x0, i1), g3);
+        __m128 y1 = _mm_add_ps(_mm_sub_ps(y0, j1), g3);
+        __m128 z1 = _mm_add_ps(_mm_sub_ps(z0, k1), g3);
+        __m128 g3x2 = _mm_add_ps(g3, g3);
+        __m128 x2 = _mm_add_ps(_mm_sub_ps(x0, i2), g3x2);
+        __m128 y2 = _mm_add_ps(_mm_sub_ps(y0, j2), g3x2);
+        __m128 z2 = _mm_add_ps(_mm_sub_ps(z0, k2), g3x2);
+        __m128 g3x3m1 = _mm_sub_ps(_mm_add_ps(g3x2, g3), one);
+        __m128 x3 = _mm_add_ps(x0, g3x3m1);
+        __m128 y3 = _mm_add_ps(y0, g3x3m1);
+        __m128 z3 = _mm_add_ps(z0, g3x3m1);
+
+        // The permutation table lookups stay scalar
+        _mm_store_si128((__m128i*) ci, i);
+        _mm_store_si128((__m128i*) cj, j);
+        _mm_store_si128((__m128i*) ck, k);
+
+        int m1i = _mm_movemask_ps(mi1), m1j = _mm_movemask_ps(mj1), m1k = _mm_movemask_ps(mk1);
+        int m2i = _mm_movemask_ps(mi2), m2j = _mm_movemask_ps(mj2), m2k = _mm_movemask_ps(mk2);
+
+        for (int l = 0; l < 4; ++l) {
+            int ii = ci[l] % 256;
+            int jj = cj[l] % 256;
+            int kk = ck[l] % 256;
+
+            int oi1 = (m1i >> l) & 1, oj1 = (m1j >> l) & 1, ok1 = (m1k >> l) & 1;
+            int oi2 = (m2i >> l) & 1, oj2 = (m2j >> l) & 1, ok2 = (m2k >> l) & 1;
+
+            hash0[l] = perm[ii+perm[jj+perm[kk]]];
+            hash1[l] = perm[ii+oi1+perm[jj+oj1+perm[kk+ok1]]];
+            hash2[l] = perm[ii+oi2+perm[jj+oj2+perm[kk+ok2]]];
+            hash3[l] = perm[ii+1+perm[jj+1+perm[kk+1]]];
+        }
+
+        __m128 sum = corner4(_mm_load_si128((__m128i*) hash0), x0, y0, z0);
+        sum = _mm_add_ps(sum, corner4(_mm_load_si128((__m128i*) hash1), x1, y1, z1));
+        sum = _mm_add_ps(sum, corner4(_mm_load_si128((__m128i*) hash2), x2, y2, z2));
+        sum = _mm_add_ps(sum, corner4(_mm_load_si128((__m128i*) hash3), x3, y3, z3));
+
+        _mm_storeu_ps(&out[n], _mm_mul_ps(sum, _mm_set1_ps(32.0f)));
+    }
+#endif
+
+    for (; n < count; ++n)
+        out[n] = noise(x[n], y[n], z);
+}
+//---------------------------------------------------------------------
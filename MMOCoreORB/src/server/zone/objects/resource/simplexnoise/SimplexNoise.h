@@ -49,6 +49,11 @@ class SimplexNoise {
     static float noise( float x, float y, float z );
     static float noise( float x, float y, float z, float w );
 
+/** 3D float Perlin noise at count points of the same z plane, four at a time
+ *  with SSE2 when available
+ */
+    static void noise( const float* x, const float* y, float z, float* out, int count );
+
 /** 1D, 2D, 3D and 4D float Perlin noise, with a specified integer period
  */
     static float pnoise( float x, int px );
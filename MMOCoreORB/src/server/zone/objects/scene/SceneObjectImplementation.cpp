@@ -670,6 +670,7 @@ void SceneObjectImplementation::broadcastMessagePrivate(BasePacket* message, Sce
 	}
 
 	SortedVector<QuadTreeEntry*> closeNoneReference;
+	Reference<CloseObjectsReceivers*> receivers;
 
 	try {
 		if (closeobjects == nullptr) {
@@ -678,7 +679,7 @@ void SceneObjectImplementation::broadcastMessagePrivate(BasePacket* message, Sce
 #endif
 			zone->getInRangeObjects(getPositionX(), getPositionY(), getOutOfRangeDistance(), &closeNoneReference, true);
 		} else {
-			closeobjects->safeCopyReceiversTo(closeNoneReference, CloseObjectsVector::PLAYERTYPE);
+			receivers = closeobjects->getReceivers(CloseObjectsVector::PLAYERTYPE);
 		}
 
 	} catch (const Exception& e) {
@@ -698,8 +699,10 @@ void SceneObjectImplementation::broadcastMessagePrivate(BasePacket* message, Sce
 	Reference<BasePacket*> pack = message;
 #endif
 
-	for (int i = 0; i < closeNoneReference.size(); ++i) {
-		SceneObject* scno = static_cast<SceneObject*>(closeNoneReference.getUnsafe(i));
+	int receiverCount = receivers != nullptr ? receivers->size() : closeNoneReference.size();
+
+	for (int i = 0; i < receiverCount; ++i) {
+		SceneObject* scno = static_cast<SceneObject*>(receivers != nullptr ? receivers->get(i) : closeNoneReference.getUnsafe(i));
 
 #ifdef LOCKFREE_BCLIENT_BUFFERS
 		scno->sendMessage(pack);
@@ -754,6 +757,7 @@ void SceneObjectImplementation::broadcastMessagesPrivate(Vector<BasePacket*>* me
 	}
 
 	SortedVector<QuadTreeEntry*> closeSceneObjects;
+	Reference<CloseObjectsReceivers*> receivers;
 
 	try {
 
@@ -763,7 +767,7 @@ void SceneObjectImplementation::broadcastMessagesPrivate(Vector<BasePacket*>* me
 #endif
 			zone->getInRangeObjects(getPositionX(), getPositionY(), getOutOfRangeDistance(), &closeSceneObjects, true);
 		} else {
-			closeobjects->safeCopyReceiversTo(closeSceneObjects, CloseObjectsVector::PLAYERTYPE);
+			receivers = closeobjects->getReceivers(CloseObjectsVector::PLAYERTYPE);
 		}
 
 	} catch (const Exception& e) {
@@ -778,8 +782,10 @@ void SceneObjectImplementation::broadcastMessagesPrivate(Vector<BasePacket*>* me
 	}
 #endif
 
-	for (int i = 0; i < closeSceneObjects.size(); ++i) {
-		SceneObject* scno = static_cast<SceneObject*>(closeSceneObjects.getUnsafe(i));
+	int receiverCount = receivers != nullptr ? receivers->size() : closeSceneObjects.size();
+
+	for (int i = 0; i < receiverCount; ++i) {
+		SceneObject* scno = static_cast<SceneObject*>(receivers != nullptr ? receivers->get(i) : closeSceneObjects.getUnsafe(i));
 
 		if (selfObject == scno)
 			continue;
@@ -1629,8 +1635,8 @@ String SceneObjectImplementation::getDisplayedName() const {
 	return StringIdManager::instance()->getStringId(objectName.getFullPath().hashCode()).toString();
 }
 
-bool SceneObjectImplementation::setTransformForCollisionMatrixIfNull(Matrix4* mat) {
-	return transformForCollisionMatrix.compareAndSet(nullptr, mat);
+CollisionTransform* SceneObjectImplementation::getCollisionTransform() {
+	return &collisionTransform;
 }
 
 int SceneObjectImplementation::getCountableObjectsRecursive() {
@@ -0,0 +1,115 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef MPSCRINGBUFFER_H_
+#define MPSCRINGBUFFER_H_
+
+#include "engine/engine.h"
+
+#include <atomic>
+
+/**
+ * Bounded queue for many producers and one consumer, without locks.
+ *
+ * Every slot carries a sequence number: a producer claims the next position with a
+ * compare and swap on tail and publishes the slot by setting its sequence to position + 1,
+ * the consumer frees it again by setting it to position + capacity. The capacity is rounded
+ * up to a power of two.
+ */
+template<class E> class MPSCRingBuffer {
+	struct Slot {
+		std::atomic<uint64> sequence;
+		E element;
+	};
+
+	Slot* slots;
+	uint64 mask;
+
+	// producers and the consumer each get their own cache line
+	alignas(64) std::atomic<uint64> tail;
+	alignas(64) std::atomic<uint64> head;
+
+public:
+	MPSCRingBuffer(int minCapacity) : tail(0), head(0) {
+		uint64 capacity = 2;
+
+		while (capacity < (uint64) minCapacity)
+			capacity <<= 1;
+
+		mask = capacity - 1;
+		slots = new Slot[capacity];
+
+		for (uint64 i = 0; i < capacity; ++i)
+			slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	MPSCRingBuffer(const MPSCRingBuffer&) = delete;
+	MPSCRingBuffer& operator=(const MPSCRingBuffer&) = delete;
+
+	~MPSCRingBuffer() {
+		delete [] slots;
+	}
+
+	/**
+	 * Returns false without waiting when the buffer is full.
+	 */
+	bool push(const E& element) {
+		uint64 position = tail.load(std::memory_order_relaxed);
+		Slot* slot;
+
+		while (true) {
+			slot = &slots[position & mask];
+
+			int64 difference = (int64) (slot->sequence.load(std::memory_order_acquire) - position);
+
+			if (difference == 0) {
+				if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					break;
+			} else if (difference < 0) {
+				return false;
+			} else {
+				position = tail.load(std::memory_order_relaxed);
+			}
+		}
+
+		slot->element = element;
+		slot->sequence.store(position + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	/**
+	 * Consumer side only. Returns false when the next element isn't published yet.
+	 */
+	bool pop(E& element) {
+		uint64 position = head.load(std::memory_order_relaxed);
+		Slot* slot = &slots[position & mask];
+
+		if (slot->sequence.load(std::memory_order_acquire) != position + 1)
+			return false;
+
+		element = slot->element;
+		slot->element = E();
+		slot->sequence.store(position + mask + 1, std::memory_order_release);
+
+		head.store(position + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	/**
+	 * Claimed positions not consumed yet, including ones still being written.
+	 */
+	int size() const {
+		uint64 consumed = head.load(std::memory_order_acquire);
+
+		return (int) (tail.load(std::memory_order_acquire) - consumed);
+	}
+
+	int getCapacity() const {
+		return (int) (mask + 1);
+	}
+};
+
+#endif /* MPSCRINGBUFFER_H_ */
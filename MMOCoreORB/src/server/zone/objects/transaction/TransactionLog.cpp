@@ -25,6 +25,7 @@
 #include "server/zone/objects/tangible/components/vendor/VendorDataComponent.h"
 
 AtomicInteger TransactionLog::exportBacklog;
+std::atomic<TransactionLogWriter*> TransactionLog::writerStarted(nullptr);
 
 TransactionLog::TransactionLog(SceneObject* src, SceneObject* dst, SceneObject* subject, TrxCode code, bool exportSubject, CAPTURE_CALLER_ARGS) {
 	if (!isEnabled()) {
@@ -353,21 +354,11 @@ Logger& TransactionLog::getLogger() {
 		Logger log("TransactionLog");
 
 		log.setGlobalLogging(false);
-		log.setFileLogger("log/transaction.log", true, ConfigManager::instance()->getRotateLogAtStart());
 		log.setLogLevelToFile(false);
 		log.setLogToConsole(false);
-		log.setRotateLogSizeMB(ConfigManager::instance()->getInt("Core3.TransactionLog.RotateLogSizeMB", ConfigManager::instance()->getRotateLogSizeMB()));
 		log.setLogLevel(static_cast<Logger::LogLevel>(logLevel));
-		log.setLoggerCallback([log](Logger::LogLevel level, const char* msg) -> int {
-			static Mutex logWriteMutext;
-			auto logFile = log.getFileLogger();
-			StringBuffer logLine;
-
-			logLine << msg << endl;
-
-			Locker guard(&logWriteMutext);
-			(*logFile) << logLine;
-			logFile->flush();
+		log.setLoggerCallback([](Logger::LogLevel level, const char* msg) -> int {
+			getWriter()->write(msg);
 
 			return Logger::DONTLOG;
 		});
@@ -378,6 +369,40 @@ Logger& TransactionLog::getLogger() {
 	return customLogger;
 };
 
+TransactionLogWriter* TransactionLog::getWriter() {
+	auto static writer = [] () {
+		auto config = ConfigManager::instance();
+		auto framing = TransactionLogWriter::getFraming(config->getString("Core3.TransactionLog.Framing", "text"));
+		auto fileName = config->getString("Core3.TransactionLog.File", TransactionLogWriter::getDefaultFileName(framing));
+		auto queueSize = config->getInt("Core3.TransactionLog.QueueSize", 65536);
+		auto rotateSizeMB = config->getInt("Core3.TransactionLog.RotateLogSizeMB", config->getRotateLogSizeMB());
+
+		auto logWriter = new TransactionLogWriter(fileName, framing, queueSize, rotateSizeMB, config->getRotateLogAtStart());
+
+		writerStarted.store(logWriter);
+
+		return logWriter;
+	} ();
+
+	return writer;
+}
+
+void TransactionLog::stopWriter() {
+	auto writer = writerStarted.load();
+
+	if (writer != nullptr)
+		writer->stop();
+}
+
+String TransactionLog::getWriterStatistics() {
+	auto writer = writerStarted.load();
+
+	if (writer == nullptr)
+		return "Transaction log: not started";
+
+	return writer->getStatistics();
+}
+
 const TaskQueue* TransactionLog::getCustomQueue() {
 	auto static customQueue = [] () {
 		auto numberOfThreads = ConfigManager::instance()->getInt("Core3.TransactionLog.WorkerThreads", 4);
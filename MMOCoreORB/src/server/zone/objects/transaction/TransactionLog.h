@@ -13,6 +13,7 @@
 #include "engine/engine.h"
 #include "server/zone/objects/scene/SceneObject.h"
 #include "server/zone/objects/creature/credits/CreditObject.h"
+#include "server/zone/objects/transaction/TransactionLogWriter.h"
 
 // clang-format off
 enum class TrxCode {
@@ -311,9 +312,20 @@ public:
 
 	void exportRelated();
 
+	/**
+	 * Writes out the queued transactions and closes the log, at shutdown.
+	 */
+	static void stopWriter();
+
+	static String getWriterStatistics();
+
 private:
 	static AtomicInteger exportBacklog;
 
+	static std::atomic<TransactionLogWriter*> writerStarted;
+
+	static TransactionLogWriter* getWriter();
+
 	void catchAndLog(const char* functioName, Function<void()> function);
 
 	static Logger& getLogger();
@@ -0,0 +1,401 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "TransactionLogWriter.h"
+
+#include <sys/stat.h>
+#include <iterator>
+#include <string>
+#include <zlib.h>
+
+namespace {
+	void appendUint32(std::string& buffer, uint32 value) {
+		for (int i = 0; i < 4; ++i)
+			buffer += (char) ((value >> (i * 8)) & 0xFF);
+	}
+
+	uint32 readUint32(const std::string& buffer, size_t offset) {
+		uint32 value = 0;
+
+		for (int i = 0; i < 4; ++i)
+			value |= ((uint32) (uint8) buffer[offset + i]) << (i * 8);
+
+		return value;
+	}
+
+	void splitLines(const char* data, size_t size, Vector<String>& lines) {
+		size_t start = 0;
+
+		for (size_t i = 0; i < size; ++i) {
+			if (data[i] != '\n')
+				continue;
+
+			lines.add(String(data + start, (int) (i - start)));
+			start = i + 1;
+		}
+
+		if (start < size)
+			lines.add(String(data + start, (int) (size - start)));
+	}
+
+	void updateMax(std::atomic<uint64>& max, uint64 value) {
+		uint64 current = max.load(std::memory_order_relaxed);
+
+		while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+			;
+	}
+}
+
+TransactionLogWriter::TransactionLogWriter(const String& fileName, int framing, int queueSize, int rotateSizeMB, bool rotateAtStart)
+		: Logger("TransactionLogWriter"), fileName(fileName), framing(framing), queue(queueSize), fileSize(0),
+		stopping(false), stopped(false), writers(0), maxWriteMicros(0), maxCommitMicros(0), maxQueueDepth(0) {
+
+	rotateBytes = rotateSizeMB > 0 ? (uint64) rotateSizeMB * 1024 * 1024 : 0;
+	maxBatchSize = 4096;
+	idleSleepMs = 2;
+
+	openFile(rotateAtStart);
+
+	start();
+}
+
+TransactionLogWriter::~TransactionLogWriter() {
+	stop();
+}
+
+void TransactionLogWriter::write(const String& line) {
+	writers.fetch_add(1);
+
+	if (stopped.load()) {
+		writers.fetch_sub(1);
+		rejected.increment();
+
+		error() << "writer stopped, transaction not written to " << fileName << ": " << line;
+		return;
+	}
+
+	Entry entry;
+	entry.line = line;
+	entry.queuedNano = Time::currentNanoTime();
+
+	if (!queue.push(entry)) {
+		stalls.increment();
+
+		// the writer is behind by a whole buffer, hold the worker instead of dropping the transaction.
+		// After stop() it is stop() that makes room
+		while (!queue.push(entry))
+			Thread::sleep(1);
+	}
+
+	writers.fetch_sub(1);
+}
+
+void TransactionLogWriter::stop() {
+	if (stopping.exchange(true))
+		return;
+
+	join();
+
+	stopped.store(true);
+
+	// anything that got in while the thread was finishing, and the writes that passed the stopped
+	// check before it was set
+	Vector<Entry> batch;
+
+	while (true) {
+		bool idle = writers.load() == 0;
+
+		if (drain(batch) > 0) {
+			writeBatch(batch);
+			batch.removeAll();
+
+			continue;
+		}
+
+		if (idle)
+			break;
+
+		Thread::sleep(1);
+	}
+
+	file.close();
+}
+
+void TransactionLogWriter::run() {
+	Vector<Entry> batch;
+
+	while (true) {
+		bool finishing = stopping.load();
+
+		if (drain(batch) > 0) {
+			writeBatch(batch);
+			batch.removeAll();
+
+			continue;
+		}
+
+		if (finishing)
+			break;
+
+		Thread::sleep(idleSleepMs);
+	}
+}
+
+int TransactionLogWriter::drain(Vector<Entry>& batch) {
+	int depth = queue.size();
+	int max = maxQueueDepth.load(std::memory_order_relaxed);
+
+	while (depth > max && !maxQueueDepth.compare_exchange_weak(max, depth, std::memory_order_relaxed))
+		;
+
+	Entry entry;
+
+	while (batch.size() < maxBatchSize && queue.pop(entry))
+		batch.add(entry);
+
+	return batch.size();
+}
+
+void TransactionLogWriter::writeBatch(const Vector<Entry>& batch) {
+	uint64 start = Time::currentNanoTime();
+
+	std::string buffer;
+
+	if (framing == BINARY) {
+		for (int i = 0; i < batch.size(); ++i) {
+			const String& line = batch.get(i).line;
+
+			appendUint32(buffer, line.length());
+			buffer.append(line.toCharArray(), line.length());
+		}
+	} else {
+		for (int i = 0; i < batch.size(); ++i) {
+			const String& line = batch.get(i).line;
+
+			buffer.append(line.toCharArray(), line.length());
+			buffer += '\n';
+		}
+	}
+
+	if (framing == DEFLATE) {
+		std::string compressed;
+
+		int result = compressBatch(buffer, compressed);
+
+		if (result == Z_OK) {
+			std::string frame;
+			appendUint32(frame, DEFLATEMAGIC);
+			appendUint32(frame, buffer.size());
+			appendUint32(frame, compressed.size());
+			frame.append(compressed);
+
+			buffer.swap(frame);
+		} else {
+			error() << "failed to compress " << batch.size() << " transactions: " << result << ", writing them uncompressed";
+
+			std::string frame;
+			appendUint32(frame, STOREDMAGIC);
+			appendUint32(frame, buffer.size());
+			frame.append(buffer);
+
+			buffer.swap(frame);
+		}
+	}
+
+	file.write(buffer.data(), buffer.size());
+	file.flush();
+
+	if (!file.good()) {
+		error() << "failed to write " << batch.size() << " transactions to " << fileName;
+
+		file.clear();
+	}
+
+	fileSize += buffer.size();
+
+	uint64 end = Time::currentNanoTime();
+	uint64 micros = (end - start) / 1000;
+	uint64 commit = (end - batch.get(0).queuedNano) / 1000;
+
+	entries.add(batch.size());
+	batches.increment();
+	bytes.add(buffer.size());
+	writeMicros.add(micros);
+	commitMicros.add(commit);
+
+	updateMax(maxWriteMicros, micros);
+	updateMax(maxCommitMicros, commit);
+
+	if (rotateBytes > 0 && fileSize >= rotateBytes)
+		rotateFile();
+}
+
+int TransactionLogWriter::compressBatch(const std::string& raw, std::string& compressed) {
+	uLongf compressedSize = compressBound(raw.size());
+	compressed.assign(compressedSize, '\0');
+
+	int result = compress2((Bytef*) &compressed[0], &compressedSize, (const Bytef*) raw.data(), raw.size(), Z_BEST_SPEED);
+
+	compressed.resize(result == Z_OK ? compressedSize : 0);
+
+	return result;
+}
+
+void TransactionLogWriter::openFile(bool rotate) {
+	struct stat st;
+
+	fileSize = stat(fileName.toCharArray(), &st) == 0 ? st.st_size : 0;
+
+	if (rotate && fileSize > 0) {
+		rotateFile();
+		return;
+	}
+
+	file.open(fileName.toCharArray(), std::ios::out | std::ios::app | std::ios::binary);
+
+	if (!file.is_open())
+		error() << "failed to open " << fileName;
+}
+
+void TransactionLogWriter::rotateFile() {
+	if (file.is_open())
+		file.close();
+
+	int extension = fileName.lastIndexOf(".");
+
+	if (extension <= fileName.lastIndexOf("/"))
+		extension = fileName.length();
+
+	String base = fileName.subString(0, extension);
+	String suffix = fileName.subString(extension);
+
+	uint64 now = Time().getMiliTime();
+	String archiveName = base + "-" + String::valueOf(now) + suffix;
+
+	struct stat st;
+
+	// more than one rotation in a millisecond on a tiny rotation size
+	for (int i = 1; stat(archiveName.toCharArray(), &st) == 0; ++i)
+		archiveName = base + "-" + String::valueOf(now) + "-" + String::valueOf(i) + suffix;
+
+	int err = std::rename(fileName.toCharArray(), archiveName.toCharArray());
+
+	if (err != 0)
+		error() << "Failed to archive " << fileName << " to " << archiveName << " err = " << err;
+	else
+		rotations.increment();
+
+	fileSize = stat(fileName.toCharArray(), &st) == 0 ? st.st_size : 0;
+
+	file.open(fileName.toCharArray(), std::ios::out | std::ios::app | std::ios::binary);
+
+	if (!file.is_open())
+		error() << "failed to open " << fileName;
+}
+
+String TransactionLogWriter::getStatistics() {
+	uint64 batchCount = batches.get();
+	uint64 written = entries.get();
+
+	StringBuffer str;
+
+	str << "Transaction log: " << written << " lines in " << batchCount << " batches";
+
+	if (batchCount > 0)
+		str << " (" << (written / batchCount) << " per batch)";
+
+	str << ", " << getQueueDepth() << " queued (max " << maxQueueDepth.load() << " of " << queue.getCapacity() << ")"
+		<< ", " << stalls.get() << " stalls, " << rejected.get() << " rejected after stop, " << (bytes.get() / 1024) << " KB written, " << rotations.get() << " rotations";
+
+	if (batchCount > 0) {
+		str << endl << "  write " << (writeMicros.get() / batchCount) << "us avg, " << maxWriteMicros.load() << "us max"
+			<< "; queued to flushed " << (commitMicros.get() / batchCount) << "us avg, " << maxCommitMicros.load() << "us max";
+	}
+
+	return str.toString();
+}
+
+TransactionLogWriter::Framing TransactionLogWriter::getFraming(const String& name) {
+	String framing = name.toLowerCase();
+
+	if (framing == "binary")
+		return BINARY;
+	else if (framing == "deflate" || framing == "compressed")
+		return DEFLATE;
+
+	return TEXT;
+}
+
+String TransactionLogWriter::getDefaultFileName(int framing) {
+	switch (framing) {
+	case BINARY:
+		return "log/transaction.bin";
+	case DEFLATE:
+		return "log/transaction.logz";
+	default:
+		return "log/transaction.log";
+	}
+}
+
+bool TransactionLogWriter::readFile(const String& fileName, int framing, Vector<String>& lines) {
+	std::ifstream input(fileName.toCharArray(), std::ios::in | std::ios::binary);
+
+	if (!input.is_open())
+		return false;
+
+	std::string data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+	if (framing == TEXT) {
+		splitLines(data.data(), data.size(), lines);
+
+		return true;
+	}
+
+	size_t offset = 0;
+
+	while (offset < data.size()) {
+		if (framing == BINARY) {
+			if (offset + 4 > data.size())
+				return false;
+
+			uint32 length = readUint32(data, offset);
+			offset += 4;
+
+			if (offset + length > data.size())
+				return false;
+
+			lines.add(String(data.data() + offset, length));
+			offset += length;
+		} else if (offset + 8 <= data.size() && readUint32(data, offset) == STOREDMAGIC) {
+			uint32 rawSize = readUint32(data, offset + 4);
+			offset += 8;
+
+			if (offset + rawSize > data.size())
+				return false;
+
+			splitLines(data.data() + offset, rawSize, lines);
+			offset += rawSize;
+		} else {
+			if (offset + 12 > data.size() || readUint32(data, offset) != DEFLATEMAGIC)
+				return false;
+
+			uLongf rawSize = readUint32(data, offset + 4);
+			uint32 compressedSize = readUint32(data, offset + 8);
+			offset += 12;
+
+			if (offset + compressedSize > data.size())
+				return false;
+
+			std::string raw(rawSize, '\0');
+
+			if (uncompress((Bytef*) &raw[0], &rawSize, (const Bytef*) data.data() + offset, compressedSize) != Z_OK)
+				return false;
+
+			splitLines(raw.data(), rawSize, lines);
+			offset += compressedSize;
+		}
+	}
+
+	return true;
+}
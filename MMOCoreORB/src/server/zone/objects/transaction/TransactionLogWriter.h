@@ -0,0 +1,146 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef TRANSACTIONLOGWRITER_H_
+#define TRANSACTIONLOGWRITER_H_
+
+#include "engine/engine.h"
+
+#include "MPSCRingBuffer.h"
+
+#include <atomic>
+#include <fstream>
+
+/**
+ * Writes the transaction log from its own thread. TransactionLog hands the finished lines to a
+ * lock free ring buffer, the writer takes whatever is queued, writes it as one batch and flushes
+ * the file once per batch instead of once per line.
+ *
+ * The file is written as plain lines (text), as length prefixed records (binary) or as zlib
+ * compressed batches (deflate), and gets renamed to <name>-<milliseconds>.<ext> once it is over
+ * the rotation size. readFile() reads back any of them.
+ */
+class TransactionLogWriter : public Thread, public Logger {
+public:
+	enum Framing {
+		TEXT,
+		BINARY,
+		DEFLATE
+	};
+
+	// deflate batch header, "TLZ1" little endian
+	const static uint32 DEFLATEMAGIC = 0x315A4C54;
+
+	// header of a deflate file batch written uncompressed when compressing it failed, "TLS1"
+	const static uint32 STOREDMAGIC = 0x31534C54;
+
+protected:
+	struct Entry {
+		String line;
+		uint64 queuedNano;
+
+		Entry() : queuedNano(0) {
+		}
+	};
+
+	String fileName;
+	int framing;
+	uint64 rotateBytes;
+	int maxBatchSize;
+	int idleSleepMs;
+
+	MPSCRingBuffer<Entry> queue;
+
+	std::ofstream file;
+	uint64 fileSize;
+
+	std::atomic<bool> stopping;
+	std::atomic<bool> stopped;
+
+	// write() calls past the stopped check, stop() drains until they are done
+	std::atomic<int> writers;
+
+	AtomicLong entries;
+	AtomicLong batches;
+	AtomicLong bytes;
+	AtomicLong stalls;
+	AtomicLong rejected;
+	AtomicLong rotations;
+	AtomicLong writeMicros;
+	AtomicLong commitMicros;
+	std::atomic<uint64> maxWriteMicros;
+	std::atomic<uint64> maxCommitMicros;
+	std::atomic<int> maxQueueDepth;
+
+	int drain(Vector<Entry>& batch);
+
+	void writeBatch(const Vector<Entry>& batch);
+
+	/**
+	 * Deflates a batch, returns the zlib result
+	 */
+	virtual int compressBatch(const std::string& raw, std::string& compressed);
+
+	void openFile(bool rotate);
+
+	void rotateFile();
+
+	void run();
+
+public:
+	TransactionLogWriter(const String& fileName, int framing = TEXT, int queueSize = 65536, int rotateSizeMB = 100, bool rotateAtStart = false);
+
+	~TransactionLogWriter();
+
+	/**
+	 * Queues a line, waiting for room when the writer is behind. Lines logged after stop() go to
+	 * the console log instead.
+	 */
+	void write(const String& line);
+
+	/**
+	 * Writes out everything queued and closes the file.
+	 */
+	void stop();
+
+	int getQueueDepth() const {
+		return queue.size();
+	}
+
+	uint64 getWrittenCount() {
+		return entries.get();
+	}
+
+	uint64 getRejectedCount() {
+		return rejected.get();
+	}
+
+	uint64 getRotationCount() {
+		return rotations.get();
+	}
+
+	const String& getFileName() const {
+		return fileName;
+	}
+
+	String getStatistics();
+
+	void setRotateBytes(uint64 size) {
+		rotateBytes = size;
+	}
+
+	static Framing getFraming(const String& name);
+
+	/**
+	 * Default file name for the framing, plain text keeps log/transaction.log.
+	 */
+	static String getDefaultFileName(int framing);
+
+	/**
+	 * Appends the lines stored in a transaction log file written with the framing.
+	 */
+	static bool readFile(const String& fileName, int framing, Vector<String>& lines);
+};
+
+#endif /* TRANSACTIONLOGWRITER_H_ */
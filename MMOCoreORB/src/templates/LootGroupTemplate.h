@@ -91,6 +91,17 @@ public:
 		return entry->getKey();
 	}
 
+	int getLootGroupWeightAt(int i) const {
+		if (i < 0 || i >= entryMap.size())
+			return 0;
+
+		return entryMap.elementAt(i).getValue();
+	}
+
+	void addLootGroupEntry(const String& name, int weight) {
+		entryMap.put(name, weight);
+	}
+
 	void readObject(LuaObject* lua) {
 		LuaObject lootItems = lua->getObjectField("lootItems");
 
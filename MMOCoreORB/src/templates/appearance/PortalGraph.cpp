@@ -0,0 +1,309 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "PortalGraph.h"
+#include "templates/appearance/PathGraph.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <queue>
+
+namespace {
+	typedef std::pair<float, int> QueueEntry;
+	typedef std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry> > SearchQueue;
+
+	inline float getCost(const PathNode* node1, const PathNode* node2) {
+		return node1->getPosition().distanceTo(node2->getPosition());
+	}
+}
+
+PortalGraph::PortalGraph(const Vector<const PathGraph*>& cellGraphs) {
+	nodeIndex.setNullValue(-1);
+
+	cells.resize(cellGraphs.size());
+	firstPortal.resize(cellGraphs.size(), 0);
+
+	for (int c = 0; c < cellGraphs.size(); ++c) {
+		Cell& cell = cells[c];
+		cell.graph = cellGraphs.get(c);
+
+		if (cell.graph == nullptr)
+			continue;
+
+		const Vector<PathNode*>* nodes = cell.graph->getPathNodes();
+
+		for (int i = 0; i < nodes->size(); ++i) {
+			const PathNode* node = nodes->getUnsafe(i);
+
+			cell.nodes.push_back(node);
+			nodeIndex.put(getNodeKey(node), (c << 16) | i);
+
+			if (node->getGlobalGraphNodeID() != -1)
+				cell.portals.push_back(i);
+		}
+
+		cell.outgoing.resize(cell.nodes.size());
+		cell.incoming.resize(cell.nodes.size());
+	}
+
+	std::vector<std::vector<int> > portalOf(cells.size());
+
+	for (int c = 0; c < cells.size(); ++c) {
+		Cell& cell = cells[c];
+
+		firstPortal[c] = portals.size();
+		portalOf[c].resize(cell.nodes.size(), -1);
+
+		for (int k = 0; k < cell.portals.size(); ++k) {
+			Portal portal;
+			portal.cell = c;
+			portal.portalIndex = k;
+
+			portalOf[c][cell.portals[k]] = portals.size();
+			portals.push_back(portal);
+		}
+	}
+
+	// local links inside every cell, and the portal crossings between them
+	for (int c = 0; c < cells.size(); ++c) {
+		Cell& cell = cells[c];
+
+		for (int i = 0; i < cell.nodes.size(); ++i) {
+			const PathNode* node = cell.nodes[i];
+			const Vector<PathNode*>* neighbors = node->getNeighbors();
+
+			for (int n = 0; n < neighbors->size(); ++n) {
+				const PathNode* neighbor = neighbors->getUnsafe(n);
+
+				int neighborCell, neighborLocal;
+
+				if (!findNode(neighbor, neighborCell, neighborLocal))
+					continue;
+
+				float cost = getCost(node, neighbor);
+
+				if (neighborCell == c) {
+					cell.outgoing[i].push_back(Link(neighborLocal, cost));
+					cell.incoming[neighborLocal].push_back(Link(i, cost));
+				} else if (portalOf[c][i] != -1 && portalOf[neighborCell][neighborLocal] != -1) {
+					portals[portalOf[c][i]].crossings.push_back(Link(portalOf[neighborCell][neighborLocal], cost));
+				}
+			}
+		}
+	}
+
+	// routes between every pair of portals of a cell
+	std::vector<float> cost;
+	std::vector<int> previous;
+
+	for (int c = 0; c < cells.size(); ++c) {
+		Cell& cell = cells[c];
+		int count = cell.portals.size();
+
+		cell.portalCost.resize(count, std::vector<float>(count, FLT_MAX));
+		cell.portalRoute.resize(count, std::vector<std::vector<int> >(count));
+
+		for (int i = 0; i < count; ++i) {
+			searchCell(cell, cell.portals[i], false, cost, previous);
+
+			for (int j = 0; j < count; ++j) {
+				int target = cell.portals[j];
+
+				if (i == j || cost[target] == FLT_MAX)
+					continue;
+
+				cell.portalCost[i][j] = cost[target];
+
+				std::vector<int>& route = cell.portalRoute[i][j];
+
+				for (int node = target; node != -1; node = previous[node])
+					route.push_back(node);
+
+				std::reverse(route.begin(), route.end());
+			}
+		}
+	}
+}
+
+bool PortalGraph::findNode(const PathNode* node, int& cell, int& local) const {
+	int index = nodeIndex.get(getNodeKey(node));
+
+	if (index == -1)
+		return false;
+
+	cell = index >> 16;
+	local = index & 0xFFFF;
+
+	return true;
+}
+
+void PortalGraph::searchCell(const Cell& cell, int source, bool reverse, std::vector<float>& cost, std::vector<int>& previous) const {
+	const std::vector<std::vector<Link> >& links = reverse ? cell.incoming : cell.outgoing;
+
+	cost.assign(cell.nodes.size(), FLT_MAX);
+	previous.assign(cell.nodes.size(), -1);
+
+	SearchQueue queue;
+
+	cost[source] = 0;
+	queue.push(QueueEntry(0, source));
+
+	while (!queue.empty()) {
+		QueueEntry entry = queue.top();
+		queue.pop();
+
+		int node = entry.second;
+
+		if (entry.first > cost[node])
+			continue;
+
+		for (const Link& link : links[node]) {
+			float newCost = entry.first + link.cost;
+
+			if (newCost < cost[link.node]) {
+				cost[link.node] = newCost;
+				previous[link.node] = node;
+
+				queue.push(QueueEntry(newCost, link.node));
+			}
+		}
+	}
+}
+
+Vector<const PathNode*>* PortalGraph::getPath(const PathNode* node1, const PathNode* node2) const {
+	int sourceCell, source, targetCell, target;
+
+	if (!findNode(node1, sourceCell, source) || !findNode(node2, targetCell, target) || sourceCell == targetCell)
+		return nullptr;
+
+	const Cell& startCell = cells[sourceCell];
+	const Cell& endCell = cells[targetCell];
+
+	// refine the legs inside the start and target cells
+	std::vector<float> sourceCost, targetCost;
+	std::vector<int> sourcePrevious, targetNext;
+
+	searchCell(startCell, source, false, sourceCost, sourcePrevious);
+	searchCell(endCell, target, true, targetCost, targetNext);
+
+	// solve on the portals, the last slot stands for node2
+	const int goal = portals.size();
+
+	std::vector<float> cost(goal + 1, FLT_MAX);
+	std::vector<int> previous(goal + 1, -1);
+
+	SearchQueue queue;
+
+	for (int k = 0; k < startCell.portals.size(); ++k) {
+		float startCost = sourceCost[startCell.portals[k]];
+
+		if (startCost == FLT_MAX)
+			continue;
+
+		int portal = firstPortal[sourceCell] + k;
+
+		cost[portal] = startCost;
+		queue.push(QueueEntry(startCost, portal));
+	}
+
+	while (!queue.empty()) {
+		QueueEntry entry = queue.top();
+		queue.pop();
+
+		int current = entry.second;
+
+		if (entry.first > cost[current])
+			continue;
+
+		if (current == goal)
+			break;
+
+		const Portal& portal = portals[current];
+		const Cell& cell = cells[portal.cell];
+
+		if (portal.cell == targetCell) {
+			float endCost = targetCost[cell.portals[portal.portalIndex]];
+
+			if (endCost != FLT_MAX && entry.first + endCost < cost[goal]) {
+				cost[goal] = entry.first + endCost;
+				previous[goal] = current;
+
+				queue.push(QueueEntry(cost[goal], goal));
+			}
+		}
+
+		for (int k = 0; k < cell.portals.size(); ++k) {
+			float linkCost = cell.portalCost[portal.portalIndex][k];
+
+			if (linkCost == FLT_MAX)
+				continue;
+
+			int next = firstPortal[portal.cell] + k;
+			float newCost = entry.first + linkCost;
+
+			if (newCost < cost[next]) {
+				cost[next] = newCost;
+				previous[next] = current;
+
+				queue.push(QueueEntry(newCost, next));
+			}
+		}
+
+		for (const Link& link : portal.crossings) {
+			float newCost = entry.first + link.cost;
+
+			if (newCost < cost[link.node]) {
+				cost[link.node] = newCost;
+				previous[link.node] = current;
+
+				queue.push(QueueEntry(newCost, link.node));
+			}
+		}
+	}
+
+	if (previous[goal] == -1)
+		return nullptr;
+
+	std::vector<int> route;
+
+	for (int portal = previous[goal]; portal != -1; portal = previous[portal])
+		route.push_back(portal);
+
+	std::reverse(route.begin(), route.end());
+
+	Vector<const PathNode*>* path = new Vector<const PathNode*>(route.size() * 2 + 4, 8);
+
+	// node1 to the first portal
+	const Portal& first = portals[route.front()];
+	std::vector<int> startLeg;
+
+	for (int node = startCell.portals[first.portalIndex]; node != -1; node = sourcePrevious[node])
+		startLeg.push_back(node);
+
+	for (auto it = startLeg.rbegin(); it != startLeg.rend(); ++it)
+		path->add(startCell.nodes[*it]);
+
+	for (int i = 1; i < route.size(); ++i) {
+		const Portal& from = portals[route[i - 1]];
+		const Portal& to = portals[route[i]];
+		const Cell& cell = cells[to.cell];
+
+		if (from.cell == to.cell) {
+			const std::vector<int>& leg = cell.portalRoute[from.portalIndex][to.portalIndex];
+
+			for (int j = 1; j < leg.size(); ++j)
+				path->add(cell.nodes[leg[j]]);
+		} else {
+			path->add(cell.nodes[cell.portals[to.portalIndex]]);
+		}
+	}
+
+	// last portal to node2
+	const Portal& last = portals[route.back()];
+
+	for (int node = targetNext[endCell.portals[last.portalIndex]]; node != -1; node = targetNext[node])
+		path->add(endCell.nodes[node]);
+
+	return path;
+}
@@ -0,0 +1,92 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef PORTALGRAPH_H_
+#define PORTALGRAPH_H_
+
+#include "engine/engine.h"
+#include "templates/appearance/PathNode.h"
+
+#include <vector>
+
+class PathGraph;
+
+/**
+ * Portal level abstraction of the cell path graphs of a building.
+ *
+ * Built once per PortalLayout: for every cell it keeps the local path graph adjacency and the
+ * shortest routes between each pair of its portal nodes (the global nodes shared with other
+ * cells). A cross cell path is then solved on the small graph of portals, and only the legs
+ * inside the start and target cells are searched node by node.
+ */
+class PortalGraph {
+	struct Link {
+		int node;
+		float cost;
+
+		Link(int n, float c) : node(n), cost(c) {
+		}
+	};
+
+	struct Cell {
+		const PathGraph* graph;
+
+		std::vector<const PathNode*> nodes;
+		std::vector<std::vector<Link> > outgoing;
+		std::vector<std::vector<Link> > incoming;
+
+		// local indices of the nodes shared with other cells
+		std::vector<int> portals;
+
+		// best route between portals[i] and portals[j], as local node indices from i to j
+		std::vector<std::vector<float> > portalCost;
+		std::vector<std::vector<std::vector<int> > > portalRoute;
+	};
+
+	struct Portal {
+		int cell;
+		int portalIndex;
+
+		// the same portal seen from the neighbouring cells
+		std::vector<Link> crossings;
+	};
+
+	std::vector<Cell> cells;
+	std::vector<Portal> portals;
+
+	// node address to (cell << 16 | local index)
+	HashTable<uint64, int> nodeIndex;
+
+	// portals[i] of cell c is portal firstPortal[c] + i
+	std::vector<int> firstPortal;
+
+	inline static uint64 getNodeKey(const PathNode* node) {
+		return (uint64) node;
+	}
+
+	bool findNode(const PathNode* node, int& cell, int& local) const;
+
+	/**
+	 * Dijkstra inside one cell, from source along outgoing links or towards it along incoming links.
+	 */
+	void searchCell(const Cell& cell, int source, bool reverse, std::vector<float>& cost, std::vector<int>& previous) const;
+
+public:
+	/**
+	 * @param cellGraphs path graph of every cell indexed by cell id, nullptr for cells without one
+	 */
+	PortalGraph(const Vector<const PathGraph*>& cellGraphs);
+
+	/**
+	 * Same contract as PortalLayout::getPath: the node route from node1 to node2, both included,
+	 * or nullptr when they are in the same cell or there is no route. The caller deletes it.
+	 */
+	Vector<const PathNode*>* getPath(const PathNode* node1, const PathNode* node2) const;
+
+	int getPortalCount() const {
+		return portals.size();
+	}
+};
+
+#endif /* PORTALGRAPH_H_ */
@@ -156,6 +156,7 @@ void PortalLayout::readPortalGeometry0004(IffStream *iff, int numPortals) {
 
 PortalLayout::PortalLayout() {
 	pathGraph = nullptr;
+	portalGraph = nullptr;
 
 	setLoggingName("PortalLayout");
 }
@@ -163,6 +164,9 @@ PortalLayout::PortalLayout() {
 PortalLayout::~PortalLayout() {
 	delete pathGraph;
 	pathGraph = nullptr;
+
+	delete portalGraph;
+	portalGraph = nullptr;
 }
 
 void PortalLayout::parse(IffStream* iffStream) {
@@ -238,6 +242,8 @@ void PortalLayout::parse(IffStream* iffStream) {
 	}
 
 	connectFloorMeshGraphs();
+
+	buildPortalGraph();
 }
 
 int PortalLayout::getCellID(const String& cellName) const {
@@ -296,6 +302,19 @@ void PortalLayout::connectFloorMeshGraphs() {
 	}
 }
 
+void PortalLayout::buildPortalGraph() {
+	Vector<const PathGraph*> cellGraphs;
+
+	for (int i = 0; i < cellProperties.size(); ++i) {
+		const FloorMesh* floorMesh = getFloorMesh(i);
+
+		cellGraphs.add(floorMesh != nullptr ? floorMesh->getPathGraph() : nullptr);
+	}
+
+	delete portalGraph;
+	portalGraph = new PortalGraph(cellGraphs);
+}
+
 int PortalLayout::getFloorMeshID(int globalNodeID, int floorMeshToExclude) const {
 	for (int i = 0; i < cellProperties.size(); ++i) {
 		if (i == floorMeshToExclude)
@@ -335,6 +354,14 @@ void PortalLayout::parseCELSForm(IffStream* iffStream, int numCells) {
 }
 
 Vector<const PathNode*>* PortalLayout::getPath(const PathNode* node1, const PathNode* node2) const {
+	// across cells solve on the portals first, A* over every node is left for paths inside one cell
+	if (portalGraph != nullptr && node1->getPathGraph() != node2->getPathGraph()) {
+		Vector<const PathNode*>* path = portalGraph->getPath(node1, node2);
+
+		if (path != nullptr)
+			return path;
+	}
+
 	return AStarAlgorithm<PathGraph, PathNode>::search<uint32>(node1->getPathGraph(), node1, node2);
 }
 
@@ -15,6 +15,7 @@
 #include "templates/appearance/FloorMesh.h"
 #include "templates/appearance/AppearanceTemplate.h"
 #include "templates/appearance/PathGraph.h"
+#include "templates/appearance/PortalGraph.h"
 
 class PortalGeometry : public Object {
 	Reference<MeshData*> geometry;
@@ -41,6 +42,7 @@ public:
 
 class PortalLayout : public IffTemplate, public Logger {
 	PathGraph* pathGraph;
+	PortalGraph* portalGraph;
 	Vector<Reference<PortalGeometry*> > portalGeometry;
 	Vector<Reference<CellProperty*> > cellProperties;
 public:
@@ -64,6 +66,12 @@ public:
 
 	void connectFloorMeshGraphs();
 
+	void buildPortalGraph();
+
+	const PortalGraph* getPortalGraph() const {
+		return portalGraph;
+	}
+
 	int getFloorMeshID(int globalNodeID, int floorMeshToExclude) const;
 
 	Vector<const PathNode*>* getPath(const PathNode* node1, const PathNode* node2) const;
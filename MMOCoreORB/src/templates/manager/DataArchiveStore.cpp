@@ -7,9 +7,11 @@
 
 #include "DataArchiveStore.h"
 #include "tre3/TreeArchive.h"
+#include "conf/ConfigManager.h"
 
 DataArchiveStore::DataArchiveStore() : Logger("DataArchiveStore") {
 	treeDirectory = nullptr;
+	loadTimeMs = 0;
 }
 
 DataArchiveStore::~DataArchiveStore() {
@@ -17,8 +19,7 @@ DataArchiveStore::~DataArchiveStore() {
 	treeDirectory = nullptr;
 }
 
-byte* DataArchiveStore::getData(const String& path, int& size) const {
-	//read from local dir else from tres
+byte* DataArchiveStore::readLocalFile(const String& path, int& size) const {
 	File file(path);
 	byte* data = nullptr;
 	size = 0;
@@ -27,30 +28,59 @@ byte* DataArchiveStore::getData(const String& path, int& size) const {
 		FileReader test(&file);
 
 		if (file.exists()) {
+			uint64 start = Time::currentNanoTime();
+
 			size = file.size();
 			data = new byte[size];
 
 			test.read((char*)data, size);
 			test.close();
 
+			requests.increment();
+			localFileReads.increment();
+			bytesRead.add(size);
+			readTimeNs.add(Time::currentNanoTime() - start);
+
 			return data;
 		}
 	} catch (const Exception& e) {
 	}
 
+	return nullptr;
+}
+
+bool DataArchiveStore::getView(const String& path, TreeRecordView& view) const {
 	ReadLocker locker(this);
 
 	if (treeDirectory == nullptr)
-		return nullptr;
+		return false;
+
+	uint64 start = Time::currentNanoTime();
+
+	bool res = treeDirectory->getView(path, view);
+
+	requests.increment();
+	bytesRead.add(view.size());
+	readTimeNs.add(Time::currentNanoTime() - start);
+
+	return res;
+}
+
+byte* DataArchiveStore::getData(const String& path, int& size) const {
+	//read from local dir else from tres
+	byte* data = readLocalFile(path, size);
+
+	if (data != nullptr)
+		return data;
 
-	data = treeDirectory->getBytes(path, size);
+	TreeRecordView view;
 
-	if (size == 0) {
-		delete [] data;
+	if (!getView(path, view) || view.isEmpty())
 		return nullptr;
-	}
 
-	return data;
+	size = view.size();
+
+	return view.copyBytes();
 }
 
 int DataArchiveStore::loadTres(const String& path, const Vector<String>& treFilesToLoad) {
@@ -70,18 +100,25 @@ int DataArchiveStore::loadTres(const String& path, const Vector<String>& treFile
 
 	debug("Loading TRE archives...");
 
-	treeDirectory = new TreeArchive();
+	uint64 cacheSize = Math::max(0, ConfigManager::instance()->getTreRecordCacheSize());
 
-	int j = 0;
+	treeDirectory = new TreeArchive(cacheSize * 1024 * 1024);
 
+	Timer loadTimer;
+	loadTimer.start();
+
+	Vector<String> fullPaths;
 
 	for (int i = 0; i < treFilesToLoad.size(); ++i) {
 		const String& file = treFilesToLoad.get(i);
-		String fullPath = path + "/" + file;
 
-		treeDirectory->unpackFile(fullPath);
+		fullPaths.add(path + "/" + file);
 	}
 
+	treeDirectory->unpackFiles(fullPaths, ConfigManager::instance()->getTreLoaderThreads());
+
+	loadTimeMs = loadTimer.stopMs();
+
 	debug("Finished loading TRE archives.");
 
 	return 0;
@@ -97,16 +134,28 @@ IffStream* DataArchiveStore::openIffFile(const String& fileName) const {
 
 	int size = 0;
 
-	byte* data = getData(fileName, size);
+	byte* localData = readLocalFile(fileName, size);
+	const byte* data = localData;
+
+	// TRE records are parsed straight from the mapped archive or the record cache
+	TreeRecordView view;
+
+	if (localData == nullptr && getView(fileName, view)) {
+		data = view.getData();
+		size = view.size();
+	}
 
-	if (size == 0)
+	if (data == nullptr || size == 0) {
+		delete [] localData;
 		return nullptr;
+	}
 
 	iffStream = new IffStream();
 
 	if (iffStream != nullptr) {
 		try {
-			if (!iffStream->parseChunks(data, size, fileName)) {
+			// parseChunks copies the chunk contents, it never writes to or keeps the buffer
+			if (!iffStream->parseChunks(const_cast<byte*>(data), size, fileName)) {
 				delete iffStream;
 				iffStream = nullptr;
 			}
@@ -118,8 +167,22 @@ IffStream* DataArchiveStore::openIffFile(const String& fileName) const {
 		}
 	}
 
-	delete [] data;
+	delete [] localData;
 
 	return iffStream;
 }
 
+void DataArchiveStore::printStatistics(const String& phase) const {
+	ReadLocker locker(this);
+
+	if (treeDirectory == nullptr)
+		return;
+
+	info(true) << "TRE I/O " << phase << ": "
+		<< treeDirectory->getMappedFileCount() << " archives ("
+		<< (treeDirectory->getMappedSize() >> 20) << " MB) mapped in " << loadTimeMs << "ms, "
+		<< requests.get() << " reads (" << localFileReads.get() << " local files) returned "
+		<< (bytesRead.get() >> 10) << " KB in " << (readTimeNs.get() / 1000000) << "ms";
+
+	info(true) << "TRE I/O " << phase << ": " << treeDirectory->getRecordCache()->getStatistics();
+}
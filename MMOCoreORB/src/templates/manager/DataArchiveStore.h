@@ -14,19 +14,38 @@
 #include "system/thread/ReadLocker.h"
 #include "system/thread/Locker.h"
 #include "engine/util/iffstream/IffStream.h"
+#include "system/thread/atomic/AtomicInteger.h"
+#include "system/thread/atomic/AtomicLong.h"
 
 class TreeArchive;
+class TreeRecordView;
 
 class DataArchiveStore : public Singleton<DataArchiveStore>, public Logger,
 		public ReadWriteLock, public Object {
 	TreeArchive* treeDirectory;
 
+	// TRE I/O statistics for the startup report
+	uint64 loadTimeMs;
+
+	mutable AtomicInteger requests;
+	mutable AtomicInteger localFileReads;
+	mutable AtomicLong bytesRead;
+	mutable AtomicLong readTimeNs;
+
+	byte* readLocalFile(const String& path, int& size) const;
+
 public:
 	DataArchiveStore();
 	~DataArchiveStore();
 
 	byte* getData(const String& path, int& size) const;
 
+	/**
+	 * Points view at a record of the loaded TRE archives without copying it.
+	 * Files in the local directory are not considered.
+	 */
+	bool getView(const String& path, TreeRecordView& view) const;
+
 	int loadTres(const String& path, const Vector<String>& treFilesToLoad);
 
 	IffStream* openIffFile(const String& fileName) const;
@@ -35,6 +54,10 @@ public:
 		return treeDirectory;
 	}
 
+	/**
+	 * Logs how much time has been spent reading TRE data so far.
+	 */
+	void printStatistics(const String& phase) const;
 
 };
 
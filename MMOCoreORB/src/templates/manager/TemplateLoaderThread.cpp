@@ -0,0 +1,173 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "TemplateLoaderThread.h"
+#include "TemplateManager.h"
+
+namespace {
+	// Only used on the thread running collectTemplateFiles
+	Vector<String>* collectingFiles = nullptr;
+}
+
+TemplateLoaderThread::TemplateLoaderThread(const Vector<String>& templateFiles, const HashTable<String, int>& templateFileOrder,
+		const HashTable<String, String>& templateDependencyFiles, int shardIndex, int shards) :
+		Logger("TemplateLoaderThread " + String::valueOf(shardIndex)), files(templateFiles), fileOrder(templateFileOrder),
+		dependencyFiles(templateDependencyFiles), shard(shardIndex), shardCount(shards) {
+
+	lua = nullptr;
+
+	templateOrder.setNullValue(UNLISTEDFILE);
+
+	loadedFiles = 0;
+	elapsedMs = 0;
+}
+
+TemplateLoaderThread::~TemplateLoaderThread() {
+	delete lua;
+	lua = nullptr;
+}
+
+void TemplateLoaderThread::run() {
+	Timer timer;
+	timer.start();
+
+	TemplateManager* templateManager = TemplateManager::instance();
+	TemplateManager::loaderThread.set(this);
+
+	lua = new Lua();
+	lua->init();
+
+	templateManager->registerFunctions(lua);
+	templateManager->registerGlobals(lua);
+
+	lua->registerFunction("loadTemplateDependency", loadTemplateDependency);
+
+	// every shard needs the shared client templates the server templates derive from
+	if (runTemplateFile("scripts/object/templates.lua", UNLISTEDFILE) && runTemplateFile("scripts/object/allobjects.lua", UNLISTEDFILE)) {
+		for (int i = shard; i < files.size(); i += shardCount) {
+			runTemplateFile(files.get(i), i);
+
+			++loadedFiles;
+		}
+	}
+
+	TemplateManager::loaderThread.set(nullptr);
+
+	delete lua;
+	lua = nullptr;
+
+	elapsedMs = timer.stopMs();
+}
+
+bool TemplateLoaderThread::runTemplateFile(const String& file, int order) {
+	loadingFiles.add(order);
+
+	bool res = Lua::runFile(file, lua->getLuaState());
+
+	loadingFiles.remove(loadingFiles.size() - 1);
+
+	if (!res) {
+		error() << "could not load " << file;
+
+		TemplateManager::ERROR_CODE = TemplateManager::LOAD_LUA_TEMPLATE_ERROR;
+	}
+
+	return res;
+}
+
+void TemplateLoaderThread::loadDependency(const String& file) {
+	runTemplateFile(file, fileOrder.containsKey(file) ? DEPENDENCYFILE : UNLISTEDFILE);
+}
+
+bool TemplateLoaderThread::hasLuaTemplate(uint32 crc) {
+	lua_State* L = lua->getLuaState();
+
+	LuaFunction getObject(L, "getTemplate", 1);
+	getObject << crc;
+	getObject.callFunction();
+
+	bool found = lua_istable(L, -1);
+
+	lua_pop(L, 1);
+
+	return found;
+}
+
+void TemplateLoaderThread::addTemplate(uint32 crc, SharedObjectTemplate* templateObject) {
+	templates.put(crc, templateObject);
+	templateOrder.put(crc, loadingFiles.size() > 0 ? loadingFiles.getLast() : UNLISTEDFILE);
+}
+
+void TemplateLoaderThread::addClientTemplate(uint32 crc, const String& file) {
+	clientTemplates.put(crc, file);
+}
+
+bool TemplateLoaderThread::collectTemplateFiles(Vector<String>& files) {
+	Lua* collector = new Lua();
+	collector->init();
+
+	collector->registerFunction("includeFile", collectIncludeFile);
+
+	collectingFiles = &files;
+
+	bool res = collector->runFile("scripts/object/serverobjects.lua");
+
+	collectingFiles = nullptr;
+
+	delete collector;
+
+	return res;
+}
+
+String TemplateLoaderThread::getTemplateGlobalName(const String& file) {
+	int start = file.indexOf("custom_scripts/");
+
+	if (start != -1)
+		start += 15;
+	else
+		start = file.indexOf("scripts/") + 8;
+
+	String name = file.subString(start, file.length() - 4);
+
+	return name.replaceAll("/", "_");
+}
+
+int TemplateLoaderThread::loadTemplateDependency(lua_State* L) {
+	String name = Lua::getStringParameter(L);
+
+	TemplateLoaderThread* loader = TemplateManager::loaderThread.get();
+
+	if (loader == nullptr || !name.beginsWith("object_") || loader->resolvedDependencies.contains(name)) {
+		lua_pushnil(L);
+		return 1;
+	}
+
+	loader->resolvedDependencies.put(name);
+
+	const String& file = loader->dependencyFiles.get(name);
+
+	if (file.isEmpty()) {
+		lua_pushnil(L);
+		return 1;
+	}
+
+	loader->loadDependency(file);
+
+	lua_getglobal(L, name.toCharArray());
+
+	return 1;
+}
+
+int TemplateLoaderThread::collectIncludeFile(lua_State* L) {
+	String filename = Lua::getStringParameter(L);
+
+	if (filename.endsWith("serverobjects.lua")) {
+		if (!Lua::runFile("scripts/object/" + filename, L))
+			TemplateManager::ERROR_CODE = TemplateManager::LOAD_LUA_TEMPLATE_ERROR;
+	} else if (collectingFiles != nullptr) {
+		collectingFiles->add("scripts/object/" + filename);
+	}
+
+	return 0;
+}
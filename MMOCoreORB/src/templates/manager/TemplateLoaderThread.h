@@ -0,0 +1,119 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef TEMPLATELOADERTHREAD_H_
+#define TEMPLATELOADERTHREAD_H_
+
+#include "engine/engine.h"
+
+#include "templates/manager/TemplateCRCMap.h"
+
+/**
+ * Loads one shard of the server object template files on its own Lua state.
+ *
+ * Every loader runs the shared client templates (allobjects.lua) and then
+ * every shardCount'th file of the collected server template list. Templates
+ * are kept in the loader until TemplateManager merges all shards, keeping the
+ * one from the latest file when a template is defined more than once.
+ */
+class TemplateLoaderThread : public Thread, public Logger {
+public:
+	// file order used for templates that are not part of the collected file list
+	const static int UNLISTEDFILE = -1;
+
+	// file order used while loading a file owned by another shard, nothing gets registered
+	const static int DEPENDENCYFILE = -2;
+
+protected:
+	const Vector<String>& files;
+	const HashTable<String, int>& fileOrder;
+	const HashTable<String, String>& dependencyFiles;
+
+	int shard;
+	int shardCount;
+
+	Lua* lua;
+
+	TemplateCRCMap templates;
+	HashTable<uint32, int> templateOrder;
+	ClientTemplateCRCMap clientTemplates;
+
+	Vector<int> loadingFiles;
+	SortedVector<String> resolvedDependencies;
+
+	int loadedFiles;
+	uint64 elapsedMs;
+
+public:
+	TemplateLoaderThread(const Vector<String>& templateFiles, const HashTable<String, int>& templateFileOrder,
+			const HashTable<String, String>& templateDependencyFiles, int shardIndex, int shards);
+	~TemplateLoaderThread();
+
+	void run();
+
+	/**
+	 * Runs a template file that is not part of this shard, as a dependency of a template being loaded.
+	 */
+	void loadDependency(const String& file);
+
+	/**
+	 * Checks if the Lua state of this loader already has the template with crc.
+	 */
+	bool hasLuaTemplate(uint32 crc);
+
+	void addTemplate(uint32 crc, SharedObjectTemplate* templateObject);
+
+	void addClientTemplate(uint32 crc, const String& file);
+
+	/**
+	 * Returns false while loading a file owned by another shard.
+	 */
+	inline bool isRegisteringTemplates() const {
+		return loadingFiles.size() == 0 || loadingFiles.getLast() != DEPENDENCYFILE;
+	}
+
+	inline Lua* getLua() const {
+		return lua;
+	}
+
+	inline const TemplateCRCMap& getTemplates() const {
+		return templates;
+	}
+
+	inline int getTemplateOrder(uint32 crc) const {
+		return templateOrder.get(crc);
+	}
+
+	inline const ClientTemplateCRCMap& getClientTemplates() const {
+		return clientTemplates;
+	}
+
+	inline int getLoadedFiles() const {
+		return loadedFiles;
+	}
+
+	inline uint64 getElapsedMs() const {
+		return elapsedMs;
+	}
+
+	/**
+	 * Runs the server template include tree without loading any template and
+	 * returns the template files it would load, in load order.
+	 */
+	static bool collectTemplateFiles(Vector<String>& files);
+
+	/**
+	 * Returns the global name a template file defines its template with.
+	 */
+	static String getTemplateGlobalName(const String& file);
+
+	// LUA
+	static int loadTemplateDependency(lua_State* L);
+	static int collectIncludeFile(lua_State* L);
+
+private:
+	bool runTemplateFile(const String& file, int order);
+};
+
+#endif /* TEMPLATELOADERTHREAD_H_ */
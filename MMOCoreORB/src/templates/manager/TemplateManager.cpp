@@ -7,6 +7,7 @@
 
 #include "TemplateManager.h"
 #include "TemplateCRCMap.h"
+#include "TemplateLoaderThread.h"
 
 #include "templates/appearance/AppearanceRedirect.h"
 #include "templates/appearance/ComponentAppearanceTemplate.h"
@@ -135,6 +136,8 @@ Lua* TemplateManager::luaTemplatesInstance = nullptr;
 
 AtomicInteger TemplateManager::loadedTemplatesCount;
 
+ThreadLocal<TemplateLoaderThread*> TemplateManager::loaderThread;
+
 int TemplateManager::ERROR_CODE = NO_ERROR;
 
 TemplateManager::TemplateManager() {
@@ -156,8 +159,8 @@ TemplateManager::TemplateManager() {
 	appearanceMap = new AppearanceMap();
 	interiorMap = new InteriorMap();
 
-	registerFunctions();
-	registerGlobals();
+	registerFunctions(luaTemplatesInstance);
+	registerGlobals(luaTemplatesInstance);
 
 	loadTreArchive();
 	loadSlotDefinitions();
@@ -383,29 +386,144 @@ void TemplateManager::loadLuaTemplates() {
 
 	info(true) << "Loading object templates";
 
-	try {
-		bool val = luaTemplatesInstance->runFile("scripts/object/main.lua");
+	Timer loadTimer;
+	loadTimer.start();
 
-		if (!val)
-			ERROR_CODE = LOAD_LUA_TEMPLATE_ERROR;
-	} catch (const Exception& e) {
-		error(e.getMessage());
-		e.printStackTrace();
+	int threads = ConfigManager::instance()->getTemplateLoaderThreads();
 
-		ERROR_CODE = LOAD_LUA_TEMPLATE_ERROR;
+	if (threads > 0) {
+		loadLuaTemplatesParallel(threads);
+	} else {
+		try {
+			bool val = luaTemplatesInstance->runFile("scripts/object/main.lua");
+
+			if (!val)
+				ERROR_CODE = LOAD_LUA_TEMPLATE_ERROR;
+		} catch (const Exception& e) {
+			error(e.getMessage());
+			e.printStackTrace();
+
+			ERROR_CODE = LOAD_LUA_TEMPLATE_ERROR;
+		}
 	}
 
 	System::out << endl;
-	info("Finished loading object templates", true);
+	info(true) << "Finished loading " << templateCRCMap->size() << " object templates in " << loadTimer.stopMs() << "ms";
 
 	info() << portalLayoutMap->size() << " portal layouts loaded";
 	info() << floorMeshMap->size() << " floor meshes loaded";
 	info() << structureFootprints.size() << " structure footprints.";
 
+	DataArchiveStore::instance()->printStatistics("after object templates");
+
 	delete luaTemplatesInstance;
 	luaTemplatesInstance = nullptr;
 }
 
+void TemplateManager::loadLuaTemplatesParallel(int threads) {
+	Timer phaseTimer;
+	phaseTimer.start();
+
+	// Phase 1: walk the serverobjects.lua include tree to get the template files in load order
+	Vector<String> files;
+
+	if (!TemplateLoaderThread::collectTemplateFiles(files)) {
+		error("could not collect object template files");
+
+		ERROR_CODE = LOAD_LUA_TEMPLATE_ERROR;
+		return;
+	}
+
+	HashTable<String, int> fileOrder(files.size() * 2);
+	fileOrder.setNullValue(-1);
+
+	HashTable<String, String> dependencyFiles(files.size() * 2);
+	dependencyFiles.setNullValue("");
+
+	for (int i = 0; i < files.size(); ++i) {
+		const String& file = files.get(i);
+
+		fileOrder.put(file, i);
+
+		// custom scripts load last, so they also win as dependency of other templates
+		dependencyFiles.put(TemplateLoaderThread::getTemplateGlobalName(file), file);
+	}
+
+	uint64 collectMs = phaseTimer.stopMs();
+
+	// Phase 2: every loader parses its shard of template files and their client iff files
+	phaseTimer.start();
+
+	threads = Math::max(1, Math::min(threads, files.size()));
+
+	Vector<TemplateLoaderThread*> loaders;
+
+	for (int i = 0; i < threads; ++i) {
+		TemplateLoaderThread* loader = new TemplateLoaderThread(files, fileOrder, dependencyFiles, i, threads);
+		loader->start();
+
+		loaders.add(loader);
+	}
+
+	uint64 slowestShardMs = 0;
+
+	for (int i = 0; i < loaders.size(); ++i) {
+		TemplateLoaderThread* loader = loaders.get(i);
+		loader->join();
+
+		slowestShardMs = Math::max(slowestShardMs, loader->getElapsedMs());
+
+		debug() << "shard " << i << " loaded " << loader->getLoadedFiles() << " files in " << loader->getElapsedMs() << "ms";
+	}
+
+	uint64 loadMs = phaseTimer.stopMs();
+
+	// Phase 3: merge the shards, a template defined by a later file replaces the earlier one like a sequential load does
+	phaseTimer.start();
+
+	HashTable<uint32, int> templateOrder(files.size() * 2);
+	templateOrder.setNullValue(TemplateLoaderThread::UNLISTEDFILE - 1);
+
+	for (int i = 0; i < loaders.size(); ++i) {
+		TemplateLoaderThread* loader = loaders.get(i);
+
+		auto iterator = loader->getTemplates().iterator();
+
+		while (iterator.hasNext()) {
+			uint32* crc;
+			TemplateReference<SharedObjectTemplate*>* templateObject;
+
+			iterator.getNextKeyAndValue(crc, templateObject);
+
+			int order = loader->getTemplateOrder(*crc);
+
+			if (templateOrder.get(*crc) >= order)
+				continue;
+
+			templateCRCMap->put(*crc, *templateObject);
+			templateOrder.put(*crc, order);
+		}
+
+		auto clientIterator = loader->getClientTemplates().iterator();
+
+		while (clientIterator.hasNext()) {
+			uint32* crc;
+			String* file;
+
+			clientIterator.getNextKeyAndValue(crc, file);
+
+			clientTemplateCRCMap->put(*crc, *file);
+		}
+
+		delete loader;
+	}
+
+	uint64 mergeMs = phaseTimer.stopMs();
+
+	info(true) << "Template loading phases with " << threads << " threads: collected " << files.size() << " files in " << collectMs
+		<< "ms, loaded in " << loadMs << "ms (slowest shard " << slowestShardMs << "ms), merged in " << mergeMs << "ms";
+}
+
 void TemplateManager::loadTreArchive() {
 	const auto& path = ConfigManager::instance()->getTrePath();
 
@@ -464,6 +582,13 @@ void TemplateManager::addTemplate(uint32 key, const String& fullName, LuaObject*
 
 	debug() << "loaded " << fullName;
 
+	TemplateLoaderThread* loader = loaderThread.get();
+
+	if (loader != nullptr) {
+		loader->addTemplate(key, templateObject);
+		return;
+	}
+
 	if (templateCRCMap->put(key, templateObject) != nullptr) {
 		//error("duplicate template for " + fullName);
 	}
@@ -556,219 +681,219 @@ void TemplateManager::registerTemplateObjects() {
 	templateFactory.registerObject<XpPurchaseTemplate>(SharedObjectTemplate::XPPURCHASE);
 }
 
-void TemplateManager::registerFunctions() {
+void TemplateManager::registerFunctions(Lua* lua) {
 	//lua generic
-	luaTemplatesInstance->registerFunction("includeFile", includeFile);
-	luaTemplatesInstance->registerFunction("crcString", crcString);
-	luaTemplatesInstance->registerFunction("addTemplateCRC", addTemplateCRC);
-	luaTemplatesInstance->registerFunction("addClientTemplate", addClientTemplate);
+	lua->registerFunction("includeFile", includeFile);
+	lua->registerFunction("crcString", crcString);
+	lua->registerFunction("addTemplateCRC", addTemplateCRC);
+	lua->registerFunction("addClientTemplate", addClientTemplate);
 }
 
-void TemplateManager::registerGlobals() {
-	luaTemplatesInstance->setGlobalLong("DISEASED", CreatureState::DISEASED);
-	luaTemplatesInstance->setGlobalLong("ONFIRE", CreatureState::ONFIRE);
-	luaTemplatesInstance->setGlobalLong("POISONED", CreatureState::POISONED);
-	luaTemplatesInstance->setGlobalLong("BLINDED", CreatureState::BLINDED);
-	luaTemplatesInstance->setGlobalLong("STUNNED", CreatureState::STUNNED);
-	luaTemplatesInstance->setGlobalLong("DIZZY", CreatureState::DIZZY);
-	luaTemplatesInstance->setGlobalLong("INTIMIDATED", CreatureState::INTIMIDATED);
-	luaTemplatesInstance->setGlobalLong("IMMOBILIZED", CreatureState::IMMOBILIZED);
-	luaTemplatesInstance->setGlobalLong("FROZEN", CreatureState::FROZEN);
-
-	luaTemplatesInstance->setGlobalShort("HEALTH", CreatureAttribute::HEALTH);
-	luaTemplatesInstance->setGlobalShort("ACTION", CreatureAttribute::ACTION);
-	luaTemplatesInstance->setGlobalShort("MIND", CreatureAttribute::MIND);
-
-	luaTemplatesInstance->setGlobalInt("KINETIC", SharedWeaponObjectTemplate::KINETIC);
-	luaTemplatesInstance->setGlobalInt("ENERGY", SharedWeaponObjectTemplate::ENERGY);
-	luaTemplatesInstance->setGlobalInt("ELECTRICITY", SharedWeaponObjectTemplate::ELECTRICITY);
-	luaTemplatesInstance->setGlobalInt("STUN", SharedWeaponObjectTemplate::STUN);
-	luaTemplatesInstance->setGlobalInt("BLAST", SharedWeaponObjectTemplate::BLAST);
-	luaTemplatesInstance->setGlobalInt("HEAT", SharedWeaponObjectTemplate::HEAT);
-	luaTemplatesInstance->setGlobalInt("COLD", SharedWeaponObjectTemplate::COLD);
-	luaTemplatesInstance->setGlobalInt("ACID", SharedWeaponObjectTemplate::ACID);
-	luaTemplatesInstance->setGlobalInt("LIGHTSABER", SharedWeaponObjectTemplate::LIGHTSABER);
-
-	luaTemplatesInstance->setGlobalInt("NONE", SharedWeaponObjectTemplate::NONE);
-	luaTemplatesInstance->setGlobalInt("LIGHT", SharedWeaponObjectTemplate::LIGHT);
-	luaTemplatesInstance->setGlobalInt("MEDIUM", SharedWeaponObjectTemplate::MEDIUM);
-	luaTemplatesInstance->setGlobalInt("HEAVY", SharedWeaponObjectTemplate::HEAVY);
-
-	luaTemplatesInstance->setGlobalInt("ATTACKABLE", CreatureFlag::ATTACKABLE);
-	luaTemplatesInstance->setGlobalInt("AGGRESSIVE", CreatureFlag::AGGRESSIVE);
-	luaTemplatesInstance->setGlobalInt("OVERT", CreatureFlag::OVERT);
-	luaTemplatesInstance->setGlobalInt("TEF", CreatureFlag::TEF);
-	luaTemplatesInstance->setGlobalInt("PLAYER", CreatureFlag::PLAYER);
-	luaTemplatesInstance->setGlobalInt("ENEMY", CreatureFlag::ENEMY);
-	luaTemplatesInstance->setGlobalInt("WILLBEDECLARED", CreatureFlag::WILLBEDECLARED);
-	luaTemplatesInstance->setGlobalInt("WASDECLARED", CreatureFlag::WASDECLARED);
-
-	luaTemplatesInstance->setGlobalInt("CONVERSABLE", OptionBitmask::CONVERSE);
-	luaTemplatesInstance->setGlobalInt("AIENABLED", OptionBitmask::AIENABLED);
-	luaTemplatesInstance->setGlobalInt("INVULNERABLE", OptionBitmask::INVULNERABLE);
-	luaTemplatesInstance->setGlobalInt("FACTIONAGGRO", OptionBitmask::FACTIONAGGRO);
-	luaTemplatesInstance->setGlobalInt("INTERESTING", OptionBitmask::INTERESTING);
-	luaTemplatesInstance->setGlobalInt("JTLINTERESTING", OptionBitmask::JTLINTERESTING);
-
-	luaTemplatesInstance->setGlobalInt("MELEEATTACK", SharedWeaponObjectTemplate::MELEEATTACK);
-	luaTemplatesInstance->setGlobalInt("RANGEDATTACK", SharedWeaponObjectTemplate::RANGEDATTACK);
-	luaTemplatesInstance->setGlobalInt("FORCEATTACK", SharedWeaponObjectTemplate::FORCEATTACK);
-	luaTemplatesInstance->setGlobalInt("TRAPATTACK", SharedWeaponObjectTemplate::TRAPATTACK);
-	luaTemplatesInstance->setGlobalInt("GRENADEATTACK", SharedWeaponObjectTemplate::GRENADEATTACK);
-	luaTemplatesInstance->setGlobalInt("HEAVYACIDBEAMATTACK", SharedWeaponObjectTemplate::HEAVYACIDBEAMATTACK);
-	luaTemplatesInstance->setGlobalInt("HEAVYLIGHTNINGBEAMATTACK", SharedWeaponObjectTemplate::HEAVYLIGHTNINGBEAMATTACK);
-	luaTemplatesInstance->setGlobalInt("HEAVYPARTICLEBEAMATTACK", SharedWeaponObjectTemplate::HEAVYPARTICLEBEAMATTACK);
-	luaTemplatesInstance->setGlobalInt("HEAVYROCKETLAUNCHERATTACK", SharedWeaponObjectTemplate::HEAVYROCKETLAUNCHERATTACK);
-	luaTemplatesInstance->setGlobalInt("HEAVYLAUNCHERATTACK", SharedWeaponObjectTemplate::HEAVYLAUNCHERATTACK);
-
-	luaTemplatesInstance->setGlobalInt("ANYWEAPON", SharedWeaponObjectTemplate::ANYWEAPON);
-	luaTemplatesInstance->setGlobalInt("THROWNWEAPON", SharedWeaponObjectTemplate::THROWNWEAPON);
-	luaTemplatesInstance->setGlobalInt("HEAVYWEAPON", SharedWeaponObjectTemplate::HEAVYWEAPON);
-	luaTemplatesInstance->setGlobalInt("MINEWEAPON", SharedWeaponObjectTemplate::MINEWEAPON);
-	luaTemplatesInstance->setGlobalInt("SPECIALHEAVYWEAPON", SharedWeaponObjectTemplate::SPECIALHEAVYWEAPON);
-	luaTemplatesInstance->setGlobalInt("UNARMEDWEAPON", SharedWeaponObjectTemplate::UNARMEDWEAPON);
-	luaTemplatesInstance->setGlobalInt("ONEHANDMELEEWEAPON", SharedWeaponObjectTemplate::ONEHANDMELEEWEAPON);
-	luaTemplatesInstance->setGlobalInt("TWOHANDMELEEWEAPON", SharedWeaponObjectTemplate::TWOHANDMELEEWEAPON);
-	luaTemplatesInstance->setGlobalInt("POLEARMWEAPON", SharedWeaponObjectTemplate::POLEARMWEAPON);
-	luaTemplatesInstance->setGlobalInt("PISTOLWEAPON", SharedWeaponObjectTemplate::PISTOLWEAPON);
-	luaTemplatesInstance->setGlobalInt("CARBINEWEAPON", SharedWeaponObjectTemplate::CARBINEWEAPON);
-	luaTemplatesInstance->setGlobalInt("RIFLEWEAPON", SharedWeaponObjectTemplate::RIFLEWEAPON);
-	luaTemplatesInstance->setGlobalInt("GRENADEWEAPON", SharedWeaponObjectTemplate::GRENADEWEAPON);
-	luaTemplatesInstance->setGlobalInt("LIGHTNINGRIFLEWEAPON", SharedWeaponObjectTemplate::LIGHTNINGRIFLEWEAPON);
-	luaTemplatesInstance->setGlobalInt("ONEHANDJEDIWEAPON", SharedWeaponObjectTemplate::ONEHANDJEDIWEAPON);
-	luaTemplatesInstance->setGlobalInt("TWOHANDJEDIWEAPON", SharedWeaponObjectTemplate::TWOHANDJEDIWEAPON);
-	luaTemplatesInstance->setGlobalInt("POLEARMJEDIWEAPON", SharedWeaponObjectTemplate::POLEARMJEDIWEAPON);
-	luaTemplatesInstance->setGlobalInt("MELEEWEAPON", SharedWeaponObjectTemplate::MELEEWEAPON);
-	luaTemplatesInstance->setGlobalInt("RANGEDWEAPON", SharedWeaponObjectTemplate::RANGEDWEAPON);
-	luaTemplatesInstance->setGlobalInt("JEDIWEAPON", SharedWeaponObjectTemplate::JEDIWEAPON);
-
-	luaTemplatesInstance->setGlobalInt("OBJECTDESTRUCTION", ObserverEventType::OBJECTDESTRUCTION);
-	luaTemplatesInstance->setGlobalInt("DAMAGERECEIVED", ObserverEventType::DAMAGERECEIVED);
-	luaTemplatesInstance->setGlobalInt("PLAYERKILLED", ObserverEventType::PLAYERKILLED);
-	luaTemplatesInstance->setGlobalInt("PLAYERCLONED", ObserverEventType::PLAYERCLONED);
-	luaTemplatesInstance->setGlobalInt("CRAFTINGASSEMBLY", ObserverEventType::CRAFTINGASSEMBLY);
-	luaTemplatesInstance->setGlobalInt("CRAFTINGEXPERIMENTATION", ObserverEventType::CRAFTINGEXPERIMENTATION);
-	luaTemplatesInstance->setGlobalInt("HEALINGRECEIVED", ObserverEventType::HEALINGRECEIVED);
-	luaTemplatesInstance->setGlobalInt("ENHANCINGPERFORMED", ObserverEventType::ENHANCINGPERFORMED);
-	luaTemplatesInstance->setGlobalInt("WOUNDHEALINGRECEIVED", ObserverEventType::WOUNDHEALINGRECEIVED);
-	luaTemplatesInstance->setGlobalInt("XPAWARDED", ObserverEventType::XPAWARDED);
-	luaTemplatesInstance->setGlobalInt("SPICEDOWNERACTIVATED", ObserverEventType::SPICEDOWNERACTIVATED);
-	luaTemplatesInstance->setGlobalInt("MEDPACKUSED", ObserverEventType::MEDPACKUSED);
-
-	luaTemplatesInstance->setGlobalInt("SHOT", SharedObjectTemplate::SHOT);
-	luaTemplatesInstance->setGlobalInt("STOT", SharedObjectTemplate::STOT);
-	luaTemplatesInstance->setGlobalInt("SBMK", SharedObjectTemplate::SBMK);
-	luaTemplatesInstance->setGlobalInt("SBOT", SharedObjectTemplate::SBOT);
-	luaTemplatesInstance->setGlobalInt("STAT", SharedObjectTemplate::STAT);
-	luaTemplatesInstance->setGlobalInt("SIOT", SharedObjectTemplate::SIOT);
-	luaTemplatesInstance->setGlobalInt("CCLT", SharedObjectTemplate::CCLT);
-	luaTemplatesInstance->setGlobalInt("SCOU", SharedObjectTemplate::SCOU);
-	luaTemplatesInstance->setGlobalInt("SDSC", SharedObjectTemplate::SDSC);
-	luaTemplatesInstance->setGlobalInt("SFOT", SharedObjectTemplate::SFOT);
-	luaTemplatesInstance->setGlobalInt("SGRP", SharedObjectTemplate::SGRP);
-	luaTemplatesInstance->setGlobalInt("SITN", SharedObjectTemplate::SITN);
-	luaTemplatesInstance->setGlobalInt("SGLD", SharedObjectTemplate::SGLD);
-	luaTemplatesInstance->setGlobalInt("SJED", SharedObjectTemplate::SJED);
-	luaTemplatesInstance->setGlobalInt("SMSC", SharedObjectTemplate::SMSC);
-	luaTemplatesInstance->setGlobalInt("SMSO", SharedObjectTemplate::SMSO);
-	luaTemplatesInstance->setGlobalInt("SMSD", SharedObjectTemplate::SMSD);
-	luaTemplatesInstance->setGlobalInt("SMLE", SharedObjectTemplate::SMLE);
-	luaTemplatesInstance->setGlobalInt("SPLY", SharedObjectTemplate::SPLY);
-	luaTemplatesInstance->setGlobalInt("RCCT", SharedObjectTemplate::RCCT);
-	luaTemplatesInstance->setGlobalInt("SSHP", SharedObjectTemplate::SSHP);
-	luaTemplatesInstance->setGlobalInt("SUNI", SharedObjectTemplate::SUNI);
-	luaTemplatesInstance->setGlobalInt("SWAY", SharedObjectTemplate::SWAY);
-	luaTemplatesInstance->setGlobalInt("STOK", SharedObjectTemplate::STOK);
-	luaTemplatesInstance->setGlobalInt("SWOT", SharedObjectTemplate::SWOT);
-	luaTemplatesInstance->setGlobalInt("SCNC", SharedObjectTemplate::SCNC);
-	luaTemplatesInstance->setGlobalInt("SCOT", SharedObjectTemplate::SCOT);
-	luaTemplatesInstance->setGlobalInt("CHARACTERBUILDERTERMINAL", SharedObjectTemplate::CHARACTERBUILDERTERMINAL);
-	luaTemplatesInstance->setGlobalInt("LOOTKIT", SharedObjectTemplate::LOOTKIT);
-	luaTemplatesInstance->setGlobalInt("LOOTSCHEMATIC", SharedObjectTemplate::LOOTSCHEMATIC);
-	luaTemplatesInstance->setGlobalInt("GAMBLINGTERMINAL", SharedObjectTemplate::GAMBLINGTERMINAL);
-	luaTemplatesInstance->setGlobalInt("FIREWORK", SharedObjectTemplate::FIREWORK);
-	luaTemplatesInstance->setGlobalInt("SURVEYTOOL", SharedObjectTemplate::SURVEYTOOL);
-	luaTemplatesInstance->setGlobalInt("RECYCLETOOL", SharedObjectTemplate::RECYCLETOOL);
-	luaTemplatesInstance->setGlobalInt("CRAFTINGTOOL", SharedObjectTemplate::CRAFTINGTOOL);
-	luaTemplatesInstance->setGlobalInt("CRAFTINGSTATION", SharedObjectTemplate::CRAFTINGSTATION);
-	luaTemplatesInstance->setGlobalInt("RESOURCESPAWN", SharedObjectTemplate::RESOURCESPAWN);
-	luaTemplatesInstance->setGlobalInt("ARMOROBJECT", SharedObjectTemplate::ARMOROBJECT);
-	luaTemplatesInstance->setGlobalInt("DEED", SharedObjectTemplate::DEED);
-	luaTemplatesInstance->setGlobalInt("STRUCTUREDEED", SharedObjectTemplate::STRUCTUREDEED);
-	luaTemplatesInstance->setGlobalInt("VEHICLEDEED", SharedObjectTemplate::VEHICLEDEED);
-	luaTemplatesInstance->setGlobalInt("PETDEED", SharedObjectTemplate::PETDEED);
-	luaTemplatesInstance->setGlobalInt("DROIDDEED", SharedObjectTemplate::DROIDDEED);
-	luaTemplatesInstance->setGlobalInt("EVENTPERKDEED", SharedObjectTemplate::EVENTPERKDEED);
-	luaTemplatesInstance->setGlobalInt("MISSIONTERMINAL", SharedObjectTemplate::MISSIONTERMINAL);
-	luaTemplatesInstance->setGlobalInt("CLONINGBUILDING", SharedObjectTemplate::CLONINGBUILDING);
-	luaTemplatesInstance->setGlobalInt("DRAFTSCHEMATIC", SharedObjectTemplate::DRAFTSCHEMATIC);
-	luaTemplatesInstance->setGlobalInt("NPCCREATURE", SharedObjectTemplate::NPCCREATURE);
-	luaTemplatesInstance->setGlobalInt("LAIRTEMPLATE", SharedObjectTemplate::LAIRTEMPLATE);
-	luaTemplatesInstance->setGlobalInt("FACTORY", SharedObjectTemplate::FACTORY);
-	luaTemplatesInstance->setGlobalInt("STIMPACK", SharedObjectTemplate::STIMPACK);
-	luaTemplatesInstance->setGlobalInt("RANGEDSTIMPACK", SharedObjectTemplate::RANGEDSTIMPACK);
-	luaTemplatesInstance->setGlobalInt("ENHANCEPACK", SharedObjectTemplate::ENHANCEPACK);
-	luaTemplatesInstance->setGlobalInt("CUREPACK", SharedObjectTemplate::CUREPACK);
-	luaTemplatesInstance->setGlobalInt("DOTPACK", SharedObjectTemplate::DOTPACK);
-	luaTemplatesInstance->setGlobalInt("WOUNDPACK", SharedObjectTemplate::WOUNDPACK);
-	luaTemplatesInstance->setGlobalInt("STATEPACK", SharedObjectTemplate::STATEPACK);
-	luaTemplatesInstance->setGlobalInt("SKILLBUFF", SharedObjectTemplate::SKILLBUFF);
-	luaTemplatesInstance->setGlobalInt("CONSUMABLE", SharedObjectTemplate::CONSUMABLE);
-	luaTemplatesInstance->setGlobalInt("INSTRUMENT", SharedObjectTemplate::INSTRUMENT);
-	luaTemplatesInstance->setGlobalInt("CAMPKIT", SharedObjectTemplate::CAMPKIT);
-	luaTemplatesInstance->setGlobalInt("PLAYERCREATURE", SharedObjectTemplate::PLAYERCREATURE);
-	luaTemplatesInstance->setGlobalInt("SLICINGTOOL", SharedObjectTemplate::SLICINGTOOL);
-	luaTemplatesInstance->setGlobalInt("CONTAINER", SharedObjectTemplate::CONTAINER);
-	luaTemplatesInstance->setGlobalInt("ELEVATORTERMINAL", SharedObjectTemplate::ELEVATORTERMINAL);
-	luaTemplatesInstance->setGlobalInt("VENDORCREATURE", SharedObjectTemplate::VENDORCREATURE);
-	luaTemplatesInstance->setGlobalInt("CAMPSTRUCTURE", SharedObjectTemplate::CAMPSTRUCTURE);
-	luaTemplatesInstance->setGlobalInt("HOSPITALBUILDING", SharedObjectTemplate::HOSPITALBUILDING);
-	luaTemplatesInstance->setGlobalInt("RECREATIONBUILDING", SharedObjectTemplate::RECREATIONBUILDING);
-	luaTemplatesInstance->setGlobalInt("TRAP", SharedObjectTemplate::TRAP);
-	luaTemplatesInstance->setGlobalInt("CAMOKIT", SharedObjectTemplate::CAMOKIT);
-	luaTemplatesInstance->setGlobalInt("POWERUP", SharedObjectTemplate::POWERUP);
-	luaTemplatesInstance->setGlobalInt("DICE", SharedObjectTemplate::DICE);
-	luaTemplatesInstance->setGlobalInt("LIVESAMPLE", SharedObjectTemplate::LIVESAMPLE);
-	luaTemplatesInstance->setGlobalInt("CREATUREHABITAT", SharedObjectTemplate::CREATUREHABITAT);
-	luaTemplatesInstance->setGlobalInt("REPAIRTOOL", SharedObjectTemplate::REPAIRTOOL);
-	luaTemplatesInstance->setGlobalInt("VEHICLECUSTOMKIT", SharedObjectTemplate::VEHICLECUSTOMKIT);
-	luaTemplatesInstance->setGlobalInt("DROIDCUSTOMKIT", SharedObjectTemplate::DROIDCUSTOMKIT);
-	luaTemplatesInstance->setGlobalInt("DNASAMPLE", SharedObjectTemplate::DNASAMPLE);
-	luaTemplatesInstance->setGlobalInt("DROIDCOMPONENT", SharedObjectTemplate::DROIDCOMPONENT);
-	luaTemplatesInstance->setGlobalInt("DROIDCRAFTINGMODULE", SharedObjectTemplate::DROIDMODULECRAFTING);
-	luaTemplatesInstance->setGlobalInt("DROIDEFFECTSMODULE", SharedObjectTemplate::DROIDMODULEEFFECTS);
-	luaTemplatesInstance->setGlobalInt("DROIDPERSONALITYCHIP", SharedObjectTemplate::DROIDMODULEPERSONALITY);
-	luaTemplatesInstance->setGlobalInt("VEHICLE", SharedObjectTemplate::VEHICLE);
-	luaTemplatesInstance->setGlobalInt("XPPURCHASE", SharedObjectTemplate::XPPURCHASE);
-
-	luaTemplatesInstance->setGlobalInt("NO_HITLOCATION", ArmorObjectTemplate::NOLOCATION);
-	luaTemplatesInstance->setGlobalInt("CHEST_HITLOCATION", ArmorObjectTemplate::CHEST);
-	luaTemplatesInstance->setGlobalInt("ARMS_HITLOCATION", ArmorObjectTemplate::ARMS);
-	luaTemplatesInstance->setGlobalInt("LEGS_HITLOCATION", ArmorObjectTemplate::LEGS);
-	luaTemplatesInstance->setGlobalInt("HEAD_HITLOCATION", ArmorObjectTemplate::HEAD);
-
-	luaTemplatesInstance->setGlobalInt("GENETIC_LAB", DraftSchematicObjectTemplate::GENETIC_LAB);
-	luaTemplatesInstance->setGlobalInt("RESOURCE_LAB", DraftSchematicObjectTemplate::RESOURCE_LAB);
-
-	luaTemplatesInstance->setGlobalInt("STATIC", EventPerkDeedTemplate::STATIC);
-	luaTemplatesInstance->setGlobalInt("THEATER", EventPerkDeedTemplate::THEATER);
-	luaTemplatesInstance->setGlobalInt("RECRUITER", EventPerkDeedTemplate::RECRUITER);
-	luaTemplatesInstance->setGlobalInt("GAME", EventPerkDeedTemplate::GAME);
-	luaTemplatesInstance->setGlobalInt("HONORGUARD", EventPerkDeedTemplate::HONORGUARD);
-
-	luaTemplatesInstance->setGlobalInt("STIM_A", StimPackTemplate::STIM_A);
-	luaTemplatesInstance->setGlobalInt("STIM_B", StimPackTemplate::STIM_B);
-	luaTemplatesInstance->setGlobalInt("STIM_C", StimPackTemplate::STIM_C);
-	luaTemplatesInstance->setGlobalInt("STIM_D", StimPackTemplate::STIM_D);
-	luaTemplatesInstance->setGlobalInt("STIM_E", StimPackTemplate::STIM_E);
-
-	luaTemplatesInstance->setGlobalInt("CLONER_STANDARD", CloningBuildingObjectTemplate::STANDARD);
-	luaTemplatesInstance->setGlobalInt("CLONER_PLAYER_CITY", CloningBuildingObjectTemplate::PLAYER_CITY);
-	luaTemplatesInstance->setGlobalInt("CLONER_JEDI_ONLY", CloningBuildingObjectTemplate::JEDI_ONLY);
-	luaTemplatesInstance->setGlobalInt("CLONER_LIGHT_JEDI_ONLY", CloningBuildingObjectTemplate::LIGHT_JEDI_ONLY);
-	luaTemplatesInstance->setGlobalInt("CLONER_DARK_JEDI_ONLY", CloningBuildingObjectTemplate::DARK_JEDI_ONLY);
-	luaTemplatesInstance->setGlobalInt("CLONER_FACTION_REBEL", CloningBuildingObjectTemplate::FACTION_REBEL);
-	luaTemplatesInstance->setGlobalInt("CLONER_FACTION_IMPERIAL", CloningBuildingObjectTemplate::FACTION_IMPERIAL);
+void TemplateManager::registerGlobals(Lua* lua) {
+	lua->setGlobalLong("DISEASED", CreatureState::DISEASED);
+	lua->setGlobalLong("ONFIRE", CreatureState::ONFIRE);
+	lua->setGlobalLong("POISONED", CreatureState::POISONED);
+	lua->setGlobalLong("BLINDED", CreatureState::BLINDED);
+	lua->setGlobalLong("STUNNED", CreatureState::STUNNED);
+	lua->setGlobalLong("DIZZY", CreatureState::DIZZY);
+	lua->setGlobalLong("INTIMIDATED", CreatureState::INTIMIDATED);
+	lua->setGlobalLong("IMMOBILIZED", CreatureState::IMMOBILIZED);
+	lua->setGlobalLong("FROZEN", CreatureState::FROZEN);
+
+	lua->setGlobalShort("HEALTH", CreatureAttribute::HEALTH);
+	lua->setGlobalShort("ACTION", CreatureAttribute::ACTION);
+	lua->setGlobalShort("MIND", CreatureAttribute::MIND);
+
+	lua->setGlobalInt("KINETIC", SharedWeaponObjectTemplate::KINETIC);
+	lua->setGlobalInt("ENERGY", SharedWeaponObjectTemplate::ENERGY);
+	lua->setGlobalInt("ELECTRICITY", SharedWeaponObjectTemplate::ELECTRICITY);
+	lua->setGlobalInt("STUN", SharedWeaponObjectTemplate::STUN);
+	lua->setGlobalInt("BLAST", SharedWeaponObjectTemplate::BLAST);
+	lua->setGlobalInt("HEAT", SharedWeaponObjectTemplate::HEAT);
+	lua->setGlobalInt("COLD", SharedWeaponObjectTemplate::COLD);
+	lua->setGlobalInt("ACID", SharedWeaponObjectTemplate::ACID);
+	lua->setGlobalInt("LIGHTSABER", SharedWeaponObjectTemplate::LIGHTSABER);
+
+	lua->setGlobalInt("NONE", SharedWeaponObjectTemplate::NONE);
+	lua->setGlobalInt("LIGHT", SharedWeaponObjectTemplate::LIGHT);
+	lua->setGlobalInt("MEDIUM", SharedWeaponObjectTemplate::MEDIUM);
+	lua->setGlobalInt("HEAVY", SharedWeaponObjectTemplate::HEAVY);
+
+	lua->setGlobalInt("ATTACKABLE", CreatureFlag::ATTACKABLE);
+	lua->setGlobalInt("AGGRESSIVE", CreatureFlag::AGGRESSIVE);
+	lua->setGlobalInt("OVERT", CreatureFlag::OVERT);
+	lua->setGlobalInt("TEF", CreatureFlag::TEF);
+	lua->setGlobalInt("PLAYER", CreatureFlag::PLAYER);
+	lua->setGlobalInt("ENEMY", CreatureFlag::ENEMY);
+	lua->setGlobalInt("WILLBEDECLARED", CreatureFlag::WILLBEDECLARED);
+	lua->setGlobalInt("WASDECLARED", CreatureFlag::WASDECLARED);
+
+	lua->setGlobalInt("CONVERSABLE", OptionBitmask::CONVERSE);
+	lua->setGlobalInt("AIENABLED", OptionBitmask::AIENABLED);
+	lua->setGlobalInt("INVULNERABLE", OptionBitmask::INVULNERABLE);
+	lua->setGlobalInt("FACTIONAGGRO", OptionBitmask::FACTIONAGGRO);
+	lua->setGlobalInt("INTERESTING", OptionBitmask::INTERESTING);
+	lua->setGlobalInt("JTLINTERESTING", OptionBitmask::JTLINTERESTING);
+
+	lua->setGlobalInt("MELEEATTACK", SharedWeaponObjectTemplate::MELEEATTACK);
+	lua->setGlobalInt("RANGEDATTACK", SharedWeaponObjectTemplate::RANGEDATTACK);
+	lua->setGlobalInt("FORCEATTACK", SharedWeaponObjectTemplate::FORCEATTACK);
+	lua->setGlobalInt("TRAPATTACK", SharedWeaponObjectTemplate::TRAPATTACK);
+	lua->setGlobalInt("GRENADEATTACK", SharedWeaponObjectTemplate::GRENADEATTACK);
+	lua->setGlobalInt("HEAVYACIDBEAMATTACK", SharedWeaponObjectTemplate::HEAVYACIDBEAMATTACK);
+	lua->setGlobalInt("HEAVYLIGHTNINGBEAMATTACK", SharedWeaponObjectTemplate::HEAVYLIGHTNINGBEAMATTACK);
+	lua->setGlobalInt("HEAVYPARTICLEBEAMATTACK", SharedWeaponObjectTemplate::HEAVYPARTICLEBEAMATTACK);
+	lua->setGlobalInt("HEAVYROCKETLAUNCHERATTACK", SharedWeaponObjectTemplate::HEAVYROCKETLAUNCHERATTACK);
+	lua->setGlobalInt("HEAVYLAUNCHERATTACK", SharedWeaponObjectTemplate::HEAVYLAUNCHERATTACK);
+
+	lua->setGlobalInt("ANYWEAPON", SharedWeaponObjectTemplate::ANYWEAPON);
+	lua->setGlobalInt("THROWNWEAPON", SharedWeaponObjectTemplate::THROWNWEAPON);
+	lua->setGlobalInt("HEAVYWEAPON", SharedWeaponObjectTemplate::HEAVYWEAPON);
+	lua->setGlobalInt("MINEWEAPON", SharedWeaponObjectTemplate::MINEWEAPON);
+	lua->setGlobalInt("SPECIALHEAVYWEAPON", SharedWeaponObjectTemplate::SPECIALHEAVYWEAPON);
+	lua->setGlobalInt("UNARMEDWEAPON", SharedWeaponObjectTemplate::UNARMEDWEAPON);
+	lua->setGlobalInt("ONEHANDMELEEWEAPON", SharedWeaponObjectTemplate::ONEHANDMELEEWEAPON);
+	lua->setGlobalInt("TWOHANDMELEEWEAPON", SharedWeaponObjectTemplate::TWOHANDMELEEWEAPON);
+	lua->setGlobalInt("POLEARMWEAPON", SharedWeaponObjectTemplate::POLEARMWEAPON);
+	lua->setGlobalInt("PISTOLWEAPON", SharedWeaponObjectTemplate::PISTOLWEAPON);
+	lua->setGlobalInt("CARBINEWEAPON", SharedWeaponObjectTemplate::CARBINEWEAPON);
+	lua->setGlobalInt("RIFLEWEAPON", SharedWeaponObjectTemplate::RIFLEWEAPON);
+	lua->setGlobalInt("GRENADEWEAPON", SharedWeaponObjectTemplate::GRENADEWEAPON);
+	lua->setGlobalInt("LIGHTNINGRIFLEWEAPON", SharedWeaponObjectTemplate::LIGHTNINGRIFLEWEAPON);
+	lua->setGlobalInt("ONEHANDJEDIWEAPON", SharedWeaponObjectTemplate::ONEHANDJEDIWEAPON);
+	lua->setGlobalInt("TWOHANDJEDIWEAPON", SharedWeaponObjectTemplate::TWOHANDJEDIWEAPON);
+	lua->setGlobalInt("POLEARMJEDIWEAPON", SharedWeaponObjectTemplate::POLEARMJEDIWEAPON);
+	lua->setGlobalInt("MELEEWEAPON", SharedWeaponObjectTemplate::MELEEWEAPON);
+	lua->setGlobalInt("RANGEDWEAPON", SharedWeaponObjectTemplate::RANGEDWEAPON);
+	lua->setGlobalInt("JEDIWEAPON", SharedWeaponObjectTemplate::JEDIWEAPON);
+
+	lua->setGlobalInt("OBJECTDESTRUCTION", ObserverEventType::OBJECTDESTRUCTION);
+	lua->setGlobalInt("DAMAGERECEIVED", ObserverEventType::DAMAGERECEIVED);
+	lua->setGlobalInt("PLAYERKILLED", ObserverEventType::PLAYERKILLED);
+	lua->setGlobalInt("PLAYERCLONED", ObserverEventType::PLAYERCLONED);
+	lua->setGlobalInt("CRAFTINGASSEMBLY", ObserverEventType::CRAFTINGASSEMBLY);
+	lua->setGlobalInt("CRAFTINGEXPERIMENTATION", ObserverEventType::CRAFTINGEXPERIMENTATION);
+	lua->setGlobalInt("HEALINGRECEIVED", ObserverEventType::HEALINGRECEIVED);
+	lua->setGlobalInt("ENHANCINGPERFORMED", ObserverEventType::ENHANCINGPERFORMED);
+	lua->setGlobalInt("WOUNDHEALINGRECEIVED", ObserverEventType::WOUNDHEALINGRECEIVED);
+	lua->setGlobalInt("XPAWARDED", ObserverEventType::XPAWARDED);
+	lua->setGlobalInt("SPICEDOWNERACTIVATED", ObserverEventType::SPICEDOWNERACTIVATED);
+	lua->setGlobalInt("MEDPACKUSED", ObserverEventType::MEDPACKUSED);
+
+	lua->setGlobalInt("SHOT", SharedObjectTemplate::SHOT);
+	lua->setGlobalInt("STOT", SharedObjectTemplate::STOT);
+	lua->setGlobalInt("SBMK", SharedObjectTemplate::SBMK);
+	lua->setGlobalInt("SBOT", SharedObjectTemplate::SBOT);
+	lua->setGlobalInt("STAT", SharedObjectTemplate::STAT);
+	lua->setGlobalInt("SIOT", SharedObjectTemplate::SIOT);
+	lua->setGlobalInt("CCLT", SharedObjectTemplate::CCLT);
+	lua->setGlobalInt("SCOU", SharedObjectTemplate::SCOU);
+	lua->setGlobalInt("SDSC", SharedObjectTemplate::SDSC);
+	lua->setGlobalInt("SFOT", SharedObjectTemplate::SFOT);
+	lua->setGlobalInt("SGRP", SharedObjectTemplate::SGRP);
+	lua->setGlobalInt("SITN", SharedObjectTemplate::SITN);
+	lua->setGlobalInt("SGLD", SharedObjectTemplate::SGLD);
+	lua->setGlobalInt("SJED", SharedObjectTemplate::SJED);
+	lua->setGlobalInt("SMSC", SharedObjectTemplate::SMSC);
+	lua->setGlobalInt("SMSO", SharedObjectTemplate::SMSO);
+	lua->setGlobalInt("SMSD", SharedObjectTemplate::SMSD);
+	lua->setGlobalInt("SMLE", SharedObjectTemplate::SMLE);
+	lua->setGlobalInt("SPLY", SharedObjectTemplate::SPLY);
+	lua->setGlobalInt("RCCT", SharedObjectTemplate::RCCT);
+	lua->setGlobalInt("SSHP", SharedObjectTemplate::SSHP);
+	lua->setGlobalInt("SUNI", SharedObjectTemplate::SUNI);
+	lua->setGlobalInt("SWAY", SharedObjectTemplate::SWAY);
+	lua->setGlobalInt("STOK", SharedObjectTemplate::STOK);
+	lua->setGlobalInt("SWOT", SharedObjectTemplate::SWOT);
+	lua->setGlobalInt("SCNC", SharedObjectTemplate::SCNC);
+	lua->setGlobalInt("SCOT", SharedObjectTemplate::SCOT);
+	lua->setGlobalInt("CHARACTERBUILDERTERMINAL", SharedObjectTemplate::CHARACTERBUILDERTERMINAL);
+	lua->setGlobalInt("LOOTKIT", SharedObjectTemplate::LOOTKIT);
+	lua->setGlobalInt("LOOTSCHEMATIC", SharedObjectTemplate::LOOTSCHEMATIC);
+	lua->setGlobalInt("GAMBLINGTERMINAL", SharedObjectTemplate::GAMBLINGTERMINAL);
+	lua->setGlobalInt("FIREWORK", SharedObjectTemplate::FIREWORK);
+	lua->setGlobalInt("SURVEYTOOL", SharedObjectTemplate::SURVEYTOOL);
+	lua->setGlobalInt("RECYCLETOOL", SharedObjectTemplate::RECYCLETOOL);
+	lua->setGlobalInt("CRAFTINGTOOL", SharedObjectTemplate::CRAFTINGTOOL);
+	lua->setGlobalInt("CRAFTINGSTATION", SharedObjectTemplate::CRAFTINGSTATION);
+	lua->setGlobalInt("RESOURCESPAWN", SharedObjectTemplate::RESOURCESPAWN);
+	lua->setGlobalInt("ARMOROBJECT", SharedObjectTemplate::ARMOROBJECT);
+	lua->setGlobalInt("DEED", SharedObjectTemplate::DEED);
+	lua->setGlobalInt("STRUCTUREDEED", SharedObjectTemplate::STRUCTUREDEED);
+	lua->setGlobalInt("VEHICLEDEED", SharedObjectTemplate::VEHICLEDEED);
+	lua->setGlobalInt("PETDEED", SharedObjectTemplate::PETDEED);
+	lua->setGlobalInt("DROIDDEED", SharedObjectTemplate::DROIDDEED);
+	lua->setGlobalInt("EVENTPERKDEED", SharedObjectTemplate::EVENTPERKDEED);
+	lua->setGlobalInt("MISSIONTERMINAL", SharedObjectTemplate::MISSIONTERMINAL);
+	lua->setGlobalInt("CLONINGBUILDING", SharedObjectTemplate::CLONINGBUILDING);
+	lua->setGlobalInt("DRAFTSCHEMATIC", SharedObjectTemplate::DRAFTSCHEMATIC);
+	lua->setGlobalInt("NPCCREATURE", SharedObjectTemplate::NPCCREATURE);
+	lua->setGlobalInt("LAIRTEMPLATE", SharedObjectTemplate::LAIRTEMPLATE);
+	lua->setGlobalInt("FACTORY", SharedObjectTemplate::FACTORY);
+	lua->setGlobalInt("STIMPACK", SharedObjectTemplate::STIMPACK);
+	lua->setGlobalInt("RANGEDSTIMPACK", SharedObjectTemplate::RANGEDSTIMPACK);
+	lua->setGlobalInt("ENHANCEPACK", SharedObjectTemplate::ENHANCEPACK);
+	lua->setGlobalInt("CUREPACK", SharedObjectTemplate::CUREPACK);
+	lua->setGlobalInt("DOTPACK", SharedObjectTemplate::DOTPACK);
+	lua->setGlobalInt("WOUNDPACK", SharedObjectTemplate::WOUNDPACK);
+	lua->setGlobalInt("STATEPACK", SharedObjectTemplate::STATEPACK);
+	lua->setGlobalInt("SKILLBUFF", SharedObjectTemplate::SKILLBUFF);
+	lua->setGlobalInt("CONSUMABLE", SharedObjectTemplate::CONSUMABLE);
+	lua->setGlobalInt("INSTRUMENT", SharedObjectTemplate::INSTRUMENT);
+	lua->setGlobalInt("CAMPKIT", SharedObjectTemplate::CAMPKIT);
+	lua->setGlobalInt("PLAYERCREATURE", SharedObjectTemplate::PLAYERCREATURE);
+	lua->setGlobalInt("SLICINGTOOL", SharedObjectTemplate::SLICINGTOOL);
+	lua->setGlobalInt("CONTAINER", SharedObjectTemplate::CONTAINER);
+	lua->setGlobalInt("ELEVATORTERMINAL", SharedObjectTemplate::ELEVATORTERMINAL);
+	lua->setGlobalInt("VENDORCREATURE", SharedObjectTemplate::VENDORCREATURE);
+	lua->setGlobalInt("CAMPSTRUCTURE", SharedObjectTemplate::CAMPSTRUCTURE);
+	lua->setGlobalInt("HOSPITALBUILDING", SharedObjectTemplate::HOSPITALBUILDING);
+	lua->setGlobalInt("RECREATIONBUILDING", SharedObjectTemplate::RECREATIONBUILDING);
+	lua->setGlobalInt("TRAP", SharedObjectTemplate::TRAP);
+	lua->setGlobalInt("CAMOKIT", SharedObjectTemplate::CAMOKIT);
+	lua->setGlobalInt("POWERUP", SharedObjectTemplate::POWERUP);
+	lua->setGlobalInt("DICE", SharedObjectTemplate::DICE);
+	lua->setGlobalInt("LIVESAMPLE", SharedObjectTemplate::LIVESAMPLE);
+	lua->setGlobalInt("CREATUREHABITAT", SharedObjectTemplate::CREATUREHABITAT);
+	lua->setGlobalInt("REPAIRTOOL", SharedObjectTemplate::REPAIRTOOL);
+	lua->setGlobalInt("VEHICLECUSTOMKIT", SharedObjectTemplate::VEHICLECUSTOMKIT);
+	lua->setGlobalInt("DROIDCUSTOMKIT", SharedObjectTemplate::DROIDCUSTOMKIT);
+	lua->setGlobalInt("DNASAMPLE", SharedObjectTemplate::DNASAMPLE);
+	lua->setGlobalInt("DROIDCOMPONENT", SharedObjectTemplate::DROIDCOMPONENT);
+	lua->setGlobalInt("DROIDCRAFTINGMODULE", SharedObjectTemplate::DROIDMODULECRAFTING);
+	lua->setGlobalInt("DROIDEFFECTSMODULE", SharedObjectTemplate::DROIDMODULEEFFECTS);
+	lua->setGlobalInt("DROIDPERSONALITYCHIP", SharedObjectTemplate::DROIDMODULEPERSONALITY);
+	lua->setGlobalInt("VEHICLE", SharedObjectTemplate::VEHICLE);
+	lua->setGlobalInt("XPPURCHASE", SharedObjectTemplate::XPPURCHASE);
+
+	lua->setGlobalInt("NO_HITLOCATION", ArmorObjectTemplate::NOLOCATION);
+	lua->setGlobalInt("CHEST_HITLOCATION", ArmorObjectTemplate::CHEST);
+	lua->setGlobalInt("ARMS_HITLOCATION", ArmorObjectTemplate::ARMS);
+	lua->setGlobalInt("LEGS_HITLOCATION", ArmorObjectTemplate::LEGS);
+	lua->setGlobalInt("HEAD_HITLOCATION", ArmorObjectTemplate::HEAD);
+
+	lua->setGlobalInt("GENETIC_LAB", DraftSchematicObjectTemplate::GENETIC_LAB);
+	lua->setGlobalInt("RESOURCE_LAB", DraftSchematicObjectTemplate::RESOURCE_LAB);
+
+	lua->setGlobalInt("STATIC", EventPerkDeedTemplate::STATIC);
+	lua->setGlobalInt("THEATER", EventPerkDeedTemplate::THEATER);
+	lua->setGlobalInt("RECRUITER", EventPerkDeedTemplate::RECRUITER);
+	lua->setGlobalInt("GAME", EventPerkDeedTemplate::GAME);
+	lua->setGlobalInt("HONORGUARD", EventPerkDeedTemplate::HONORGUARD);
+
+	lua->setGlobalInt("STIM_A", StimPackTemplate::STIM_A);
+	lua->setGlobalInt("STIM_B", StimPackTemplate::STIM_B);
+	lua->setGlobalInt("STIM_C", StimPackTemplate::STIM_C);
+	lua->setGlobalInt("STIM_D", StimPackTemplate::STIM_D);
+	lua->setGlobalInt("STIM_E", StimPackTemplate::STIM_E);
+
+	lua->setGlobalInt("CLONER_STANDARD", CloningBuildingObjectTemplate::STANDARD);
+	lua->setGlobalInt("CLONER_PLAYER_CITY", CloningBuildingObjectTemplate::PLAYER_CITY);
+	lua->setGlobalInt("CLONER_JEDI_ONLY", CloningBuildingObjectTemplate::JEDI_ONLY);
+	lua->setGlobalInt("CLONER_LIGHT_JEDI_ONLY", CloningBuildingObjectTemplate::LIGHT_JEDI_ONLY);
+	lua->setGlobalInt("CLONER_DARK_JEDI_ONLY", CloningBuildingObjectTemplate::DARK_JEDI_ONLY);
+	lua->setGlobalInt("CLONER_FACTION_REBEL", CloningBuildingObjectTemplate::FACTION_REBEL);
+	lua->setGlobalInt("CLONER_FACTION_IMPERIAL", CloningBuildingObjectTemplate::FACTION_IMPERIAL);
 }
 
 const String& TemplateManager::getTemplateFile(uint32 key) const {
@@ -992,22 +1117,39 @@ int TemplateManager::includeFile(lua_State* L) {
 }
 
 LuaObject* TemplateManager::getLuaObject(const String& iffTemplate) {
-	if (templateCRCMap->get(iffTemplate.hashCode()) == nullptr) {
-		String luaFileName = iffTemplate.replaceAll(".iff", ".lua");
+	auto hashCode = iffTemplate.hashCode();
 
-		luaTemplatesInstance->runFile("scripts/" + luaFileName);
-	}
+	TemplateLoaderThread* loader = loaderThread.get();
+	Lua* lua = luaTemplatesInstance;
 
-	auto hashCode = iffTemplate.hashCode();
+	if (loader != nullptr) {
+		// parallel loaders only know the templates of their own shard
+		lua = loader->getLua();
 
-	if (templateCRCMap->get(hashCode) == nullptr)
-		return nullptr;
+		if (!loader->hasLuaTemplate(hashCode)) {
+			String luaFileName = iffTemplate.replaceAll(".iff", ".lua");
+
+			loader->loadDependency("scripts/" + luaFileName);
+		}
+
+		if (!loader->hasLuaTemplate(hashCode))
+			return nullptr;
+	} else {
+		if (templateCRCMap->get(hashCode) == nullptr) {
+			String luaFileName = iffTemplate.replaceAll(".iff", ".lua");
+
+			luaTemplatesInstance->runFile("scripts/" + luaFileName);
+		}
+
+		if (templateCRCMap->get(hashCode) == nullptr)
+			return nullptr;
+	}
 
-	LuaFunction getObject(luaTemplatesInstance->getLuaState(), "getTemplate", 1);
+	LuaFunction getObject(lua->getLuaState(), "getTemplate", 1);
 	getObject << hashCode; // push first argument
 	getObject.callFunction();
 
-	LuaObject* result = new LuaObject(luaTemplatesInstance->getLuaState());
+	LuaObject* result = new LuaObject(lua->getLuaState());
 
 	if (!result->isValidTable()) {
 		System::err << "Unknown lua object template " << iffTemplate << endl;
@@ -1037,6 +1179,12 @@ int TemplateManager::addTemplateCRC(lua_State* L) {
 
 	uint32 crc = (uint32) ascii.hashCode();
 
+	TemplateLoaderThread* loader = loaderThread.get();
+
+	// the shard owning this file registers it
+	if (loader != nullptr && !loader->isRegisteringTemplates())
+		return 0;
+
 	TemplateManager::instance()->addTemplate(crc, ascii, &obj);
 
 //	uint64 seconds = Logger::getElapsedTime();
@@ -1058,7 +1206,13 @@ int TemplateManager::addClientTemplate(lua_State* L) {
 
 	uint32 crc = (uint32) ascii.hashCode();
 
-	TemplateManager::instance()->clientTemplateCRCMap->put(crc, ascii);
+	TemplateLoaderThread* loader = loaderThread.get();
+
+	if (loader != nullptr)
+		loader->addClientTemplate(crc, ascii);
+	else
+		TemplateManager::instance()->clientTemplateCRCMap->put(crc, ascii);
+
 	return 0;
 }
 
@@ -1072,6 +1226,14 @@ const StructureFootprint* TemplateManager::loadStructureFootprint(const String&
 
 	Reference<StructureFootprint*> structureFootprint = structureFootprints.get(filePath);
 
+	if (structureFootprint != nullptr)
+		return structureFootprint;
+
+	// parallel template loaders must not replace a footprint another template already points to
+	Locker locker(&structureFootprintsMutex);
+
+	structureFootprint = structureFootprints.get(filePath);
+
 	if (structureFootprint != nullptr)
 		return structureFootprint;
 
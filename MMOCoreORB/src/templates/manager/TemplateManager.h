@@ -25,6 +25,7 @@ class ClientTemplateCRCMap;
 
 class TreeDirectory;
 class PaletteTemplate;
+class TemplateLoaderThread;
 
 class TemplateManager : public Singleton<TemplateManager>, public Logger, public Object {
 	TemplateCRCMap* templateCRCMap;
@@ -45,11 +46,16 @@ class TemplateManager : public Singleton<TemplateManager>, public Logger, public
 	SynchronizedVectorMap<String, Reference<ArrangementDescriptor*> > arrangementDescriptors;
 
 	ReadWriteLock appearanceMapLock;
+	Mutex structureFootprintsMutex;
+
+	// set on the threads of a parallel template load
+	static ThreadLocal<TemplateLoaderThread*> loaderThread;
 
 	void loadTreArchive();
 	void loadSlotDefinitions();
 	void loadPlanetMapCategories();
 	void loadAssetCustomizationManager();
+	void loadLuaTemplatesParallel(int threads);
 
 public:
 	static Lua* luaTemplatesInstance;
@@ -122,8 +128,8 @@ public:
 	bool existsTemplate(uint32 key) const;
 
 	// LUA
-	void registerFunctions();
-	void registerGlobals();
+	void registerFunctions(Lua* lua);
+	void registerGlobals(Lua* lua);
 	static int includeFile(lua_State* L);
 	static int crcString(lua_State* L);
 	static int addTemplateCRC(lua_State* L);
@@ -172,6 +178,7 @@ public:
 	}
 
 	friend class SharedObjectTemplate;
+	friend class TemplateLoaderThread;
 };
 
 #endif /* TEMPLATEMANAGER_H_ */
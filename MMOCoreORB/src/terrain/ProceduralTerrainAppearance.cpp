@@ -424,6 +424,22 @@ int ProceduralTerrainAppearance::getEnvironmentID(float x, float y) const {
 float ProceduralTerrainAppearance::getHeight(float x, float y) const {
 	ReadLocker locker(&guard);
 
+	return getHeightUnlocked(x, y);
+}
+
+void ProceduralTerrainAppearance::getHeights(float x0, float y0, float spacing, int width, int height, float* heights) const {
+	// one guard acquisition for the whole grid instead of one per sample
+	ReadLocker locker(&guard);
+
+	for (int i = 0; i < height; ++i) {
+		float y = y0 + i * spacing;
+
+		for (int j = 0; j < width; ++j)
+			heights[i * width + j] = getHeightUnlocked(x0 + j * spacing, y);
+	}
+}
+
+float ProceduralTerrainAppearance::getHeightUnlocked(float x, float y) const {
 	float affectorTransform = 1.0;
 
 	float transformValue = 0;
@@ -72,6 +72,12 @@ class ProceduralTerrainAppearance : public TemplateVariable<'PTAT'>, public Logg
 protected:
 	static float calculateFeathering(float value, int featheringType);
 	float processTerrain(const Layer* layer, float x, float y, float& baseValue, float affectorTransformValue, int affectorType) const;
+
+	/**
+	 * getHeight without taking the guard, callers hold it
+	 */
+	float getHeightUnlocked(float x, float y) const;
+
 	Layer* getLayerRecursive(float x, float y, Layer* rootParent) const;
 	Layer* getLayer(float x, float y) const;
 
@@ -103,6 +109,7 @@ public:
 
 	bool getWater(float x, float y, float& waterHeight) const override;
 	float getHeight(float x, float y) const override;
+	void getHeights(float x0, float y0, float spacing, int width, int height, float* heights) const override;
 	int getEnvironmentID(float x, float y) const;
 
 	float getGlobalWaterTableHeight() const {
@@ -20,6 +20,16 @@ public:
 		return 0;
 	}
 
+	/**
+	 * Fills heights with the width x height grid of samples starting at x0, y0, spacing meters apart, row by row.
+	 */
+	virtual void getHeights(float x0, float y0, float spacing, int width, int height, float* heights) const {
+		for (int i = 0; i < height; ++i) {
+			for (int j = 0; j < width; ++j)
+				heights[i * width + j] = getHeight(x0 + j * spacing, y0 + i * spacing);
+		}
+	}
+
 	virtual bool getWater(float x, float y, float& waterHeight) const {
 		return false;
 	}
@@ -9,140 +9,329 @@
 #include "TerrainManager.h"
 
 #include "terrain/TerrainGenerator.h"
+#include "terrain/ProceduralTerrainAppearance.h"
 
-#include "system/util/Vector.h"
+#include <algorithm>
 
-#define CACHE_CAPACITY 1024 * 1024
-#define CACHE_MIN_ACCESS_COUNT 5
-#define QT_MIN_SQUARE 16
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+
+#define CACHE_MAX_SAMPLES (4 * 1024 * 1024)
+#define CACHE_EVICT_DIVISOR 8
+#define MAX_POLE_SPACING 1.f
+#define MIN_POLE_SPACING 0.25f
+#define MAX_TILE_SUBDIVISIONS 3
+#define HEIGHT_TOLERANCE 0.05f
 
 namespace detail {
-	inline uint64 hashPosition(const float x, const float y) {
-		union {
-			uint32 uval;
-			float fval;
-		} v;
+	template<class T>
+	inline T clamp(T low, T value, T high) {
+		return Math::min(high, Math::max(low, value));
+	}
 
-		v.fval = x ;
+	inline float bilinear(float h00, float h10, float h01, float h11, float fracX, float fracY) {
+		float top = h00 + (h10 - h00) * fracX;
+		float bottom = h01 + (h11 - h01) * fracX;
 
-		uint32 val1 = v.uval;
+		return top + (bottom - top) * fracY;
+	}
+}
 
-		v.fval = y;
+TerrainCache::TerrainCache(TerrainManager* terrainManager) : Logger("TerrainCache"),
+		terrainManager(terrainManager), min(terrainManager->getMin()), max(terrainManager->getMax()),
+		publishedSamples(0), epoch(0), version(0), accessClock(0) {
 
-		uint32 val2 = v.uval;
+	activeReaders[0].store(0);
+	activeReaders[1].store(0);
 
-		uint64 hash = val1;
+	spacing = MAX_POLE_SPACING;
 
-		return (hash << 32) | val2;
-	}
+	ProceduralTerrainAppearance* ptat = terrainManager->getProceduralTerrainAppearance();
+
+	// sample at the client terrain pole spacing, which is what players see the ground at
+	if (ptat != nullptr && ptat->getDistanceBetweenPoles() > 0)
+		spacing = detail::clamp(MIN_POLE_SPACING, ptat->getDistanceBetweenPoles(), MAX_POLE_SPACING);
+
+	tileSize = spacing * TerrainHeightTile::TILE_CELLS;
+	tilesPerSide = Math::max(1, (int) ceil((max - min) / tileSize));
+
+	int totalTiles = tilesPerSide * tilesPerSide;
+
+	tiles = new std::atomic<TerrainHeightTile*>[totalTiles];
+
+	for (int i = 0; i < totalTiles; ++i)
+		tiles[i].store(nullptr, std::memory_order_relaxed);
 }
 
-class HeightQuadTreeEntry : public QuadTreeEntryInterface {
-	float x, y;
-public:
-	HeightQuadTreeEntry(float x, float y) : x(x), y(y) {
+TerrainCache::~TerrainCache() {
+	int totalTiles = tilesPerSide * tilesPerSide;
 
-	}
+	for (int i = 0; i < totalTiles; ++i)
+		delete tiles[i].load(std::memory_order_relaxed);
 
-	int compareTo(const QuadTreeEntryInterfaceBase<BasicQuadTreeNode>* obj) const override {
-		auto oid = getObjectID();
-		auto targetOid = obj->getObjectID();
+	delete [] tiles;
 
-		if (oid < targetOid)
-			return 1;
-		else if (oid > targetOid)
-			return -1;
-		else
-			return 0;
-	}
+	Locker locker(&tilesMutex);
 
-	uint64 getObjectID() const override {
-		return detail::hashPosition(x, y);
-	}
+	freeRetiredTiles(true);
+}
 
-	float getPositionX() const override {
-		return x;
-	}
+void TerrainCache::locate(float x, float y, int& tileIndex, int& cellX, int& cellY, float& fracX, float& fracY) const {
+	int maxCell = tilesPerSide * TerrainHeightTile::TILE_CELLS - 1;
 
-	float getPositionY() const override {
-		return y;
-	}
-};
+	float gridX = (x - min) / spacing;
+	float gridY = (y - min) / spacing;
 
-class HeightCacheFunction : public LRUFunction2<uint64, float, float,
-	Pair<QuadTreeEntryInterface*, float> > {
-	TerrainManager* terrainData;
+	int globalX = detail::clamp(0, (int) gridX, maxCell);
+	int globalY = detail::clamp(0, (int) gridY, maxCell);
 
-public:
-	HeightCacheFunction(TerrainManager* app) : terrainData(app) {
+	fracX = detail::clamp(0.f, gridX - globalX, 1.f);
+	fracY = detail::clamp(0.f, gridY - globalY, 1.f);
 
-	}
+	int tileX = globalX / TerrainHeightTile::TILE_CELLS;
+	int tileY = globalY / TerrainHeightTile::TILE_CELLS;
+
+	cellX = globalX - tileX * TerrainHeightTile::TILE_CELLS;
+	cellY = globalY - tileY * TerrainHeightTile::TILE_CELLS;
+
+	tileIndex = tileY * tilesPerSide + tileX;
+}
+
+void TerrainCache::getCorners(float x, float y, float& h00, float& h10, float& h01, float& h11, float& fracX, float& fracY) {
+	int tileIndex, cellX, cellY, sampleX, sampleY;
+
+	locate(x, y, tileIndex, cellX, cellY, fracX, fracY);
+
+	const TerrainHeightTile* tile = getTile(tileIndex);
+
+	tile->locateSample(cellX, cellY, fracX, fracY, sampleX, sampleY);
 
-	TerrainCache::lru_value_t run(const float& k, const float& k2) override {
-		float height = terrainData->getUnCachedHeight(k , k2);
+	const float* row0 = tile->getRow(sampleY);
+	const float* row1 = tile->getRow(sampleY + 1);
 
-		return make_pair(new HeightQuadTreeEntry(k, k2), height);
+	h00 = row0[sampleX];
+	h10 = row0[sampleX + 1];
+	h01 = row1[sampleX];
+	h11 = row1[sampleX + 1];
+}
+
+float TerrainCache::getHeight(float x, float y) {
+	float h00, h10, h01, h11, fracX, fracY;
+
+	uint32 readEpoch = enterRead();
+
+	getCorners(x, y, h00, h10, h01, h11, fracX, fracY);
+
+	exitRead(readEpoch);
+
+	return detail::bilinear(h00, h10, h01, h11, fracX, fracY);
+}
+
+void TerrainCache::getHeights(const float* x, const float* y, float* heights, int count) {
+	int i = 0;
+
+	uint32 readEpoch = enterRead();
+
+#ifdef __SSE__
+	alignas(16) float h00[4], h10[4], h01[4], h11[4], fracX[4], fracY[4];
+
+	for (; i + 4 <= count; i += 4) {
+		for (int k = 0; k < 4; ++k)
+			getCorners(x[i + k], y[i + k], h00[k], h10[k], h01[k], h11[k], fracX[k], fracY[k]);
+
+		__m128 fx = _mm_load_ps(fracX);
+		__m128 fy = _mm_load_ps(fracY);
+
+		__m128 a = _mm_load_ps(h00);
+		__m128 b = _mm_load_ps(h01);
+
+		__m128 top = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(_mm_load_ps(h10), a), fx));
+		__m128 bottom = _mm_add_ps(b, _mm_mul_ps(_mm_sub_ps(_mm_load_ps(h11), b), fx));
+
+		_mm_storeu_ps(&heights[i], _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), fy)));
 	}
+#endif
+
+	for (; i < count; ++i) {
+		float h00, h10, h01, h11, fracX, fracY;
+
+		getCorners(x[i], y[i], h00, h10, h01, h11, fracX, fracY);
 
-	uint64 hash(const float& k, const float& k2) const override {
-		return detail::hashPosition(k, k2);
+		heights[i] = detail::bilinear(h00, h10, h01, h11, fracX, fracY);
 	}
-};
 
-TerrainCache::TerrainCache(TerrainManager* terrainManager) :
-		SynchronizedLRUCache2<uint64, float, float, Pair<QuadTreeEntryInterface*, float> >(new HeightCacheFunction(terrainManager),
-				CACHE_CAPACITY, CACHE_MIN_ACCESS_COUNT), Logger("TerrainCache"),
-		quadTree(terrainManager->getMin(), terrainManager->getMin(),
-				terrainManager->getMax(), terrainManager->getMax(), QT_MIN_SQUARE),
-				clearCount(0), clearHeightsCount(0), evictCount(0), max(terrainManager->getMax()),
-				min(terrainManager->getMin()) {
+	exitRead(readEpoch);
+}
+
+const TerrainHeightTile* TerrainCache::getTile(int tileIndex) {
+	TerrainHeightTile* tile = tiles[tileIndex].load();
+
+	if (tile == nullptr)
+		return generateTile(tileIndex);
+
+	hitCount.increment();
+
+	uint32 clock = accessClock.load(std::memory_order_relaxed);
+
+	// avoid dirtying the cache line of hot tiles on every read
+	if (tile->lastAccess.load(std::memory_order_relaxed) != clock)
+		tile->lastAccess.store(clock, std::memory_order_relaxed);
 
+	return tile;
 }
 
-TerrainCache::~TerrainCache() {
-	while (getSize() > 0) {
-		evict();
+TerrainHeightTile* TerrainCache::sampleTile(float x0, float y0) {
+	for (int subdivisions = 0; ; ++subdivisions) {
+		int cells = TerrainHeightTile::TILE_CELLS << subdivisions;
+		float sampleSpacing = spacing / (1 << subdivisions);
+
+		TerrainHeightTile* tile = new TerrainHeightTile(subdivisions);
+
+		terrainManager->getUnCachedHeights(x0, y0, sampleSpacing, cells + 1, cells + 1, tile->heights);
+
+		if (subdivisions == MAX_TILE_SUBDIVISIONS)
+			return tile;
+
+		// the interpolation is furthest from the poles in the middle of a cell
+		std::vector<float> centers(cells * cells);
+
+		terrainManager->getUnCachedHeights(x0 + sampleSpacing / 2, y0 + sampleSpacing / 2, sampleSpacing, cells, cells, centers.data());
+
+		bool smooth = true;
+
+		for (int y = 0; y < cells && smooth; ++y) {
+			const float* row0 = tile->getRow(y);
+			const float* row1 = tile->getRow(y + 1);
+
+			for (int x = 0; x < cells; ++x) {
+				float interpolated = (row0[x] + row0[x + 1] + row1[x] + row1[x + 1]) * 0.25f;
+
+				if (fabs(interpolated - centers[y * cells + x]) > HEIGHT_TOLERANCE) {
+					smooth = false;
+					break;
+				}
+			}
+		}
+
+		if (smooth)
+			return tile;
+
+		refinedCount.increment();
+
+		delete tile;
 	}
 }
 
-bool TerrainCache::insert(const float& k, const float& k2, const lru_value_t& v) {
-	Locker writeLock(getLock());
+const TerrainHeightTile* TerrainCache::generateTile(int tileIndex) {
+	uint32 generatedVersion = version.load(std::memory_order_acquire);
 
-	bool result = lru_cache_t::insert(k, k2, v);
+	int tileX = tileIndex % tilesPerSide;
+	int tileY = tileIndex / tilesPerSide;
 
-	if (!result) {
-		delete v.first;
+	TerrainHeightTile* tile = sampleTile(min + tileX * tileSize, min + tileY * tileSize);
 
-		return result;
+	tile->lastAccess.store(accessClock.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+	missCount.increment();
+
+	Locker locker(&tilesMutex);
+
+	TerrainHeightTile* current = tiles[tileIndex].load(std::memory_order_relaxed);
+
+	// another thread published it first
+	if (current != nullptr) {
+		delete tile;
+
+		return current;
 	}
 
-	if (k >= max || k2 >= max
-			|| k <= min || k2 <= min) {
-		warning() << "position  (" << k << ", " << k2 << ") out of planet/cache bounds: ["
-				<< min << ", " << max << "]";
-	} else {
-		quadTree.insert(v.first);
+	// the layers changed while we were sampling them
+	if (version.load(std::memory_order_relaxed) != generatedVersion) {
+		locker.release();
+
+		delete tile;
+
+		return generateTile(tileIndex);
 	}
 
-	return true;
+	tiles[tileIndex].store(tile);
+	publishedTiles.push_back(tileIndex);
+	publishedSamples += tile->getSampleCount();
+
+	if (publishedSamples > CACHE_MAX_SAMPLES)
+		evictTiles();
+
+	freeRetiredTiles(false);
+
+	return tile;
 }
 
-TerrainCache::lru_value_t TerrainCache::evict() {
-	lru_value_t value = lru_cache_t::evict();
+void TerrainCache::evictTiles() {
+	std::vector<uint64> candidates;
+	candidates.reserve(publishedTiles.size());
+
+	for (int tileIndex : publishedTiles) {
+		TerrainHeightTile* tile = tiles[tileIndex].load(std::memory_order_relaxed);
 
-	quadTree.remove(value.first);
+		if (tile != nullptr)
+			candidates.push_back(((uint64) tile->lastAccess.load(std::memory_order_relaxed) << 32) | (uint32) tileIndex);
+	}
 
-	delete value.first;
+	std::sort(candidates.begin(), candidates.end());
 
-	++evictCount;
+	uint64 targetSamples = CACHE_MAX_SAMPLES - CACHE_MAX_SAMPLES / CACHE_EVICT_DIVISOR;
 
-	return value;
+	for (int i = 0; i < (int) candidates.size() && publishedSamples > targetSamples; ++i) {
+		int tileIndex = (int) (candidates[i] & 0xFFFFFFFF);
+
+		retireTile(tiles[tileIndex].exchange(nullptr));
+
+		evictCount.increment();
+	}
+
+	publishedTiles.erase(std::remove_if(publishedTiles.begin(), publishedTiles.end(), [this] (int tileIndex) {
+		return tiles[tileIndex].load(std::memory_order_relaxed) == nullptr;
+	}), publishedTiles.end());
 }
 
-float TerrainCache::getHeight(float x, float y) {
-	lru_value_t result = (*this)(x, y);
+void TerrainCache::retireTile(TerrainHeightTile* tile) {
+	if (tile == nullptr)
+		return;
+
+	publishedSamples -= tile->getSampleCount();
+
+	retiredTiles.emplace_back(epoch.load(), tile);
+}
+
+void TerrainCache::freeRetiredTiles(bool force) {
+	if (retiredTiles.empty())
+		return;
+
+	// a reader can be counted in either parity, each step waits for the one
+	// before the current epoch to drain
+	for (int i = 0; i < 2; ++i) {
+		uint32 current = epoch.load();
 
-	return result.second;
+		if (activeReaders[(current - 1) & 1].load() != 0)
+			break;
+
+		epoch.store(current + 1);
+	}
+
+	uint32 current = epoch.load();
+
+	auto it = retiredTiles.begin();
+
+	while (it != retiredTiles.end()) {
+		if (force || current - it->first >= 2) {
+			delete it->second;
+
+			it = retiredTiles.erase(it);
+		} else {
+			++it;
+		}
+	}
 }
 
 void TerrainCache::clear(TerrainGenerator* generator) {
@@ -153,21 +342,40 @@ void TerrainCache::clear(TerrainGenerator* generator) {
 	if (!result)
 		return;
 
-	Vector<QuadTreeEntryInterface*> heightsToDelete;
+	Locker locker(&tilesMutex);
+
+	version.fetch_add(1, std::memory_order_acq_rel);
+
+	clearCount.increment();
 
-	Locker writeLock(getLock());
+	// one extra pole around the circle, samples next to it interpolate into it
+	int minTileX = detail::clamp(0, (int) ((centerX - radius - spacing - min) / tileSize), tilesPerSide - 1);
+	int maxTileX = detail::clamp(0, (int) ((centerX + radius + spacing - min) / tileSize), tilesPerSide - 1);
+	int minTileY = detail::clamp(0, (int) ((centerY - radius - spacing - min) / tileSize), tilesPerSide - 1);
+	int maxTileY = detail::clamp(0, (int) ((centerY + radius + spacing - min) / tileSize), tilesPerSide - 1);
 
-	++clearCount;
+	bool cleared = false;
 
-	clearHeightsCount += quadTree.inRange(centerX, centerY, radius, heightsToDelete);
+	for (int tileY = minTileY; tileY <= maxTileY; ++tileY) {
+		for (int tileX = minTileX; tileX <= maxTileX; ++tileX) {
+			TerrainHeightTile* tile = tiles[tileY * tilesPerSide + tileX].exchange(nullptr);
 
-	for (int i = 0; i < heightsToDelete.size(); ++i) {
-		HeightQuadTreeEntry* entry = static_cast<HeightQuadTreeEntry*>(heightsToDelete.get(i));
+			if (tile == nullptr)
+				continue;
 
-		remove(entry->getObjectID());
+			clearHeightsCount.add(tile->getSampleCount());
 
-		quadTree.remove(entry);
+			retireTile(tile);
 
-		delete entry;
+			cleared = true;
+		}
 	}
+
+	if (cleared) {
+		publishedTiles.erase(std::remove_if(publishedTiles.begin(), publishedTiles.end(), [this] (int tileIndex) {
+			return tiles[tileIndex].load(std::memory_order_relaxed) == nullptr;
+		}), publishedTiles.end());
+	}
+
+	freeRetiredTiles(false);
 }
@@ -9,54 +9,206 @@
 #define SRC_SERVER_ZONE_MANAGERS_TERRAIN_TERRAINCACHE_H_
 
 #include "engine/engine.h"
-#include "engine/util/lru/SynchronizedLRUCache.h"
-#include "engine/util/u3d/BasicQuadTree.h"
 
-#include "system/lang/Pair.h"
+#include <atomic>
+#include <vector>
 
 class TerrainManager;
 class TerrainGenerator;
 
-class TerrainCache : public SynchronizedLRUCache2<uint64, float, float,
-	Pair<QuadTreeEntryInterface*, float> >, public Logger {
+/**
+ * Square height field of a TILE_CELLS x TILE_CELLS block of terrain poles. Tiles share
+ * their border samples with their neighbors so a tile can be sampled on its own. Where
+ * the layers are too rough to interpolate between poles, every pole cell is split in
+ * 1 << subdivisions cells per side.
+ */
+class TerrainHeightTile {
 public:
-	typedef Pair<QuadTreeEntryInterface*, float> lru_value_t;
-	typedef SynchronizedLRUCache2<uint64, float, float, lru_value_t > lru_cache_t;
+	const static int TILE_CELLS = 32;
+	const static int TILE_SAMPLES = TILE_CELLS + 1;
+
+	const int subdivisions;
+	const int samples;
+
+	float* heights;
+
+	// cache access clock of the last read, for eviction
+	std::atomic<uint32> lastAccess;
+
+	TerrainHeightTile(int subdivisions) : subdivisions(subdivisions), samples((TILE_CELLS << subdivisions) + 1), lastAccess(0) {
+		heights = new float[samples * samples];
+	}
+
+	~TerrainHeightTile() {
+		delete [] heights;
+	}
+
+	inline const float* getRow(int y) const {
+		return &heights[y * samples];
+	}
+
+	inline int getSampleCount() const {
+		return samples * samples;
+	}
+
+	/**
+	 * Turns a pole cell and the fractions inside it into the sample cell and fractions of this tile.
+	 */
+	inline void locateSample(int cellX, int cellY, float& fracX, float& fracY, int& sampleX, int& sampleY) const {
+		if (subdivisions == 0) {
+			sampleX = cellX;
+			sampleY = cellY;
+
+			return;
+		}
+
+		int scale = 1 << subdivisions;
+
+		float u = (cellX + fracX) * scale;
+		float v = (cellY + fracY) * scale;
 
+		sampleX = Math::min((int) u, samples - 2);
+		sampleY = Math::min((int) v, samples - 2);
+
+		fracX = Math::min(u - sampleX, 1.f);
+		fracY = Math::min(v - sampleY, 1.f);
+	}
+};
+
+/**
+ * Tiled height field of a planet. Tiles are generated in one pass over the procedural
+ * layers the first time a position inside them is asked for, then published in a flat
+ * tile grid that readers sample without taking any lock. Heights are bilinearly
+ * interpolated between the terrain poles, tiles the interpolation doesn't fit within
+ * HEIGHT_TOLERANCE are sampled finer.
+ *
+ * Readers register in the parity of the epoch they start in. Evicted and cleared tiles
+ * are unpublished right away and freed once the epoch moved two steps past the one they
+ * were retired in, which can only happen after every reader that could still see them
+ * left.
+ */
+class TerrainCache : public Logger {
 protected:
-	BasicQuadTree quadTree;
+	TerrainManager* terrainManager;
 
-	int clearCount;
-	int clearHeightsCount;
-	int evictCount;
+	const float min, max;
 
-	const float max, min;
+	float spacing;
+	float tileSize;
+	int tilesPerSide;
 
-public:
-	TerrainCache(TerrainManager* terrainManager);
-	~TerrainCache();
+	std::atomic<TerrainHeightTile*>* tiles;
 
-private:
-	bool insert(const float& k, const float& k2, const lru_value_t& v) override;
+	// guards publishing, eviction, clears and reclamation
+	Mutex tilesMutex;
+	std::vector<int> publishedTiles;
+	std::vector<std::pair<uint32, TerrainHeightTile*> > retiredTiles;
+	uint64 publishedSamples;
+
+	std::atomic<uint32> epoch;
+	std::atomic<int> activeReaders[2];
+
+	// bumped on every clear so tiles generated from the old layers are not published
+	std::atomic<uint32> version;
+	std::atomic<uint32> accessClock;
 
-	lru_value_t evict() override;
+	AtomicInteger hitCount;
+	AtomicInteger missCount;
+	AtomicInteger clearCount;
+	AtomicInteger clearHeightsCount;
+	AtomicInteger evictCount;
+	AtomicInteger refinedCount;
 
 public:
+	TerrainCache(TerrainManager* terrainManager);
+	~TerrainCache();
+
 	void clear(TerrainGenerator* layers);
 
 	float getHeight(float x, float y);
 
+	/**
+	 * Samples count positions, four at a time.
+	 */
+	void getHeights(const float* x, const float* y, float* heights, int count);
+
+	inline float getSpacing() const {
+		return spacing;
+	}
+
+	int getHitCount() const {
+		return hitCount.get();
+	}
+
+	int getMissCount() const {
+		return missCount.get();
+	}
+
+	int getSize() {
+		Locker locker(&tilesMutex);
+
+		return publishedTiles.size();
+	}
+
+	int getRetiredCount() {
+		Locker locker(&tilesMutex);
+
+		return retiredTiles.size();
+	}
+
 	int getClearCount() const {
-		return clearCount;
+		return clearCount.get();
 	}
 
 	int getClearHeightsCount() const {
-		return clearHeightsCount;
+		return clearHeightsCount.get();
 	}
 
 	int getEvictCount() const {
-		return evictCount;
+		return evictCount.get();
+	}
+
+	int getRefinedCount() const {
+		return refinedCount.get();
 	}
+
+private:
+	inline uint32 enterRead() {
+		uint32 readEpoch = epoch.load();
+
+		activeReaders[readEpoch & 1].fetch_add(1);
+
+		return readEpoch;
+	}
+
+	inline void exitRead(uint32 readEpoch) {
+		activeReaders[readEpoch & 1].fetch_sub(1, std::memory_order_release);
+	}
+
+	/**
+	 * Splits a position into its tile and the cell and fractions inside the tile.
+	 */
+	inline void locate(float x, float y, int& tileIndex, int& cellX, int& cellY, float& fracX, float& fracY) const;
+
+	/**
+	 * Reads the four samples around a position, to be called between enterRead and exitRead.
+	 */
+	inline void getCorners(float x, float y, float& h00, float& h10, float& h01, float& h11, float& fracX, float& fracY);
+
+	const TerrainHeightTile* getTile(int tileIndex);
+
+	const TerrainHeightTile* generateTile(int tileIndex);
+
+	TerrainHeightTile* sampleTile(float x0, float y0);
+
+	/// Pre Locked
+	void evictTiles();
+
+	/// Pre Locked
+	void retireTile(TerrainHeightTile* tile);
+
+	/// Pre Locked
+	void freeRetiredTiles(bool force);
 };
 
 #endif /* SRC_SERVER_ZONE_MANAGERS_TERRAIN_TERRAINCACHE_H_ */
@@ -64,10 +64,12 @@ float TerrainManager::getHighestHeight(float x0, float y0, float x1, float y1, i
 
 	float maxHeight = -16000.f;
 
+	std::vector<float> xs, ys, heights;
+
 	for (int i = (int)y0; i < (int)y0 + deltaY; i += stepping) {
-		for (int j = (int)x0; j < (int)x0 + deltaX; j += stepping) {
-			float height = getHeight(j, i);
+		getRowHeights((int)x0, (int)x0 + deltaX, i, stepping, xs, ys, heights);
 
+		for (float height : heights) {
 			if (height > maxHeight)
 				maxHeight = height;
 		}
@@ -82,10 +84,12 @@ float TerrainManager::getLowestHeight(float x0, float y0, float x1, float y1, in
 
 	float minHeight = 16000.f;
 
+	std::vector<float> xs, ys, heights;
+
 	for (int i = (int)y0; i < (int)y0 + deltaY; i += stepping) {
-		for (int j = (int)x0; j < (int)x0 + deltaX; j += stepping) {
-			float height = getHeight(j, i);
+		getRowHeights((int)x0, (int)x0 + deltaX, i, stepping, xs, ys, heights);
 
+		for (float height : heights) {
 			if (height < minHeight)
 				minHeight = height;
 		}
@@ -94,6 +98,21 @@ float TerrainManager::getLowestHeight(float x0, float y0, float x1, float y1, in
 	return minHeight;
 }
 
+void TerrainManager::getRowHeights(int x0, int x1, int y, int stepping, std::vector<float>& xs, std::vector<float>& ys, std::vector<float>& heights) {
+	xs.clear();
+	ys.clear();
+
+	for (int j = x0; j < x1; j += stepping) {
+		xs.push_back(j);
+		ys.push_back(y);
+	}
+
+	heights.resize(xs.size());
+
+	if (!heights.empty())
+		getHeights(xs.data(), ys.data(), heights.data(), heights.size());
+}
+
 float TerrainManager::getHighestHeightDifference(float x0, float y0, float x1, float y1, int stepping) {
 	return getHighestHeight(x0, y0, x1, y1, stepping) - getLowestHeight(x0, y0, x1, y1, stepping);
 }
@@ -158,6 +177,10 @@ float TerrainManager::getUnCachedHeight(float x, float y) const {
 	return terrainData->getHeight(x, y);
 }
 
+void TerrainManager::getUnCachedHeights(float x0, float y0, float spacing, int width, int height, float* heights) const {
+	terrainData->getHeights(x0, y0, spacing, width, height, heights);
+}
+
 float TerrainManager::getCachedHeight(float x, float y) {
 	return heightCache->getHeight(x, y);
 }
@@ -173,11 +196,27 @@ float TerrainManager::getHeight(float x, float y) {
 	}
 
 #ifdef USE_CACHED_HEIGHT
-	x = floor(x * 10) / 10.f;
-	y = floor(y * 10) / 10.f;
-
 	return getCachedHeight(x, y);
 #else
 	return getUnCachedHeight(x, y);
 #endif
 }
+
+void TerrainManager::getHeights(const float* x, const float* y, float* heights, int count) {
+#ifdef USE_CACHED_HEIGHT
+	for (int i = 0; i < count; ++i) {
+		// let getHeight report the positions out of bounds
+		if (x[i] <= min || x[i] >= max || y[i] <= min || y[i] >= max) {
+			for (int j = 0; j < count; ++j)
+				heights[j] = getHeight(x[j], y[j]);
+
+			return;
+		}
+	}
+
+	heightCache->getHeights(x, y, heights, count);
+#else
+	for (int i = 0; i < count; ++i)
+		heights[i] = getHeight(x[i], y[i]);
+#endif
+}
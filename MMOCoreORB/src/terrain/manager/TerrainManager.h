@@ -26,6 +26,11 @@ class TerrainManager : public Logger, public Object {
 protected:
 	void clearCache(TerrainGenerator* generator);
 
+	/**
+	 * Samples the heights of one row of an area through getHeights.
+	 */
+	void getRowHeights(int x0, int x1, int y, int stepping, std::vector<float>& xs, std::vector<float>& ys, std::vector<float>& heights);
+
 public:
 	TerrainManager();
 	~TerrainManager();
@@ -54,9 +59,15 @@ public:
 
 	float getCachedHeight(float x, float y);
 	float getUnCachedHeight(float x, float y) const;
+	void getUnCachedHeights(float x0, float y0, float spacing, int width, int height, float* heights) const;
 
 	virtual float getHeight(float x, float y);
 
+	/**
+	 * Batched getHeight, interpolates four positions at a time.
+	 */
+	virtual void getHeights(const float* x, const float* y, float* heights, int count);
+
 	float getMin() const {
 		if (terrainData) {
 			return terrainData->getSize() / 2 * -1;
@@ -106,6 +117,11 @@ public:
 class MockTerrainManager : public TerrainManager {
 public:
 	MOCK_METHOD2(getHeight,float(float x, float y));
+
+	void getHeights(const float* x, const float* y, float* heights, int count) {
+		for (int i = 0; i < count; ++i)
+			heights[i] = getHeight(x[i], y[i]);
+	}
 };
 #endif
 
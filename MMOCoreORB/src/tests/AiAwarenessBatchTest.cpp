@@ -0,0 +1,195 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "gtest/gtest.h"
+
+#include "conf/ConfigManager.h"
+#include "server/zone/managers/creature/AiAwarenessBatch.h"
+
+TEST(AiAwarenessBatchTest, CellKeys) {
+	// same cell
+	EXPECT_EQ(AiAwarenessBatch::getCellKey(1, 1), AiAwarenessBatch::getCellKey(60, 30));
+
+	EXPECT_NE(AiAwarenessBatch::getCellKey(1, 1), AiAwarenessBatch::getCellKey(70, 1));
+	EXPECT_NE(AiAwarenessBatch::getCellKey(1, 1), AiAwarenessBatch::getCellKey(1, -10));
+
+	// rows sort together, west to east
+	EXPECT_LT(AiAwarenessBatch::getCellKey(-500, 100), AiAwarenessBatch::getCellKey(500, 100));
+	EXPECT_LT(AiAwarenessBatch::getCellKey(500, 100), AiAwarenessBatch::getCellKey(-500, 200));
+
+	// off the map ends up in the border cells
+	EXPECT_EQ(AiAwarenessBatch::getCellKey(-9000, -9000), AiAwarenessBatch::getCellKey(-8192, -8192));
+}
+
+TEST(AiAwarenessBatchTest, FullPasses) {
+	ConfigManager::instance()->setInt("Core3.AiAwarenessFullPass", 3);
+
+	Reference<AiAwarenessBatch*> batch = new AiAwarenessBatch("awareness_test");
+
+	// nothing queued, the pass is not consumed
+	batch->runPass();
+
+	EXPECT_EQ(batch->getPass(), 1);
+	EXPECT_FALSE(batch->isFullPass());
+	EXPECT_EQ(batch->getPendingCount(), 0);
+
+	ConfigManager::instance()->setInt("Core3.AiAwarenessFullPass", 1);
+
+	batch = new AiAwarenessBatch("awareness_test");
+
+	EXPECT_TRUE(batch->isFullPass());
+}
+
+class TestAiAwarenessBatch : public AiAwarenessBatch {
+public:
+	uint64 now;
+	int scheduled;
+
+	TestAiAwarenessBatch() : AiAwarenessBatch("awareness_test"), now(100000), scheduled(0) {
+	}
+
+	void schedulePass() override {
+		++scheduled;
+	}
+
+	uint64 getTime() override {
+		return now;
+	}
+
+	void queue(uint64 objectID, uint64 delay) {
+		Locker locker(&pendingMutex);
+
+		pending.put(objectID, new AiAwarenessRequest(nullptr, now + delay));
+	}
+
+	int takeDue(uint64 delay) {
+		Vector<ManagedReference<AiAgent*> > agents;
+
+		Locker locker(&pendingMutex);
+
+		return takeDueRequests(now + delay, agents);
+	}
+
+	void nextPass() {
+		startPass();
+	}
+};
+
+TEST(AiAwarenessBatchTest, DueTimeSelection) {
+	ConfigManager::instance()->setInt("Core3.AiAwarenessInterval", 1000);
+
+	Reference<TestAiAwarenessBatch*> batch = new TestAiAwarenessBatch();
+
+	batch->queue(1, 0);
+	batch->queue(2, 400);
+	batch->queue(3, 1000);
+	batch->queue(4, 3000);
+
+	// up to half an interval early is still checked in this pass
+	EXPECT_EQ(batch->takeDue(500), 2);
+	EXPECT_EQ(batch->getPendingCount(), 2);
+
+	batch->now += 1000;
+
+	EXPECT_EQ(batch->takeDue(500), 1);
+	EXPECT_EQ(batch->getPendingCount(), 1);
+
+	// runPass keeps the remaining request for a later pass
+	batch->now += 1000;
+	batch->runPass();
+
+	EXPECT_EQ(batch->getPendingCount(), 1);
+	EXPECT_GT(batch->scheduled, 0);
+
+	batch->now += 1000;
+	batch->runPass();
+
+	EXPECT_EQ(batch->getPendingCount(), 0);
+}
+
+TEST(AiAwarenessBatchTest, MoverFiltering) {
+	Reference<TestAiAwarenessBatch*> batch = new TestAiAwarenessBatch();
+
+	Reference<SceneObject*> idle = new SceneObject();
+	idle->_setObjectID(1);
+
+	Reference<SceneObject*> walker = new SceneObject();
+	walker->_setObjectID(2);
+
+	// nobody looked at them in the previous pass
+	EXPECT_TRUE(batch->hasMoved(idle));
+	EXPECT_TRUE(batch->hasMoved(walker));
+
+	batch->nextPass();
+
+	walker->incrementMovementCounter();
+
+	EXPECT_FALSE(batch->hasMoved(idle));
+	EXPECT_TRUE(batch->hasMoved(walker));
+
+	// the answer holds for the whole pass
+	walker->incrementMovementCounter();
+	idle->incrementMovementCounter();
+
+	EXPECT_FALSE(batch->hasMoved(idle));
+	EXPECT_TRUE(batch->hasMoved(walker));
+
+	batch->nextPass();
+
+	EXPECT_TRUE(batch->hasMoved(idle));
+	EXPECT_TRUE(batch->hasMoved(walker));
+
+	batch->nextPass();
+
+	EXPECT_FALSE(batch->hasMoved(idle));
+	EXPECT_FALSE(batch->hasMoved(walker));
+
+	// not looked at in the previous pass, counts as moved again
+	batch->nextPass();
+	batch->nextPass();
+
+	EXPECT_TRUE(batch->hasMoved(idle));
+}
+
+TEST(AiAwarenessBatchTest, ChunkSplitting) {
+	Vector<uint32> keys;
+
+	for (int i = 0; i < 100; ++i)
+		keys.add(AiAwarenessBatch::getCellKey(i * 64.f, 0));
+
+	Vector<int> ends;
+	AiAwarenessBatch::splitChunks(keys, 4, ends);
+
+	ASSERT_EQ(ends.size(), 4);
+	EXPECT_EQ(ends.get(0), 25);
+	EXPECT_EQ(ends.get(1), 50);
+	EXPECT_EQ(ends.get(2), 75);
+	EXPECT_EQ(ends.get(3), 100);
+
+	// a cell crossing a split point stays in one chunk
+	keys.removeAll();
+
+	for (int i = 0; i < 100; ++i)
+		keys.add(i < 60 ? 1 : 2 + i);
+
+	ends.removeAll();
+	AiAwarenessBatch::splitChunks(keys, 4, ends);
+
+	ASSERT_EQ(ends.size(), 3);
+	EXPECT_EQ(ends.get(0), 60);
+	EXPECT_EQ(ends.get(1), 75);
+	EXPECT_EQ(ends.get(2), 100);
+
+	// a single cell is never split
+	keys.removeAll();
+
+	for (int i = 0; i < 100; ++i)
+		keys.add(7);
+
+	ends.removeAll();
+	AiAwarenessBatch::splitChunks(keys, 4, ends);
+
+	ASSERT_EQ(ends.size(), 1);
+	EXPECT_EQ(ends.get(0), 100);
+}
@@ -0,0 +1,68 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "gtest/gtest.h"
+
+#include "conf/ConfigManager.h"
+#include "server/zone/managers/creature/AiTickScheduler.h"
+
+TEST(AiTickSchedulerTest, Multipliers) {
+	AiTickScheduler* scheduler = AiTickScheduler::instance();
+
+	EXPECT_EQ(scheduler->getMultiplier(AiTickScheduler::FULL), 1);
+	EXPECT_GT(scheduler->getMultiplier(AiTickScheduler::SLOW), 1);
+	EXPECT_GE(scheduler->getMultiplier(AiTickScheduler::DORMANT), scheduler->getMultiplier(AiTickScheduler::SLOW));
+	EXPECT_EQ(scheduler->getMultiplier(AiTickScheduler::LODCOUNT), 1);
+}
+
+TEST(AiTickSchedulerTest, ZoneBudget) {
+	ConfigManager::instance()->setInt("Core3.AiTickBudget.budget_test", 10);
+
+	AiTickScheduler* scheduler = AiTickScheduler::instance();
+
+	// every tick is accounted in the same second, however long the test takes
+	uint64 now = System::getMiliTime();
+	int deferred = scheduler->getDeferredTicks();
+
+	// the first ten throttled ticks of the second fit in the budget
+	for (int i = 0; i < 10; ++i)
+		EXPECT_EQ(scheduler->scheduleTick("budget_test", AiTickScheduler::DORMANT, 8000, now), 8000);
+
+	// the overflow moves to the next seconds
+	EXPECT_EQ(scheduler->scheduleTick("budget_test", AiTickScheduler::DORMANT, 8000, now), 9000);
+	EXPECT_EQ(scheduler->scheduleTick("budget_test", AiTickScheduler::SLOW, 2000, now + 999), 3000);
+
+	for (int i = 0; i < 8; ++i)
+		scheduler->scheduleTick("budget_test", AiTickScheduler::SLOW, 2000, now);
+
+	EXPECT_EQ(scheduler->scheduleTick("budget_test", AiTickScheduler::SLOW, 2000, now), 4000);
+
+	EXPECT_EQ(scheduler->getDeferredTicks() - deferred, 11);
+
+	// agents players can see are never deferred, nor zones without a budget
+	EXPECT_EQ(scheduler->scheduleTick("budget_test", AiTickScheduler::FULL, 500, now), 500);
+	EXPECT_EQ(scheduler->scheduleTick("no_budget_test", AiTickScheduler::DORMANT, 8000, now), 8000);
+
+	// a new second starts with the whole budget again
+	EXPECT_EQ(scheduler->scheduleTick("budget_test", AiTickScheduler::DORMANT, 8000, now + 1000), 8000);
+}
+
+TEST(AiTickSchedulerTest, DeferralIsCapped) {
+	ConfigManager::instance()->setInt("Core3.AiTickBudget.deferral_test", 1);
+	ConfigManager::instance()->setInt("Core3.AiTickBudget.deferral_other_test", 1);
+
+	AiTickScheduler* scheduler = AiTickScheduler::instance();
+
+	uint64 now = System::getMiliTime();
+	uint64 maxDeferral = ConfigManager::instance()->getAiTickMaxDeferral();
+	uint64 delay = 0;
+
+	for (int i = 0; i < 100; ++i)
+		delay = scheduler->scheduleTick("deferral_test", AiTickScheduler::DORMANT, 8000, now);
+
+	EXPECT_EQ(delay, 8000 + maxDeferral);
+
+	// every zone is accounted on its own
+	EXPECT_EQ(scheduler->scheduleTick("deferral_other_test", AiTickScheduler::DORMANT, 8000, now), 8000);
+}
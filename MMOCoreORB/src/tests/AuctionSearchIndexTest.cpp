@@ -0,0 +1,240 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "gtest/gtest.h"
+
+#include "server/zone/managers/auction/TerminalListVector.h"
+
+namespace {
+	const int BENCHMARK_ITEMS = 100000;
+	const int BENCHMARK_SEARCHES = 100;
+}
+
+class AuctionSearchIndexTest : public ::testing::Test {
+protected:
+	uint64 nextObjectId;
+
+public:
+	AuctionSearchIndexTest() {
+		nextObjectId = 1;
+	}
+
+	Reference<AuctionItem*> createItem(const String& name, int itemType, int price, bool auction = false) {
+		Reference<AuctionItem*> item = new AuctionItem(nextObjectId++);
+
+		Locker locker(item);
+
+		item->setItemName(name);
+		item->setItemType(itemType);
+		item->setPrice(price);
+		item->setAuction(auction);
+
+		return item;
+	}
+
+	Vector<uint64> search(AuctionSearchIndex* index, uint32 category, int minPrice, int maxPrice, const String& filter) {
+		Vector<uint64> ids;
+
+		index->search(category, minPrice, maxPrice, filter, [&ids] (const AuctionSearchEntry& entry) -> bool {
+			ids.add(entry.getObjectID());
+			return true;
+		});
+
+		return ids;
+	}
+};
+
+TEST_F(AuctionSearchIndexTest, Tokenize) {
+	Vector<String> words;
+	AuctionSearchIndex::tokenize("E-11 Carbine (Mark II)", words);
+
+	ASSERT_EQ(words.size(), 5);
+	EXPECT_EQ(words.get(0), "e");
+	EXPECT_EQ(words.get(1), "11");
+	EXPECT_EQ(words.get(2), "carbine");
+	EXPECT_EQ(words.get(3), "mark");
+	EXPECT_EQ(words.get(4), "ii");
+}
+
+TEST_F(AuctionSearchIndexTest, CategoryAndPriceOrder) {
+	Reference<AuctionSearchIndex*> index = new AuctionSearchIndex();
+
+	Reference<AuctionItem*> rifle = createItem("Rifle", 0x20000 | 1, 500);
+	Reference<AuctionItem*> pistol = createItem("Pistol", 0x20000 | 2, 100);
+	Reference<AuctionItem*> carbine = createItem("Carbine", 0x20000 | 3, 300, true);
+	Reference<AuctionItem*> armor = createItem("Armor", 0x100 | 1, 200);
+
+	index->add(rifle, nullptr);
+	index->add(pistol, nullptr);
+	index->add(carbine, nullptr);
+	index->add(armor, nullptr);
+
+	EXPECT_EQ(index->size(), 4);
+
+	// every type, fixed prices cheapest first and auctions after them
+	Vector<uint64> ids = search(index, 0, 0, 0, "");
+
+	ASSERT_EQ(ids.size(), 4);
+	EXPECT_EQ(ids.get(0), pistol->getAuctionedItemObjectID());
+	EXPECT_EQ(ids.get(1), armor->getAuctionedItemObjectID());
+	EXPECT_EQ(ids.get(2), rifle->getAuctionedItemObjectID());
+	EXPECT_EQ(ids.get(3), carbine->getAuctionedItemObjectID());
+
+	// main category
+	ids = search(index, 0x20000, 0, 0, "");
+
+	ASSERT_EQ(ids.size(), 3);
+	EXPECT_EQ(ids.get(0), pistol->getAuctionedItemObjectID());
+
+	// sub category
+	ids = search(index, 0x20000 | 1, 0, 0, "");
+
+	ASSERT_EQ(ids.size(), 1);
+	EXPECT_EQ(ids.get(0), rifle->getAuctionedItemObjectID());
+
+	// price range keeps auctions for the caller to check
+	ids = search(index, 0, 150, 400, "");
+
+	ASSERT_EQ(ids.size(), 2);
+	EXPECT_EQ(ids.get(0), armor->getAuctionedItemObjectID());
+	EXPECT_EQ(ids.get(1), carbine->getAuctionedItemObjectID());
+
+	index->remove(armor);
+
+	EXPECT_EQ(index->size(), 3);
+	EXPECT_EQ(search(index, 0x100, 0, 0, "").size(), 0);
+}
+
+TEST_F(AuctionSearchIndexTest, FilterText) {
+	Reference<AuctionSearchIndex*> index = new AuctionSearchIndex();
+
+	Reference<AuctionItem*> carbine = createItem("E-11 Carbine", 1, 100);
+	Reference<AuctionItem*> dlt = createItem("DLT-20A Rifle", 1, 200);
+	Reference<AuctionItem*> rifle = createItem("Laser Rifle", 1, 50);
+
+	index->add(carbine, nullptr);
+	index->add(dlt, nullptr);
+	index->add(rifle, nullptr);
+
+	// matches inside words too, like the substring search it narrows down
+	Vector<uint64> ids = search(index, 0, 0, 0, "rif");
+
+	ASSERT_EQ(ids.size(), 2);
+	EXPECT_EQ(ids.get(0), rifle->getAuctionedItemObjectID());
+	EXPECT_EQ(ids.get(1), dlt->getAuctionedItemObjectID());
+
+	ids = search(index, 0, 0, 0, "e-11 carb");
+
+	ASSERT_EQ(ids.size(), 1);
+	EXPECT_EQ(ids.get(0), carbine->getAuctionedItemObjectID());
+
+	// the end of a word is found through its suffixes
+	ids = search(index, 0, 0, 0, "arbine");
+
+	ASSERT_EQ(ids.size(), 1);
+	EXPECT_EQ(ids.get(0), carbine->getAuctionedItemObjectID());
+
+	EXPECT_EQ(search(index, 0, 0, 0, "aser").size(), 1);
+
+	index->remove(rifle);
+
+	EXPECT_EQ(search(index, 0, 0, 0, "laser").size(), 0);
+	EXPECT_EQ(search(index, 0, 0, 0, "aser").size(), 0);
+	EXPECT_EQ(search(index, 0, 0, 0, "ifle").size(), 1);
+}
+
+TEST_F(AuctionSearchIndexTest, TerminalMoves) {
+	Reference<AuctionSearchIndex*> region = new AuctionSearchIndex();
+	Reference<AuctionSearchIndex*> otherRegion = new AuctionSearchIndex();
+
+	Reference<TerminalItemList*> terminal = new TerminalItemList();
+	terminal->setNoDuplicateInsertPlan();
+
+	Vector<Reference<AuctionSearchIndex*> > indexes;
+	indexes.add(region);
+
+	terminal->setSearchIndexes(indexes);
+
+	Reference<AuctionItem*> item = createItem("Rifle", 1, 100);
+	terminal->put(item.get());
+
+	EXPECT_EQ(region->size(), 1);
+
+	indexes.removeAll();
+	indexes.add(otherRegion);
+
+	terminal->setSearchIndexes(indexes);
+
+	EXPECT_EQ(region->size(), 0);
+	EXPECT_EQ(otherRegion->size(), 1);
+
+	terminal->drop(item.get());
+
+	EXPECT_EQ(otherRegion->size(), 0);
+}
+
+TEST_F(AuctionSearchIndexTest, IndexVsScanBenchmark) {
+	Reference<AuctionSearchIndex*> index = new AuctionSearchIndex();
+	Vector<Reference<AuctionItem*> > items;
+
+	const char* names[] = { "Rifle", "Pistol", "Carbine", "Armor Chest", "Food", "Resource Crate", "Furniture", "Vibroblade" };
+
+	for (int i = 0; i < BENCHMARK_ITEMS; ++i) {
+		int itemType = (0x100 << (i % 8)) | (i % 16 + 1);
+		Reference<AuctionItem*> item = createItem(String(names[i % 8]) + " " + String::valueOf(i), itemType, System::random(100000) + 1);
+
+		items.add(item);
+		index->add(item, nullptr);
+	}
+
+	uint32 category = 0x800 | 4;
+	int minPrice = 1000, maxPrice = 20000;
+
+	Timer timer;
+	timer.start();
+
+	int scanned = 0;
+
+	for (int n = 0; n < BENCHMARK_SEARCHES; ++n) {
+		int displaying = 0;
+
+		for (int i = 0; i < items.size() && displaying < 100; ++i) {
+			AuctionItem* item = items.getUnsafe(i);
+
+			if (item->getItemType() == (int) category && item->getPrice() >= minPrice && item->getPrice() <= maxPrice)
+				displaying++;
+		}
+
+		scanned += displaying;
+	}
+
+	uint64 scanMs = timer.stopMs();
+
+	timer.start();
+
+	int found = 0;
+
+	for (int n = 0; n < BENCHMARK_SEARCHES; ++n) {
+		int displaying = 0;
+
+		index->search(category, minPrice, maxPrice, "", [&] (const AuctionSearchEntry& entry) -> bool {
+			AuctionItem* item = entry.getItem();
+
+			if (item->getItemType() == (int) category && item->getPrice() >= minPrice && item->getPrice() <= maxPrice)
+				displaying++;
+
+			return displaying < 100;
+		});
+
+		found += displaying;
+	}
+
+	uint64 indexMs = timer.stopMs();
+
+	EXPECT_EQ(scanned, found);
+
+	std::cerr << "[>>>>>>>>>>] " << BENCHMARK_ITEMS << " items, " << BENCHMARK_SEARCHES << " searches" << std::endl;
+	std::cerr << "[>>>>>>>>>>] Scan: " << scanMs << "ms" << std::endl;
+	std::cerr << "[>>>>>>>>>>] Index: " << indexMs << "ms" << std::endl;
+}
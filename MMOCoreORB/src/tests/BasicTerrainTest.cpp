@@ -11,6 +11,7 @@
 #include "templates/manager/DataArchiveStore.h"
 #include "terrain/ProceduralTerrainAppearance.h"
 #include "terrain/SpaceTerrainAppearance.h"
+#include "terrain/manager/TerrainManager.h"
 #include "conf/ConfigManager.h"
 
 class BasicTerrainTest : public ::testing::Test {
@@ -67,3 +68,91 @@ TEST_F(BasicTerrainTest, LoadTestSpaceTerrain) {
 
 	terrain.readObject(stream);
 }
+
+TEST_F(BasicTerrainTest, TiledHeightCacheTest) {
+	Reference<TerrainManager*> terrainManager = new TerrainManager();
+
+	ASSERT_TRUE(terrainManager->initialize("terrain/test_terrain.trn"));
+
+	ProceduralTerrainAppearance* terrain = terrainManager->getProceduralTerrainAppearance();
+
+	ASSERT_TRUE(terrain != nullptr);
+
+	float spacing = Math::min(terrain->getDistanceBetweenPoles(), 1.f);
+
+	// poles are sampled straight from the layers
+	for (int i = 0; i < 16; ++i) {
+		float x = -238 + i * spacing;
+		float y = -166;
+
+		EXPECT_FLOAT_EQ(terrainManager->getHeight(x, y), terrain->getHeight(x, y));
+	}
+
+	EXPECT_NEAR(terrainManager->getHeight(-45.1f, 49.0f), 83.3, 0.2);
+
+	const int count = 4099;
+
+	float xs[count], ys[count], heights[count];
+
+	for (int i = 0; i < count; ++i) {
+		xs[i] = System::random(400) - 200.f + System::random(99) / 100.f;
+		ys[i] = System::random(400) - 200.f + System::random(99) / 100.f;
+	}
+
+	terrainManager->getHeights(xs, ys, heights, count);
+
+	for (int i = 0; i < count; ++i) {
+		float cached = terrainManager->getHeight(xs[i], ys[i]);
+
+		EXPECT_FLOAT_EQ(heights[i], cached);
+		EXPECT_NEAR(cached, terrain->getHeight(xs[i], ys[i]), 0.1);
+	}
+
+	// the batched area scans match sampling every point
+	float highest = -16000.f, lowest = 16000.f;
+
+	for (int y = -20; y < 20; y += 2) {
+		for (int x = -20; x < 20; x += 2) {
+			highest = Math::max(highest, terrainManager->getHeight(x, y));
+			lowest = Math::min(lowest, terrainManager->getHeight(x, y));
+		}
+	}
+
+	EXPECT_FLOAT_EQ(terrainManager->getHighestHeight(-20, -20, 20, 20, 2), highest);
+	EXPECT_FLOAT_EQ(terrainManager->getLowestHeight(-20, -20, 20, 20, 2), lowest);
+
+	Timer timer;
+	timer.start();
+
+	volatile float sum = 0;
+
+	for (int i = 0; i < count; ++i)
+		sum += terrain->getHeight(xs[i], ys[i]);
+
+	timer.stop();
+
+	uint64 proceduralNs = timer.getElapsedTime();
+
+	timer.clear();
+	timer.start();
+
+	for (int i = 0; i < count; ++i)
+		sum += terrainManager->getHeight(xs[i], ys[i]);
+
+	timer.stop();
+
+	uint64 cachedNs = timer.getElapsedTime();
+
+	timer.clear();
+	timer.start();
+
+	terrainManager->getHeights(xs, ys, heights, count);
+
+	timer.stop();
+
+	uint64 batchNs = timer.getElapsedTime();
+
+	std::cerr << "[>>>>>>>>>>] " << count << " heights, procedural: " << proceduralNs / 1000 << "us, tiled: "
+		<< cachedNs / 1000 << "us, tiled batch: " << batchNs / 1000 << "us" << std::endl;
+	std::cerr << "[>>>>>>>>>>] " << terrainManager->getCachedValuesCount() << " tiles, " << terrainManager->getCacheMissCount() << " generated" << std::endl;
+}
@@ -0,0 +1,186 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "gtest/gtest.h"
+
+#include "conf/ConfigManager.h"
+#include "server/zone/objects/creature/CreatureObject.h"
+#include "server/chat/room/ChatRoomDelivery.h"
+
+#include <thread>
+#include <vector>
+
+namespace {
+	const int TEST_WORKERS = 3;
+}
+
+// shards are queued per worker and only run when the test starts the workers
+class TestChatRoomDelivery : public ChatRoomDelivery {
+public:
+	std::vector<Function<void()> > shardQueues[TEST_WORKERS];
+
+	Mutex receivedMutex;
+	HashTable<uint64, Reference<Vector<BaseMessage*>*> > received;
+
+	TestChatRoomDelivery(int shardSize) {
+		this->shardSize = shardSize;
+		threads = TEST_WORKERS;
+
+		received.setNullValue(nullptr);
+	}
+
+	void executeShard(int shard, Function<void()>&& function) {
+		shardQueues[shard].push_back(std::move(function));
+	}
+
+	void sendToMember(CreatureObject* player, BaseMessage* message) {
+		Locker locker(&receivedMutex);
+
+		Reference<Vector<BaseMessage*>*> messages = received.get(player->getObjectID());
+
+		if (messages == nullptr) {
+			messages = new Vector<BaseMessage*>();
+			received.put(player->getObjectID(), messages);
+		}
+
+		messages->add(message);
+	}
+
+	void runWorkers() {
+		std::thread workers[TEST_WORKERS];
+
+		for (int i = 0; i < TEST_WORKERS; ++i) {
+			std::vector<Function<void()> >* queue = &shardQueues[i];
+
+			workers[i] = std::thread([queue] () {
+				for (auto& function : *queue)
+					function();
+
+				queue->clear();
+			});
+		}
+
+		for (int i = 0; i < TEST_WORKERS; ++i)
+			workers[i].join();
+	}
+};
+
+TEST(ChatRoomDeliveryTest, QueueNames) {
+	EXPECT_EQ(ChatRoomDelivery::getQueueName(0), "ChatDeliveryQueue0");
+	EXPECT_EQ(ChatRoomDelivery::getQueueName(3), "ChatDeliveryQueue3");
+}
+
+TEST(ChatRoomDeliveryTest, RoomStatistics) {
+	// no workers, every room is delivered inline
+	ConfigManager::instance()->setInt("Core3.ChatDeliveryThreads", 0);
+
+	ChatRoomDelivery* delivery = ChatRoomDelivery::instance();
+
+	// drop whatever an earlier test recorded
+	delivery->getStatistics();
+
+	Reference<ChatRoomMembers*> members = new ChatRoomMembers(4);
+
+	for (int i = 0; i < 4; ++i)
+		members->add(nullptr);
+
+	delivery->deliver(1, "SWG.Galaxy.tatooine.Planet", members, new BaseMessage());
+	delivery->deliver(1, "SWG.Galaxy.tatooine.Planet", members, new BaseMessage(), true, "someone");
+	delivery->deliver(2, "SWG.Galaxy.Auction", members, new BaseMessage());
+
+	String statistics = delivery->getStatistics();
+
+	EXPECT_TRUE(statistics.contains("2 active"));
+
+	// the busiest room comes first
+	int planet = statistics.indexOf("SWG.Galaxy.tatooine.Planet");
+	int auction = statistics.indexOf("SWG.Galaxy.Auction");
+
+	EXPECT_GE(planet, 0);
+	EXPECT_GT(auction, planet);
+
+	// rates cover the time since the previous read only
+	EXPECT_TRUE(delivery->getStatistics().contains("0 active"));
+}
+
+TEST(ChatRoomDeliveryTest, ShardedMemberOrdering) {
+	TestChatRoomDelivery delivery(8);
+
+	Vector<Reference<CreatureObject*> > players;
+
+	for (int i = 0; i < 40; ++i) {
+		Reference<CreatureObject*> player = new CreatureObject();
+		player->_setObjectID(1000 + i);
+
+		players.add(player);
+	}
+
+	Vector<BaseMessage*> sent;
+
+	// the room grows and shrinks across the shard size while earlier deliveries are still queued,
+	// smaller deliveries must queue behind them instead of running inline
+	for (int m = 0; m < 30; ++m) {
+		int memberCount = 2 + (m * 7) % 38;
+
+		Reference<ChatRoomMembers*> members = new ChatRoomMembers(memberCount);
+
+		for (int i = 0; i < memberCount; ++i)
+			members->add(players.get((i + m) % players.size()).get());
+
+		BaseMessage* message = new BaseMessage();
+		sent.add(message);
+
+		delivery.deliver(1, "SWG.Galaxy.tatooine.Planet", members, message);
+	}
+
+	// the first room fits a shard and went inline, every later one is sharded over all the workers
+	for (int i = 0; i < TEST_WORKERS; ++i)
+		EXPECT_EQ(delivery.shardQueues[i].size(), 29);
+
+	delivery.runWorkers();
+
+	int deliveries = 0;
+
+	for (int i = 0; i < players.size(); ++i) {
+		Reference<Vector<BaseMessage*>*> messages = delivery.received.get(players.get(i)->getObjectID());
+
+		if (messages == nullptr)
+			continue;
+
+		// in the order the room sent them
+		int last = -1;
+
+		for (int j = 0; j < messages->size(); ++j) {
+			int index = -1;
+
+			for (int k = 0; k < sent.size() && index == -1; ++k) {
+				if (sent.get(k) == messages->get(j))
+					index = k;
+			}
+
+			EXPECT_GT(index, last);
+
+			last = index;
+		}
+
+		deliveries += messages->size();
+	}
+
+	int expected = 0;
+
+	for (int m = 0; m < 30; ++m)
+		expected += 2 + (m * 7) % 38;
+
+	EXPECT_EQ(deliveries, expected);
+
+	// done rooms fall back to inline delivery
+	Reference<ChatRoomMembers*> members = new ChatRoomMembers(2);
+	members->add(players.get(0).get());
+	members->add(players.get(1).get());
+
+	delivery.deliver(1, "SWG.Galaxy.tatooine.Planet", members, new BaseMessage());
+
+	for (int i = 0; i < TEST_WORKERS; ++i)
+		EXPECT_EQ(delivery.shardQueues[i].size(), 0);
+}
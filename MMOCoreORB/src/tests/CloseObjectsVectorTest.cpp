@@ -0,0 +1,118 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "gtest/gtest.h"
+
+#include "server/zone/CloseObjectsVector.h"
+#include "server/zone/objects/scene/SceneObject.h"
+
+// registers receivers with explicit types instead of relying on the entries receiver flags
+class TestCloseObjectsVector : public CloseObjectsVector {
+public:
+	void putWithReceiverTypes(QuadTreeEntry* entry, uint32 receiverTypes) {
+		put(entry);
+		putReceiver(entry, receiverTypes);
+	}
+
+	void dropWithReceiverTypes(QuadTreeEntry* entry, uint32 receiverTypes) {
+		dropReceiver(entry, receiverTypes);
+		drop(entry);
+	}
+};
+
+class CloseObjectsVectorTest : public ::testing::Test {
+protected:
+	AtomicLong nextObjectId;
+
+public:
+	CloseObjectsVectorTest() {
+		nextObjectId = 1;
+	}
+
+	Reference<SceneObject*> createSceneObject() {
+		Reference<SceneObject*> object = new SceneObject();
+		object->_setObjectID(nextObjectId.increment());
+
+		return object;
+	}
+};
+
+TEST_F(CloseObjectsVectorTest, SnapshotShared) {
+	TestCloseObjectsVector vector;
+
+	Reference<SceneObject*> first = createSceneObject();
+
+	vector.putWithReceiverTypes(first, CloseObjectsVector::CREOTYPE);
+
+	Reference<CloseObjectsReceivers*> snapshot = vector.getReceivers(CloseObjectsVector::CREOTYPE);
+
+	ASSERT_TRUE(snapshot != nullptr);
+	EXPECT_EQ(snapshot->size(), 1);
+
+	// nothing changed, the same snapshot is handed out again
+	EXPECT_EQ(vector.getReceivers(CloseObjectsVector::CREOTYPE).get(), snapshot.get());
+
+	EXPECT_EQ(vector.getReceivers(CloseObjectsVector::PLAYERTYPE)->size(), 0);
+}
+
+TEST_F(CloseObjectsVectorTest, SnapshotInvalidation) {
+	TestCloseObjectsVector vector;
+
+	Reference<SceneObject*> first = createSceneObject();
+	Reference<SceneObject*> second = createSceneObject();
+
+	vector.putWithReceiverTypes(first, CloseObjectsVector::CREOTYPE);
+
+	Reference<CloseObjectsReceivers*> snapshot = vector.getReceivers(CloseObjectsVector::CREOTYPE);
+
+	ASSERT_EQ(snapshot->size(), 1);
+
+	vector.putWithReceiverTypes(second, CloseObjectsVector::CREOTYPE);
+
+	Reference<CloseObjectsReceivers*> added = vector.getReceivers(CloseObjectsVector::CREOTYPE);
+
+	EXPECT_NE(added.get(), snapshot.get());
+	EXPECT_EQ(added->size(), 2);
+
+	// the old snapshot is immutable, broadcasts still iterating it are unaffected
+	EXPECT_EQ(snapshot->size(), 1);
+
+	vector.removeAll();
+
+	Reference<CloseObjectsReceivers*> cleared = vector.getReceivers(CloseObjectsVector::CREOTYPE);
+
+	EXPECT_NE(cleared.get(), added.get());
+	EXPECT_EQ(cleared->size(), 0);
+	EXPECT_EQ(vector.size(), 0);
+}
+
+TEST_F(CloseObjectsVectorTest, DroppedReceiverReleased) {
+	TestCloseObjectsVector vector;
+
+	Reference<SceneObject*> first = createSceneObject();
+
+	int references = first->getReferenceCount();
+
+	vector.putWithReceiverTypes(first, CloseObjectsVector::CREOTYPE);
+
+	EXPECT_EQ(vector.getReceivers(CloseObjectsVector::CREOTYPE)->size(), 1);
+
+	// held by the close objects and by the cached snapshot
+	EXPECT_EQ(first->getReferenceCount(), references + 2);
+
+	vector.dropWithReceiverTypes(first, CloseObjectsVector::CREOTYPE);
+
+	EXPECT_EQ(first->getReferenceCount(), references);
+	EXPECT_EQ(vector.getReceivers(CloseObjectsVector::CREOTYPE)->size(), 0);
+}
+
+TEST_F(CloseObjectsVectorTest, VersionWrapAround) {
+	EXPECT_TRUE(CloseObjectsReceivers::isNewerVersion(1, 0));
+	EXPECT_FALSE(CloseObjectsReceivers::isNewerVersion(0, 1));
+	EXPECT_FALSE(CloseObjectsReceivers::isNewerVersion(5, 5));
+
+	EXPECT_TRUE(CloseObjectsReceivers::isNewerVersion(0, 0xFFFFFFFF));
+	EXPECT_TRUE(CloseObjectsReceivers::isNewerVersion(3, 0xFFFFFFFE));
+	EXPECT_FALSE(CloseObjectsReceivers::isNewerVersion(0xFFFFFFFF, 0));
+}
@@ -0,0 +1,267 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "gtest/gtest.h"
+
+#include "server/zone/managers/collision/CollisionBroadphase.h"
+#include "server/zone/managers/collision/CollisionTransform.h"
+#include "server/zone/objects/scene/SceneObject.h"
+
+namespace {
+	const int TEST_BUILDINGS = 2000;
+	const int TEST_RAYS = 20000;
+	const float TEST_AREA = 1024.f;
+	const float TEST_RAY_LENGTH = 96.f;
+}
+
+class CollisionBroadphaseTest : public ::testing::Test {
+protected:
+	struct Bounds {
+		float minX, minY, maxX, maxY;
+	};
+
+	Vector<Reference<SceneObject*> > buildings;
+	Vector<Bounds> bounds;
+
+	Reference<CollisionBroadphase*> broadphase;
+
+public:
+	void SetUp() {
+		broadphase = new CollisionBroadphase();
+
+		// a dense city, every building between 4m and 20m from its center to its farthest corner
+		for (int i = 0; i < TEST_BUILDINGS; ++i) {
+			Reference<SceneObject*> object = new SceneObject();
+			object->_setObjectID(i + 1);
+			object->initializePosition(System::random((int) TEST_AREA * 2) - TEST_AREA, 0, System::random((int) TEST_AREA * 2) - TEST_AREA);
+
+			float radius = 4.f + System::random(16);
+
+			Bounds box = { object->getPositionX() - radius, object->getPositionY() - radius,
+					object->getPositionX() + radius, object->getPositionY() + radius };
+
+			broadphase->add(object, box.minX, box.minY, box.maxX, box.maxY);
+
+			buildings.add(object);
+			bounds.add(box);
+		}
+	}
+
+	void TearDown() {
+		broadphase = nullptr;
+
+		buildings.removeAll();
+		bounds.removeAll();
+	}
+
+	static bool segmentCrosses(const Bounds& box, float x0, float y0, float x1, float y1) {
+		float tMin = 0.f, tMax = 1.f;
+
+		const float origin[2] = { x0, y0 };
+		const float dir[2] = { x1 - x0, y1 - y0 };
+		const float boxMin[2] = { box.minX, box.minY };
+		const float boxMax[2] = { box.maxX, box.maxY };
+
+		for (int axis = 0; axis < 2; ++axis) {
+			if (dir[axis] == 0.f) {
+				if (origin[axis] < boxMin[axis] || origin[axis] > boxMax[axis])
+					return false;
+
+				continue;
+			}
+
+			float t0 = (boxMin[axis] - origin[axis]) / dir[axis];
+			float t1 = (boxMax[axis] - origin[axis]) / dir[axis];
+
+			tMin = Math::max(tMin, Math::min(t0, t1));
+			tMax = Math::min(tMax, Math::max(t0, t1));
+		}
+
+		return tMin <= tMax;
+	}
+
+	int scan(float x0, float y0, float x1, float y1, Vector<ManagedReference<SceneObject*> >& objects) {
+		int found = 0;
+
+		for (int i = 0; i < bounds.size(); ++i) {
+			if (segmentCrosses(bounds.getUnsafe(i), x0, y0, x1, y1)) {
+				objects.add(buildings.getUnsafe(i).get());
+				++found;
+			}
+		}
+
+		return found;
+	}
+
+	void randomRay(float& x0, float& y0, float& x1, float& y1) {
+		x0 = System::random((int) TEST_AREA * 2) - TEST_AREA;
+		y0 = System::random((int) TEST_AREA * 2) - TEST_AREA;
+
+		float angle = System::random(360) * Math::DEG2RAD;
+
+		x1 = x0 + cos(angle) * TEST_RAY_LENGTH;
+		y1 = y0 + sin(angle) * TEST_RAY_LENGTH;
+	}
+};
+
+TEST_F(CollisionBroadphaseTest, RaycastMatchesScan) {
+	ASSERT_EQ(broadphase->size(), TEST_BUILDINGS);
+
+	// a balanced tree over 2000 leaves
+	EXPECT_LT(broadphase->getHeight(), 24);
+
+	for (int i = 0; i < 500; ++i) {
+		float x0, y0, x1, y1;
+		randomRay(x0, y0, x1, y1);
+
+		Vector<ManagedReference<SceneObject*> > treeObjects, scanObjects;
+
+		broadphase->raycast(x0, y0, x1, y1, treeObjects);
+		scan(x0, y0, x1, y1, scanObjects);
+
+		ASSERT_EQ(treeObjects.size(), scanObjects.size());
+
+		for (int j = 0; j < scanObjects.size(); ++j)
+			ASSERT_TRUE(treeObjects.contains(scanObjects.getUnsafe(j)));
+	}
+
+	// axis aligned rays take the slab test shortcut
+	Vector<ManagedReference<SceneObject*> > treeObjects, scanObjects;
+
+	broadphase->raycast(-TEST_AREA, 0, TEST_AREA, 0, treeObjects);
+	scan(-TEST_AREA, 0, TEST_AREA, 0, scanObjects);
+
+	EXPECT_EQ(treeObjects.size(), scanObjects.size());
+}
+
+TEST_F(CollisionBroadphaseTest, AddMoveRemove) {
+	SceneObject* building = buildings.getUnsafe(0);
+
+	ASSERT_TRUE(broadphase->contains(building));
+
+	// moved far out of the city
+	broadphase->add(building, 5000, 5000, 5010, 5010);
+
+	EXPECT_EQ(broadphase->size(), TEST_BUILDINGS);
+
+	Vector<ManagedReference<SceneObject*> > objects;
+	broadphase->raycast(4990, 5005, 5020, 5005, objects);
+
+	ASSERT_EQ(objects.size(), 1);
+	EXPECT_EQ(objects.getUnsafe(0).get(), building);
+
+	for (int i = 0; i < buildings.size(); i += 2)
+		broadphase->remove(buildings.getUnsafe(i));
+
+	EXPECT_EQ(broadphase->size(), TEST_BUILDINGS / 2);
+	EXPECT_FALSE(broadphase->contains(building));
+
+	objects.removeAll();
+	broadphase->raycast(4990, 5005, 5020, 5005, objects);
+
+	EXPECT_EQ(objects.size(), 0);
+
+	for (int i = 1; i < buildings.size(); i += 2)
+		broadphase->remove(buildings.getUnsafe(i));
+
+	EXPECT_EQ(broadphase->size(), 0);
+	EXPECT_EQ(broadphase->getHeight(), 0);
+}
+
+TEST_F(CollisionBroadphaseTest, CollisionTransformCache) {
+	CollisionTransform transform;
+
+	Quaternion direction;
+	direction.setHeadingDirection(1.3f);
+
+	Matrix4 matrix;
+	transform.get(100, 200, 10, direction, matrix);
+	transform.get(100, 200, 10, direction, matrix);
+
+	EXPECT_EQ(transform.getRebuildCount(), 1);
+
+	Matrix4 expected = CollisionTransform::buildWorldToModel(100, 200, 10, direction.getRadians());
+
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j)
+			EXPECT_FLOAT_EQ(matrix[i][j], expected[i][j]);
+	}
+
+	// moving the object invalidates it
+	transform.get(101, 200, 10, direction, matrix);
+
+	EXPECT_EQ(transform.getRebuildCount(), 2);
+}
+
+TEST_F(CollisionBroadphaseTest, LineOfSightBenchmark) {
+	Vector<float> rays(TEST_RAYS * 4, 1);
+
+	for (int i = 0; i < TEST_RAYS; ++i) {
+		float x0, y0, x1, y1;
+		randomRay(x0, y0, x1, y1);
+
+		rays.add(x0);
+		rays.add(y0);
+		rays.add(x1);
+		rays.add(y1);
+	}
+
+	Vector<ManagedReference<SceneObject*> > objects;
+
+	Timer timer;
+	timer.start();
+
+	int scanFound = 0;
+
+	for (int i = 0; i < TEST_RAYS; ++i) {
+		objects.removeAll();
+		scanFound += scan(rays.getUnsafe(i * 4), rays.getUnsafe(i * 4 + 1), rays.getUnsafe(i * 4 + 2), rays.getUnsafe(i * 4 + 3), objects);
+	}
+
+	uint64 scanMs = timer.stopMs();
+
+	timer.start();
+
+	int treeFound = 0;
+
+	for (int i = 0; i < TEST_RAYS; ++i) {
+		objects.removeAll();
+		treeFound += broadphase->raycast(rays.getUnsafe(i * 4), rays.getUnsafe(i * 4 + 1), rays.getUnsafe(i * 4 + 2), rays.getUnsafe(i * 4 + 3), objects);
+	}
+
+	uint64 treeMs = timer.stopMs();
+
+	EXPECT_EQ(scanFound, treeFound);
+
+	// transform of a standing building, rebuilt every time versus read back from the cache
+	CollisionTransform transform;
+	Quaternion direction;
+	direction.setHeadingDirection(0.7f);
+
+	Matrix4 matrix;
+	float sum = 0;
+
+	timer.start();
+
+	for (int i = 0; i < TEST_RAYS; ++i) {
+		matrix = CollisionTransform::buildWorldToModel(100, 200, 10, direction.getRadians());
+		sum += matrix[3][0];
+	}
+
+	uint64 buildMs = timer.stopMs();
+
+	timer.start();
+
+	for (int i = 0; i < TEST_RAYS; ++i) {
+		transform.get(100, 200, 10, direction, matrix);
+		sum += matrix[3][0];
+	}
+
+	uint64 cachedMs = timer.stopMs();
+
+	std::cerr << "[>>>>>>>>>>] " << TEST_BUILDINGS << " buildings, " << TEST_RAYS << " rays of " << TEST_RAY_LENGTH << "m" << std::endl;
+	std::cerr << "[>>>>>>>>>>] scan: " << scanMs << "ms (" << (float) scanFound / TEST_RAYS << " candidates per ray)" << std::endl;
+	std::cerr << "[>>>>>>>>>>] tree: " << treeMs << "ms, height " << broadphase->getHeight() << std::endl;
+	std::cerr << "[>>>>>>>>>>] transform built: " << buildMs << "ms, cached: " << cachedMs << "ms (" << sum << ")" << std::endl;
+}
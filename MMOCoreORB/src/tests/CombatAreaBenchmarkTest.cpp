@@ -0,0 +1,271 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "gtest/gtest.h"
+
+#include "server/zone/managers/combat/CombatManager.h"
+#include "server/zone/managers/combat/CreatureAttackData.h"
+#include "server/zone/managers/combat/AttackerCombatValues.h"
+#include "server/zone/managers/skill/SkillModManager.h"
+#include "server/zone/objects/creature/commands/CombatQueueCommand.h"
+#include "templates/tangible/SharedWeaponObjectTemplate.h"
+#include "templates/params/creature/CreaturePosture.h"
+
+// the math doTargetCombatAction runs for every defender of an area attack
+class CombatTestManager : public CombatManager {
+public:
+	using CombatManager::getHitChance;
+	using CombatManager::calculateDamage;
+};
+
+class AreaTestCommand : public CombatQueueCommand {
+public:
+	AreaTestCommand() : CombatQueueCommand("areatestcommand", nullptr) {
+		setAreaAction(true);
+		setAreaRange(30);
+		setAccuracyBonus(15);
+		setAccuracySkillMod("areatest_accuracy");
+	}
+
+	int doQueueCommand(CreatureObject* creature, const uint64& target, const UnicodeString& arguments) const {
+		return SUCCESS;
+	}
+};
+
+class CombatAreaBenchmarkTest : public ::testing::Test {
+protected:
+	Reference<CombatTestManager*> manager;
+	Reference<AreaTestCommand*> command;
+	Reference<SharedWeaponObjectTemplate*> weaponTemplate;
+
+	Reference<CreatureObject*> attacker;
+	Reference<WeaponObject*> weapon;
+	Vector<Reference<CreatureObject*> > defenders;
+
+	AtomicLong nextObjectId;
+
+public:
+	CombatAreaBenchmarkTest() {
+		nextObjectId = 1;
+
+		CreaturePosture::instance()->loadMovementData();
+	}
+
+	void SetUp() {
+		manager = new CombatTestManager();
+		command = new AreaTestCommand();
+
+		Vector<String> mods;
+		mods.add("onehandmelee_accuracy");
+		weaponTemplate = new SharedWeaponObjectTemplate();
+		weaponTemplate->setCreatureAccuracyModifiers(mods);
+
+		mods.removeAll();
+		mods.add("onehandmelee_damage");
+		weaponTemplate->setDamageModifiers(mods);
+
+		mods.removeAll();
+		mods.add("melee_defense");
+		weaponTemplate->setDefenderDefenseModifiers(mods);
+
+		mods.removeAll();
+		mods.add("dodge");
+		weaponTemplate->setDefenderSecondaryDefenseModifiers(mods);
+
+		mods.removeAll();
+		mods.add("melee_toughness");
+		weaponTemplate->setDefenderToughnessModifiers(mods);
+
+		// a fixed damage so both ways of resolving it can be compared
+		weaponTemplate->setMinDamage(100);
+		weaponTemplate->setMaxDamage(100);
+		weaponTemplate->setIdealRange(5);
+		weaponTemplate->setMaxRange(10);
+
+		weapon = createWeapon();
+
+		attacker = createCreatureObject(0, 0);
+		addSkillMod(attacker, "areatest_accuracy", 20);
+		addSkillMod(attacker, "onehandmelee_accuracy", 50);
+		addSkillMod(attacker, "attack_accuracy", 10);
+		addSkillMod(attacker, "melee_accuracy", 5);
+		addSkillMod(attacker, "private_accuracy_bonus", 7);
+		addSkillMod(attacker, "private_melee_accuracy_bonus", 3);
+		addSkillMod(attacker, "creature_hit_bonus", 4);
+		addSkillMod(attacker, "onehandmelee_damage", 30);
+		addSkillMod(attacker, "private_melee_damage_bonus", 5);
+		addSkillMod(attacker, "private_damage_bonus", 5);
+	}
+
+	void TearDown() {
+		defenders.removeAll();
+	}
+
+	Reference<CreatureObject*> createCreatureObject(float x, float y) {
+		Reference<CreatureObject*> creature = new CreatureObject();
+
+		creature->setContainerComponent("ContainerComponent");
+		creature->setZoneComponent("ZoneComponent");
+		creature->_setObjectID(nextObjectId.increment());
+		creature->initializeContainerObjectsMap();
+		creature->initializePosition(x, 0, y);
+
+		return creature;
+	}
+
+	Reference<WeaponObject*> createWeapon() {
+		Reference<WeaponObject*> object = new WeaponObject();
+
+		object->_setObjectID(nextObjectId.increment());
+		object->loadTemplateData(weaponTemplate);
+
+		return object;
+	}
+
+	void addSkillMod(CreatureObject* creature, const String& mod, int value) {
+		creature->addSkillMod(SkillModManager::PERMANENTMOD, mod, value, false);
+	}
+
+	// a ring of defenders with different defenses, like a mob pack around the attacker
+	void createDefenders(int count) {
+		defenders.removeAll();
+
+		Reference<WeaponObject*> defenderWeapon = createWeapon();
+
+		for (int i = 0; i < count; ++i) {
+			float angle = Math::PI * 2 * i / count;
+			Reference<CreatureObject*> defender = createCreatureObject(Math::cos(angle) * (2 + i % 8), Math::sin(angle) * (2 + i % 8));
+
+			defender->setWeapon(defenderWeapon, false);
+
+			addSkillMod(defender, "melee_defense", i % 60);
+			addSkillMod(defender, "dodge", i % 40);
+			addSkillMod(defender, "melee_toughness", i % 20);
+			addSkillMod(defender, "private_damage_susceptibility", i % 3);
+
+			defenders.add(defender);
+		}
+	}
+
+	// the attacker skill mods read again for every defender, as before the values were shared
+	int runPerDefender(const CreatureAttackData& data) {
+		int damage = 0;
+
+		for (int i = 0; i < defenders.size(); ++i) {
+			CreatureObject* defender = defenders.get(i);
+
+			int hitDamage = manager->calculateDamage(attacker, weapon, defender, data);
+			int accuracyBonus = data.getAccuracyBonus() + attacker->getSkillMod(data.getCommand()->getAccuracySkillMod());
+
+			if (manager->getHitChance(attacker, defender, weapon, data, hitDamage, accuracyBonus) != CombatManager::MISS)
+				damage += hitDamage;
+		}
+
+		return damage;
+	}
+
+	// resolved once per attack, the defenders only read their own side
+	int runShared(const CreatureAttackData& data) {
+		AttackerCombatValues values;
+		manager->getAttackerCombatValues(attacker, weapon, data, values);
+
+		CreatureAttackData attackData(data);
+		attackData.setAttackerValues(&values);
+
+		int damage = 0;
+
+		for (int i = 0; i < defenders.size(); ++i) {
+			CreatureObject* defender = defenders.get(i);
+
+			int hitDamage = manager->calculateDamage(attacker, weapon, defender, attackData);
+
+			if (manager->getHitChance(attacker, defender, weapon, attackData, hitDamage, values.accuracyBonus) != CombatManager::MISS)
+				damage += hitDamage;
+		}
+
+		return damage;
+	}
+};
+
+TEST_F(CombatAreaBenchmarkTest, AttackerValues) {
+	CreatureAttackData data("", command, 0);
+
+	AttackerCombatValues values;
+	manager->getAttackerCombatValues(attacker, weapon, data, values);
+
+	EXPECT_EQ(values.commandAccuracy, 20);
+	EXPECT_EQ(values.accuracyBonus, 35);
+	EXPECT_EQ(values.attackerAccuracy, 65);
+	EXPECT_EQ(values.bonusAccuracy, 10);
+	EXPECT_EQ(values.creatureHitBonus, 4);
+
+	// melee, no private_aim
+	EXPECT_EQ(values.aimAccuracy, 0);
+
+	EXPECT_FALSE(values.specialAttack);
+	EXPECT_FLOAT_EQ(values.minDamage, 100);
+	EXPECT_FLOAT_EQ(values.maxDamage, 100);
+
+	EXPECT_FLOAT_EQ(values.damageBonus, 40);
+	EXPECT_FLOAT_EQ(values.applyDamageModifiers(100), 140);
+
+	addSkillMod(attacker, "private_damage_multiplier", 2);
+	addSkillMod(attacker, "private_damage_divisor", 4);
+
+	manager->getAttackerCombatValues(attacker, weapon, data, values);
+
+	EXPECT_FLOAT_EQ(values.applyDamageModifiers(100), 70);
+}
+
+TEST_F(CombatAreaBenchmarkTest, SharedValuesMatchPerDefender) {
+	createDefenders(40);
+
+	CreatureAttackData data("", command, 0);
+
+	AttackerCombatValues values;
+	manager->getAttackerCombatValues(attacker, weapon, data, values);
+
+	CreatureAttackData attackData(data);
+	attackData.setAttackerValues(&values);
+
+	for (int i = 0; i < defenders.size(); ++i) {
+		CreatureObject* defender = defenders.get(i);
+
+		EXPECT_FLOAT_EQ(manager->calculateDamage(attacker, weapon, defender, data), manager->calculateDamage(attacker, weapon, defender, attackData));
+	}
+}
+
+TEST_F(CombatAreaBenchmarkTest, Benchmark) {
+	CreatureAttackData data("", command, 0);
+
+	const int evaluations = 200000;
+	const int targets[] = { 1, 10, 50, 200 };
+
+	for (int count : targets) {
+		createDefenders(count);
+
+		int attacks = evaluations / count;
+		int damage = 0;
+
+		Timer timer;
+		timer.start();
+
+		for (int i = 0; i < attacks; ++i)
+			damage += runPerDefender(data);
+
+		uint64 perDefenderMs = Math::max((uint64) 1, timer.stopMs());
+
+		timer.start();
+
+		for (int i = 0; i < attacks; ++i)
+			damage += runShared(data);
+
+		uint64 sharedMs = Math::max((uint64) 1, timer.stopMs());
+
+		EXPECT_GT(damage, 0);
+
+		std::cerr << "[>>>>>>>>>>] " << count << " targets: per defender " << (attacks * 1000 / perDefenderMs)
+			<< " attacks/s, shared attacker values " << (attacks * 1000 / sharedMs) << " attacks/s" << std::endl;
+	}
+}
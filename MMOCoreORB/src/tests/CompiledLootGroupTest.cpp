@@ -0,0 +1,222 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "gtest/gtest.h"
+
+#include "server/zone/managers/loot/LootGroupMap.h"
+#include "templates/LootItemTemplate.h"
+
+class CompiledLootGroupTest : public ::testing::Test {
+protected:
+	// not deleted, the destructor closes the Lua state shared with LootGroupMap::instance()
+	LootGroupMap* map;
+
+	void SetUp() {
+		map = new LootGroupMap();
+	}
+
+	void addGroup(const String& name, const Vector<String>& entries, const Vector<int>& weights) {
+		Reference<LootGroupTemplate*> group = new LootGroupTemplate(name);
+
+		for (int i = 0; i < entries.size(); ++i)
+			group->addLootGroupEntry(entries.get(i), weights.get(i));
+
+		map->putLootGroupTemplate(name, group);
+	}
+
+	void addItem(const String& name) {
+		map->putLootItemTemplate(name, new LootItemTemplate(name));
+	}
+
+	// the per roll walk createLoot did before the groups were compiled
+	String legacyRoll(const String& groupName) {
+		const LootGroupTemplate* group = map->getLootGroupTemplate(groupName);
+		String selection = group->getLootGroupEntryForRoll(System::random(10000000));
+
+		if (map->lootGroupExists(selection))
+			return legacyRoll(selection);
+
+		return map->getLootItemTemplate(selection) != nullptr ? selection : "";
+	}
+
+	double getChance(const CompiledLootGroup* group, const String& itemName) {
+		double chance = 0;
+
+		for (int i = 0; i < group->size(); ++i) {
+			const CompiledLootGroup::Outcome& outcome = group->getOutcome(i);
+
+			if (outcome.itemName == itemName || (itemName == "" && outcome.itemTemplate == nullptr))
+				chance += outcome.chance;
+		}
+
+		return chance;
+	}
+
+	void createNestedGroups() {
+		Vector<String> entries;
+		Vector<int> weights;
+
+		entries.add("sub"); weights.add(4000000);
+		entries.add("item_a"); weights.add(5000000);
+		entries.add("item_missing"); weights.add(1000000);
+		addGroup("top", entries, weights);
+
+		entries.removeAll();
+		weights.removeAll();
+
+		// only adds up to 8000000, a fifth of the rolls drop nothing
+		entries.add("item_b"); weights.add(2000000);
+		entries.add("item_c"); weights.add(6000000);
+		addGroup("sub", entries, weights);
+
+		addItem("item_a");
+		addItem("item_b");
+		addItem("item_c");
+
+		map->compileLootGroups();
+	}
+};
+
+TEST_F(CompiledLootGroupTest, FlattenedChances) {
+	createNestedGroups();
+
+	const CompiledLootGroup* top = map->getCompiledLootGroup("top");
+	ASSERT_TRUE(top != nullptr);
+
+	EXPECT_NEAR(getChance(top, "item_a"), 0.5, 1e-6);
+	EXPECT_NEAR(getChance(top, "item_b"), 0.08, 1e-6);
+	EXPECT_NEAR(getChance(top, "item_c"), 0.24, 1e-6);
+	EXPECT_NEAR(getChance(top, ""), 0.18, 1e-6);
+
+	for (int i = 0; i < top->size(); ++i) {
+		const CompiledLootGroup::Outcome& outcome = top->getOutcome(i);
+
+		if (outcome.itemName == "item_b" || outcome.itemName == "item_c")
+			EXPECT_EQ(outcome.groupName, "sub");
+		else if (outcome.itemTemplate != nullptr)
+			EXPECT_EQ(outcome.groupName, "top");
+	}
+
+	EXPECT_TRUE(map->getCompiledLootGroup("missing") == nullptr);
+}
+
+TEST_F(CompiledLootGroupTest, SamplingMatchesLegacyRolls) {
+	createNestedGroups();
+
+	const CompiledLootGroup* top = map->getCompiledLootGroup("top");
+	ASSERT_TRUE(top != nullptr);
+
+	const int rolls = 200000;
+	VectorMap<String, int> compiled, legacy;
+	compiled.setNullValue(0);
+	legacy.setNullValue(0);
+
+	for (int i = 0; i < rolls; ++i) {
+		const CompiledLootGroup::Outcome& outcome = top->select();
+		String name = outcome.itemTemplate != nullptr ? outcome.itemName : "";
+
+		compiled.put(name, compiled.get(name) + 1);
+
+		String legacyName = legacyRoll("top");
+		legacy.put(legacyName, legacy.get(legacyName) + 1);
+	}
+
+	const char* names[] = { "item_a", "item_b", "item_c", "" };
+
+	for (auto name : names) {
+		EXPECT_NEAR(compiled.get(name) / (double) rolls, getChance(top, name), 0.006) << name;
+		EXPECT_NEAR(compiled.get(name) / (double) rolls, legacy.get(name) / (double) rolls, 0.008) << name;
+	}
+}
+
+TEST_F(CompiledLootGroupTest, NestingLoop) {
+	Vector<String> entries;
+	Vector<int> weights;
+
+	entries.add("loop_b"); weights.add(10000000);
+	addGroup("loop_a", entries, weights);
+
+	entries.removeAll();
+	entries.add("loop_a");
+	addGroup("loop_b", entries, weights);
+
+	map->compileLootGroups();
+
+	const CompiledLootGroup* group = map->getCompiledLootGroup("loop_a");
+	ASSERT_TRUE(group != nullptr);
+
+	EXPECT_TRUE(group->select().itemTemplate == nullptr);
+}
+
+TEST_F(CompiledLootGroupTest, Benchmark) {
+	// three levels of twenty entries, 8000 items
+	Vector<String> entries;
+	Vector<int> weights;
+
+	for (int i = 0; i < 20; ++i) {
+		entries.add("bench_" + String::valueOf(i));
+		weights.add(500000);
+	}
+
+	addGroup("bench", entries, weights);
+
+	for (int i = 0; i < 20; ++i) {
+		entries.removeAll();
+
+		for (int j = 0; j < 20; ++j)
+			entries.add("bench_" + String::valueOf(i) + "_" + String::valueOf(j));
+
+		addGroup("bench_" + String::valueOf(i), entries, weights);
+
+		for (int j = 0; j < 20; ++j) {
+			Vector<String> items;
+
+			for (int k = 0; k < 20; ++k) {
+				String item = "bench_" + String::valueOf(i) + "_" + String::valueOf(j) + "_" + String::valueOf(k);
+
+				items.add(item);
+				addItem(item);
+			}
+
+			addGroup(entries.get(j), items, weights);
+		}
+	}
+
+	Timer timer;
+	timer.start();
+
+	map->compileLootGroups();
+
+	uint64 compileMs = timer.stopMs();
+
+	const CompiledLootGroup* group = map->getCompiledLootGroup("bench");
+	ASSERT_TRUE(group != nullptr);
+	EXPECT_EQ(group->size(), 8000);
+
+	const int rolls = 200000;
+	int found = 0;
+
+	timer.start();
+
+	for (int i = 0; i < rolls; ++i) {
+		if (!legacyRoll("bench").isEmpty())
+			++found;
+	}
+
+	uint64 legacyMs = Math::max((uint64) 1, timer.stopMs());
+
+	timer.start();
+
+	for (int i = 0; i < rolls; ++i) {
+		if (group->select().itemTemplate != nullptr)
+			++found;
+	}
+
+	uint64 compiledMs = Math::max((uint64) 1, timer.stopMs());
+
+	EXPECT_EQ(found, rolls * 2);
+
+	std::cerr << "[>>>>>>>>>>] compiled in " << compileMs << "ms, nested rolls " << (rolls * 1000 / legacyMs)
+		<< "/s, compiled rolls " << (rolls * 1000 / compiledMs) << "/s" << std::endl;
+}
@@ -0,0 +1,69 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "gtest/gtest.h"
+
+#include "server/db/DatabaseStatistics.h"
+#include "server/db/QueryParameters.h"
+
+using namespace server::db::mysql;
+
+TEST(DatabaseStatisticsTest, Buckets) {
+	EXPECT_EQ(StatementLatency::getBucket(0), 0);
+	EXPECT_EQ(StatementLatency::getBucket(249), 0);
+	EXPECT_EQ(StatementLatency::getBucket(250), 1);
+	EXPECT_EQ(StatementLatency::getBucket(1500), 3);
+	EXPECT_EQ(StatementLatency::getBucket(10000000), StatementLatency::BUCKETS - 1);
+}
+
+TEST(DatabaseStatisticsTest, Percentiles) {
+	StatementLatency latency("SELECT 1");
+
+	for (int i = 0; i < 98; ++i)
+		latency.add(100);
+
+	latency.add(3000);
+	latency.add(40000);
+
+	EXPECT_EQ(latency.count, 100);
+	EXPECT_EQ(latency.maxMicros, 40000);
+
+	// upper bound of the bucket, never past the slowest run
+	EXPECT_EQ(latency.getPercentile(0.5f), 250);
+	EXPECT_EQ(latency.getPercentile(0.99f), 4000);
+	EXPECT_EQ(latency.getPercentile(1.f), 40000);
+}
+
+TEST(DatabaseStatisticsTest, UnpreparedKeys) {
+	DatabaseStatistics* statistics = DatabaseStatistics::instance();
+	statistics->reset();
+
+	statistics->recordUnprepared("(select a FROM characters WHERE account_id = 12)", 10);
+	statistics->recordUnprepared("SELECT b FROM accounts WHERE username = 'x'", 20);
+	statistics->record("SELECT b FROM accounts WHERE username = ?", 30);
+
+	Reference<StatementLatency*> unprepared = statistics->getLatency("SELECT (unprepared)");
+	ASSERT_NE(unprepared, nullptr);
+	EXPECT_EQ(unprepared->count, 2);
+
+	Reference<StatementLatency*> prepared = statistics->getLatency("SELECT b FROM accounts WHERE username = ?");
+	ASSERT_NE(prepared, nullptr);
+	EXPECT_EQ(prepared->count, 1);
+
+	EXPECT_TRUE(statistics->getStatistics().contains("Database statements: 2"));
+
+	statistics->reset();
+}
+
+TEST(DatabaseStatisticsTest, QueryParameters) {
+	QueryParameters parameters;
+	parameters.add(5).add((uint64) 1ull << 40).add(String("name")).add(1.5).addNull();
+
+	ASSERT_EQ(parameters.size(), 5);
+	EXPECT_EQ(parameters.get(0).type, QueryParameters::SIGNED);
+	EXPECT_EQ(parameters.get(1).unsignedValue, 1ull << 40);
+	EXPECT_EQ(parameters.get(2).stringValue, "name");
+	EXPECT_EQ(parameters.get(3).doubleValue, 1.5);
+	EXPECT_EQ(parameters.get(4).type, QueryParameters::NULLVALUE);
+}
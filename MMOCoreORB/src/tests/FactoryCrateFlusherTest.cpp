@@ -0,0 +1,68 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "gtest/gtest.h"
+
+#include "server/zone/objects/installation/factory/FactoryObject.h"
+
+// records the factories it is asked to flush instead of writing their crates
+class TestFactoryCrateFlusher : public FactoryCrateFlusher {
+public:
+	Vector<uint64> flushed;
+
+protected:
+	void flush(FactoryObject* factory) override {
+		flushed.add(factory->getObjectID());
+
+		remove(factory->getObjectID());
+	}
+};
+
+TEST(FactoryCrateFlusherTest, FlushAtCapacity) {
+	FactoryCrateUnits units;
+
+	// lazy, nobody watching: units pile up until the crate is full
+	for (int i = 0; i < 9; ++i)
+		EXPECT_FALSE(units.add(90, 100, false));
+
+	EXPECT_EQ(units.get(), 9);
+	EXPECT_FALSE(units.isFull(90, 100));
+
+	EXPECT_TRUE(units.add(90, 100, false));
+	EXPECT_TRUE(units.isFull(90, 100));
+
+	EXPECT_EQ(units.take(), 10);
+	EXPECT_EQ(units.get(), 0);
+
+	// an open hopper or lazy crates off write every unit
+	EXPECT_TRUE(units.add(0, 100, true));
+	EXPECT_EQ(units.take(), 1);
+}
+
+TEST(FactoryCrateFlusherTest, FlushAtShutdown) {
+	Reference<TestFactoryCrateFlusher*> flusher = new TestFactoryCrateFlusher();
+
+	Reference<FactoryObject*> first = new FactoryObject();
+	first->_setObjectID(1);
+
+	Reference<FactoryObject*> second = new FactoryObject();
+	second->_setObjectID(2);
+
+	flusher->add(first);
+	flusher->add(second);
+	flusher->add(first);
+
+	ASSERT_EQ(flusher->size(), 2);
+
+	// a factory that stopped flushed on its own
+	flusher->remove(second->getObjectID());
+
+	EXPECT_EQ(flusher->flushAll(), 1);
+
+	ASSERT_EQ(flusher->flushed.size(), 1);
+	EXPECT_EQ(flusher->flushed.get(0), 1);
+	EXPECT_EQ(flusher->size(), 0);
+
+	EXPECT_EQ(flusher->flushAll(), 0);
+}
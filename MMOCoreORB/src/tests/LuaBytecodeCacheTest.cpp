@@ -0,0 +1,113 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "gtest/gtest.h"
+
+#include "server/zone/managers/director/LuaBytecodeCache.h"
+
+namespace {
+	const char* TEST_SCRIPT = "lua_bytecode_cache_test.lua";
+
+	void writeScript(const char* contents) {
+		FILE* file = fopen(TEST_SCRIPT, "wb");
+
+		ASSERT_TRUE(file != nullptr);
+
+		fwrite(contents, 1, strlen(contents), file);
+		fclose(file);
+	}
+}
+
+class LuaBytecodeCacheTest : public ::testing::Test {
+protected:
+	Lua* lua = nullptr;
+	LuaBytecodeCache* cache = nullptr;
+
+public:
+	void SetUp() {
+		lua = new Lua();
+		lua->init();
+
+		cache = LuaBytecodeCache::instance();
+		cache->clear();
+	}
+
+	void TearDown() {
+		delete lua;
+		lua = nullptr;
+
+		unlink(TEST_SCRIPT);
+	}
+
+	int runScript() {
+		lua_State* L = lua->getLuaState();
+
+		int status = cache->loadFile(TEST_SCRIPT, L);
+
+		if (status == LUA_OK)
+			status = lua_pcall(L, 0, 0, 0);
+
+		if (status != LUA_OK) {
+			lua_pop(L, 1);
+
+			return -1;
+		}
+
+		return lua->getGlobalInt("bytecodeCacheTestValue");
+	}
+};
+
+TEST_F(LuaBytecodeCacheTest, UnchangedSourceHits) {
+	writeScript("bytecodeCacheTestValue = 1\n");
+
+	int compiles = cache->getCompiles();
+	int hits = cache->getHits();
+
+	EXPECT_EQ(runScript(), 1);
+	EXPECT_EQ(cache->getCompiles(), compiles + 1);
+
+	EXPECT_EQ(runScript(), 1);
+	EXPECT_EQ(runScript(), 1);
+
+	EXPECT_EQ(cache->getCompiles(), compiles + 1);
+	EXPECT_EQ(cache->getHits(), hits + 2);
+}
+
+TEST_F(LuaBytecodeCacheTest, SameSizeEditInvalidates) {
+	writeScript("bytecodeCacheTestValue = 1\n");
+
+	EXPECT_EQ(runScript(), 1);
+
+	int compiles = cache->getCompiles();
+
+	// same size and, written right away, usually the same modification second
+	writeScript("bytecodeCacheTestValue = 2\n");
+
+	EXPECT_EQ(runScript(), 2);
+	EXPECT_EQ(cache->getCompiles(), compiles + 1);
+
+	EXPECT_EQ(runScript(), 2);
+	EXPECT_EQ(cache->getCompiles(), compiles + 1);
+}
+
+TEST_F(LuaBytecodeCacheTest, SyntaxErrorIsReported) {
+	writeScript("bytecodeCacheTestValue = = 1\n");
+
+	int compiles = cache->getCompiles();
+
+	EXPECT_EQ(runScript(), -1);
+	EXPECT_EQ(cache->getCompiles(), compiles);
+
+	writeScript("bytecodeCacheTestValue = 3\n");
+
+	EXPECT_EQ(runScript(), 3);
+}
+
+TEST_F(LuaBytecodeCacheTest, SourceHash) {
+	const char* first = "bytecodeCacheTestValue = 1";
+	const char* second = "bytecodeCacheTestValue = 2";
+
+	EXPECT_EQ(LuaBytecodeCache::hashSource(first, strlen(first)), LuaBytecodeCache::hashSource(first, strlen(first)));
+	EXPECT_NE(LuaBytecodeCache::hashSource(first, strlen(first)), LuaBytecodeCache::hashSource(second, strlen(second)));
+}
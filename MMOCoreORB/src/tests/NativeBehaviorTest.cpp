@@ -0,0 +1,146 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "gtest/gtest.h"
+
+#include "conf/ConfigManager.h"
+#include "server/zone/managers/director/DirectorManager.h"
+#include "server/zone/managers/creature/AiMap.h"
+#include "server/zone/objects/creature/ai/AiAgent.h"
+#include "server/zone/objects/creature/ai/bt/NativeBehavior.h"
+
+namespace {
+	const int BENCHMARK_AGENTS = 10000;
+	const int BENCHMARK_TICKS = 10;
+}
+
+class NativeBehaviorTest : public ::testing::Test {
+protected:
+	AtomicLong nextObjectId;
+
+public:
+	NativeBehaviorTest() {
+		nextObjectId = 1;
+
+		ConfigManager::instance()->loadConfigData();
+		ConfigManager::instance()->setProgressMonitors(false);
+	}
+
+	void SetUp() {
+		// loads ais.lua and the ai templates into AiMap
+		ASSERT_NE(DirectorManager::instance()->getLuaInstance(), nullptr);
+	}
+
+	Reference<AiAgent*> createAiAgent() {
+		Reference<AiAgent*> agent = new AiAgent();
+
+		agent->setContainerComponent("ContainerComponent");
+		agent->setZoneComponent("ZoneComponent");
+		agent->_setObjectID(nextObjectId.increment());
+		agent->initializeContainerObjectsMap();
+
+		return agent;
+	}
+
+	/**
+	 * Runs one start/doAction/end cycle of the behavior and returns the doAction result.
+	 */
+	int runCycle(LuaBehavior* behavior, AiAgent* agent, bool& conditions) {
+		Locker locker(agent);
+
+		conditions = behavior->checkConditions(agent);
+
+		behavior->start(agent);
+		int result = behavior->doAction(agent);
+		behavior->end(agent);
+
+		return result;
+	}
+
+	uint64 runBenchmark(const String& compositeName, const String& waitName, Vector<Reference<AiAgent*> >& agents) {
+		Reference<LuaBehavior*> composite = AiMap::instance()->getBehavior(compositeName);
+		Reference<LuaBehavior*> wait = AiMap::instance()->getBehavior(waitName);
+
+		Timer timer;
+		timer.start();
+
+		for (int tick = 0; tick < BENCHMARK_TICKS; ++tick) {
+			for (int i = 0; i < agents.size(); ++i) {
+				AiAgent* agent = agents.getUnsafe(i);
+
+				Locker locker(agent);
+
+				// a tick runs the composite and its current leaf
+				if (composite->checkConditions(agent))
+					composite->doAction(agent);
+
+				if (wait->checkConditions(agent))
+					wait->doAction(agent);
+			}
+		}
+
+		return timer.stopMs();
+	}
+};
+
+TEST_F(NativeBehaviorTest, NativeBehaviorsAreRegistered) {
+	const char* names[] = { "NativeCompositeDefault", "NativeWaitDefault", "NativeWait10Default", "NativeMoveDefault",
+		"NativeWalkDefault", "NativeGeneratePatrolDefault", "NativeGetTarget", "NativeSelectWeapon", "NativeSelectAttack",
+		"NativeCombatMove", "NativeLeash" };
+
+	for (auto name : names) {
+		Reference<LuaBehavior*> behavior = AiMap::instance()->getBehavior(name);
+
+		ASSERT_NE(behavior, nullptr) << name;
+		EXPECT_EQ(behavior->print(), String(name));
+	}
+
+	EXPECT_EQ(NativeBehavior::createNativeBehavior("NotANode", "Test", "Interrupt"), nullptr);
+}
+
+TEST_F(NativeBehaviorTest, NativeMatchesLua) {
+	const char* pairs[][2] = {
+		{ "CompositeDefault", "NativeCompositeDefault" },
+		{ "WaitDefault", "NativeWaitDefault" },
+		{ "GeneratePatrolDefault", "NativeGeneratePatrolDefault" },
+	};
+
+	for (auto pair : pairs) {
+		Reference<LuaBehavior*> luaBehavior = AiMap::instance()->getBehavior(pair[0]);
+		Reference<LuaBehavior*> nativeBehavior = AiMap::instance()->getBehavior(pair[1]);
+
+		ASSERT_NE(luaBehavior, nullptr) << pair[0];
+		ASSERT_NE(nativeBehavior, nullptr) << pair[1];
+
+		Reference<AiAgent*> luaAgent = createAiAgent();
+		Reference<AiAgent*> nativeAgent = createAiAgent();
+
+		bool luaConditions = false;
+		bool nativeConditions = false;
+
+		int luaResult = runCycle(luaBehavior, luaAgent, luaConditions);
+		int nativeResult = runCycle(nativeBehavior, nativeAgent, nativeConditions);
+
+		EXPECT_EQ(luaConditions, nativeConditions) << pair[1];
+		EXPECT_EQ(luaResult, nativeResult) << pair[1];
+		EXPECT_EQ(luaAgent->isWaiting(), nativeAgent->isWaiting()) << pair[1];
+		EXPECT_EQ(luaAgent->getWait(), nativeAgent->getWait()) << pair[1];
+	}
+}
+
+TEST_F(NativeBehaviorTest, LuaVsNativeTickBenchmark) {
+	Vector<Reference<AiAgent*> > agents;
+
+	for (int i = 0; i < BENCHMARK_AGENTS; ++i)
+		agents.add(createAiAgent());
+
+	uint64 luaMs = runBenchmark("CompositeDefault", "WaitDefault", agents);
+	uint64 nativeMs = runBenchmark("NativeCompositeDefault", "NativeWaitDefault", agents);
+
+	uint64 ticks = (uint64) BENCHMARK_AGENTS * BENCHMARK_TICKS;
+
+	std::cerr << "[>>>>>>>>>>] " << BENCHMARK_AGENTS << " agents x " << BENCHMARK_TICKS << " ticks" << std::endl;
+	std::cerr << "[>>>>>>>>>>] Lua: " << luaMs << "ms (" << (ticks * 1000 / Math::max((uint64) 1, luaMs)) << " ticks/s)" << std::endl;
+	std::cerr << "[>>>>>>>>>>] Native: " << nativeMs << "ms (" << (ticks * 1000 / Math::max((uint64) 1, nativeMs)) << " ticks/s)" << std::endl;
+}
@@ -0,0 +1,122 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "gtest/gtest.h"
+
+#include "pathfinding/NavMeshCache.h"
+#include "templates/appearance/MeshData.h"
+
+class NavMeshCacheTest : public ::testing::Test {
+public:
+	RecastSettings settings;
+	AABB bounds;
+
+	NavMeshCacheTest() : bounds(Vector3(0, -10, 0), Vector3(64, 10, 64)) {
+		settings.m_cellSize = 0.5f;
+		settings.m_tileSize = 32;
+	}
+
+	void addQuad(MeshData* mesh, float x, float z, float size) {
+		Vector<Vector3>* verts = mesh->getVerts();
+		int first = verts->size();
+
+		verts->add(Vector3(x, 0, z));
+		verts->add(Vector3(x + size, 0, z));
+		verts->add(Vector3(x + size, 0, z + size));
+		verts->add(Vector3(x, 0, z + size));
+
+		mesh->getTriangles()->add(MeshTriangle(first, first + 1, first + 2));
+		mesh->getTriangles()->add(MeshTriangle(first, first + 2, first + 3));
+	}
+
+	dtNavMesh* createNavMesh() {
+		dtNavMeshParams params;
+		params.orig[0] = bounds.getXMin();
+		params.orig[1] = bounds.getYMin();
+		params.orig[2] = bounds.getZMin();
+		params.tileWidth = settings.m_tileSize * settings.m_cellSize;
+		params.tileHeight = settings.m_tileSize * settings.m_cellSize;
+		params.maxTiles = 16;
+		params.maxPolys = 1 << 18;
+
+		dtNavMesh* mesh = dtAllocNavMesh();
+		mesh->init(&params);
+
+		return mesh;
+	}
+};
+
+TEST_F(NavMeshCacheTest, TileHashes) {
+	Reference<MeshData*> mesh = new MeshData();
+	addQuad(mesh, 2, 2, 4);
+	addQuad(mesh, 40, 40, 4);
+
+	Reference<MeshData*> reordered = new MeshData();
+	addQuad(reordered, 40, 40, 4);
+	addQuad(reordered, 2, 2, 4);
+
+	VectorMap<uint32, uint64> hashes, reorderedHashes;
+	NavMeshCache::hashTiles(mesh, bounds, settings, hashes);
+	NavMeshCache::hashTiles(reordered, bounds, settings, reorderedHashes);
+
+	// 64m bounds with 16m tiles
+	ASSERT_EQ(hashes.size(), 16);
+
+	for (int i = 0; i < hashes.size(); ++i)
+		EXPECT_EQ(hashes.elementAt(i).getValue(), reorderedHashes.elementAt(i).getValue());
+
+	EXPECT_NE(hashes.get(NavMeshCache::getTileKey(0, 0)), 0);
+	EXPECT_NE(hashes.get(NavMeshCache::getTileKey(2, 2)), 0);
+	EXPECT_EQ(hashes.get(NavMeshCache::getTileKey(3, 0)), 0);
+
+	// moving the second quad only dirties the tiles around it
+	Reference<MeshData*> moved = new MeshData();
+	addQuad(moved, 2, 2, 4);
+	addQuad(moved, 41, 40, 4);
+
+	VectorMap<uint32, uint64> movedHashes;
+	NavMeshCache::hashTiles(moved, bounds, settings, movedHashes);
+
+	EXPECT_EQ(hashes.get(NavMeshCache::getTileKey(0, 0)), movedHashes.get(NavMeshCache::getTileKey(0, 0)));
+	EXPECT_NE(hashes.get(NavMeshCache::getTileKey(2, 2)), movedHashes.get(NavMeshCache::getTileKey(2, 2)));
+}
+
+TEST_F(NavMeshCacheTest, SaveAndLoad) {
+	NavMeshCache cache(".");
+
+	Reference<MeshData*> mesh = new MeshData();
+	addQuad(mesh, 2, 2, 4);
+
+	VectorMap<uint32, uint64> hashes;
+	NavMeshCache::hashTiles(mesh, bounds, settings, hashes);
+
+	Vector<Reference<RecastPolygon*> > water;
+	uint64 settingsHash = NavMeshCache::hashSettings(settings, bounds, -1000.f, water);
+
+	dtNavMesh* navMesh = createNavMesh();
+
+	ASSERT_TRUE(cache.saveTiles("navmeshcache_test", settingsHash, hashes, navMesh));
+
+	SortedVector<uint32> cachedTiles;
+	cachedTiles.setNoDuplicateInsertPlan();
+
+	EXPECT_EQ(cache.loadTiles("navmeshcache_test", settingsHash, hashes, navMesh, cachedTiles), hashes.size());
+	EXPECT_EQ(cachedTiles.size(), hashes.size());
+
+	// changed geometry under one tile
+	hashes.get(NavMeshCache::getTileKey(0, 0)) += 1;
+	cachedTiles.removeAll();
+
+	EXPECT_EQ(cache.loadTiles("navmeshcache_test", settingsHash, hashes, navMesh, cachedTiles), hashes.size() - 1);
+	EXPECT_FALSE(cachedTiles.contains(NavMeshCache::getTileKey(0, 0)));
+
+	// changed settings
+	cachedTiles.removeAll();
+
+	EXPECT_EQ(cache.loadTiles("navmeshcache_test", settingsHash + 1, hashes, navMesh, cachedTiles), 0);
+
+	dtFreeNavMesh(navMesh);
+
+	std::remove("./navmeshcache_test.navcache");
+}
@@ -0,0 +1,152 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "gtest/gtest.h"
+
+#include "server/zone/managers/collision/PathCache.h"
+
+class PathCacheTest : public ::testing::Test {
+public:
+	VectorMap<uint64, uint32> noNavMeshes;
+
+	Vector<WorldCoordinates> createPath(const WorldCoordinates& start, const WorldCoordinates& goal) {
+		Vector<WorldCoordinates> path;
+		path.add(start);
+		path.add(WorldCoordinates(Vector3(50, 50, 0), nullptr));
+		path.add(goal);
+
+		return path;
+	}
+
+	void put(PathCache& cache, const WorldCoordinates& start, const WorldCoordinates& goal, uint64 zoneID, const VectorMap<uint64, uint32>& navMeshes) {
+		Vector<WorldCoordinates> path = createPath(start, goal);
+
+		cache.put(start, goal, zoneID, &path, navMeshes, cache.getNavMeshUpdateCount());
+	}
+
+	bool isCached(PathCache& cache, const WorldCoordinates& start, const WorldCoordinates& goal, uint64 zoneID) {
+		Reference<Vector<WorldCoordinates>*> cached = cache.get(start, goal, zoneID);
+
+		return cached != nullptr;
+	}
+};
+
+TEST_F(PathCacheTest, HitsAndMisses) {
+	PathCache cache(64);
+
+	WorldCoordinates start(Vector3(10.2f, 20.3f, 0), nullptr);
+	WorldCoordinates goal(Vector3(100, 200, 0), nullptr);
+
+	EXPECT_EQ(cache.get(start, goal, 1), nullptr);
+
+	put(cache, start, goal, 1, noNavMeshes);
+
+	// an agent standing a few centimeters away gets the path from where it stands
+	WorldCoordinates nearStart(Vector3(10.6f, 20.5f, 0), nullptr);
+
+	Reference<Vector<WorldCoordinates>*> cached = cache.get(nearStart, goal, 1);
+
+	ASSERT_NE(cached, nullptr);
+	ASSERT_EQ(cached->size(), 3);
+	EXPECT_EQ(cached->get(0).getX(), nearStart.getX());
+	EXPECT_EQ(cached->get(1).getX(), 50);
+
+	// other zone
+	EXPECT_EQ(cache.get(start, goal, 2), nullptr);
+
+	EXPECT_EQ(cache.getHits(), 1);
+	EXPECT_EQ(cache.getMisses(), 2);
+}
+
+TEST_F(PathCacheTest, NavMeshRebuildInvalidatesCrossingPaths) {
+	PathCache cache(64);
+
+	WorldCoordinates goal(Vector3(100, 200, 0), nullptr);
+	WorldCoordinates first(Vector3(10, 20, 0), nullptr);
+	WorldCoordinates second(Vector3(-500, 20, 0), nullptr);
+
+	VectorMap<uint64, uint32> firstMeshes;
+	firstMeshes.put(100, 1);
+
+	VectorMap<uint64, uint32> secondMeshes;
+	secondMeshes.put(200, 2);
+
+	put(cache, first, goal, 1, firstMeshes);
+	put(cache, second, goal, 1, secondMeshes);
+
+	EXPECT_TRUE(isCached(cache, first, goal, 1));
+	EXPECT_TRUE(isCached(cache, second, goal, 1));
+
+	// only the path over the rebuilt area goes
+	cache.notifyNavMeshUpdated(1, 100, 3, false);
+
+	EXPECT_FALSE(isCached(cache, first, goal, 1));
+	EXPECT_TRUE(isCached(cache, second, goal, 1));
+
+	// and comes back once found on the new mesh
+	firstMeshes.put(100, 3);
+	put(cache, first, goal, 1, firstMeshes);
+
+	EXPECT_TRUE(isCached(cache, first, goal, 1));
+
+	cache.notifyNavMeshRemoved(200);
+
+	EXPECT_TRUE(isCached(cache, first, goal, 1));
+	EXPECT_FALSE(isCached(cache, second, goal, 1));
+}
+
+TEST_F(PathCacheTest, NewNavAreaInvalidatesZone) {
+	PathCache cache(64);
+
+	WorldCoordinates start(Vector3(10, 20, 0), nullptr);
+	WorldCoordinates goal(Vector3(100, 200, 0), nullptr);
+
+	put(cache, start, goal, 1, noNavMeshes);
+	put(cache, start, goal, 2, noNavMeshes);
+
+	// open terrain paths may now cross the new area, other zones don't care
+	cache.notifyNavMeshUpdated(1, 300, 4, true);
+
+	EXPECT_FALSE(isCached(cache, start, goal, 1));
+	EXPECT_TRUE(isCached(cache, start, goal, 2));
+}
+
+TEST_F(PathCacheTest, UpdateDuringSearchIsNotCached) {
+	PathCache cache(64);
+
+	WorldCoordinates start(Vector3(10, 20, 0), nullptr);
+	WorldCoordinates goal(Vector3(100, 200, 0), nullptr);
+
+	int updateCount = cache.getNavMeshUpdateCount();
+
+	cache.notifyNavMeshUpdated(1, 100, 5, false);
+
+	VectorMap<uint64, uint32> navMeshes;
+	navMeshes.put(100, 5);
+
+	Vector<WorldCoordinates> path = createPath(start, goal);
+	cache.put(start, goal, 1, &path, navMeshes, updateCount);
+
+	EXPECT_EQ(cache.size(), 0);
+}
+
+TEST_F(PathCacheTest, Bounded) {
+	PathCache cache(64);
+
+	WorldCoordinates goal(Vector3(1000, 1000, 0), nullptr);
+
+	for (int i = 0; i < 1000; ++i) {
+		WorldCoordinates start(Vector3(i * 2, 0, 0), nullptr);
+		put(cache, start, goal, 1, noNavMeshes);
+
+		EXPECT_LE(cache.size(), 64);
+	}
+
+	// the most recent paths survive
+	Reference<Vector<WorldCoordinates>*> cached = cache.get(WorldCoordinates(Vector3(999 * 2, 0, 0), nullptr), goal, 1);
+	EXPECT_NE(cached, nullptr);
+
+	cached = cache.get(WorldCoordinates(Vector3(0, 0, 0), nullptr), goal, 1);
+	EXPECT_EQ(cached, nullptr);
+}
@@ -0,0 +1,145 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "gtest/gtest.h"
+
+#include "conf/ConfigManager.h"
+#include "server/zone/managers/collision/PathRequestQueue.h"
+
+// searches and callbacks run inline on the test thread instead of the task manager
+class TestPathRequestQueue : public PathRequestQueue {
+public:
+	int drainsScheduled = 0;
+	Vector<uint64> searched;
+
+	using PathRequestQueue::enqueue;
+	using PathRequestQueue::drain;
+
+	void scheduleDrain() override {
+		++drainsScheduled;
+	}
+
+	Reference<Vector<WorldCoordinates>*> findPath(PathRequest* request) override {
+		searched.add(request->getKey());
+
+		Reference<Vector<WorldCoordinates>*> path = new Vector<WorldCoordinates>();
+		path->add(request->getStart());
+		path->add(request->getGoal());
+
+		return path;
+	}
+
+	void runCallback(PathRequestListener* listener, const Reference<Vector<WorldCoordinates>*>& path) override {
+		listener->run(path);
+	}
+};
+
+class PathRequestQueueTest : public ::testing::Test {
+protected:
+	Reference<TestPathRequestQueue*> queue;
+
+	Vector<Reference<Vector<WorldCoordinates>*> > results;
+	Vector<int> callbacks;
+
+public:
+	void SetUp() {
+		ConfigManager::instance()->setInt("Core3.PathRequestBatchSize", 2);
+
+		queue = new TestPathRequestQueue();
+	}
+
+	void TearDown() {
+		ConfigManager::instance()->setInt("Core3.PathRequestBatchSize", 64);
+	}
+
+	void request(int id, const WorldCoordinates& start, const WorldCoordinates& goal) {
+		uint64 key = PathRequestQueue::getRequestKey(start, goal);
+
+		queue->enqueue(key, start, goal, nullptr, new PathRequestListener(start, "", [this, id] (const Reference<Vector<WorldCoordinates>*>& path) {
+			callbacks.add(id);
+			results.add(path);
+		}));
+	}
+};
+
+TEST(PathRequestQueueTest, RequestKey) {
+	WorldCoordinates goal(Vector3(100, 200, 10), nullptr);
+
+	WorldCoordinates start(Vector3(10.2f, 20.3f, 5.1f), nullptr);
+	WorldCoordinates sameCell(Vector3(10.8f, 20.9f, 5.7f), nullptr);
+	WorldCoordinates nextCell(Vector3(11.2f, 20.3f, 5.1f), nullptr);
+
+	// agents standing on the same merge grid cell share one search
+	EXPECT_EQ(PathRequestQueue::getRequestKey(start, goal), PathRequestQueue::getRequestKey(sameCell, goal));
+
+	EXPECT_NE(PathRequestQueue::getRequestKey(start, goal), PathRequestQueue::getRequestKey(nextCell, goal));
+
+	// start and goal are not interchangeable
+	EXPECT_NE(PathRequestQueue::getRequestKey(start, goal), PathRequestQueue::getRequestKey(goal, start));
+
+	WorldCoordinates movedGoal(Vector3(100, 203, 10), nullptr);
+
+	EXPECT_NE(PathRequestQueue::getRequestKey(start, goal), PathRequestQueue::getRequestKey(start, movedGoal));
+}
+
+TEST_F(PathRequestQueueTest, MergesEqualRequests) {
+	WorldCoordinates goal(Vector3(100, 200, 10), nullptr);
+
+	WorldCoordinates start(Vector3(10.2f, 20.3f, 5.1f), nullptr);
+	WorldCoordinates sameCell(Vector3(10.8f, 20.9f, 5.7f), nullptr);
+
+	request(1, start, goal);
+	request(2, sameCell, goal);
+
+	EXPECT_EQ(queue->getRequestCount(), 2);
+	EXPECT_EQ(queue->getMergedCount(), 1);
+	EXPECT_EQ(queue->drainsScheduled, 1);
+
+	queue->drain();
+
+	// one search, both callbacks
+	EXPECT_EQ(queue->searched.size(), 1);
+	ASSERT_EQ(callbacks.size(), 2);
+
+	EXPECT_EQ(callbacks.get(0), 1);
+	EXPECT_EQ(callbacks.get(1), 2);
+
+	// every listener gets its own copy starting where it stood
+	ASSERT_TRUE(results.get(0) != nullptr && results.get(1) != nullptr);
+	EXPECT_NE(results.get(0).get(), results.get(1).get());
+
+	EXPECT_FLOAT_EQ(results.get(0)->get(0).getPoint().getX(), 10.2f);
+	EXPECT_FLOAT_EQ(results.get(1)->get(0).getPoint().getX(), 10.8f);
+	EXPECT_FLOAT_EQ(results.get(1)->get(1).getPoint().getX(), 100);
+}
+
+TEST_F(PathRequestQueueTest, DrainsInBatches) {
+	WorldCoordinates goal(Vector3(100, 200, 10), nullptr);
+
+	for (int i = 0; i < 5; ++i)
+		request(i, WorldCoordinates(Vector3(i * 10, 0, 0), nullptr), goal);
+
+	EXPECT_EQ(queue->getMergedCount(), 0);
+
+	// the batch size is 2, each drain hands the rest to another one
+	queue->drain();
+
+	EXPECT_EQ(queue->searched.size(), 2);
+	EXPECT_EQ(callbacks.size(), 2);
+
+	queue->drain();
+	queue->drain();
+
+	EXPECT_EQ(queue->searched.size(), 5);
+	EXPECT_EQ(callbacks.size(), 5);
+	EXPECT_EQ(queue->getSearchCount(), 5);
+
+	// a request after its search finished starts a new one
+	request(5, WorldCoordinates(Vector3(0, 0, 0), nullptr), goal);
+
+	queue->drain();
+
+	EXPECT_EQ(queue->searched.size(), 6);
+	EXPECT_EQ(callbacks.size(), 6);
+}
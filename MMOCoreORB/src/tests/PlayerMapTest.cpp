@@ -0,0 +1,35 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "gtest/gtest.h"
+
+#include "server/zone/objects/creature/CreatureObject.h"
+#include "server/zone/managers/player/PlayerMap.h"
+
+TEST(PlayerMapTest, SnapshotSharedUntilChanged) {
+	Reference<PlayerMap*> playerMap = new PlayerMap(100);
+
+	playerMap->put("alpha", nullptr);
+	playerMap->put("beta", nullptr);
+
+	Reference<PlayerList*> snapshot = playerMap->getSnapshot();
+	ASSERT_NE(snapshot, nullptr);
+	EXPECT_EQ(snapshot->size(), 2);
+
+	// readers share the same list while nobody logs in or out
+	EXPECT_EQ(playerMap->getSnapshot().get(), snapshot.get());
+
+	playerMap->put("gamma", nullptr);
+
+	Reference<PlayerList*> next = playerMap->getSnapshot();
+	EXPECT_NE(next.get(), snapshot.get());
+	EXPECT_EQ(next->size(), 3);
+
+	// a broadcast still walking the old list is not affected
+	EXPECT_EQ(snapshot->size(), 2);
+
+	playerMap->remove("alpha");
+
+	EXPECT_EQ(playerMap->getSnapshot()->size(), 2);
+}
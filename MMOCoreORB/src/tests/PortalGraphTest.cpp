@@ -0,0 +1,189 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "gtest/gtest.h"
+
+#include "templates/appearance/PathGraph.h"
+#include "templates/appearance/PortalGraph.h"
+#include "engine/util/u3d/AStarAlgorithm.h"
+
+class TestPathNode : public PathNode {
+public:
+	TestPathNode(PathGraph* graph, uint32 index, int globalID, float px, float py) : PathNode(graph) {
+		id = index;
+		globalGraphNodeID = globalID;
+		x = px;
+		y = py;
+	}
+};
+
+class PortalGraphTest : public ::testing::Test {
+public:
+	Vector<PathGraph*> graphs;
+
+	void TearDown() {
+		for (int i = 0; i < graphs.size(); ++i)
+			delete graphs.get(i);
+	}
+
+	PathNode* addNode(PathGraph* graph, int globalID, float x, float y) {
+		PathNode* node = new TestPathNode(graph, graph->getPathNodes()->size(), globalID, x, y);
+		graph->addPathNode(node);
+
+		return node;
+	}
+
+	void link(PathNode* node1, PathNode* node2) {
+		node1->addChild(node2);
+		node2->addChild(node1);
+	}
+
+	/**
+	 * A corridor of cells in a row, every cell a chain of nodes ending in the portals it shares
+	 * with the cells before and after it. With branches, every cell also gets a dead end loop.
+	 */
+	Vector<const PathGraph*> createCorridor(int cellCount, int nodesPerCell, bool branches) {
+		Vector<const PathGraph*> cellGraphs;
+		PathNode* lastPortal = nullptr;
+
+		for (int c = 0; c < cellCount; ++c) {
+			PathGraph* graph = new PathGraph(nullptr);
+			graphs.add(graph);
+
+			float base = c * 100;
+			PathNode* previous = nullptr;
+
+			if (lastPortal != nullptr) {
+				previous = addNode(graph, c, base, 0);
+				link(lastPortal, previous);
+			}
+
+			for (int i = 0; i < nodesPerCell; ++i) {
+				PathNode* node = addNode(graph, -1, base + 10 + i * (80.f / nodesPerCell), 0);
+
+				if (previous != nullptr)
+					link(previous, node);
+
+				if (branches) {
+					PathNode* branch = addNode(graph, -1, base + 10 + i * (80.f / nodesPerCell), 20);
+					link(node, branch);
+				}
+
+				previous = node;
+			}
+
+			lastPortal = addNode(graph, c + 1, base + 100, 0);
+			link(previous, lastPortal);
+
+			cellGraphs.add(graph);
+		}
+
+		return cellGraphs;
+	}
+};
+
+TEST_F(PortalGraphTest, CrossCellPath) {
+	Vector<const PathGraph*> cellGraphs = createCorridor(3, 4, true);
+
+	PortalGraph portalGraph(cellGraphs);
+
+	// an entry and an exit portal per cell, the first cell only has its exit
+	EXPECT_EQ(portalGraph.getPortalCount(), 5);
+
+	const PathNode* start = cellGraphs.get(0)->getPathNodes()->get(0);
+	const PathNode* end = cellGraphs.get(2)->getPathNodes()->get(5);
+
+	Vector<const PathNode*>* path = portalGraph.getPath(start, end);
+	ASSERT_NE(path, nullptr);
+
+	EXPECT_EQ(path->get(0), start);
+	EXPECT_EQ(path->get(path->size() - 1), end);
+
+	// consecutive nodes are linked and both twins of every crossed portal are on the route
+	int crossings = 0;
+
+	for (int i = 1; i < path->size(); ++i) {
+		const PathNode* from = path->get(i - 1);
+		const PathNode* to = path->get(i);
+
+		EXPECT_TRUE(from->getNeighbors()->contains(const_cast<PathNode*>(to)));
+
+		if (from->getPathGraph() != to->getPathGraph()) {
+			EXPECT_EQ(from->getGlobalGraphNodeID(), to->getGlobalGraphNodeID());
+			++crossings;
+		}
+
+		// no detours into the dead ends
+		EXPECT_EQ(to->getY(), 0);
+	}
+
+	EXPECT_EQ(crossings, 2);
+
+	// same route as a search over the whole node graph
+	Vector<const PathNode*>* expected = AStarAlgorithm<PathGraph, PathNode>::search<uint32>(start->getPathGraph(), start, end);
+	ASSERT_NE(expected, nullptr);
+	ASSERT_EQ(path->size(), expected->size());
+
+	for (int i = 0; i < path->size(); ++i)
+		EXPECT_EQ(path->get(i), expected->get(i));
+
+	delete path;
+	delete expected;
+}
+
+TEST_F(PortalGraphTest, SameCellAndUnreachable) {
+	Vector<const PathGraph*> cellGraphs = createCorridor(2, 3, false);
+
+	// a cell nothing links into
+	PathGraph* island = new PathGraph(nullptr);
+	graphs.add(island);
+	addNode(island, -1, 500, 0);
+	cellGraphs.add(island);
+
+	cellGraphs.add(nullptr);
+
+	PortalGraph portalGraph(cellGraphs);
+
+	const PathNode* start = cellGraphs.get(0)->getPathNodes()->get(0);
+
+	// paths inside one cell are left to the node search
+	EXPECT_EQ(portalGraph.getPath(start, cellGraphs.get(0)->getPathNodes()->get(2)), nullptr);
+
+	EXPECT_EQ(portalGraph.getPath(start, island->getPathNodes()->get(0)), nullptr);
+
+	// the way back goes through the same portal
+	Vector<const PathNode*>* path = portalGraph.getPath(cellGraphs.get(1)->getPathNodes()->get(2), start);
+	ASSERT_NE(path, nullptr);
+	EXPECT_EQ(path->get(path->size() - 1), start);
+
+	delete path;
+}
+
+TEST_F(PortalGraphTest, Benchmark) {
+	Vector<const PathGraph*> cellGraphs = createCorridor(32, 24, true);
+
+	PortalGraph portalGraph(cellGraphs);
+
+	const PathNode* start = cellGraphs.get(0)->getPathNodes()->get(0);
+	const PathNode* end = cellGraphs.get(31)->getPathNodes()->get(10);
+
+	const int iterations = 200;
+
+	Timer timer;
+	timer.start();
+
+	for (int i = 0; i < iterations; ++i)
+		delete AStarAlgorithm<PathGraph, PathNode>::search<uint32>(start->getPathGraph(), start, end);
+
+	uint64 nodeSearch = timer.stopMs();
+
+	timer.start();
+
+	for (int i = 0; i < iterations; ++i)
+		delete portalGraph.getPath(start, end);
+
+	uint64 portalSearch = timer.stopMs();
+
+	std::cerr << "[>>>>>>>>>>] " << iterations << " cross cell paths: node A* " << nodeSearch << "ms, portal graph " << portalSearch << "ms" << std::endl;
+}
@@ -0,0 +1,86 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "gtest/gtest.h"
+
+#include "server/zone/objects/resource/SpawnDensityMap.h"
+#include "server/zone/objects/resource/simplexnoise/SimplexNoise.h"
+
+#include <vector>
+
+class SimplexNoiseTest : public ::testing::Test {
+protected:
+	std::vector<float> x, y;
+
+	void SetUp() {
+		// survey coordinates scaled the way the density maps do, ore and organic
+		for (int i = 0; i < 1027; ++i) {
+			x.push_back(System::random(16384) * (i % 2 ? 0.00015f : 0.0006f));
+			y.push_back(System::random(16384) * (i % 2 ? 0.00015f : 0.0006f));
+		}
+	}
+};
+
+TEST_F(SimplexNoiseTest, BatchMatchesScalar) {
+	float z = System::random(1000000) * 0.0006f;
+
+	std::vector<float> values(x.size());
+
+	// odd count so the scalar tail runs too
+	SimplexNoise::noise(x.data(), y.data(), z, values.data(), values.size());
+
+	for (int i = 0; i < values.size(); ++i)
+		EXPECT_NEAR(values[i], SimplexNoise::noise(x[i], y[i], z), 1e-5f) << "at " << x[i] << ", " << y[i];
+}
+
+TEST_F(SimplexNoiseTest, DensityMapBatch) {
+	SpawnDensityMap map(true, SpawnDensityMap::HIGHDENSITY, -8192, 8192, -8192, 8192);
+
+	std::vector<float> worldX, worldY;
+
+	for (int i = 0; i < 300; ++i) {
+		worldX.push_back(System::random(16384) - 8192.f);
+		worldY.push_back(System::random(16384) - 8192.f);
+	}
+
+	std::vector<float> densities(worldX.size());
+	map.getDensitiesAt(worldX.data(), worldY.data(), densities.data(), densities.size());
+
+	for (int i = 0; i < densities.size(); ++i) {
+		EXPECT_GE(densities[i], 0.f);
+		EXPECT_NEAR(densities[i], map.getDensityAt(worldX[i], worldY[i]), 1e-5f);
+	}
+}
+
+TEST_F(SimplexNoiseTest, Benchmark) {
+	const int iterations = 200;
+	float z = 42.f;
+
+	std::vector<float> values(x.size());
+	float sum = 0;
+
+	Timer timer;
+	timer.start();
+
+	for (int n = 0; n < iterations; ++n) {
+		for (int i = 0; i < x.size(); ++i)
+			values[i] = SimplexNoise::noise(x[i], y[i], z);
+
+		sum += values[n];
+	}
+
+	uint64 scalar = timer.stopMs();
+
+	timer.start();
+
+	for (int n = 0; n < iterations; ++n) {
+		SimplexNoise::noise(x.data(), y.data(), z, values.data(), values.size());
+
+		sum += values[n];
+	}
+
+	uint64 batch = timer.stopMs();
+
+	std::cerr << "[>>>>>>>>>>] " << iterations * x.size() << " noise points: scalar " << scalar << "ms, batch " << batch << "ms (" << sum << ")" << std::endl;
+}
@@ -0,0 +1,182 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "gtest/gtest.h"
+
+#include "server/zone/QuadTree.h"
+#include "server/zone/SpatialGrid.h"
+#include "server/zone/objects/scene/SceneObject.h"
+
+namespace {
+	const int TEST_ENTRIES = 5000;
+	const int TEST_MOVERS = 4;
+	const int TEST_QUERIERS = 4;
+	const int TEST_MOVES = 20000;
+	const int TEST_QUERIES = 5000;
+	const float TEST_AREA = 2048.f;
+	const float TEST_RANGE = 128.f;
+}
+
+template<class Index>
+class SpatialIndexMover : public Thread {
+	Index* index;
+	Vector<Reference<SceneObject*> >* entries;
+	int offset;
+
+public:
+	SpatialIndexMover(Index* idx, Vector<Reference<SceneObject*> >* ents, int off) : index(idx), entries(ents), offset(off) {
+	}
+
+	void run() {
+		for (int i = 0; i < TEST_MOVES; ++i) {
+			SceneObject* entry = entries->getUnsafe((offset + i * TEST_MOVERS) % entries->size());
+
+			float x = Math::max(-TEST_AREA, Math::min(TEST_AREA - 1, entry->getPositionX() + System::random(20) - 10.f));
+			float y = Math::max(-TEST_AREA, Math::min(TEST_AREA - 1, entry->getPositionY() + System::random(20) - 10.f));
+
+			entry->setPosition(x, 0, y);
+
+			index->update(entry);
+		}
+	}
+};
+
+template<class Index>
+class SpatialIndexQuerier : public Thread {
+	Index* index;
+
+public:
+	int found = 0;
+
+	SpatialIndexQuerier(Index* idx) : index(idx) {
+	}
+
+	void run() {
+		SortedVector<QuadTreeEntry*> objects(500, 250);
+
+		for (int i = 0; i < TEST_QUERIES; ++i) {
+			float x = System::random((int) TEST_AREA * 2) - TEST_AREA;
+			float y = System::random((int) TEST_AREA * 2) - TEST_AREA;
+
+			objects.removeAll(500, 250);
+
+			found += index->inRange(x, y, TEST_RANGE, objects);
+		}
+	}
+};
+
+class SpatialIndexTest : public ::testing::Test {
+protected:
+	Vector<Reference<SceneObject*> > entries;
+
+public:
+	void SetUp() {
+		for (int i = 0; i < TEST_ENTRIES; ++i) {
+			Reference<SceneObject*> object = new SceneObject();
+			object->_setObjectID(i + 1);
+			object->initializePosition(System::random((int) TEST_AREA * 2) - TEST_AREA, 0, System::random((int) TEST_AREA * 2) - TEST_AREA);
+
+			entries.add(object);
+		}
+	}
+
+	void TearDown() {
+		entries.removeAll();
+	}
+
+	template<class Index>
+	uint64 runBenchmark(Index* index, int& found) {
+		for (int i = 0; i < entries.size(); ++i)
+			index->insert(entries.getUnsafe(i));
+
+		Vector<Reference<SpatialIndexMover<Index>*> > movers;
+		Vector<Reference<SpatialIndexQuerier<Index>*> > queriers;
+
+		Timer timer;
+		timer.start();
+
+		for (int i = 0; i < TEST_MOVERS; ++i) {
+			movers.add(new SpatialIndexMover<Index>(index, &entries, i));
+			movers.get(i)->start();
+		}
+
+		for (int i = 0; i < TEST_QUERIERS; ++i) {
+			queriers.add(new SpatialIndexQuerier<Index>(index));
+			queriers.get(i)->start();
+		}
+
+		for (int i = 0; i < movers.size(); ++i)
+			movers.get(i)->join();
+
+		for (int i = 0; i < queriers.size(); ++i) {
+			queriers.get(i)->join();
+			found += queriers.get(i)->found;
+		}
+
+		uint64 elapsedMs = timer.stopMs();
+
+		for (int i = 0; i < entries.size(); ++i) {
+			if (entries.getUnsafe(i)->isInQuadTree())
+				index->remove(entries.getUnsafe(i));
+		}
+
+		return elapsedMs;
+	}
+};
+
+TEST_F(SpatialIndexTest, GridMatchesQuadTree) {
+	Reference<QuadTree*> quadTree = new QuadTree(-8192, -8192, 8192, 8192);
+	Reference<SpatialGrid*> grid = new SpatialGrid(-8192, -8192, 8192, 8192);
+
+	Vector<Reference<SceneObject*> > gridEntries;
+
+	for (int i = 0; i < entries.size(); ++i) {
+		SceneObject* entry = entries.getUnsafe(i);
+
+		Reference<SceneObject*> copy = new SceneObject();
+		copy->_setObjectID(entry->getObjectID());
+		copy->initializePosition(entry->getPositionX(), 0, entry->getPositionY());
+
+		quadTree->insert(entry);
+		grid->insert(copy);
+
+		gridEntries.add(copy);
+	}
+
+	for (int i = 0; i < 100; ++i) {
+		float x = System::random((int) TEST_AREA * 2) - TEST_AREA;
+		float y = System::random((int) TEST_AREA * 2) - TEST_AREA;
+
+		SortedVector<QuadTreeEntry*> treeObjects;
+		SortedVector<QuadTreeEntry*> gridObjects;
+
+		quadTree->inRange(x, y, TEST_RANGE, treeObjects);
+		grid->inRange(x, y, TEST_RANGE, gridObjects);
+
+		ASSERT_EQ(treeObjects.size(), gridObjects.size());
+	}
+
+	for (int i = 0; i < entries.size(); ++i) {
+		quadTree->remove(entries.getUnsafe(i));
+		grid->remove(gridEntries.getUnsafe(i));
+
+		ASSERT_FALSE(gridEntries.getUnsafe(i)->isInQuadTree());
+	}
+}
+
+TEST_F(SpatialIndexTest, MoversAndQueriersBenchmark) {
+	Reference<QuadTree*> quadTree = new QuadTree(-8192, -8192, 8192, 8192);
+	Reference<SpatialGrid*> grid = new SpatialGrid(-8192, -8192, 8192, 8192);
+
+	int treeFound = 0;
+	int gridFound = 0;
+
+	uint64 treeMs = runBenchmark(quadTree.get(), treeFound);
+	uint64 gridMs = runBenchmark(grid.get(), gridFound);
+
+	std::cerr << "[>>>>>>>>>>] " << TEST_ENTRIES << " entries, " << TEST_MOVERS << " movers x " << TEST_MOVES
+		<< " updates, " << TEST_QUERIERS << " queriers x " << TEST_QUERIES << " queries" << std::endl;
+	std::cerr << "[>>>>>>>>>>] QuadTree: " << treeMs << "ms (" << treeFound << " results)" << std::endl;
+	std::cerr << "[>>>>>>>>>>] SpatialGrid: " << gridMs << "ms (" << gridFound << " results)" << std::endl;
+}
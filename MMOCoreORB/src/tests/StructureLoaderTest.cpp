@@ -0,0 +1,149 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "gtest/gtest.h"
+
+#include "server/zone/managers/structure/StructureLoader.h"
+#include "server/zone/objects/building/BuildingObject.h"
+
+#include <thread>
+#include <vector>
+
+namespace {
+	const int TEST_STRUCTURES = 10 * StructureLoader::CHUNKSIZE + 5;
+}
+
+// structures come from a table instead of the database, queued chunks wait for the test to run them
+class TestStructureLoader : public StructureLoader {
+public:
+	struct QueuedChunk {
+		Vector<uint64> objectIDs;
+		int firstSequence;
+	};
+
+	std::vector<QueuedChunk> queuedChunks;
+
+	Mutex registeredMutex;
+	Vector<uint64> registeredBases;
+
+	TestStructureLoader(int threads) : StructureLoader(nullptr, "structure_loader_test") {
+		this->threads = threads;
+		maxPendingChunks = threads * 4;
+	}
+
+	void executeChunk(const Vector<uint64>& objectIDs, int firstSequence) {
+		QueuedChunk queued;
+		queued.objectIDs = objectIDs;
+		queued.firstSequence = firstSequence;
+
+		queuedChunks.push_back(queued);
+	}
+
+	void runQueuedChunks() {
+		// last queued first, registration must still follow the index
+		for (int i = queuedChunks.size() - 1; i >= 0; --i) {
+			loadChunk(queuedChunks[i].objectIDs, queuedChunks[i].firstSequence);
+
+			chunkDone();
+		}
+
+		queuedChunks.clear();
+	}
+
+	Reference<SceneObject*> loadStructure(uint64 objectID) {
+		// every 7th id is missing from the database
+		if (objectID % 7 == 0)
+			return nullptr;
+
+		Reference<BuildingObject*> building = new BuildingObject();
+		building->_setObjectID(objectID);
+
+		return building.get();
+	}
+
+	bool isGCWBase(SceneObject* object) {
+		return object->getObjectID() % 5 == 0;
+	}
+
+	void registerGCWBase(BuildingObject* building) {
+		Locker locker(&registeredMutex);
+
+		registeredBases.add(building->getObjectID());
+	}
+
+	static int getExpectedLoaded() {
+		int count = 0;
+
+		for (int i = 1; i <= TEST_STRUCTURES; ++i) {
+			if (i % 7 != 0)
+				++count;
+		}
+
+		return count;
+	}
+};
+
+TEST(StructureLoaderTest, InlineWithoutThreads) {
+	Reference<TestStructureLoader*> loader = new TestStructureLoader(0);
+
+	for (int i = 1; i <= TEST_STRUCTURES; ++i)
+		loader->add(i);
+
+	loader->finish();
+
+	EXPECT_EQ((int) loader->queuedChunks.size(), 0);
+	EXPECT_EQ(loader->getLoadedCount(), TestStructureLoader::getExpectedLoaded());
+}
+
+TEST(StructureLoaderTest, QueueFullFallsBackInline) {
+	Reference<TestStructureLoader*> loader = new TestStructureLoader(1);
+
+	for (int i = 1; i <= TEST_STRUCTURES; ++i)
+		loader->add(i);
+
+	// four chunks wait for the worker, the loader read the other six itself
+	EXPECT_EQ((int) loader->queuedChunks.size(), 4);
+
+	int queuedLoaded = 0;
+
+	for (const auto& queued : loader->queuedChunks) {
+		const Vector<uint64>& objectIDs = queued.objectIDs;
+
+		EXPECT_EQ(objectIDs.size(), StructureLoader::CHUNKSIZE);
+
+		for (int j = 0; j < objectIDs.size(); ++j) {
+			if (objectIDs.get(j) % 7 != 0)
+				++queuedLoaded;
+		}
+	}
+
+	EXPECT_EQ(loader->getLoadedCount(), TestStructureLoader::getExpectedLoaded() - queuedLoaded);
+
+	// finish() sleeps until the worker is done with the last chunk, then registers the bases
+	std::thread worker([loader] () {
+		Thread::sleep(50);
+
+		loader->runQueuedChunks();
+	});
+
+	loader->finish();
+
+	worker.join();
+
+	EXPECT_EQ(loader->getLoadedCount(), TestStructureLoader::getExpectedLoaded());
+
+	ASSERT_GT(loader->registeredBases.size(), 0);
+
+	int expectedBases = 0;
+
+	for (int i = 1; i <= TEST_STRUCTURES; ++i) {
+		if (i % 7 != 0 && i % 5 == 0)
+			++expectedBases;
+	}
+
+	EXPECT_EQ(loader->registeredBases.size(), expectedBases);
+
+	for (int i = 1; i < loader->registeredBases.size(); ++i)
+		EXPECT_LT(loader->registeredBases.get(i - 1), loader->registeredBases.get(i));
+}
@@ -0,0 +1,209 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "gtest/gtest.h"
+
+#include "server/zone/objects/transaction/TransactionLogWriter.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <thread>
+#include <vector>
+#include <zlib.h>
+
+// zlib failing on every batch
+class FailingCompressionWriter : public TransactionLogWriter {
+public:
+	FailingCompressionWriter(const String& fileName) : TransactionLogWriter(fileName, DEFLATE, 256, 0) {
+	}
+
+protected:
+	int compressBatch(const std::string& raw, std::string& compressed) override {
+		return Z_MEM_ERROR;
+	}
+};
+
+class TransactionLogWriterTest : public ::testing::Test {
+protected:
+	String directory;
+
+	void SetUp() {
+		directory = "transactionlogwriter-test";
+
+		mkdir(directory.toCharArray(), 0755);
+		clear();
+	}
+
+	void TearDown() {
+		clear();
+		rmdir(directory.toCharArray());
+	}
+
+	void clear() {
+		DIR* dir = opendir(directory.toCharArray());
+
+		if (dir == nullptr)
+			return;
+
+		while (struct dirent* file = readdir(dir)) {
+			String name = file->d_name;
+
+			if (name != "." && name != "..")
+				unlink((directory + "/" + name).toCharArray());
+		}
+
+		closedir(dir);
+	}
+
+	int countFiles() {
+		DIR* dir = opendir(directory.toCharArray());
+		int count = 0;
+
+		while (struct dirent* file = readdir(dir)) {
+			if (file->d_name[0] != '.')
+				++count;
+		}
+
+		closedir(dir);
+
+		return count;
+	}
+
+	static String getLine(int thread, int i) {
+		return "{\"trxId\":\"" + String::valueOf(thread) + "-" + String::valueOf(i) + "\",\"type\":\"transfer\"}";
+	}
+
+	// several workers logging at once, like the TransactionLogWorker queue
+	void writeLines(TransactionLogWriter& writer, int threads, int lines) {
+		std::vector<std::thread> workers;
+
+		for (int t = 0; t < threads; ++t) {
+			workers.emplace_back([&writer, t, lines] () {
+				for (int i = 0; i < lines; ++i)
+					writer.write(getLine(t, i));
+			});
+		}
+
+		for (auto& worker : workers)
+			worker.join();
+	}
+
+	void checkFraming(int framing) {
+		String fileName = directory + "/transaction.log";
+		const int threads = 4, lines = 2000;
+
+		// a small queue so the workers also wait on the writer
+		TransactionLogWriter writer(fileName, framing, 256, 0);
+
+		writeLines(writer, threads, lines);
+		writer.stop();
+
+		EXPECT_EQ(writer.getWrittenCount(), threads * lines);
+		EXPECT_EQ(writer.getQueueDepth(), 0);
+
+		Vector<String> written;
+		ASSERT_TRUE(TransactionLogWriter::readFile(fileName, framing, written));
+		ASSERT_EQ(written.size(), threads * lines);
+
+		// lines of one worker keep their order
+		Vector<int> next;
+
+		for (int t = 0; t < threads; ++t)
+			next.add(0);
+
+		for (int i = 0; i < written.size(); ++i) {
+			const String& line = written.get(i);
+			int thread = line.charAt(10) - '0';
+
+			ASSERT_TRUE(thread >= 0 && thread < threads) << line.toCharArray();
+			EXPECT_EQ(line, getLine(thread, next.get(thread)));
+
+			next.set(thread, next.get(thread) + 1);
+		}
+	}
+};
+
+TEST_F(TransactionLogWriterTest, Text) {
+	checkFraming(TransactionLogWriter::TEXT);
+}
+
+TEST_F(TransactionLogWriterTest, Binary) {
+	checkFraming(TransactionLogWriter::BINARY);
+}
+
+TEST_F(TransactionLogWriterTest, Deflate) {
+	checkFraming(TransactionLogWriter::DEFLATE);
+}
+
+TEST_F(TransactionLogWriterTest, Rotation) {
+	String fileName = directory + "/transaction.log";
+
+	TransactionLogWriter writer(fileName, TransactionLogWriter::TEXT, 1024, 0);
+	writer.setRotateBytes(4096);
+
+	// one at a time so every batch is small
+	for (int i = 0; i < 200; ++i) {
+		writer.write(getLine(0, i));
+
+		while (writer.getQueueDepth() > 0)
+			Thread::sleep(1);
+	}
+
+	writer.stop();
+
+	EXPECT_GT(writer.getRotationCount(), 0);
+	EXPECT_EQ(countFiles(), writer.getRotationCount() + 1);
+
+	struct stat st;
+	ASSERT_EQ(stat(fileName.toCharArray(), &st), 0);
+	EXPECT_LT(st.st_size, 4096);
+}
+
+TEST_F(TransactionLogWriterTest, StopWhileWriting) {
+	String fileName = directory + "/transaction.log";
+	const int threads = 4, lines = 5000;
+
+	TransactionLogWriter writer(fileName, TransactionLogWriter::BINARY, 64, 0);
+
+	std::thread stopper([&writer] () {
+		Thread::sleep(5);
+
+		writer.stop();
+	});
+
+	writeLines(writer, threads, lines);
+	stopper.join();
+
+	// every line is either in the file or was refused, none is lost in the queue
+	Vector<String> written;
+	ASSERT_TRUE(TransactionLogWriter::readFile(fileName, TransactionLogWriter::BINARY, written));
+
+	EXPECT_EQ(writer.getQueueDepth(), 0);
+	EXPECT_EQ(written.size(), writer.getWrittenCount());
+	EXPECT_EQ(writer.getWrittenCount() + writer.getRejectedCount(), threads * lines);
+}
+
+TEST_F(TransactionLogWriterTest, DeflateFallback) {
+	String fileName = directory + "/transaction.logz";
+	const int threads = 2, lines = 500;
+
+	FailingCompressionWriter writer(fileName);
+
+	writeLines(writer, threads, lines);
+	writer.stop();
+
+	EXPECT_EQ(writer.getWrittenCount(), threads * lines);
+
+	Vector<String> written;
+	ASSERT_TRUE(TransactionLogWriter::readFile(fileName, TransactionLogWriter::DEFLATE, written));
+	EXPECT_EQ(written.size(), threads * lines);
+}
+
+TEST_F(TransactionLogWriterTest, Framing) {
+	EXPECT_EQ(TransactionLogWriter::getFraming("text"), TransactionLogWriter::TEXT);
+	EXPECT_EQ(TransactionLogWriter::getFraming("Binary"), TransactionLogWriter::BINARY);
+	EXPECT_EQ(TransactionLogWriter::getFraming("compressed"), TransactionLogWriter::DEFLATE);
+	EXPECT_EQ(TransactionLogWriter::getDefaultFileName(TransactionLogWriter::TEXT), "log/transaction.log");
+}
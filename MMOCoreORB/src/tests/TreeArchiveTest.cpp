@@ -0,0 +1,149 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "gtest/gtest.h"
+
+#include "tre3/TreeArchive.h"
+
+namespace {
+	const int TEST_TRE_FILES = 12;
+	const int TEST_TRE_RECORDS = 50;
+
+	// an uncompressed version 5 tree file holding records named path -> contents
+	bool writeTreeFile(const String& fileName, const Vector<String>& paths, const Vector<String>& contents) {
+		const uint32 headerSize = 36;
+		const uint32 totalRecords = paths.size();
+
+		Vector<uint32> dataOffsets;
+		uint32 offset = headerSize;
+
+		for (int i = 0; i < contents.size(); ++i) {
+			dataOffsets.add(offset);
+			offset += contents.get(i).length();
+		}
+
+		uint32 dataOffset = offset;
+
+		Vector<uint32> nameOffsets;
+		uint32 nameSize = 0;
+
+		for (int i = 0; i < paths.size(); ++i) {
+			nameOffsets.add(nameSize);
+			nameSize += paths.get(i).length() + 1;
+		}
+
+		FILE* file = fopen(fileName.toCharArray(), "wb");
+
+		if (file == nullptr)
+			return false;
+
+		uint32 header[9] = { 'TREE', '0005', totalRecords, dataOffset, 0, TreeDataBlock::SIZE * totalRecords, 0, nameSize, nameSize };
+
+		fwrite(header, sizeof(uint32), 9, file);
+
+		for (int i = 0; i < contents.size(); ++i)
+			fwrite(contents.get(i).toCharArray(), 1, contents.get(i).length(), file);
+
+		for (int i = 0; i < paths.size(); ++i) {
+			uint32 size = contents.get(i).length();
+			uint32 record[6] = { 0, size, dataOffsets.get(i), 0, size, nameOffsets.get(i) };
+
+			fwrite(record, sizeof(uint32), 6, file);
+		}
+
+		for (int i = 0; i < paths.size(); ++i)
+			fwrite(paths.get(i).toCharArray(), 1, paths.get(i).length() + 1, file);
+
+		byte md5[16];
+		memset(md5, 0, sizeof(md5));
+
+		for (int i = 0; i < paths.size(); ++i)
+			fwrite(md5, 1, sizeof(md5), file);
+
+		fclose(file);
+
+		return true;
+	}
+
+	String getContents(const TreeArchive& archive, const String& path) {
+		TreeRecordView view;
+
+		if (!archive.getView(path, view))
+			return "";
+
+		return String((const char*) view.getData(), view.size());
+	}
+}
+
+class TreeArchiveTest : public ::testing::Test {
+protected:
+	Vector<String> files;
+
+public:
+	void SetUp() {
+		for (int i = 0; i < TEST_TRE_FILES; ++i) {
+			String fileName = "tree_archive_test_" + String::valueOf(i) + ".tre";
+
+			Vector<String> paths;
+			Vector<String> contents;
+
+			// every file overrides the shared records, the rest are its own
+			paths.add("test/shared.iff");
+			contents.add("shared from " + String::valueOf(i));
+
+			for (int j = 0; j < TEST_TRE_RECORDS; ++j) {
+				paths.add("test/file_" + String::valueOf(i) + "/record_" + String::valueOf(j) + ".iff");
+				contents.add("record " + String::valueOf(j) + " of " + String::valueOf(i));
+			}
+
+			ASSERT_TRUE(writeTreeFile(fileName, paths, contents));
+
+			files.add(fileName);
+		}
+	}
+
+	void TearDown() {
+		for (int i = 0; i < files.size(); ++i)
+			unlink(files.get(i).toCharArray());
+	}
+};
+
+TEST_F(TreeArchiveTest, ParallelLoadMatchesSequential) {
+	TreeArchive sequential;
+	sequential.unpackFiles(files, 0);
+
+	TreeArchive parallel;
+	parallel.unpackFiles(files, 4);
+
+	EXPECT_EQ(sequential.getMappedFileCount(), TEST_TRE_FILES);
+	EXPECT_EQ(parallel.getMappedFileCount(), TEST_TRE_FILES);
+
+	// the same file has to win the overridden record no matter which thread read it
+	String shared = getContents(sequential, "test/shared.iff");
+
+	EXPECT_FALSE(shared.isEmpty());
+	EXPECT_EQ(getContents(parallel, "test/shared.iff"), shared);
+
+	for (int i = 0; i < TEST_TRE_FILES; ++i) {
+		for (int j = 0; j < TEST_TRE_RECORDS; ++j) {
+			String path = "test/file_" + String::valueOf(i) + "/record_" + String::valueOf(j) + ".iff";
+			String expected = "record " + String::valueOf(j) + " of " + String::valueOf(i);
+
+			EXPECT_EQ(getContents(sequential, path), expected);
+			EXPECT_EQ(getContents(parallel, path), expected);
+		}
+	}
+}
+
+TEST_F(TreeArchiveTest, ParallelLoadSkipsMissingFiles) {
+	Vector<String> withMissing;
+	withMissing.addAll(files);
+	withMissing.add("tree_archive_test_missing.tre");
+
+	TreeArchive parallel;
+	parallel.unpackFiles(withMissing, 3);
+
+	EXPECT_EQ(parallel.getMappedFileCount(), TEST_TRE_FILES);
+	EXPECT_EQ(getContents(parallel, "test/file_0/record_0.iff"), "record 0 of 0");
+}
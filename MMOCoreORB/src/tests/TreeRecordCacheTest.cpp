@@ -0,0 +1,70 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "gtest/gtest.h"
+
+#include "tre3/TreeRecordCache.h"
+
+namespace {
+	TreeRecordData* createRecord(uint32 size) {
+		byte* buffer = new byte[size];
+		memset(buffer, size & 0xFF, size);
+
+		return new TreeRecordData(buffer, size);
+	}
+}
+
+TEST(TreeRecordCacheTest, EvictsLeastRecentlyUsed) {
+	TreeRecordCache cache(300);
+
+	cache.put(1, createRecord(100));
+	cache.put(2, createRecord(100));
+	cache.put(3, createRecord(100));
+
+	// touch 1 so 2 becomes the least recently used record
+	ASSERT_NE(cache.get(1).get(), nullptr);
+
+	cache.put(4, createRecord(100));
+
+	EXPECT_NE(cache.get(1).get(), nullptr);
+	EXPECT_EQ(cache.get(2).get(), nullptr);
+	EXPECT_NE(cache.get(3).get(), nullptr);
+	EXPECT_NE(cache.get(4).get(), nullptr);
+}
+
+TEST(TreeRecordCacheTest, RespectsSizeLimit) {
+	TreeRecordCache cache(256);
+
+	Reference<TreeRecordData*> tooBig = createRecord(512);
+	cache.put(1, tooBig.get());
+
+	EXPECT_EQ(cache.get(1).get(), nullptr);
+
+	cache.put(2, createRecord(200));
+	cache.put(3, createRecord(200));
+
+	EXPECT_EQ(cache.get(2).get(), nullptr);
+	EXPECT_NE(cache.get(3).get(), nullptr);
+
+	cache.setMaxSize(100);
+
+	EXPECT_EQ(cache.get(3).get(), nullptr);
+}
+
+TEST(TreeRecordCacheTest, ViewKeepsEvictedRecordAlive) {
+	TreeRecordCache cache(100);
+
+	TreeRecordView view;
+
+	Reference<TreeRecordData*> data = createRecord(100);
+	cache.put(1, data.get());
+	view.set(data.get(), data->getData(), data->size());
+	data = nullptr;
+
+	cache.put(2, createRecord(100));
+
+	EXPECT_EQ(cache.get(1).get(), nullptr);
+	ASSERT_EQ(view.size(), 100);
+	EXPECT_EQ(view.getData()[99], 100);
+}
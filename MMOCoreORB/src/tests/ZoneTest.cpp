@@ -14,6 +14,7 @@
 #include "server/zone/ZoneProcessServer.h"
 #include "server/zone/objects/scene/SceneObject.h"
 #include "server/zone/objects/area/ActiveArea.h"
+#include "server/zone/InRangeBatch.h"
 #include "conf/ConfigManager.h"
 #include "server/zone/managers/player/PlayerManager.h"
 #include "server/login/objects/GalaxyList.h"
@@ -23,6 +24,27 @@ using ::testing::Return;
 using ::testing::AnyNumber;
 using ::testing::TypedEq;
 using ::testing::An;
+using ::testing::AtLeast;
+using ::testing::Mock;
+
+// records the recalculations instead of querying a zone, passes only run when the test asks
+class TestInRangeBatch : public InRangeBatch {
+public:
+	Vector<QuadTreeEntry*> recalculated;
+	Vector<float> ranges;
+
+	TestInRangeBatch() : InRangeBatch(nullptr, "test_zone", 100) {
+	}
+
+protected:
+	void schedulePass() override {
+	}
+
+	void recalculate(QuadTreeEntry* entry, float range) override {
+		recalculated.add(entry);
+		ranges.add(range);
+	}
+};
 
 class ZoneTest : public ::testing::Test {
 protected:
@@ -65,6 +87,15 @@ public:
 		return object;
 	}
 
+	Reference<SceneObject*> createMockSceneObject() {
+		Reference<SceneObject*> object = new MockSceneObject();
+		setDefaultComponents(object);
+		object->_setObjectID(nextObjectId.increment());
+		object->initializeContainerObjectsMap();
+
+		return object;
+	}
+
 	Reference<ActiveArea*> createActiveArea(bool mock = false) {
 		Reference<ActiveArea*> activeArea;
 
@@ -252,3 +283,88 @@ TEST_F(ZoneTest, InRangeTest) {
 
 	ASSERT_EQ(objects.size(), 0);
 }
+
+TEST_F(ZoneTest, InRangeHysteresisTest) {
+	ConfigManager::instance()->setFloat("Core3.InRangeHysteresis", 16);
+
+	// the hysteresis is read when the zone is created
+	zone = new Zone(processServer, "test_zone_hysteresis");
+	zone->createContainerComponent();
+	zone->_setObjectID(2);
+
+	Reference<SceneObject*> neighbour = createMockSceneObject();
+	MockSceneObject* mockNeighbour = dynamic_cast<MockSceneObject*>(neighbour.get());
+
+	ASSERT_TRUE(mockNeighbour != nullptr);
+
+	EXPECT_CALL(*mockNeighbour, notifyPositionUpdate(_)).Times(AnyNumber());
+
+	Locker nlocker(neighbour);
+
+	neighbour->initializePosition(5, 0, 5);
+	zone->transferObject(neighbour, -1);
+
+	nlocker.release();
+
+	Reference<SceneObject*> mover = createSceneObject();
+
+	Locker mlocker(mover);
+
+	zone->transferObject(mover, -1);
+
+	ASSERT_TRUE(mover->getCloseObjects() != nullptr);
+	ASSERT_TRUE(mover->getCloseObjects()->contains(neighbour.get()));
+
+	Mock::VerifyAndClearExpectations(mockNeighbour);
+
+	// well inside the hysteresis, close objects aren't recalculated but the neighbour still sees the move
+	EXPECT_CALL(*mockNeighbour, notifyPositionUpdate(mover.get())).Times(AtLeast(1));
+
+	mover->teleport(1, 0, 1);
+
+	Mock::VerifyAndClearExpectations(mockNeighbour);
+
+	EXPECT_CALL(*mockNeighbour, notifyPositionUpdate(_)).Times(AnyNumber());
+
+	mover->destroyObjectFromWorld(false);
+
+	mlocker.release();
+
+	Locker n2locker(neighbour);
+
+	neighbour->destroyObjectFromWorld(false);
+
+	ConfigManager::instance()->setFloat("Core3.InRangeHysteresis", 0);
+}
+
+TEST_F(ZoneTest, InRangeBatchTest) {
+	Reference<TestInRangeBatch*> batch = new TestInRangeBatch();
+
+	Reference<SceneObject*> first = createSceneObject();
+	Reference<SceneObject*> second = createSceneObject();
+
+	// moving several times before the pass recalculates once, with the largest range
+	batch->add(first, 64);
+	batch->add(first, 128);
+	batch->add(first, 32);
+	batch->add(second, 64);
+
+	ASSERT_EQ(batch->getPendingCount(), 2);
+
+	batch->runPass();
+
+	ASSERT_EQ(batch->getPendingCount(), 0);
+	ASSERT_EQ(batch->recalculated.size(), 2);
+
+	for (int i = 0; i < batch->recalculated.size(); ++i) {
+		if (batch->recalculated.get(i) == first.get())
+			EXPECT_EQ(batch->ranges.get(i), 128);
+		else
+			EXPECT_EQ(batch->ranges.get(i), 64);
+	}
+
+	// nothing left for the next pass
+	batch->runPass();
+
+	EXPECT_EQ(batch->recalculated.size(), 2);
+}
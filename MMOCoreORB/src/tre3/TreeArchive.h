@@ -11,11 +11,54 @@
 #include "TreeFile.h"
 #include "TreeDirectory.h"
 
+/**
+ * Reads the table of contents of every stride'th tree file starting at first,
+ * without adding the records to an archive.
+ */
+class TreeFileReader : public Thread {
+	const Vector<String>& files;
+	int first;
+	int stride;
+
+	Vector<TreeFile*> treeFiles;
+
+public:
+	TreeFileReader(const Vector<String>& paths, int firstFile, int fileStride) : files(paths), first(firstFile), stride(fileStride) {
+	}
+
+	~TreeFileReader() {
+		for (int i = 0; i < treeFiles.size(); ++i)
+			delete treeFiles.get(i);
+	}
+
+	void run() {
+		for (int i = first; i < files.size(); i += stride) {
+			TreeFile* treeFile = new TreeFile(nullptr);
+			treeFile->read(files.get(i));
+
+			treeFiles.add(treeFile);
+		}
+	}
+
+	/**
+	 * Returns the reader for files.get(first + index * stride).
+	 */
+	inline TreeFile* getTreeFile(int index) const {
+		return treeFiles.get(index);
+	}
+};
+
 class TreeArchive : public Logger {
 	HashTable<String, Reference<TreeDirectory*> > nodeMap;
 
+	Vector<Reference<TreeFileMapping*> > mappings;
+
+	mutable TreeRecordCache recordCache;
+
 public:
-	TreeArchive() {
+	const static uint64 DEFAULTRECORDCACHESIZE = 64 * 1024 * 1024;
+
+	TreeArchive(uint64 recordCacheSize = DEFAULTRECORDCACHESIZE) : recordCache(recordCacheSize) {
 		setLoggingName("TreeArchive");
 		setLogging(false);
 
@@ -26,7 +69,59 @@ public:
 
 	void unpackFile(const String& file) {
 		TreeFile treeFile(this);
-		treeFile.read(file);
+		Reference<TreeFileMapping*> mapping = treeFile.read(file);
+
+		if (mapping != nullptr)
+			mappings.add(mapping);
+	}
+
+	/**
+	 * Reads the tables of contents of files with readerThreads threads. Records
+	 * are added in the order of files afterwards, so earlier files still take
+	 * precedence over later ones exactly like with unpackFile.
+	 */
+	void unpackFiles(const Vector<String>& files, int readerThreads) {
+		readerThreads = Math::max(1, Math::min(readerThreads, files.size()));
+
+		if (readerThreads == 1) {
+			for (int i = 0; i < files.size(); ++i)
+				unpackFile(files.get(i));
+
+			return;
+		}
+
+		Vector<TreeFileReader*> readers;
+
+		for (int i = 0; i < readerThreads; ++i) {
+			TreeFileReader* reader = new TreeFileReader(files, i, readerThreads);
+			reader->start();
+
+			readers.add(reader);
+		}
+
+		for (int i = 0; i < readers.size(); ++i)
+			readers.get(i)->join();
+
+		for (int i = 0; i < files.size(); ++i) {
+			TreeFile* treeFile = readers.get(i % readerThreads)->getTreeFile(i / readerThreads);
+
+			if (treeFile->getMapping() == nullptr)
+				continue;
+
+			mappings.add(treeFile->getMapping());
+
+			const Vector<Reference<TreeFileRecord*> >& records = treeFile->getRecords();
+
+			for (int j = 0; j < records.size(); ++j) {
+				TreeFileRecord* record = records.get(j);
+				String path = record->getRecordName();
+
+				addRecord(path, record);
+			}
+		}
+
+		for (int i = 0; i < readers.size(); ++i)
+			delete readers.get(i);
 	}
 
 	void addRecord(const String& path, TreeFileRecord* record) {
@@ -59,37 +154,70 @@ public:
 	}
 
 	/**
-	 * Gets a byte buffer from the specified path.
-	 * Don't forget to delete the pointer when finished.
+	 * Points view at the record at the specified path without copying it.
+	 * @return false if the record was not found or could not be read
 	 */
-	byte* getBytes(const String& recordPath, int& size) const {
+	bool getView(const String& recordPath, TreeRecordView& view) const {
+		view.clear();
+
 		int pos = recordPath.lastIndexOf("/");
 
 		//Only folders are allowed at the root level of TRE directories.
 		if (pos == -1)
-			return nullptr;
+			return false;
 
 		String dir = recordPath.subString(0, pos);
 		String fileName = recordPath.subString(pos + 1, recordPath.length());
 
 		const TreeDirectory* treeDir = nodeMap.get(dir).get();
 
-		size = 0;
-
 		if (treeDir == nullptr)
-			return nullptr;
+			return false;
 
 		int idx = treeDir->find(fileName);
 
 		if (idx == -1) {
 			warning() << recordPath << " not found.";
-			return nullptr;
+			return false;
 		}
 
 		const Reference<TreeFileRecord*>& record = treeDir->get(idx);
-		size = record->getUncompressedSize();
 
-		return record->getBytes();
+		return record->getView(view, &recordCache);
+	}
+
+	/**
+	 * Gets a byte buffer from the specified path.
+	 * Don't forget to delete the pointer when finished.
+	 */
+	byte* getBytes(const String& recordPath, int& size) const {
+		TreeRecordView view;
+
+		size = 0;
+
+		if (!getView(recordPath, view))
+			return nullptr;
+
+		size = view.size();
+
+		return view.copyBytes();
+	}
+
+	uint64 getMappedSize() const {
+		uint64 total = 0;
+
+		for (int i = 0; i < mappings.size(); ++i)
+			total += mappings.get(i)->size();
+
+		return total;
+	}
+
+	inline int getMappedFileCount() const {
+		return mappings.size();
+	}
+
+	inline TreeRecordCache* getRecordCache() const {
+		return &recordCache;
 	}
 
 	const TreeDirectory* getDirectory(const String& path) const {
@@ -81,6 +81,36 @@ public:
 		return uncompressedData;
 	}
 
+	/**
+	 * Uncompresses a block of data that is already in memory and returns it in a byte buffer.
+	 * @param source pointer to the stored block, at least getStoredSize() bytes long
+	 * @return the uncompressed data or nullptr if it could not be inflated
+	 */
+	byte* uncompress(const byte* source) {
+		byte* uncompressedData = new byte[uncompressedSize];
+
+		switch (compressionType) {
+		case 2: //Data is compressed
+		{
+			unsigned long destSize = uncompressedSize;
+
+			int result = zlib::uncompress(uncompressedData, &destSize, source, compressedSize);
+
+			if (result != Z_OK || destSize != uncompressedSize) {
+				delete [] uncompressedData;
+				return nullptr;
+			}
+		}
+			break;
+		case 0: //Data is uncompressed
+		default:
+			memcpy(uncompressedData, source, uncompressedSize);
+			break;
+		}
+
+		return uncompressedData;
+	}
+
 	void compress() {
 
 	}
@@ -104,6 +134,13 @@ public:
 	inline uint32 getUncompressedSize() const {
 		return uncompressedSize;
 	}
+
+	/**
+	 * Returns the amount of bytes the block takes up in the tree file.
+	 */
+	inline uint32 getStoredSize() const {
+		return compressionType == 2 ? compressedSize : uncompressedSize;
+	}
 };
 
 
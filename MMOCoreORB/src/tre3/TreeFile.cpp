@@ -13,120 +13,177 @@ TreeFile::TreeFile(TreeArchive* archive) : records() {
 	treeArchive = archive;
 	totalRecords = 0;
 	dataOffset = 0;
-
+	readOffset = 0;
 }
 
 TreeFile::~TreeFile() {
 }
 
-void TreeFile::read(const String& path) {
+TreeFileMapping* TreeFile::read(const String& path) {
 	setLoggingName("TreeFile " + path);
 	setLogLevel(Logger::INFO);
 
 	filePath = path;
 
-	File file(path);
-	FileInputStream fileStream(&file);
+	mapping = new TreeFileMapping(path);
+
+	if (!mapping->map()) {
+		error("File does not exist or could not be mapped.");
 
-	if (!file.exists()) {
-		error("File does not exist.");
-		return;
+		mapping = nullptr;
+		return nullptr;
 	}
 
-	readHeader(&fileStream);
+	readOffset = 0;
+
+	if (!readHeader() || !readFileBlock() || !readNameBlock() || !readMD5Sums()) {
+		mapping = nullptr;
+		return nullptr;
+	}
 
-	fileStream.close();
+	return mapping;
 }
 
-void TreeFile::readHeader(FileInputStream* fileStream) {
-	uint32 fileType = 0;
-	fileStream->read((byte*) &fileType, 4);
+const byte* TreeFile::readBytes(uint64 size) {
+	const byte* data = mapping->getData(readOffset, size);
+
+	if (data == nullptr) {
+		error() << "Unexpected end of file reading " << size << " bytes at " << readOffset;
+		return nullptr;
+	}
+
+	readOffset += size;
+
+	return data;
+}
+
+bool TreeFile::readHeader() {
+	const byte* header = readBytes(8);
+
+	if (header == nullptr)
+		return false;
+
+	uint32 fileType = *(uint32*)(header);
 
 	if (fileType != 'TREE') {
 		error("File is not a valid Tree file.");
-		return;
+		return false;
 	}
 
-	fileStream->read((byte*) &version, 4);
+	version = *(int*)(header + 4);
 
 	//TODO: Perhaps this switch can be refactored.
 	switch (version) {
 	case '0005':
 	{
-		uint32 buffer = 0;
+		const byte* buffer = readBytes(28);
 
-		fileStream->read((byte*) &totalRecords, 4);
-		fileStream->read((byte*) &dataOffset, 4);
+		if (buffer == nullptr)
+			return false;
+
+		totalRecords = *(int*)(buffer);
+		dataOffset = *(int*)(buffer + 4);
 
 		debug() << "Found records: " << totalRecords
 			<< " Data offset at " << dataOffset;
 
 		//Setup the file block.
-		fileStream->read((byte*) &buffer, 4);
-		fileBlock.setCompressionType(buffer);
-		fileStream->read((byte*) &buffer, 4);
-		fileBlock.setCompressedSize(buffer);
+		fileBlock.setCompressionType(*(uint32*)(buffer + 8));
+		fileBlock.setCompressedSize(*(uint32*)(buffer + 12));
 		fileBlock.setUncompressedSize(TreeDataBlock::SIZE * totalRecords);
 
 		//Setup the name block.
-		fileStream->read((byte*) &buffer, 4);
-		nameBlock.setCompressionType(buffer);
-		fileStream->read((byte*) &buffer, 4);
-		nameBlock.setCompressedSize(buffer);
-		fileStream->read((byte*) &buffer, 4);
-		nameBlock.setUncompressedSize(buffer);
+		nameBlock.setCompressionType(*(uint32*)(buffer + 16));
+		nameBlock.setCompressedSize(*(uint32*)(buffer + 20));
+		nameBlock.setUncompressedSize(*(uint32*)(buffer + 24));
 	}
 		break;
 	case '0006': //Apparently, the header information is insignificant in this version?
-		fileStream->skip(28);
+		readOffset += 28;
 		break;
 	default:
 		error("Unknown Tree version: " + String::valueOf(version));
-		break;
+		return false;
 	}
 
-	readFileBlock(fileStream);
-	readNameBlock(fileStream);
-	readMD5Sums(fileStream);
+	return true;
 }
 
-void TreeFile::readFileBlock(FileInputStream* fileStream) {
-	fileStream->skip(dataOffset - 36);
-	byte* uncompressedData = fileBlock.uncompress(fileStream);
+bool TreeFile::readFileBlock() {
+	if (totalRecords <= 0)
+		return true;
+
+	readOffset = dataOffset;
+
+	const byte* source = readBytes(fileBlock.getStoredSize());
+
+	if (source == nullptr)
+		return false;
+
+	byte* uncompressedData = fileBlock.uncompress(source);
+
+	if (uncompressedData == nullptr) {
+		error("Could not uncompress the file block.");
+		return false;
+	}
 
 	//Load the records.
 	uint32 bufferOffset = 0;
 	for (int i = 0; i < totalRecords; ++i) {
 		Reference<TreeFileRecord*> tfr = new TreeFileRecord();
 		tfr->setTreeFilePath(filePath);
+		tfr->setMapping(mapping);
 		bufferOffset += tfr->readFromBuffer(uncompressedData + bufferOffset);
 
 		records.emplace(std::move(tfr));
 	}
 
 	delete [] uncompressedData;
+
+	return true;
 }
 
-void TreeFile::readNameBlock(FileInputStream* fileStream) {
-	byte* uncompressedData = nameBlock.uncompress(fileStream);
+bool TreeFile::readNameBlock() {
+	if (totalRecords <= 0)
+		return true;
+
+	const byte* source = readBytes(nameBlock.getStoredSize());
+
+	if (source == nullptr)
+		return false;
+
+	byte* uncompressedData = nameBlock.uncompress(source);
+
+	if (uncompressedData == nullptr) {
+		error("Could not uncompress the name block.");
+		return false;
+	}
 
 	for (int i = 0; i < totalRecords; ++i) {
 		TreeFileRecord* record = records.get(i);
 
 		if (treeArchive != nullptr)
 			treeArchive->addRecord(((char*) uncompressedData) + record->getNameOffset(), record);
+		else
+			record->setRecordName(((char*) uncompressedData) + record->getNameOffset());
 	}
 
 	delete [] uncompressedData;
+
+	return true;
 }
 
-void TreeFile::readMD5Sums(FileInputStream* fileStream) {
+bool TreeFile::readMD5Sums() {
 	for (int i = 0; i < totalRecords; ++i) {
 		TreeFileRecord* record = records.get(i);
 
-		byte md5[16];
-		fileStream->read(md5, 16);
+		const byte* md5 = readBytes(16);
+
+		if (md5 == nullptr)
+			return false;
 
 		record->setMD5Sum(md5);
 	}
+
+	return true;
 }
@@ -10,6 +10,7 @@
 
 #include "TreeFileRecord.h"
 #include "TreeDataBlock.h"
+#include "TreeFileMapping.h"
 
 class TreeArchive;
 
@@ -26,16 +27,38 @@ class TreeFile : public Logger {
 
 	Vector<Reference<TreeFileRecord*> > records;
 
-	void readHeader(FileInputStream* fileStream);
-	void readFileBlock(FileInputStream* fileStream);
-	void readNameBlock(FileInputStream* fileStream);
-	void readMD5Sums(FileInputStream* fileStream);
+	Reference<TreeFileMapping*> mapping;
+	uint64 readOffset;
+
+	bool readHeader();
+	bool readFileBlock();
+	bool readNameBlock();
+	bool readMD5Sums();
+
+	/**
+	 * Returns the next size bytes of the mapped file and advances past them.
+	 */
+	const byte* readBytes(uint64 size);
 
 public:
 	TreeFile(TreeArchive* archive);
 	~TreeFile();
 
-	void read(const String& path);
+	/**
+	 * Maps the tree file and adds its records to the archive. Without an
+	 * archive the records keep their full path as name until they are added
+	 * with TreeArchive::unpackFiles.
+	 * @return the mapping the records read from or nullptr on failure
+	 */
+	TreeFileMapping* read(const String& path);
+
+	inline const Vector<Reference<TreeFileRecord*> >& getRecords() const {
+		return records;
+	}
+
+	inline TreeFileMapping* getMapping() const {
+		return mapping.get();
+	}
 	//void write(const String& filePath);
 };
 
@@ -0,0 +1,68 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "TreeFileMapping.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+AtomicInteger TreeFileMapping::lastMappingID;
+
+TreeFileMapping::TreeFileMapping(const String& path) : Object(), Logger("TreeFileMapping " + path) {
+	filePath = path;
+
+	data = nullptr;
+	dataSize = 0;
+
+	mappingID = lastMappingID.increment();
+}
+
+TreeFileMapping::~TreeFileMapping() {
+	if (data != nullptr) {
+		munmap(data, dataSize);
+
+		data = nullptr;
+	}
+}
+
+bool TreeFileMapping::map() {
+	if (data != nullptr)
+		return true;
+
+	int fd = open(filePath.toCharArray(), O_RDONLY);
+
+	if (fd == -1) {
+		error() << "could not open file: " << strerror(errno);
+		return false;
+	}
+
+	struct stat st;
+
+	if (fstat(fd, &st) == -1 || st.st_size <= 0) {
+		error("could not stat file or file is empty");
+
+		close(fd);
+		return false;
+	}
+
+	void* mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// the mapping keeps its own reference to the file
+	close(fd);
+
+	if (mapped == MAP_FAILED) {
+		error() << "could not map file: " << strerror(errno);
+		return false;
+	}
+
+	// records are looked up by name in any order so don't let the kernel read ahead
+	madvise(mapped, st.st_size, MADV_RANDOM);
+
+	data = static_cast<byte*>(mapped);
+	dataSize = st.st_size;
+
+	return true;
+}
@@ -0,0 +1,66 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef TREEFILEMAPPING_H_
+#define TREEFILEMAPPING_H_
+
+#include "engine/engine.h"
+
+/**
+ * Read only memory mapping of a whole TRE file.
+ *
+ * Each archive is mapped once when it is unpacked and stays mapped for as long
+ * as something references it, so records can be read straight out of the page
+ * cache instead of opening, seeking and reading the file for every lookup.
+ */
+class TreeFileMapping : public Object, public Logger {
+	String filePath;
+
+	byte* data;
+	uint64 dataSize;
+
+	// never reused, unlike the address of a mapping or record
+	uint32 mappingID;
+
+	static AtomicInteger lastMappingID;
+
+public:
+	TreeFileMapping(const String& path);
+	~TreeFileMapping();
+
+	/**
+	 * Maps the file into memory.
+	 * @return false if the file could not be opened or mapped
+	 */
+	bool map();
+
+	/**
+	 * Returns a pointer to length bytes at offset or nullptr if the range
+	 * lies outside of the mapped file.
+	 */
+	inline const byte* getData(uint64 offset, uint64 length) const {
+		if (data == nullptr || offset > dataSize || length > dataSize - offset)
+			return nullptr;
+
+		return data + offset;
+	}
+
+	inline bool isMapped() const {
+		return data != nullptr;
+	}
+
+	inline uint64 size() const {
+		return dataSize;
+	}
+
+	inline const String& getFilePath() const {
+		return filePath;
+	}
+
+	inline uint32 getMappingID() const {
+		return mappingID;
+	}
+};
+
+#endif /* TREEFILEMAPPING_H_ */
@@ -9,6 +9,8 @@
 #define TREEFILERECORD_H_
 
 #include "TreeDataBlock.h"
+#include "TreeFileMapping.h"
+#include "TreeRecordCache.h"
 
 class TreeFileRecord : public Object, public Logger {
 	String recordName;
@@ -23,6 +25,8 @@ class TreeFileRecord : public Object, public Logger {
 
 	byte md5Sum[16];
 
+	Reference<TreeFileMapping*> mapping;
+
 public:
 	TreeFileRecord() : Object(), Logger(), checksum(0), uncompressedSize(0), fileOffset(0), compressionType(0), compressedSize(0), nameOffset(0) {
 		setLoggingName("TreeFileRecord");
@@ -41,6 +45,7 @@ public:
 		compressedSize = tfr.compressedSize;
 		nameOffset = tfr.nameOffset;
 		memcpy(md5Sum, tfr.md5Sum, 16);
+		mapping = tfr.mapping;
 
 		setLoggingName("TreeFileRecord " + recordName);
 		setLogging(false);
@@ -59,6 +64,7 @@ public:
 		compressedSize = tfr.compressedSize;
 		nameOffset = tfr.nameOffset;
 		memcpy(md5Sum, tfr.md5Sum, 16);
+		mapping = tfr.mapping;
 
 		setLoggingName("TreeFileRecord " + recordName);
 
@@ -106,27 +112,61 @@ public:
 	    return bufferOffset;
 	}
 
-	byte* getBytes() {
-		File file(treeFilePath);
-		FileInputStream fileStream(&file);
-
-		if (!file.exists()) {
-			error("Tree File does not exist: " + treeFilePath);
-			return nullptr;
+	/**
+	 * Points view at the contents of this record. Uncompressed records are
+	 * viewed straight from the mapped tree file, compressed records are
+	 * inflated once and shared through cache while they stay in it.
+	 * @param cache inflated record cache, can be nullptr
+	 * @return false if the record could not be read
+	 */
+	bool getView(TreeRecordView& view, TreeRecordCache* cache) const {
+		if (mapping == nullptr) {
+			error("Tree File is not mapped: " + treeFilePath);
+			return false;
 		}
 
-		fileStream.skip(fileOffset);
-
 		TreeDataBlock db;
 		db.setCompressedSize(compressedSize);
 		db.setUncompressedSize(uncompressedSize);
 		db.setCompressionType(compressionType);
 
-		byte* buffer = db.uncompress(&fileStream);
+		const byte* source = mapping->getData(fileOffset, db.getStoredSize());
+
+		if (source == nullptr) {
+			error("Record lies outside of Tree File: " + treeFilePath);
+			return false;
+		}
+
+		if (compressionType != 2) {
+			view.set(mapping.get(), source, uncompressedSize);
+			return true;
+		}
+
+		// records of one archive never share an offset
+		uint64 key = ((uint64) mapping->getMappingID() << 32) | fileOffset;
+
+		Reference<TreeRecordData*> data;
+
+		if (cache != nullptr)
+			data = cache->get(key);
 
-		fileStream.close();
+		if (data == nullptr) {
+			byte* buffer = db.uncompress(source);
 
-		return buffer;
+			if (buffer == nullptr) {
+				error("Could not uncompress record in " + treeFilePath);
+				return false;
+			}
+
+			data = new TreeRecordData(buffer, uncompressedSize);
+
+			if (cache != nullptr)
+				cache->put(key, data);
+		}
+
+		view.set(data.get(), data->getData(), data->size());
+
+		return true;
 	}
 
 	String toString() const {
@@ -141,7 +181,7 @@ public:
 		return str.toString();
 	}
 
-	inline void setMD5Sum(byte sum[16]) {
+	inline void setMD5Sum(const byte* sum) {
 		memcpy(&md5Sum, sum, 16);
 	}
 
@@ -149,6 +189,10 @@ public:
 		return nameOffset;
 	}
 
+	inline uint32 getCompressedSize() const {
+		return compressedSize;
+	}
+
 	inline uint32 getCompressionType() const {
 		return compressionType;
 	}
@@ -168,6 +212,10 @@ public:
 	inline void setTreeFilePath(const String& path) {
 		treeFilePath = path;
 	}
+
+	inline void setMapping(TreeFileMapping* fileMapping) {
+		mapping = fileMapping;
+	}
 };
 
 #endif /* TREEFILERECORD_H_ */
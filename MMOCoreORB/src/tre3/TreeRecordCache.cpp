@@ -0,0 +1,138 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#include "TreeRecordCache.h"
+
+TreeRecordCache::TreeRecordCache(uint64 maxSize) : Logger("TreeRecordCache") {
+	records.setNullValue(nullptr);
+
+	head = nullptr;
+	tail = nullptr;
+
+	maxBytes = maxSize;
+	cachedBytes = 0;
+
+	hits = 0;
+	misses = 0;
+	evictions = 0;
+}
+
+TreeRecordCache::~TreeRecordCache() {
+	clear();
+}
+
+Reference<TreeRecordData*> TreeRecordCache::get(uint64 key) {
+	Locker locker(&mutex);
+
+	Reference<TreeRecordData*> data = records.get(key);
+
+	if (data == nullptr) {
+		++misses;
+
+		return nullptr;
+	}
+
+	++hits;
+
+	if (head != data.get()) {
+		unlink(data);
+		linkFront(data);
+	}
+
+	return data;
+}
+
+void TreeRecordCache::put(uint64 key, TreeRecordData* data) {
+	if (data == nullptr || data->size() > maxBytes)
+		return;
+
+	Locker locker(&mutex);
+
+	// another reader inflated the same record first
+	if (records.containsKey(key))
+		return;
+
+	evict(data->size());
+
+	data->key = key;
+
+	records.put(key, data);
+	linkFront(data);
+
+	cachedBytes += data->size();
+}
+
+void TreeRecordCache::clear() {
+	Locker locker(&mutex);
+
+	while (tail != nullptr) {
+		TreeRecordData* data = tail;
+
+		unlink(data);
+		records.remove(data->key);
+	}
+
+	cachedBytes = 0;
+}
+
+void TreeRecordCache::setMaxSize(uint64 maxSize) {
+	Locker locker(&mutex);
+
+	maxBytes = maxSize;
+
+	evict(0);
+}
+
+String TreeRecordCache::getStatistics() const {
+	Locker locker(&mutex);
+
+	StringBuffer str;
+	str << records.size() << " inflated records cached using " << (cachedBytes >> 10) << "/" << (maxBytes >> 10) << " KB, "
+		<< hits << " hits, " << misses << " misses, " << evictions << " evictions";
+
+	return str.toString();
+}
+
+void TreeRecordCache::unlink(TreeRecordData* data) {
+	if (data->prev != nullptr)
+		data->prev->next = data->next;
+	else
+		head = data->next;
+
+	if (data->next != nullptr)
+		data->next->prev = data->prev;
+	else
+		tail = data->prev;
+
+	data->prev = nullptr;
+	data->next = nullptr;
+}
+
+void TreeRecordCache::linkFront(TreeRecordData* data) {
+	data->prev = nullptr;
+	data->next = head;
+
+	if (head != nullptr)
+		head->prev = data;
+
+	head = data;
+
+	if (tail == nullptr)
+		tail = data;
+}
+
+void TreeRecordCache::evict(uint64 neededBytes) {
+	while (tail != nullptr && cachedBytes + neededBytes > maxBytes) {
+		TreeRecordData* data = tail;
+
+		cachedBytes -= data->size();
+
+		unlink(data);
+
+		// drops the cache reference, readers still holding a view keep the bytes alive
+		records.remove(data->key);
+
+		++evictions;
+	}
+}
@@ -0,0 +1,148 @@
+/*
+				Copyright <SWGEmu>
+		See file COPYING for copying conditions.*/
+
+#ifndef TREERECORDCACHE_H_
+#define TREERECORDCACHE_H_
+
+#include "engine/engine.h"
+
+class TreeRecordCache;
+
+/**
+ * Inflated contents of a compressed tree file record.
+ */
+class TreeRecordData : public Object {
+	byte* data;
+	uint32 dataSize;
+
+	// LRU links, guarded by the owning TreeRecordCache
+	uint64 key;
+	TreeRecordData* prev;
+	TreeRecordData* next;
+
+	friend class TreeRecordCache;
+
+public:
+	TreeRecordData(byte* buffer, uint32 size) : Object(), data(buffer), dataSize(size), key(0), prev(nullptr), next(nullptr) {
+	}
+
+	~TreeRecordData() {
+		delete [] data;
+	}
+
+	inline const byte* getData() const {
+		return data;
+	}
+
+	inline uint32 size() const {
+		return dataSize;
+	}
+};
+
+/**
+ * Read only view of a record. The view keeps whatever owns the bytes (the
+ * mapped archive or the inflated record) alive until it is cleared.
+ */
+class TreeRecordView {
+	Reference<Object*> owner;
+
+	const byte* data;
+	uint32 dataSize;
+
+public:
+	TreeRecordView() : data(nullptr), dataSize(0) {
+	}
+
+	inline void set(Object* bytesOwner, const byte* bytes, uint32 size) {
+		owner = bytesOwner;
+		data = bytes;
+		dataSize = size;
+	}
+
+	inline void clear() {
+		owner = nullptr;
+		data = nullptr;
+		dataSize = 0;
+	}
+
+	/**
+	 * Copies the viewed bytes into a new buffer.
+	 * Don't forget to delete the pointer when finished.
+	 */
+	byte* copyBytes() const {
+		if (data == nullptr)
+			return nullptr;
+
+		byte* buffer = new byte[dataSize];
+		memcpy(buffer, data, dataSize);
+
+		return buffer;
+	}
+
+	inline const byte* getData() const {
+		return data;
+	}
+
+	inline uint32 size() const {
+		return dataSize;
+	}
+
+	inline bool isEmpty() const {
+		return data == nullptr || dataSize == 0;
+	}
+};
+
+/**
+ * Bounded LRU of inflated records shared by every reader of a TreeArchive, so
+ * datatables, meshes and templates that are opened repeatedly only pay for
+ * zlib once while they stay hot.
+ */
+class TreeRecordCache : public Logger {
+	HashTable<uint64, Reference<TreeRecordData*> > records;
+
+	// most recently used at the head
+	TreeRecordData* head;
+	TreeRecordData* tail;
+
+	uint64 maxBytes;
+	uint64 cachedBytes;
+
+	uint64 hits;
+	uint64 misses;
+	uint64 evictions;
+
+	mutable Mutex mutex;
+
+public:
+	TreeRecordCache(uint64 maxSize);
+	~TreeRecordCache();
+
+	/**
+	 * Returns the cached record for key or nullptr, marking it as most recently used.
+	 */
+	Reference<TreeRecordData*> get(uint64 key);
+
+	/**
+	 * Adds an inflated record, evicting the least recently used ones to stay
+	 * within the size limit. Records bigger than the whole cache are not kept.
+	 */
+	void put(uint64 key, TreeRecordData* data);
+
+	void clear();
+
+	void setMaxSize(uint64 maxSize);
+
+	String getStatistics() const;
+
+	inline uint64 getMaxSize() const {
+		return maxBytes;
+	}
+
+private:
+	void unlink(TreeRecordData* data);
+	void linkFront(TreeRecordData* data);
+	void evict(uint64 neededBytes);
+};
+
+#endif /* TREERECORDCACHE_H_ */